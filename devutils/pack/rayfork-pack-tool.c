@@ -0,0 +1,58 @@
+// Builds a rayfork pack from a list of files.
+// Usage: rayfork-pack-tool <output.rfpk> [-c] <files...>
+// Files after -c are compressed. Paths are stored as given on the command line, so run it from the assets folder.
+// Build: cc rayfork-pack-tool.c ../../source/core/rayfork-core.c ../../source/pack/rayfork-pack.c -I../../source/core -I../../source/pack
+
+#include "rayfork-pack.h"
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Usage: %s <output.rfpk> [-c] <files...>\n", argv[0]);
+        return 1;
+    }
+
+    rf_pack_source* sources = calloc(argc, sizeof(rf_pack_source));
+    rf_int sources_count = 0;
+    rf_bool compress = 0;
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-c") == 0)
+        {
+            compress = 1;
+            continue;
+        }
+
+        rf_file_view view = rf_view_file(rf_mmap_io, argv[i], rf_default_allocator);
+
+        if (!view.valid)
+        {
+            printf("Failed to read %s\n", argv[i]);
+            return 1;
+        }
+
+        sources[sources_count++] = (rf_pack_source) { argv[i], view.data, view.size, compress };
+    }
+
+    rf_int bound = rf_pack_build_bound(sources, sources_count, RF_PACK_DEFAULT_ALIGNMENT);
+    void* archive = malloc(bound);
+    rf_int archive_size = rf_pack_build_to_buffer(sources, sources_count, RF_PACK_DEFAULT_ALIGNMENT, archive, bound);
+
+    FILE* file = fopen(argv[1], "wb");
+
+    if (!archive_size || !file || fwrite(archive, 1, archive_size, file) != (size_t) archive_size)
+    {
+        printf("Failed to write %s\n", argv[1]);
+        return 1;
+    }
+
+    fclose(file);
+    printf("Packed %d files into %s (%d bytes)\n", (int) sources_count, argv[1], (int) archive_size);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include "rayfork-arr.h"
+#include "string.h"
+
+rf_internal rf_int rf__arr_bytes(rf_int size_of_t, rf_int capacity)
+{
+    rf_int result = sizeof(rf_arr_header) + size_of_t * capacity;
+    return result;
+}
+
+rf_internal rf_bool rf__arr_set_capacity(void** arr, rf_int size_of_t, rf_int capacity)
+{
+    rf_arr_header* header = rf_arr_internals(*arr);
+    rf_arr_header* new_header = rf_realloc(header->allocator, header, rf__arr_bytes(size_of_t, capacity), rf__arr_bytes(size_of_t, header->capacity));
+
+    if (!new_header)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to grow array to a capacity of %d elements of size %d", (int) capacity, (int) size_of_t);
+        return 0;
+    }
+
+    new_header->capacity = capacity;
+    *arr = new_header + 1;
+
+    return 1;
+}
+
+rf_public void* rf_arr_make_impl(rf_int size_of_t, rf_int capacity, rf_allocator allocator)
+{
+    if (capacity < 0) capacity = 0;
+
+    rf_arr_header* header = rf_alloc(allocator, rf__arr_bytes(size_of_t, capacity));
+
+    if (!header)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate array with a capacity of %d elements of size %d", (int) capacity, (int) size_of_t);
+        return 0;
+    }
+
+    header->size      = 0;
+    header->capacity  = capacity;
+    header->allocator = allocator;
+
+    return header + 1;
+}
+
+rf_public void rf_arr_free_impl(void** arr)
+{
+    if (!*arr) return;
+
+    rf_arr_header* header = rf_arr_internals(*arr);
+    rf_free(header->allocator, header);
+    *arr = 0;
+}
+
+rf_public rf_bool rf_arr_reserve_impl(void** arr, rf_int size_of_t, rf_int capacity)
+{
+    if (!*arr) return 0;
+    if (capacity <= rf_arr_internals(*arr)->capacity) return 1;
+
+    rf_bool result = rf__arr_set_capacity(arr, size_of_t, capacity);
+    return result;
+}
+
+rf_public rf_bool rf_arr_grow_impl(void** arr, rf_int size_of_t, rf_int extra)
+{
+    if (!*arr) return 0;
+
+    rf_arr_header* header = rf_arr_internals(*arr);
+    rf_int required = header->size + extra;
+
+    if (required <= header->capacity) return 1;
+
+    // Grow by 1.5x so a sequence of adds is amortized O(1)
+    rf_int new_capacity = header->capacity + header->capacity / 2;
+    if (new_capacity < required) new_capacity = required;
+    if (new_capacity < RF_ARR_MIN_CAPACITY) new_capacity = RF_ARR_MIN_CAPACITY;
+
+    rf_bool result = rf__arr_set_capacity(arr, size_of_t, new_capacity);
+    return result;
+}
+
+rf_public rf_bool rf_arr_resize_impl(void** arr, rf_int size_of_t, rf_int size)
+{
+    if (!*arr || size < 0) return 0;
+
+    rf_int old_size = rf_arr_internals(*arr)->size;
+
+    if (size > old_size)
+    {
+        if (!rf_arr_grow_impl(arr, size_of_t, size - old_size)) return 0;
+        memset((char*) *arr + old_size * size_of_t, 0, (size - old_size) * size_of_t);
+    }
+
+    rf_arr_internals(*arr)->size = size;
+
+    return 1;
+}
+
+rf_public rf_bool rf_arr_shrink_to_fit_impl(void** arr, rf_int size_of_t)
+{
+    if (!*arr) return 0;
+
+    rf_arr_header* header = rf_arr_internals(*arr);
+    if (header->size == header->capacity) return 1;
+
+    rf_bool result = rf__arr_set_capacity(arr, size_of_t, header->size);
+    return result;
+}
+
+rf_public rf_bool rf_arr_insert_n_impl(void** arr, rf_int size_of_t, rf_int index, const void* items, rf_int count)
+{
+    if (!*arr || count < 0 || index < 0 || index > rf_arr_internals(*arr)->size) return 0;
+    if (count == 0) return 1;
+
+    // The items may point into the array itself, which can move when it grows
+    rf_int items_offset = rf_invalid_index;
+    rf_arr_header* header = rf_arr_internals(*arr);
+    if (items && (const char*) items >= (const char*) *arr && (const char*) items < (const char*) *arr + header->size * size_of_t)
+    {
+        items_offset = (const char*) items - (const char*) *arr;
+    }
+
+    if (!rf_arr_grow_impl(arr, size_of_t, count)) return 0;
+
+    header = rf_arr_internals(*arr);
+    char* data = *arr;
+
+    memmove(data + (index + count) * size_of_t, data + index * size_of_t, (header->size - index) * size_of_t);
+
+    if (items)
+    {
+        if (items_offset != rf_invalid_index)
+        {
+            // The part of the items that was after the insertion point got shifted by the memmove above
+            rf_int insert_offset = index * size_of_t;
+            rf_int bytes = count * size_of_t;
+            rf_int bytes_before = items_offset < insert_offset ? insert_offset - items_offset : 0;
+            if (bytes_before > bytes) bytes_before = bytes;
+
+            memcpy(data + insert_offset, data + items_offset, bytes_before);
+            memcpy(data + insert_offset + bytes_before, data + items_offset + bytes_before + bytes, bytes - bytes_before);
+        }
+        else
+        {
+            memcpy(data + index * size_of_t, items, count * size_of_t);
+        }
+    }
+
+    header->size += count;
+
+    return 1;
+}
+
+rf_public void rf_arr_remove_range_impl(void* arr, rf_int size_of_t, rf_int index, rf_int count)
+{
+    if (!arr || count <= 0) return;
+
+    rf_arr_header* header = rf_arr_internals(arr);
+    if (index < 0 || index >= header->size) return;
+    if (count > header->size - index) count = header->size - index;
+
+    char* data = arr;
+    memmove(data + index * size_of_t, data + (index + count) * size_of_t, (header->size - index - count) * size_of_t);
+    header->size -= count;
+}
@@ -3,6 +3,17 @@
 
 #include "rayfork-core.h"
 
+/*
+ * Type generic growable array. An rf_arr(T) is a plain T* that can be indexed normally, its size, capacity and allocator
+ * are stored in a header right before the first element. Make arrays with rf_arr_make, a null array reads as empty but can't grow
+ * since it has no allocator. Macros that can grow the array take it as an lvalue and update it in place, so pointers
+ * to its elements are invalidated by them. Macro arguments other than the array are evaluated once unless noted otherwise.
+ */
+
+#ifndef RF_ARR_MIN_CAPACITY
+    #define RF_ARR_MIN_CAPACITY (8)
+#endif
+
 typedef struct rf_arr_header
 {
     rf_int size;
@@ -11,35 +22,42 @@ typedef struct rf_arr_header
 } rf_arr_header;
 
 #define rf_arr(T) T*
-#define rf_arr_internals(arr)            ((rf_arr_header*)((arr) - sizeof(rf_arr_header)))
-#define rf_arr_size(arr)                 (rf_arr_internals(arr)->size)
-#define rf_arr_capacity(arr)             (rf_arr_internals(arr)->capacity)
+#define rf_arr_internals(arr)            ((rf_arr_header*)(void*)(arr) - 1)
+#define rf_arr_make(T, capacity, allocator) ((T*) rf_arr_make_impl(sizeof(T), (capacity), (allocator)))
+#define rf_arr_free(arr)                 (rf_arr_free_impl((void**) &(arr)))
+
+#define rf_arr_size(arr)                 ((arr) ? rf_arr_internals(arr)->size : 0)
+#define rf_arr_capacity(arr)             ((arr) ? rf_arr_internals(arr)->capacity : 0)
 #define rf_arr_allocator(arr)            (rf_arr_internals(arr)->allocator)
 #define rf_arr_begin(arr)                (arr)
-#define rf_arr_end(arr)                  ((arr) + rf_arr_internals(arr)->size)
+#define rf_arr_end(arr)                  ((arr) + rf_arr_size(arr))
 #define rf_arr_first(arr)                ((arr)[0])
 #define rf_arr_last(arr)                 ((arr)[rf_arr_size(arr) - 1])
 #define rf_arr_is_valid_index(arr, i)    (((i) >= 0) && ((i) < rf_arr_size(arr)))
-#define rf_arr_has_space_for(arr, n)     (rf_arr_size(arr) < (rf_arr_capacity(arr) - n))
-#define rf_arr_add(arr, item)            ((arr = rf_arr_ensure_capacity((arr), rf_arr_has_space_for(arr, 1) ? 1 : ceilf(rf_arr_size(arr) * 1.5f)), (arr)[rf_arr_size++] = (item) : 0))
-#define rf_arr_remove_unordered(arr, i)  ((arr)[i] = (arr)[rf_arr_size(arr)--])
-#define rf_arr_remove_ordered(arr, i)    (rf_arr_remove_ordered_impl(rf_arr_internals(arr), sizeof(arr[0]), i))
-#define rf_arr_ensure_capacity(arr, cap) (rf_arr_ensure_capacity_impl(rf_arr_internals(arr), sizeof(arr[0]), cap))
-
-rf_public rf_arr(void) rf_arr_ensure_capacity_impl(rf_arr_header* header, rf_int size_of_t, rf_int cap)
-{
-    rf_arr(void) result = header;
-
-    if (cap > header->capacity)
-    {
-        rf_int arr_cur_size = sizeof(rf_arr_header) + (size_of_t * header->capacity);
-        rf_int arr_new_size = sizeof(rf_arr_header) + (size_of_t * cap);
-        header = rf_realloc(header->allocator, header, arr_new_size, arr_cur_size);
-    }
-
-    return result;
-}
-
-rf_public rf_arr(void)
-
-#endif // RAYFORK_ARR_H
\ No newline at end of file
+#define rf_arr_has_space_for(arr, n)     (rf_arr_size(arr) + (n) <= rf_arr_capacity(arr))
+
+// These return true on success and false if the allocation failed, in which case the array is left unchanged
+#define rf_arr_reserve(arr, cap)                   (rf_arr_reserve_impl((void**) &(arr), sizeof(*(arr)), (cap)))
+#define rf_arr_resize(arr, size)                   (rf_arr_resize_impl((void**) &(arr), sizeof(*(arr)), (size)))   // New elements are zeroed
+#define rf_arr_shrink_to_fit(arr)                  (rf_arr_shrink_to_fit_impl((void**) &(arr), sizeof(*(arr))))
+#define rf_arr_add(arr, item)                      (rf_arr_grow_impl((void**) &(arr), sizeof(*(arr)), 1) ? ((arr)[rf_arr_internals(arr)->size++] = (item), 1) : 0)
+#define rf_arr_add_n(arr, items, count)            (rf_arr_insert_n_impl((void**) &(arr), sizeof(*(arr)), rf_arr_size(arr), (items), (count)))
+#define rf_arr_insert(arr, index, item)            (rf_arr_insert_n_impl((void**) &(arr), sizeof(*(arr)), (index), 0, 1) ? ((arr)[index] = (item), 1) : 0) // Evaluates index twice
+#define rf_arr_insert_n(arr, index, items, count)  (rf_arr_insert_n_impl((void**) &(arr), sizeof(*(arr)), (index), (items), (count)))
+
+#define rf_arr_pop(arr)                            ((arr)[--rf_arr_internals(arr)->size])
+#define rf_arr_clear(arr)                          ((arr) ? (void)(rf_arr_internals(arr)->size = 0) : (void) 0)
+#define rf_arr_remove_unordered(arr, i)            ((arr)[i] = (arr)[--rf_arr_internals(arr)->size]) // Moves the last element into the hole, evaluates i twice
+#define rf_arr_remove_ordered(arr, i)              (rf_arr_remove_range_impl((arr), sizeof(*(arr)), (i), 1))
+#define rf_arr_remove_range(arr, i, count)         (rf_arr_remove_range_impl((arr), sizeof(*(arr)), (i), (count)))
+
+rf_public void*   rf_arr_make_impl(rf_int size_of_t, rf_int capacity, rf_allocator allocator);
+rf_public void    rf_arr_free_impl(void** arr);
+rf_public rf_bool rf_arr_reserve_impl(void** arr, rf_int size_of_t, rf_int capacity);
+rf_public rf_bool rf_arr_grow_impl(void** arr, rf_int size_of_t, rf_int extra); // Makes space for `extra` more elements, growing the capacity geometrically
+rf_public rf_bool rf_arr_resize_impl(void** arr, rf_int size_of_t, rf_int size);
+rf_public rf_bool rf_arr_shrink_to_fit_impl(void** arr, rf_int size_of_t);
+rf_public rf_bool rf_arr_insert_n_impl(void** arr, rf_int size_of_t, rf_int index, const void* items, rf_int count); // Null items leaves the inserted elements uninitialized
+rf_public void    rf_arr_remove_range_impl(void* arr, rf_int size_of_t, rf_int index, rf_int count);
+
+#endif // RAYFORK_ARR_H
@@ -3,6 +3,383 @@
 #include "string.h"
 #include "malloc.h"
 #include "stdio.h"
+#include "stdlib.h"
+
+#if defined(rayfork_platform_windows)
+    #define WIN32_LEAN_AND_MEAN
+    #include "windows.h"
+#elif defined(rayfork_platform_linux) || defined(rayfork_platform_android) || defined(rayfork_platform_macos) || defined(rayfork_platform_ios)
+    #define rayfork__posix_io
+    #include "sys/mman.h"
+    #include "sys/stat.h"
+    #include "fcntl.h"
+    #include "unistd.h"
+#endif
+
+#if !defined(rayfork_platform_windows)
+    #include "pthread.h"
+    #include "sched.h"
+    #include "time.h"
+#endif
+
+#if defined(rayfork_sse2)
+    #include "emmintrin.h"
+#elif defined(rayfork_neon)
+    #include "arm_neon.h"
+#endif
+
+#pragma region atomics
+
+#if defined(_MSC_VER)
+    #if defined(_WIN64)
+        #define rf__atomic_add(ptr, value)      (InterlockedExchangeAdd64((volatile LONG64*)(ptr), (value)) + (value))
+        #define rf__atomic_exchange(ptr, value) (InterlockedExchange64((volatile LONG64*)(ptr), (value)))
+        #define rf__atomic_load(ptr)            (InterlockedCompareExchange64((volatile LONG64*)(ptr), 0, 0))
+        #define rf__atomic_compare_exchange(ptr, expected, desired) (InterlockedCompareExchange64((volatile LONG64*)(ptr), (desired), (expected)) == (expected))
+    #else
+        #define rf__atomic_add(ptr, value)      (InterlockedExchangeAdd((volatile LONG*)(ptr), (value)) + (value))
+        #define rf__atomic_exchange(ptr, value) (InterlockedExchange((volatile LONG*)(ptr), (value)))
+        #define rf__atomic_load(ptr)            (InterlockedCompareExchange((volatile LONG*)(ptr), 0, 0))
+        #define rf__atomic_compare_exchange(ptr, expected, desired) (InterlockedCompareExchange((volatile LONG*)(ptr), (desired), (expected)) == (expected))
+    #endif
+#else
+    #define rf__atomic_add(ptr, value)      (__atomic_add_fetch((ptr), (value), __ATOMIC_SEQ_CST))
+    #define rf__atomic_exchange(ptr, value) (__atomic_exchange_n((ptr), (value), __ATOMIC_SEQ_CST))
+    #define rf__atomic_load(ptr)            (__atomic_load_n((ptr), __ATOMIC_SEQ_CST))
+    #define rf__atomic_compare_exchange(ptr, expected, desired) (__sync_bool_compare_and_swap((ptr), (expected), (desired)))
+#endif
+
+#define rf__atomic_store(ptr, value) ((void) rf__atomic_exchange((ptr), (value)))
+
+rf_internal void rf__thread_yield(void)
+{
+    #if defined(rayfork_platform_windows)
+        SwitchToThread();
+    #else
+        sched_yield();
+    #endif
+}
+
+rf_internal void rf__thread_sleep_ms(rf_int ms)
+{
+    #if defined(rayfork_platform_windows)
+        Sleep((DWORD) ms);
+    #else
+        struct timespec duration = { ms / 1000, (ms % 1000) * 1000000 };
+        nanosleep(&duration, 0);
+    #endif
+}
+
+rf_internal void rf__spin_lock(volatile rf_int* lock)
+{
+    while (rf__atomic_exchange(lock, 1))
+    {
+        while (rf__atomic_load(lock)) rf__thread_yield();
+    }
+}
+
+rf_internal void rf__spin_unlock(volatile rf_int* lock)
+{
+    rf__atomic_store(lock, 0);
+}
+
+#pragma endregion
+
+#pragma region bit scan
+
+// Both are undefined for 0
+rf_internal int rf__count_trailing_zeros_u64(uint64_t x)
+{
+    #if defined(rayfork_msvc) && defined(_WIN64)
+        unsigned long result;
+        _BitScanForward64(&result, x);
+        return (int) result;
+    #elif defined(rayfork_gnuc) || defined(rayfork_clang)
+        return __builtin_ctzll(x);
+    #else
+        int result = 0;
+        while (!(x & 1)) { x >>= 1; result++; }
+        return result;
+    #endif
+}
+
+rf_internal int rf__count_leading_zeros_u64(uint64_t x)
+{
+    #if defined(rayfork_msvc) && defined(_WIN64)
+        unsigned long result;
+        _BitScanReverse64(&result, x);
+        return 63 - (int) result;
+    #elif defined(rayfork_gnuc) || defined(rayfork_clang)
+        return __builtin_clzll(x);
+    #else
+        int result = 0;
+        while (!(x & 0x8000000000000000ull)) { x <<= 1; result++; }
+        return result;
+    #endif
+}
+
+rf_internal int rf__popcount_u64(uint64_t x)
+{
+    #if defined(rayfork_msvc) && defined(_WIN64)
+        return (int) __popcnt64(x);
+    #elif defined(rayfork_gnuc) || defined(rayfork_clang)
+        return __builtin_popcountll(x);
+    #else
+        x = x - ((x >> 1) & 0x5555555555555555ull);
+        x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+        x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return (int) ((x * 0x0101010101010101ull) >> 56);
+    #endif
+}
+
+#pragma endregion
+
+#pragma region time
+
+rf_public uint64_t rf_get_timestamp_ns(void)
+{
+    uint64_t result = 0;
+
+    #if defined(rayfork_platform_windows)
+    {
+        LARGE_INTEGER frequency, counter;
+        QueryPerformanceFrequency(&frequency);
+        QueryPerformanceCounter(&counter);
+
+        // Split in seconds and remainder so the multiplication doesn't overflow
+        uint64_t seconds   = counter.QuadPart / frequency.QuadPart;
+        uint64_t remainder = counter.QuadPart % frequency.QuadPart;
+        result = seconds * 1000000000ull + (remainder * 1000000000ull) / frequency.QuadPart;
+    }
+    #else
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        result = (uint64_t) now.tv_sec * 1000000000ull + (uint64_t) now.tv_nsec;
+    }
+    #endif
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region profiler
+
+typedef struct rf__profile_zone
+{
+    const char* name;
+    uint64_t    begin_ns;
+} rf__profile_zone;
+
+// Single producer (the owning thread), single consumer (whoever flushes) ring buffer
+typedef struct rf__profile_thread_buffer
+{
+    rf_profile_event  events[RF_PROFILER_EVENTS_PER_THREAD];
+    volatile rf_int   write_index;
+    volatile rf_int   read_index;
+    volatile rf_int   dropped;
+    rf__profile_zone  zones[RF_PROFILER_MAX_ZONE_DEPTH];
+    rf_int            depth;
+    rf_int            thread_id;
+    struct rf__profile_thread_buffer* next;
+} rf__profile_thread_buffer;
+
+rf_internal rf_allocator    rf__profiler_allocator;
+rf_internal uint64_t        rf__profiler_start_ns;
+rf_internal volatile rf_int rf__profiler_enabled;
+rf_internal volatile rf_int rf__profiler_generation;
+rf_internal volatile rf_int rf__profiler_buffers; // Head of the list of thread buffers, stored as an integer to use the atomics
+rf_internal volatile rf_int rf__profiler_thread_count;
+
+rf_internal rf_thread_local rf__profile_thread_buffer* rf__profiler_thread_buffer;
+rf_internal rf_thread_local rf_int                     rf__profiler_thread_generation;
+
+rf_public void rf_profiler_init(rf_allocator allocator)
+{
+    rf__profiler_allocator = allocator;
+    rf__profiler_start_ns  = rf_get_timestamp_ns();
+    rf__atomic_add(&rf__profiler_generation, 1);
+    rf__atomic_store(&rf__profiler_enabled, 1);
+}
+
+rf_public void rf_profiler_shutdown(void)
+{
+    rf__atomic_store(&rf__profiler_enabled, 0);
+
+    // Threads compare their generation before using their cached buffer, so the buffers can be freed
+    rf__atomic_add(&rf__profiler_generation, 1);
+
+    rf__profile_thread_buffer* buffer = (rf__profile_thread_buffer*) rf__atomic_exchange(&rf__profiler_buffers, 0);
+    while (buffer)
+    {
+        rf__profile_thread_buffer* next = buffer->next;
+        rf_free(rf__profiler_allocator, buffer);
+        buffer = next;
+    }
+
+    rf__atomic_store(&rf__profiler_thread_count, 0);
+}
+
+rf_public rf_bool rf_profiler_is_enabled(void)
+{
+    rf_bool result = rf__atomic_load(&rf__profiler_enabled) != 0;
+    return result;
+}
+
+rf_internal rf__profile_thread_buffer* rf__profiler_get_thread_buffer(rf_bool create)
+{
+    rf_int generation = rf__atomic_load(&rf__profiler_generation);
+
+    if (rf__profiler_thread_buffer && rf__profiler_thread_generation == generation)
+    {
+        return rf__profiler_thread_buffer;
+    }
+
+    rf__profiler_thread_buffer = 0;
+    if (!create) return 0;
+
+    rf__profile_thread_buffer* buffer = rf_alloc(rf__profiler_allocator, sizeof(rf__profile_thread_buffer));
+    if (!buffer) return 0;
+
+    memset(buffer, 0, sizeof(rf__profile_thread_buffer));
+    buffer->thread_id = rf__atomic_add(&rf__profiler_thread_count, 1);
+
+    // Lock-free push to the front of the list
+    rf_int head;
+    do
+    {
+        head = rf__atomic_load(&rf__profiler_buffers);
+        buffer->next = (rf__profile_thread_buffer*) head;
+    }
+    while (!rf__atomic_compare_exchange(&rf__profiler_buffers, head, (rf_int) buffer));
+
+    rf__profiler_thread_buffer     = buffer;
+    rf__profiler_thread_generation = generation;
+
+    return buffer;
+}
+
+rf_public void rf__profile_zone_begin(const char* name)
+{
+    if (!rf__atomic_load(&rf__profiler_enabled)) return;
+
+    rf__profile_thread_buffer* buffer = rf__profiler_get_thread_buffer(1);
+    if (!buffer) return;
+
+    // Zones nested deeper than the limit are not recorded but still counted so begin/end stay paired
+    if (buffer->depth < RF_PROFILER_MAX_ZONE_DEPTH)
+    {
+        buffer->zones[buffer->depth] = (rf__profile_zone) { name, rf_get_timestamp_ns() };
+    }
+
+    buffer->depth++;
+}
+
+rf_public void rf__profile_zone_end(void)
+{
+    uint64_t end_ns = rf_get_timestamp_ns();
+
+    rf__profile_thread_buffer* buffer = rf__profiler_get_thread_buffer(0);
+    if (!buffer || buffer->depth <= 0) return;
+
+    buffer->depth--;
+    if (buffer->depth >= RF_PROFILER_MAX_ZONE_DEPTH) return;
+
+    rf_int write_index = buffer->write_index;
+
+    if (write_index - rf__atomic_load(&buffer->read_index) >= RF_PROFILER_EVENTS_PER_THREAD)
+    {
+        rf__atomic_add(&buffer->dropped, 1);
+        return;
+    }
+
+    rf__profile_zone zone = buffer->zones[buffer->depth];
+    buffer->events[write_index & (RF_PROFILER_EVENTS_PER_THREAD - 1)] = (rf_profile_event) { zone.name, zone.begin_ns, end_ns - zone.begin_ns, (uint32_t) buffer->depth };
+
+    rf__atomic_store(&buffer->write_index, write_index + 1);
+}
+
+rf_internal rf_int rf__profiler_write_json_string(char* dst, rf_int dst_size, const char* str)
+{
+    rf_int size = 0;
+
+    for (; *str && size < dst_size - 2; str++)
+    {
+        char c = *str;
+        if (c == '"' || c == '\\') dst[size++] = '\\';
+        dst[size++] = (c < ' ') ? ' ' : c;
+    }
+
+    return size;
+}
+
+rf_public rf_int rf_profiler_flush_chrome_trace(rf_profile_write_proc write_proc, void* user_data)
+{
+    if (!write_proc) return 0;
+
+    const char header[] = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    const char footer[] = "\n]}\n";
+    write_proc(user_data, header, sizeof(header) - 1);
+
+    rf_int result = 0;
+    char line[512];
+
+    for (rf__profile_thread_buffer* buffer = (rf__profile_thread_buffer*) rf__atomic_load(&rf__profiler_buffers); buffer; buffer = buffer->next)
+    {
+        rf_int write_index = rf__atomic_load(&buffer->write_index);
+        rf_int read_index  = buffer->read_index;
+
+        for (rf_int i = read_index; i < write_index; i++)
+        {
+            const rf_profile_event* event = &buffer->events[i & (RF_PROFILER_EVENTS_PER_THREAD - 1)];
+
+            rf_int size = snprintf(line, sizeof(line), "%s\n{\"name\":\"", result ? "," : "");
+            size += rf__profiler_write_json_string(line + size, sizeof(line) - 128 - size, event->name ? event->name : "");
+            size += snprintf(line + size, sizeof(line) - size, "\",\"cat\":\"rayfork\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}",
+                             (double)(event->begin_ns - rf__profiler_start_ns) / 1000.0, (double) event->duration_ns / 1000.0, (int) buffer->thread_id);
+
+            write_proc(user_data, line, size);
+            result++;
+        }
+
+        // Hand the slots back to the owning thread only once they were written out
+        rf__atomic_store(&buffer->read_index, write_index);
+
+        rf_int dropped = rf__atomic_exchange(&buffer->dropped, 0);
+        if (dropped)
+        {
+            rf_log(rf_log_type_warning, "The profiler dropped %d zones on thread %d because its buffer was full", (int) dropped, (int) buffer->thread_id);
+        }
+    }
+
+    write_proc(user_data, footer, sizeof(footer) - 1);
+
+    return result;
+}
+
+rf_internal void rf__profiler_write_to_file(void* user_data, const char* data, rf_int size)
+{
+    fwrite(data, 1, size, (FILE*) user_data);
+}
+
+rf_public rf_int rf_profiler_flush_chrome_trace_to_file(const char* filename)
+{
+    rf_int result = 0;
+
+    FILE* file = fopen(filename, "wb");
+
+    if (file)
+    {
+        result = rf_profiler_flush_chrome_trace(rf__profiler_write_to_file, file);
+        fclose(file);
+    }
+    else rf_log_error(rf_bad_io, "Failed to open %s to write the profiler trace", filename);
+
+    return result;
+}
+
+#pragma endregion
 
 #pragma region error
 
@@ -64,109 +441,1845 @@ rf_public void* rf_libc_allocator_wrapper(struct rf_allocator* this_allocator, r
 
 #pragma endregion
 
-#pragma region io
+#pragma region arena allocator
 
-rf_public rf_int rf_libc_get_file_size(void* user_data, const char* filename)
+rf_internal rf_int rf__arena_align_offset(const rf_arena* arena, rf_int offset)
 {
-    ((void)user_data);
-
-    FILE* file = fopen(filename, "rb");
+    uintptr_t address = (uintptr_t)(arena->memory + offset);
+    uintptr_t padding = (RF_ARENA_ALIGNMENT - (address % RF_ARENA_ALIGNMENT)) % RF_ARENA_ALIGNMENT;
+    return offset + (rf_int)padding;
+}
 
-    fseek(file, 0L, SEEK_END);
-    int size = ftell(file);
-    fseek(file, 0L, SEEK_SET);
+rf_public rf_arena rf_arena_make(void* memory, rf_int size)
+{
+    rf_arena result = {0};
 
-    fclose(file);
+    if (memory && size > 0)
+    {
+        result.memory = memory;
+        result.size   = size;
+        result.last_alloc_offset = rf_invalid_index;
+    }
 
-    return size;
+    return result;
 }
 
-rf_public rf_bool rf_libc_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size)
+rf_public void* rf_arena_alloc(rf_arena* arena, rf_int size)
 {
-    ((void)user_data);
-    rf_bool result = 0;
+    void* result = 0;
 
-    FILE* file = fopen(filename, "rb");
-    if (file != NULL)
+    if (arena && size >= 0)
     {
-        fseek(file, 0L, SEEK_END);
-        int file_size = ftell(file);
-        fseek(file, 0L, SEEK_SET);
+        rf_int offset = rf__arena_align_offset(arena, arena->used);
 
-        if (dst_size >= file_size)
+        if (offset + size <= arena->size)
         {
-            int read_size = fread(dst, 1, file_size, file);
-            int no_error = ferror(file) == 0;
-            if (no_error && read_size == file_size)
+            result = arena->memory + offset;
+
+            arena->last_alloc_offset = offset;
+            arena->used = offset + size;
+
+            if (arena->used > arena->high_water_mark)
             {
-                result = 1;
+                arena->high_water_mark = arena->used;
             }
         }
-        // else log_error buffer is not big enough
     }
-    // else log error could not open file
 
-    fclose(file);
+    return result;
+}
 
+rf_public rf_arena_mark rf_arena_get_mark(const rf_arena* arena)
+{
+    rf_arena_mark result = { arena->used, arena->last_alloc_offset };
     return result;
 }
 
-#pragma endregion
+rf_public void rf_arena_restore(rf_arena* arena, rf_arena_mark mark)
+{
+    // A mark taken after the current position is stale (eg: the arena was reset since), ignore it
+    if (mark.used <= arena->used)
+    {
+        arena->used = mark.used;
+        arena->last_alloc_offset = mark.last_alloc_offset;
+    }
+}
 
-#pragma region logger
+rf_public void rf_arena_reset(rf_arena* arena)
+{
+    arena->used = 0;
+    arena->last_alloc_offset = rf_invalid_index;
+}
 
-rf_internal rf_log_type rf__log_filter;
-rf_internal rf_logger   rf__logger;
+rf_public rf_int rf_arena_remaining(const rf_arena* arena)
+{
+    rf_int result = arena->size - arena->used;
+    return result;
+}
 
-rf_public void rf_set_logger(rf_logger logger) { rf__logger = logger; }
-rf_public void rf_set_logger_filter(rf_log_type filter) { rf__log_filter = filter; }
+rf_public void* rf_arena_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args)
+{
+    rf_assert(this_allocator);
+    (void)source_location;
 
-rf_public rf_logger rf_get_logger() { return rf__logger; }
-rf_public rf_log_type rf_get_log_filter() { return rf__log_filter; }
+    rf_arena* arena = this_allocator->user_data;
+    void*     result = 0;
 
-rf_public void rf__internal_log(rf_source_location source_location, rf_log_type log_type, const char* msg, ...)
-{
-    if (!(log_type & rf__log_filter)) return;
+    char* top = arena->last_alloc_offset != rf_invalid_index ? arena->memory + arena->last_alloc_offset : 0;
 
-    va_list args;
+    switch (mode)
+    {
+        case rf_allocator_mode_alloc:
+            result = rf_arena_alloc(arena, args.size_to_allocate_or_reallocate);
+            break;
 
-    va_start(args, msg);
+        case rf_allocator_mode_free:
+            // Only the most recent allocation can be given back, everything else is released on reset/restore
+            if (top && args.pointer_to_free_or_realloc == top)
+            {
+                arena->used = arena->last_alloc_offset;
+                arena->last_alloc_offset = rf_invalid_index;
+            }
+            break;
 
-    rf_error_type error_type = rf_no_error;
+        case rf_allocator_mode_realloc:
+        {
+            void*  ptr      = args.pointer_to_free_or_realloc;
+            rf_int new_size = args.size_to_allocate_or_reallocate;
 
-    // If the log type is an error then the error type must be the first arg
-    if (log_type == rf_log_type_error)
-    {
-        error_type = va_arg(args, rf_error_type);
-    }
+            if (ptr == 0)
+            {
+                result = rf_arena_alloc(arena, new_size);
+            }
+            else if (top && ptr == top && arena->last_alloc_offset + new_size <= arena->size)
+            {
+                // Grow or shrink the top allocation in place
+                arena->used = arena->last_alloc_offset + new_size;
+                if (arena->used > arena->high_water_mark)
+                {
+                    arena->high_water_mark = arena->used;
+                }
+                result = ptr;
+            }
+            else
+            {
+                result = rf_arena_alloc(arena, new_size);
+                if (result)
+                {
+                    memcpy(result, ptr, rf_min_i(args.old_size, new_size));
+                }
+            }
+        }
+        break;
 
-    if (rf__logger.log_proc)
-    {
-        rf__logger.log_proc(&rf__logger, source_location, log_type, msg, error_type, args);
+        default: break;
     }
 
-    va_end(args);
+    return result;
 }
 
-rf_public const char* rf_log_type_string(rf_log_type log_type)
+#pragma endregion
+
+#pragma region pool allocator
+
+rf_public rf_pool rf_pool_make(void* memory, rf_int memory_size, rf_int block_size)
 {
-    switch (log_type)
+    rf_pool result = {0};
+
+    // Blocks must be able to hold the free list pointer
+    if (block_size < (rf_int) sizeof(void*))
     {
-        case rf_log_type_none:    return "NONE";
-        case rf_log_type_debug:   return "DEBUG";
-        case rf_log_type_info:    return "INFO";
-        case rf_log_type_warning: return "WARNING";
-        case rf_log_type_error:   return "ERROR";
-        default:                  return "RAYFORK_LOG_TYPE_UNKNOWN";
+        block_size = sizeof(void*);
     }
+
+    if (memory && memory_size >= block_size)
+    {
+        result.memory      = memory;
+        result.block_size  = block_size;
+        result.block_count = memory_size / block_size;
+    }
+
+    return result;
 }
 
-rf_public void rf_libc_printf_logger(struct rf_logger* logger, rf_source_location source_location, rf_log_type log_type, const char* msg, rf_error_type error_type, va_list args)
+rf_public void* rf_pool_alloc(rf_pool* pool)
 {
-    ((void)logger); // unused
-    printf("[RAYFORK %s]: ", rf_log_type_string(log_type));
+    void* result = 0;
+
+    if (pool->free_list)
+    {
+        result = pool->free_list;
+        pool->free_list = *(void**)result;
+        pool->used_blocks++;
+    }
+    else if (pool->untouched_index < pool->block_count)
+    {
+        result = pool->memory + pool->untouched_index * pool->block_size;
+        pool->untouched_index++;
+        pool->used_blocks++;
+    }
+
+    return result;
+}
+
+rf_public void rf_pool_free(rf_pool* pool, void* block)
+{
+    if (block && rf_pool_owns(pool, block))
+    {
+        *(void**)block = pool->free_list;
+        pool->free_list = block;
+        pool->used_blocks--;
+    }
+}
+
+rf_public rf_bool rf_pool_owns(const rf_pool* pool, const void* ptr)
+{
+    const char* p = ptr;
+    rf_bool result = pool->memory && p >= pool->memory && p < pool->memory + pool->block_count * pool->block_size;
+    return result;
+}
+
+rf_public rf_size_class_pools rf_size_class_pools_make(void* memory, rf_int memory_size, rf_allocator fallback)
+{
+    rf_size_class_pools result = {0};
+    result.fallback = fallback;
+
+    if (memory && memory_size > 0)
+    {
+        // Align every size class so that blocks keep the alignment of their size (up to 16 bytes)
+        rf_int class_memory_size = (memory_size / RF_POOL_SIZE_CLASS_COUNT) & ~(rf_int)15;
+        char*  class_memory      = memory;
+
+        for (rf_int i = 0; i < RF_POOL_SIZE_CLASS_COUNT; i++)
+        {
+            rf_int block_size = (rf_int)RF_POOL_MIN_BLOCK_SIZE << i;
+            result.size_classes[i] = rf_pool_make(class_memory, class_memory_size, block_size);
+            class_memory += class_memory_size;
+        }
+    }
+
+    return result;
+}
+
+rf_internal rf_pool* rf__pool_for_size(rf_size_class_pools* pools, rf_int size)
+{
+    for (rf_int i = 0; i < RF_POOL_SIZE_CLASS_COUNT; i++)
+    {
+        if (size <= pools->size_classes[i].block_size)
+        {
+            return &pools->size_classes[i];
+        }
+    }
+
+    return 0;
+}
+
+rf_internal rf_pool* rf__pool_for_pointer(rf_size_class_pools* pools, const void* ptr)
+{
+    for (rf_int i = 0; i < RF_POOL_SIZE_CLASS_COUNT; i++)
+    {
+        if (rf_pool_owns(&pools->size_classes[i], ptr))
+        {
+            return &pools->size_classes[i];
+        }
+    }
+
+    return 0;
+}
+
+rf_internal void* rf__size_class_pools_alloc(rf_size_class_pools* pools, rf_int size)
+{
+    void* result = 0;
+
+    // Try the smallest size class that fits and go up if it is exhausted
+    for (rf_pool* pool = rf__pool_for_size(pools, size); pool && pool < pools->size_classes + RF_POOL_SIZE_CLASS_COUNT && !result; pool++)
+    {
+        result = rf_pool_alloc(pool);
+    }
+
+    if (!result && pools->fallback.allocator_proc)
+    {
+        result = rf_alloc(pools->fallback, size);
+    }
+
+    return result;
+}
+
+rf_public void* rf_pool_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args)
+{
+    rf_assert(this_allocator);
+    (void)source_location;
+
+    rf_size_class_pools* pools = this_allocator->user_data;
+    void* result = 0;
+
+    switch (mode)
+    {
+        case rf_allocator_mode_alloc:
+            result = rf__size_class_pools_alloc(pools, args.size_to_allocate_or_reallocate);
+            break;
+
+        case rf_allocator_mode_free:
+        {
+            void*    ptr  = args.pointer_to_free_or_realloc;
+            rf_pool* pool = rf__pool_for_pointer(pools, ptr);
+
+            if (pool) rf_pool_free(pool, ptr);
+            else if (ptr && pools->fallback.allocator_proc) rf_free(pools->fallback, ptr);
+        }
+        break;
+
+        case rf_allocator_mode_realloc:
+        {
+            void*    ptr      = args.pointer_to_free_or_realloc;
+            rf_int   new_size = args.size_to_allocate_or_reallocate;
+            rf_pool* pool     = rf__pool_for_pointer(pools, ptr);
+
+            if (!ptr)
+            {
+                result = rf__size_class_pools_alloc(pools, new_size);
+            }
+            else if (pool && new_size <= pool->block_size)
+            {
+                result = ptr;
+            }
+            else if (pool)
+            {
+                result = rf__size_class_pools_alloc(pools, new_size);
+                if (result)
+                {
+                    memcpy(result, ptr, pool->block_size);
+                    rf_pool_free(pool, ptr);
+                }
+            }
+            else if (pools->fallback.allocator_proc)
+            {
+                result = rf_realloc(pools->fallback, ptr, new_size, args.old_size);
+            }
+        }
+        break;
+
+        default: break;
+    }
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region tracking allocator
+
+// Keeps the allocation after the header aligned for any type
+#define rf__tracking_header_size (16)
+
+typedef struct rf__tracking_header
+{
+    rf_int size;
+    rf_int site_index;
+} rf__tracking_header;
+
+rf_internal rf_source_location rf__tracking_overflow_site = { "<overflow>", "<overflow>", 0 };
+
+rf_internal rf_bool rf__source_location_match(rf_source_location a, rf_source_location b)
+{
+    if (a.line_in_file != b.line_in_file) return 0;
+    if (a.file_name == b.file_name && a.proc_name == b.proc_name) return 1;
+    return a.file_name && b.file_name && a.proc_name && b.proc_name && strcmp(a.file_name, b.file_name) == 0 && strcmp(a.proc_name, b.proc_name) == 0;
+}
+
+// Returns the slot of the site, or the empty slot where it would go, or rf_invalid_index if it isn't there and the table is full
+rf_internal rf_int rf__tracking_probe_site(const rf_allocation_tracker* tracker, rf_source_location source_location)
+{
+    // Hash the file name contents rather than the pointer since the same file can end up with different string literals
+    uint64_t hash = (uint64_t) source_location.line_in_file * 0x9e3779b97f4a7c15ull;
+    for (const char* c = source_location.file_name; c && *c; c++)
+    {
+        hash = (hash ^ (unsigned char) *c) * 0x100000001b3ull;
+    }
+
+    rf_int index = (rf_int)(hash & (RF_TRACKING_ALLOCATOR_MAX_SITES - 1));
+
+    for (rf_int probes = 0; probes < RF_TRACKING_ALLOCATOR_MAX_SITES; probes++)
+    {
+        const rf_allocation_site_stats* site = &tracker->sites[index];
+
+        if (site->source_location.file_name == 0 || rf__source_location_match(site->source_location, source_location))
+        {
+            return index;
+        }
+
+        index = (index + 1) & (RF_TRACKING_ALLOCATOR_MAX_SITES - 1);
+    }
+
+    return rf_invalid_index;
+}
+
+rf_internal rf_int rf__tracking_find_site(rf_allocation_tracker* tracker, rf_source_location source_location)
+{
+    rf_int index = rf__tracking_probe_site(tracker, source_location);
+
+    // New call sites past the limit are merged into one site, we always keep one slot free for it
+    if (index == rf_invalid_index || (tracker->sites[index].source_location.file_name == 0 && tracker->sites_count >= RF_TRACKING_ALLOCATOR_MAX_SITES - 1))
+    {
+        source_location = rf__tracking_overflow_site;
+        index = rf__tracking_probe_site(tracker, source_location);
+    }
+
+    rf_allocation_site_stats* site = &tracker->sites[index];
+
+    if (site->source_location.file_name == 0)
+    {
+        site->source_location = source_location;
+        tracker->sites_count++;
+    }
+
+    return index;
+}
+
+rf_internal rf_int rf__tracking_histogram_bucket(rf_int size)
+{
+    rf_int bucket = 0;
+    while (size > 1 && bucket < RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS - 1)
+    {
+        size >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+rf_internal void rf__tracking_record_alloc(rf_allocation_tracker* tracker, rf_int site_index, rf_int size)
+{
+    rf_allocation_site_stats* site = &tracker->sites[site_index];
+
+    site->live_bytes  += size;
+    site->total_bytes += size;
+    site->size_histogram[rf__tracking_histogram_bucket(size)]++;
+    if (site->live_bytes > site->peak_live_bytes) site->peak_live_bytes = site->live_bytes;
+
+    tracker->live_bytes += size;
+    if (tracker->live_bytes > tracker->peak_live_bytes) tracker->peak_live_bytes = tracker->live_bytes;
+}
+
+rf_internal void rf__tracking_record_free(rf_allocation_tracker* tracker, rf_int site_index, rf_int size)
+{
+    tracker->sites[site_index].live_bytes -= size;
+    tracker->live_bytes -= size;
+}
+
+rf_public void rf_allocation_tracker_init(rf_allocation_tracker* tracker, rf_allocator wrapped)
+{
+    memset(tracker, 0, sizeof(rf_allocation_tracker));
+    tracker->wrapped = wrapped;
+}
+
+rf_public void* rf_tracking_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args)
+{
+    rf_assert(this_allocator);
+
+    rf_allocation_tracker* tracker = this_allocator->user_data;
+    void* result = 0;
+
+    switch (mode)
+    {
+        case rf_allocator_mode_alloc:
+        {
+            rf_int size = args.size_to_allocate_or_reallocate;
+            char*  raw  = tracker->wrapped.allocator_proc(&tracker->wrapped, source_location, rf_allocator_mode_alloc, (rf_allocator_args) { 0, size + rf__tracking_header_size, 0 });
+
+            if (raw)
+            {
+                rf_int site_index = rf__tracking_find_site(tracker, source_location);
+
+                *(rf__tracking_header*) raw = (rf__tracking_header) { size, site_index };
+                rf__tracking_record_alloc(tracker, site_index, size);
+                tracker->sites[site_index].alloc_count++;
+                tracker->alloc_count++;
+
+                result = raw + rf__tracking_header_size;
+            }
+        }
+        break;
+
+        case rf_allocator_mode_free:
+        {
+            char* ptr = args.pointer_to_free_or_realloc;
+
+            if (ptr)
+            {
+                char* raw = ptr - rf__tracking_header_size;
+                rf__tracking_header header = *(rf__tracking_header*) raw;
+
+                rf__tracking_record_free(tracker, header.site_index, header.size);
+                tracker->sites[header.site_index].free_count++;
+                tracker->free_count++;
+
+                tracker->wrapped.allocator_proc(&tracker->wrapped, source_location, rf_allocator_mode_free, (rf_allocator_args) { raw, 0, 0 });
+            }
+        }
+        break;
+
+        case rf_allocator_mode_realloc:
+        {
+            char*  ptr      = args.pointer_to_free_or_realloc;
+            rf_int new_size = args.size_to_allocate_or_reallocate;
+
+            if (!ptr)
+            {
+                args.pointer_to_free_or_realloc = 0;
+                result = rf_tracking_allocator_proc(this_allocator, source_location, rf_allocator_mode_alloc, args);
+                break;
+            }
+
+            char* raw = ptr - rf__tracking_header_size;
+            rf__tracking_header header = *(rf__tracking_header*) raw;
+
+            char* new_raw = tracker->wrapped.allocator_proc(&tracker->wrapped, source_location, rf_allocator_mode_realloc, (rf_allocator_args) { raw, new_size + rf__tracking_header_size, header.size + rf__tracking_header_size });
+
+            if (new_raw)
+            {
+                // The memory is now attributed to the call site that reallocated it
+                rf_int site_index = rf__tracking_find_site(tracker, source_location);
+
+                rf__tracking_record_free(tracker, header.site_index, header.size);
+                rf__tracking_record_alloc(tracker, site_index, new_size);
+                tracker->sites[site_index].realloc_count++;
+
+                *(rf__tracking_header*) new_raw = (rf__tracking_header) { new_size, site_index };
+                result = new_raw + rf__tracking_header_size;
+            }
+        }
+        break;
+
+        default: break;
+    }
+
+    return result;
+}
+
+#define rf__define_site_comparator(field) \
+    rf_internal int rf__compare_sites_by_##field(const void* a, const void* b) \
+    { \
+        rf_int lhs = (*(const rf_allocation_site_stats**) a)->field; \
+        rf_int rhs = (*(const rf_allocation_site_stats**) b)->field; \
+        return (lhs < rhs) - (lhs > rhs); \
+    }
+
+rf__define_site_comparator(live_bytes)
+rf__define_site_comparator(peak_live_bytes)
+rf__define_site_comparator(total_bytes)
+rf__define_site_comparator(alloc_count)
+
+rf_public rf_int rf_allocation_tracker_get_sorted_sites(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, const rf_allocation_site_stats** dst, rf_int dst_size)
+{
+    const rf_allocation_site_stats* sites[RF_TRACKING_ALLOCATOR_MAX_SITES];
+    rf_int sites_count = 0;
+
+    for (rf_int i = 0; i < RF_TRACKING_ALLOCATOR_MAX_SITES; i++)
+    {
+        if (tracker->sites[i].source_location.file_name)
+        {
+            sites[sites_count++] = &tracker->sites[i];
+        }
+    }
+
+    int (*comparator)(const void*, const void*) = rf__compare_sites_by_live_bytes;
+    switch (sort_by)
+    {
+        case rf_allocation_sort_by_peak_live_bytes: comparator = rf__compare_sites_by_peak_live_bytes; break;
+        case rf_allocation_sort_by_total_bytes:     comparator = rf__compare_sites_by_total_bytes;     break;
+        case rf_allocation_sort_by_alloc_count:     comparator = rf__compare_sites_by_alloc_count;     break;
+        default: break;
+    }
+
+    qsort(sites, sites_count, sizeof(sites[0]), comparator);
+
+    rf_int result = rf_min_i(sites_count, dst_size);
+    memcpy(dst, sites, result * sizeof(sites[0]));
+
+    return result;
+}
+
+// Appends to dst like snprintf but keeps track of the written size and never goes past the end of the buffer
+rf_internal void rf__append_format(char* dst, rf_int dst_size, rf_int* written, const char* fmt, ...)
+{
+    if (*written >= dst_size - 1) return;
+
+    va_list args;
+    va_start(args, fmt);
+    int amount = vsnprintf(dst + *written, dst_size - *written, fmt, args);
+    va_end(args);
+
+    if (amount > 0)
+    {
+        *written = rf_min_i(*written + amount, dst_size - 1);
+    }
+}
+
+rf_public rf_int rf_allocation_tracker_report_to_buffer(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, char* dst, rf_int dst_size)
+{
+    if (!dst || dst_size <= 0) return 0;
+
+    const rf_allocation_site_stats* sites[RF_TRACKING_ALLOCATOR_MAX_SITES];
+    rf_int sites_count = rf_allocation_tracker_get_sorted_sites(tracker, sort_by, sites, RF_TRACKING_ALLOCATOR_MAX_SITES);
+    rf_int written = 0;
+
+    dst[0] = 0;
+    rf__append_format(dst, dst_size, &written, "live: %td bytes, peak: %td bytes, allocs: %td, frees: %td\n", tracker->live_bytes, tracker->peak_live_bytes, tracker->alloc_count, tracker->free_count);
+    rf__append_format(dst, dst_size, &written, "%12s %12s %12s %8s %8s %8s  %s\n", "live", "peak", "total", "allocs", "reallocs", "frees", "call site");
+
+    for (rf_int i = 0; i < sites_count; i++)
+    {
+        const rf_allocation_site_stats* it = sites[i];
+        rf__append_format(dst, dst_size, &written, "%12td %12td %12td %8td %8td %8td  %s:%td (%s)\n",
+                          it->live_bytes, it->peak_live_bytes, it->total_bytes, it->alloc_count, it->realloc_count, it->free_count,
+                          it->source_location.file_name, it->source_location.line_in_file, it->source_location.proc_name);
+    }
+
+    return written;
+}
+
+rf_public rf_int rf_allocation_tracker_csv_to_buffer(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, char* dst, rf_int dst_size)
+{
+    if (!dst || dst_size <= 0) return 0;
+
+    const rf_allocation_site_stats* sites[RF_TRACKING_ALLOCATOR_MAX_SITES];
+    rf_int sites_count = rf_allocation_tracker_get_sorted_sites(tracker, sort_by, sites, RF_TRACKING_ALLOCATOR_MAX_SITES);
+    rf_int written = 0;
+
+    dst[0] = 0;
+    rf__append_format(dst, dst_size, &written, "file,line,proc,live_bytes,peak_live_bytes,total_bytes,alloc_count,realloc_count,free_count");
+    for (rf_int i = 0; i < RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS; i++)
+    {
+        rf__append_format(dst, dst_size, &written, ",size_%td", (rf_int)1 << i);
+    }
+    rf__append_format(dst, dst_size, &written, "\n");
+
+    for (rf_int i = 0; i < sites_count; i++)
+    {
+        const rf_allocation_site_stats* it = sites[i];
+        rf__append_format(dst, dst_size, &written, "\"%s\",%td,\"%s\",%td,%td,%td,%td,%td,%td",
+                          it->source_location.file_name, it->source_location.line_in_file, it->source_location.proc_name,
+                          it->live_bytes, it->peak_live_bytes, it->total_bytes, it->alloc_count, it->realloc_count, it->free_count);
+
+        for (rf_int bucket = 0; bucket < RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS; bucket++)
+        {
+            rf__append_format(dst, dst_size, &written, ",%td", it->size_histogram[bucket]);
+        }
+
+        rf__append_format(dst, dst_size, &written, "\n");
+    }
+
+    return written;
+}
+
+#pragma endregion
+
+#pragma region io
+
+rf_public rf_int rf_libc_get_file_size(void* user_data, const char* filename)
+{
+    ((void)user_data);
+
+    FILE* file = fopen(filename, "rb");
+
+    fseek(file, 0L, SEEK_END);
+    int size = ftell(file);
+    fseek(file, 0L, SEEK_SET);
+
+    fclose(file);
+
+    return size;
+}
+
+rf_public rf_bool rf_libc_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size)
+{
+    ((void)user_data);
+    rf_bool result = 0;
+
+    FILE* file = fopen(filename, "rb");
+    if (file != NULL)
+    {
+        fseek(file, 0L, SEEK_END);
+        int file_size = ftell(file);
+        fseek(file, 0L, SEEK_SET);
+
+        if (dst_size >= file_size)
+        {
+            int read_size = fread(dst, 1, file_size, file);
+            int no_error = ferror(file) == 0;
+            if (no_error && read_size == file_size)
+            {
+                result = 1;
+            }
+        }
+        // else log_error buffer is not big enough
+    }
+    // else log error could not open file
+
+    fclose(file);
+
+    return result;
+}
+
+rf_public void* rf_libc_open_stream(void* user_data, const char* filename)
+{
+    ((void)user_data);
+    void* result = fopen(filename, "rb");
+    return result;
+}
+
+rf_public rf_int rf_libc_read_stream(void* user_data, void* stream, void* dst, rf_int dst_size)
+{
+    ((void)user_data);
+    rf_int result = fread(dst, 1, dst_size, stream);
+    return result;
+}
+
+rf_public rf_bool rf_libc_seek_stream(void* user_data, void* stream, rf_int offset, rf_io_seek_origin origin)
+{
+    ((void)user_data);
+
+    int whence = SEEK_SET;
+    switch (origin)
+    {
+        case rf_io_seek_current: whence = SEEK_CUR; break;
+        case rf_io_seek_end:     whence = SEEK_END; break;
+        default: break;
+    }
+
+    rf_bool result = fseek(stream, offset, whence) == 0;
+    return result;
+}
+
+rf_public void rf_libc_close_stream(void* user_data, void* stream)
+{
+    ((void)user_data);
+    if (stream) fclose(stream);
+}
+
+rf_public rf_bool rf_libc_write_file(void* user_data, const char* filename, const void* src, rf_int src_size)
+{
+    ((void)user_data);
+    rf_bool result = 0;
+
+    FILE* file = fopen(filename, "wb");
+    if (file != NULL)
+    {
+        rf_int written = fwrite(src, 1, src_size, file);
+        result = fclose(file) == 0 && written == src_size;
+    }
+
+    return result;
+}
+
+rf_public rf_file_view rf_view_file(rf_io_callbacks io, const char* filename, rf_allocator temp_allocator)
+{
+    rf_file_view result = {0};
+
+    if (io.map_file_proc)
+    {
+        result = io.map_file_proc(io.user_data, filename);
+        if (result.valid) return result;
+    }
+
+    rf_int file_size = rf_file_size(io, filename);
+
+    if (file_size > 0)
+    {
+        void* buffer = rf_alloc(temp_allocator, file_size);
+
+        if (buffer)
+        {
+            if (rf_read_file(io, filename, buffer, file_size))
+            {
+                result.data  = buffer;
+                result.size  = file_size;
+                result.valid = 1;
+            }
+            else
+            {
+                rf_free(temp_allocator, buffer);
+                rf_log_error(rf_bad_io, "Failed to read file %s", filename);
+            }
+        }
+        else rf_log_error(rf_bad_alloc, "Temporary allocation of size %d failed", file_size);
+    }
+    else rf_log_error(rf_bad_io, "File size for %s is 0", filename);
+
+    return result;
+}
+
+rf_public void rf_release_file_view(rf_io_callbacks io, rf_file_view view, rf_allocator temp_allocator)
+{
+    if (!view.valid) return;
+
+    if (view.mapped)
+    {
+        if (io.unmap_file_proc) io.unmap_file_proc(io.user_data, view);
+    }
+    else
+    {
+        rf_free(temp_allocator, (void*) view.data);
+    }
+}
+
+rf_public rf_int rf_mmap_get_file_size(void* user_data, const char* filename)
+{
+    ((void)user_data);
+    rf_int result = 0;
+
+    #if defined(rayfork_platform_windows)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA attributes;
+        if (GetFileAttributesExA(filename, GetFileExInfoStandard, &attributes))
+        {
+            result = (rf_int)(((uint64_t) attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow);
+        }
+    }
+    #elif defined(rayfork__posix_io)
+    {
+        struct stat file_stat;
+        if (stat(filename, &file_stat) == 0)
+        {
+            result = (rf_int) file_stat.st_size;
+        }
+    }
+    #else
+    {
+        result = rf_libc_get_file_size(user_data, filename);
+    }
+    #endif
+
+    return result;
+}
+
+rf_public rf_file_view rf_mmap_map_file(void* user_data, const char* filename)
+{
+    ((void)user_data);
+    rf_file_view result = {0};
+
+    #if defined(rayfork_platform_windows)
+    {
+        HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER size;
+
+            if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+            {
+                HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+
+                if (mapping)
+                {
+                    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+                    if (data)
+                    {
+                        result = (rf_file_view) { data, (rf_int) size.QuadPart, mapping, 1, 1 };
+                    }
+                    else CloseHandle(mapping);
+                }
+            }
+
+            // The mapping keeps a reference to the file so the handle can be closed right away
+            CloseHandle(file);
+        }
+    }
+    #elif defined(rayfork__posix_io)
+    {
+        int file = open(filename, O_RDONLY);
+
+        if (file != -1)
+        {
+            struct stat file_stat;
+
+            if (fstat(file, &file_stat) == 0 && file_stat.st_size > 0)
+            {
+                void* data = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+                if (data != MAP_FAILED)
+                {
+                    result = (rf_file_view) { data, (rf_int) file_stat.st_size, NULL, 1, 1 };
+                }
+            }
+
+            // The mapping stays valid after the file descriptor is closed
+            close(file);
+        }
+    }
+    #else
+    {
+        ((void)filename);
+    }
+    #endif
+
+    return result;
+}
+
+rf_public void rf_mmap_unmap_file(void* user_data, rf_file_view view)
+{
+    ((void)user_data);
+
+    if (!view.valid || !view.mapped) return;
+
+    #if defined(rayfork_platform_windows)
+    {
+        UnmapViewOfFile(view.data);
+        CloseHandle((HANDLE) view.handle);
+    }
+    #elif defined(rayfork__posix_io)
+    {
+        munmap((void*) view.data, view.size);
+    }
+    #endif
+}
+
+#pragma endregion
+
+#pragma region logger
+
+rf_internal rf_log_type rf__log_filter;
+rf_internal rf_logger   rf__logger;
+
+rf_public void rf_set_logger(rf_logger logger) { rf__logger = logger; }
+rf_public void rf_set_logger_filter(rf_log_type filter) { rf__log_filter = filter; }
+
+rf_public rf_logger rf_get_logger() { return rf__logger; }
+rf_public rf_log_type rf_get_log_filter() { return rf__log_filter; }
+
+rf_public void rf__internal_log(rf_source_location source_location, rf_log_type log_type, const char* msg, ...)
+{
+    if (!(log_type & rf__log_filter)) return;
+
+    va_list args;
+
+    va_start(args, msg);
+
+    rf_error_type error_type = rf_no_error;
+
+    // If the log type is an error then the error type must be the first arg
+    if (log_type == rf_log_type_error)
+    {
+        error_type = va_arg(args, rf_error_type);
+    }
+
+    if (rf__logger.log_proc)
+    {
+        rf__logger.log_proc(&rf__logger, source_location, log_type, msg, error_type, args);
+    }
+
+    va_end(args);
+}
+
+rf_public const char* rf_log_type_string(rf_log_type log_type)
+{
+    switch (log_type)
+    {
+        case rf_log_type_none:    return "NONE";
+        case rf_log_type_debug:   return "DEBUG";
+        case rf_log_type_info:    return "INFO";
+        case rf_log_type_warning: return "WARNING";
+        case rf_log_type_error:   return "ERROR";
+        default:                  return "RAYFORK_LOG_TYPE_UNKNOWN";
+    }
+}
+
+rf_public void rf_libc_printf_logger(struct rf_logger* logger, rf_source_location source_location, rf_log_type log_type, const char* msg, rf_error_type error_type, va_list args)
+{
+    ((void)logger); // unused
+    printf("[RAYFORK %s]: ", rf_log_type_string(log_type));
     vprintf(msg, args);
     printf("\n");
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region async logger
+
+rf_internal rf_int rf__async_log_site_key(rf_source_location source_location)
+{
+    // The file name is a string literal so its address identifies the file
+    uint64_t hash = (uint64_t)(uintptr_t) source_location.file_name * 0x9E3779B97F4A7C15ull ^ (uint64_t) source_location.line_in_file * 0xC2B2AE3D27D4EB4Full;
+    rf_int result = (rf_int)(hash >> 1) | 1; // Never 0 since that marks unused sites
+    return result;
+}
+
+// Returns false if the message should be dropped, otherwise suppressed is the amount of messages from the site dropped before it
+rf_internal rf_bool rf__async_log_rate_limit(rf_async_logger* logger, rf_source_location source_location, rf_int* suppressed)
+{
+    *suppressed = 0;
+    if (logger->rate_limit <= 0) return 1;
+
+    rf_int key  = rf__async_log_site_key(source_location);
+    rf_int mask = RF_ASYNC_LOGGER_RATE_LIMIT_SITES - 1;
+    rf_async_log_site* site = 0;
+
+    for (rf_int i = 0; i < RF_ASYNC_LOGGER_RATE_LIMIT_SITES; i++)
+    {
+        rf_async_log_site* it = &logger->sites[(key + i) & mask];
+        rf_int it_key = rf__atomic_load(&it->key);
+
+        if (it_key == key || (it_key == 0 && (rf__atomic_compare_exchange(&it->key, 0, key) || rf__atomic_load(&it->key) == key)))
+        {
+            site = it;
+            break;
+        }
+    }
+
+    // Call sites past the table size are not rate limited
+    if (!site) return 1;
+
+    rf_int now          = (rf_int)(rf_get_timestamp_ns() / 1000000);
+    rf_int window_start = rf__atomic_load(&site->window_start_ms);
+
+    // Whoever moves the window forward resets the count, the counts are approximate when threads race here which is fine for a rate limiter
+    if (now - window_start >= 1000 && rf__atomic_compare_exchange(&site->window_start_ms, window_start, now))
+    {
+        rf__atomic_store(&site->count, 0);
+    }
+
+    rf_bool result = rf__atomic_add(&site->count, 1) <= logger->rate_limit;
+
+    if (result) *suppressed = rf__atomic_exchange(&site->suppressed, 0);
+    else rf__atomic_add(&site->suppressed, 1);
+
+    return result;
+}
+
+rf_internal rf_bool rf__async_logger_write_one(rf_async_logger* logger)
+{
+    rf_int index = logger->dequeue_index;
+    rf_async_log_cell* cell = &logger->cells[index & (logger->capacity - 1)];
+
+    if (rf__atomic_load(&cell->sequence) != index + 1) return 0;
+
+    logger->write_proc(logger->write_user_data, &cell->message);
+
+    rf__atomic_store(&cell->sequence, index + logger->capacity);
+    rf__atomic_store(&logger->dequeue_index, index + 1);
+
+    return 1;
+}
+
+rf_internal void rf__async_logger_loop(rf_async_logger* logger)
+{
+    while (!rf__atomic_load(&logger->quit))
+    {
+        rf_bool wrote_any = 0;
+        while (rf__async_logger_write_one(logger)) wrote_any = 1;
+
+        if (!wrote_any) rf__thread_sleep_ms(1);
+    }
+}
+
+#if defined(rayfork_platform_windows)
+rf_internal DWORD WINAPI rf__async_logger_thread(LPVOID param)
+{
+    rf__async_logger_loop(param);
+    return 0;
+}
+#else
+rf_internal void* rf__async_logger_thread(void* param)
+{
+    rf__async_logger_loop(param);
+    return 0;
+}
+#endif
+
+rf_public rf_bool rf_async_logger_init(rf_async_logger* logger, rf_int capacity, rf_log_message_proc write_proc, void* write_user_data, rf_allocator allocator)
+{
+    if (!logger || capacity <= 0) return 0;
+
+    memset(logger, 0, sizeof(rf_async_logger));
+
+    rf_int rounded_capacity = 1;
+    while (rounded_capacity < capacity) rounded_capacity *= 2;
+
+    logger->cells = rf_alloc(allocator, rounded_capacity * sizeof(rf_async_log_cell));
+
+    if (!logger->cells)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate the async logger ring buffer of %d messages", rounded_capacity);
+        return 0;
+    }
+
+    for (rf_int i = 0; i < rounded_capacity; i++)
+    {
+        logger->cells[i].sequence = i;
+    }
+
+    logger->capacity        = rounded_capacity;
+    logger->rate_limit      = RF_ASYNC_LOGGER_DEFAULT_RATE_LIMIT;
+    logger->write_proc      = write_proc ? write_proc : rf_libc_printf_log_message;
+    logger->write_user_data = write_user_data;
+    logger->allocator       = allocator;
+
+    #if defined(rayfork_platform_windows)
+        logger->thread = CreateThread(0, 0, rf__async_logger_thread, logger, 0, 0);
+        rf_bool started = logger->thread != 0;
+    #else
+        pthread_t thread;
+        rf_bool started = pthread_create(&thread, 0, rf__async_logger_thread, logger) == 0;
+        logger->thread = (void*) thread;
+    #endif
+
+    if (!started)
+    {
+        rf_free(allocator, logger->cells);
+        memset(logger, 0, sizeof(rf_async_logger));
+        rf_log_error(rf_bad_io, "Failed to start the async logger thread");
+        return 0;
+    }
+
+    logger->valid = 1;
+    return 1;
+}
+
+rf_public void rf_async_logger_flush(rf_async_logger* logger)
+{
+    if (!logger || !logger->valid) return;
+
+    rf_int target = rf__atomic_load(&logger->enqueue_index);
+
+    while (rf__atomic_load(&logger->dequeue_index) < target)
+    {
+        rf__thread_yield();
+    }
+}
+
+rf_public void rf_async_logger_shutdown(rf_async_logger* logger)
+{
+    if (!logger || !logger->valid) return;
+
+    rf__atomic_store(&logger->quit, 1);
+
+    #if defined(rayfork_platform_windows)
+        WaitForSingleObject(logger->thread, INFINITE);
+        CloseHandle(logger->thread);
+    #else
+        pthread_join((pthread_t) logger->thread, 0);
+    #endif
+
+    // Messages that were fully written before the thread stopped are still delivered
+    while (rf__async_logger_write_one(logger));
+
+    rf_free(logger->allocator, logger->cells);
+    memset(logger, 0, sizeof(rf_async_logger));
+}
+
+rf_public void rf_async_logger_proc(struct rf_logger* logger, rf_source_location source_location, rf_log_type log_type, const char* msg, rf_error_type error_type, va_list args)
+{
+    rf_async_logger* async_logger = logger->user_data;
+    if (!async_logger || !async_logger->valid) return;
+
+    rf_int suppressed = 0;
+    if (!rf__async_log_rate_limit(async_logger, source_location, &suppressed)) return;
+
+    // Bounded multi producer queue (Dmitry Vyukov's design): each cell's sequence tells producers whether it is free for the current lap
+    rf_int mask  = async_logger->capacity - 1;
+    rf_int index = rf__atomic_load(&async_logger->enqueue_index);
+    rf_async_log_cell* cell = 0;
+
+    while (1)
+    {
+        cell = &async_logger->cells[index & mask];
+        rf_int diff = rf__atomic_load(&cell->sequence) - index;
+
+        if (diff == 0)
+        {
+            if (rf__atomic_compare_exchange(&async_logger->enqueue_index, index, index + 1)) break;
+            index = rf__atomic_load(&async_logger->enqueue_index);
+        }
+        else if (diff < 0)
+        {
+            // The ring is full, drop the message instead of stalling the caller
+            rf__atomic_add(&async_logger->dropped, 1);
+            return;
+        }
+        else
+        {
+            index = rf__atomic_load(&async_logger->enqueue_index);
+        }
+    }
+
+    rf_log_message* message   = &cell->message;
+    message->source_location  = source_location;
+    message->log_type         = log_type;
+    message->error_type       = error_type;
+    message->suppressed_count = suppressed;
+    message->dropped_count    = rf__atomic_exchange(&async_logger->dropped, 0);
+    vsnprintf(message->text, RF_ASYNC_LOGGER_MESSAGE_SIZE, msg, args);
+
+    rf__atomic_store(&cell->sequence, index + 1);
+}
+
+rf_public void rf_libc_printf_log_message(void* user_data, const rf_log_message* message)
+{
+    ((void)user_data); // unused
+
+    if (message->dropped_count)
+    {
+        printf("[RAYFORK WARNING]: %d log messages were dropped because the async logger was full\n", (int) message->dropped_count);
+    }
+
+    printf("[RAYFORK %s]: %s", rf_log_type_string(message->log_type), message->text);
+
+    if (message->suppressed_count)
+    {
+        printf(" (%d more messages from this call site were suppressed)", (int) message->suppressed_count);
+    }
+
+    printf("\n");
+}
+
+#pragma endregion
+
+#pragma region rng
+
+rf_internal uint64_t rf__splitmix64(uint64_t* x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+rf_internal uint64_t rf__rotl64(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+rf_public rf_rand rf_rand_make(uint64_t seed)
+{
+    rf_rand result;
+
+    // splitmix64 never gives 4 zeros in a row, which is the only invalid xoshiro state
+    for (rf_int i = 0; i < 4; i++)
+    {
+        result.state[i] = rf__splitmix64(&seed);
+    }
+
+    return result;
+}
+
+rf_public uint64_t rf_rand_next(rf_rand* rng)
+{
+    uint64_t* s = rng->state;
+    uint64_t result = rf__rotl64(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rf__rotl64(s[3], 45);
+
+    return result;
+}
+
+rf_public uint32_t rf_rand_u32(rf_rand* rng)
+{
+    uint32_t result = (uint32_t)(rf_rand_next(rng) >> 32);
+    return result;
+}
+
+rf_public float rf_rand_float(rf_rand* rng)
+{
+    float result = (float)(rf_rand_next(rng) >> 40) * (1.0f / 16777216.0f);
+    return result;
+}
+
+rf_public rf_int rf_rand_range(rf_rand* rng, rf_int min, rf_int max)
+{
+    if (max <= min) return min;
+
+    uint64_t range = (uint64_t) max - (uint64_t) min + 1;
+    uint64_t value = 0;
+
+    if (range == 0)
+    {
+        // The range covers every 64 bit value
+        value = rf_rand_next(rng);
+    }
+    else if (range <= 0xFFFFFFFFull)
+    {
+        // Lemire's multiply and reject, the rejection only triggers for values in the small biased zone
+        uint64_t m = (uint64_t) rf_rand_u32(rng) * range;
+        uint32_t low = (uint32_t) m;
+
+        if (low < range)
+        {
+            uint32_t threshold = (uint32_t)((0x100000000ull - range) % range);
+            while (low < threshold)
+            {
+                m = (uint64_t) rf_rand_u32(rng) * range;
+                low = (uint32_t) m;
+            }
+        }
+
+        value = m >> 32;
+    }
+    else
+    {
+        uint64_t threshold = (0 - range) % range;
+        uint64_t r = rf_rand_next(rng);
+        while (r < threshold) r = rf_rand_next(rng);
+        value = r % range;
+    }
+
+    rf_int result = (rf_int)((uint64_t) min + value);
+    return result;
+}
+
+// 4 xoshiro128++ streams stored lane by lane so the SIMD and scalar code produce the same numbers
+typedef struct rf__rand_lanes
+{
+    uint32_t s[4][4];
+} rf__rand_lanes;
+
+rf_internal rf__rand_lanes rf__rand_lanes_make(rf_rand* rng)
+{
+    rf__rand_lanes result;
+
+    for (rf_int i = 0; i < 4; i++)
+    {
+        for (rf_int lane = 0; lane < 4; lane += 2)
+        {
+            uint64_t value = rf_rand_next(rng);
+            result.s[i][lane]     = (uint32_t) value;
+            result.s[i][lane + 1] = (uint32_t)(value >> 32);
+        }
+    }
+
+    for (rf_int lane = 0; lane < 4; lane++)
+    {
+        if (!(result.s[0][lane] | result.s[1][lane] | result.s[2][lane] | result.s[3][lane])) result.s[0][lane] = 1;
+    }
+
+    return result;
+}
+
+#if !defined(rayfork_sse2) && !defined(rayfork_neon)
+    // Only the scalar fill below rotates 32 bit values
+    rf_internal uint32_t rf__rotl32(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+#endif
+
+// Writes count values, count must be a multiple of 4
+rf_internal void rf__rand_lanes_fill(rf__rand_lanes* lanes, uint32_t* dst, rf_int count)
+{
+    #if defined(rayfork_sse2)
+    {
+        __m128i s0 = _mm_loadu_si128((const __m128i*) lanes->s[0]);
+        __m128i s1 = _mm_loadu_si128((const __m128i*) lanes->s[1]);
+        __m128i s2 = _mm_loadu_si128((const __m128i*) lanes->s[2]);
+        __m128i s3 = _mm_loadu_si128((const __m128i*) lanes->s[3]);
+
+        for (rf_int i = 0; i < count; i += 4)
+        {
+            __m128i sum    = _mm_add_epi32(s0, s3);
+            __m128i result = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(sum, 7), _mm_srli_epi32(sum, 25)), s0);
+            __m128i t      = _mm_slli_epi32(s1, 9);
+
+            s2 = _mm_xor_si128(s2, s0);
+            s3 = _mm_xor_si128(s3, s1);
+            s1 = _mm_xor_si128(s1, s2);
+            s0 = _mm_xor_si128(s0, s3);
+            s2 = _mm_xor_si128(s2, t);
+            s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+
+            _mm_storeu_si128((__m128i*)(dst + i), result);
+        }
+
+        _mm_storeu_si128((__m128i*) lanes->s[0], s0);
+        _mm_storeu_si128((__m128i*) lanes->s[1], s1);
+        _mm_storeu_si128((__m128i*) lanes->s[2], s2);
+        _mm_storeu_si128((__m128i*) lanes->s[3], s3);
+    }
+    #elif defined(rayfork_neon)
+    {
+        uint32x4_t s0 = vld1q_u32(lanes->s[0]);
+        uint32x4_t s1 = vld1q_u32(lanes->s[1]);
+        uint32x4_t s2 = vld1q_u32(lanes->s[2]);
+        uint32x4_t s3 = vld1q_u32(lanes->s[3]);
+
+        for (rf_int i = 0; i < count; i += 4)
+        {
+            uint32x4_t sum    = vaddq_u32(s0, s3);
+            uint32x4_t result = vaddq_u32(vorrq_u32(vshlq_n_u32(sum, 7), vshrq_n_u32(sum, 25)), s0);
+            uint32x4_t t      = vshlq_n_u32(s1, 9);
+
+            s2 = veorq_u32(s2, s0);
+            s3 = veorq_u32(s3, s1);
+            s1 = veorq_u32(s1, s2);
+            s0 = veorq_u32(s0, s3);
+            s2 = veorq_u32(s2, t);
+            s3 = vorrq_u32(vshlq_n_u32(s3, 11), vshrq_n_u32(s3, 21));
+
+            vst1q_u32(dst + i, result);
+        }
+
+        vst1q_u32(lanes->s[0], s0);
+        vst1q_u32(lanes->s[1], s1);
+        vst1q_u32(lanes->s[2], s2);
+        vst1q_u32(lanes->s[3], s3);
+    }
+    #else
+    {
+        uint32_t (*s)[4] = lanes->s;
+
+        for (rf_int i = 0; i < count; i += 4)
+        {
+            for (rf_int lane = 0; lane < 4; lane++)
+            {
+                uint32_t t = s[1][lane] << 9;
+                dst[i + lane] = rf__rotl32(s[0][lane] + s[3][lane], 7) + s[0][lane];
+
+                s[2][lane] ^= s[0][lane];
+                s[3][lane] ^= s[1][lane];
+                s[1][lane] ^= s[2][lane];
+                s[0][lane] ^= s[3][lane];
+                s[2][lane] ^= t;
+                s[3][lane] = rf__rotl32(s[3][lane], 11);
+            }
+        }
+    }
+    #endif
+}
+
+rf_public void rf_rand_fill_u32(rf_rand* rng, uint32_t* dst, rf_int count)
+{
+    if (!rng || !dst || count <= 0) return;
+
+    rf__rand_lanes lanes = rf__rand_lanes_make(rng);
+    rf_int body = count & ~(rf_int)3;
+
+    rf__rand_lanes_fill(&lanes, dst, body);
+
+    if (body < count)
+    {
+        uint32_t tail[4];
+        rf__rand_lanes_fill(&lanes, tail, 4);
+        memcpy(dst + body, tail, (count - body) * sizeof(uint32_t));
+    }
+}
+
+rf_public void rf_rand_fill_float(rf_rand* rng, float* dst, rf_int count)
+{
+    if (!rng || !dst || count <= 0) return;
+
+    // The bits go through a local block instead of dst so floats are never accessed as uint32_t. Blocks are a multiple of
+    // 4 so the values are the same as rf_rand_fill_u32 with the same seed, of which we keep the top 24 bits which a float
+    // represents exactly.
+    rf__rand_lanes lanes = rf__rand_lanes_make(rng);
+    uint32_t block[256];
+
+    for (rf_int begin = 0; begin < count; begin += 256)
+    {
+        rf_int size = count - begin < 256 ? count - begin : 256;
+        float* out = dst + begin;
+        rf_int i = 0;
+
+        rf__rand_lanes_fill(&lanes, block, (size + 3) & ~(rf_int)3);
+
+        #if defined(rayfork_sse2)
+        {
+            __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+            for (; i + 4 <= size; i += 4)
+            {
+                __m128i bits = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(block + i)), 8);
+                _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(bits), scale));
+            }
+        }
+        #elif defined(rayfork_neon)
+        {
+            float32x4_t scale = vdupq_n_f32(1.0f / 16777216.0f);
+            for (; i + 4 <= size; i += 4)
+            {
+                uint32x4_t bits = vshrq_n_u32(vld1q_u32(block + i), 8);
+                vst1q_f32(out + i, vmulq_f32(vcvtq_f32_u32(bits), scale));
+            }
+        }
+        #endif
+
+        for (; i < size; i++)
+        {
+            out[i] = (float)(block[i] >> 8) * (1.0f / 16777216.0f);
+        }
+    }
+}
+
+rf_public void rf_rand_fill_range(rf_rand* rng, int* dst, rf_int count, int min, int max)
+{
+    if (!rng || !dst || count <= 0) return;
+
+    if (max <= min)
+    {
+        for (rf_int i = 0; i < count; i++) dst[i] = min;
+        return;
+    }
+
+    rf_rand_fill_u32(rng, (uint32_t*) dst, count);
+
+    // Multiply-shift without rejection, simple enough for compilers to vectorize
+    uint64_t range = (uint64_t)((int64_t) max - (int64_t) min + 1);
+    for (rf_int i = 0; i < count; i++)
+    {
+        dst[i] = (int)((int64_t) min + (int64_t)(((uint64_t)(uint32_t) dst[i] * range) >> 32));
+    }
+}
+
+rf_internal rf_thread_local rf_rand rf__default_rand;
+rf_internal rf_thread_local rf_bool rf__default_rand_initialized;
+
+rf_public rf_rand* rf_get_default_rand(void)
+{
+    if (!rf__default_rand_initialized)
+    {
+        rf__default_rand = rf_rand_make(RF_DEFAULT_RAND_SEED);
+        rf__default_rand_initialized = 1;
+    }
+
+    return &rf__default_rand;
+}
+
+rf_public rf_int rf_default_rand_wrapper(rf_int min, rf_int max)
+{
+    rf_int result = rf_rand_range(rf_get_default_rand(), min, max);
+    return result;
+}
+
+#pragma endregion
+
+#pragma region hash map
+
+rf_public uint64_t rf_hash_u64(uint64_t x)
+{
+    // splitmix64 finalizer, every input bit affects every output bit
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    x =  x ^ (x >> 31);
+    return x;
+}
+
+rf_internal uint64_t rf__hash_mix_block(uint64_t h, uint64_t k)
+{
+    k *= 0x87C37B91114253D5ull;
+    k  = rf__rotl64(k, 31);
+    k *= 0x4CF5AD432745937Full;
+    h ^= k;
+    h  = rf__rotl64(h, 27) * 5 + 0x52DCE729;
+    return h;
+}
+
+rf_public uint64_t rf_hash_bytes(const void* data, rf_int size)
+{
+    const unsigned char* p = data;
+    uint64_t h = 0x9E3779B97F4A7C15ull ^ ((uint64_t) size * 0xC2B2AE3D27D4EB4Full);
+
+    // Murmur3 style mixing 8 bytes at a time, the tail is zero padded and the size is part of the seed so it can't collide with longer keys
+    while (size >= 8)
+    {
+        uint64_t k;
+        memcpy(&k, p, 8);
+        h = rf__hash_mix_block(h, k);
+        p += 8;
+        size -= 8;
+    }
+
+    if (size > 0)
+    {
+        uint64_t k = 0;
+        memcpy(&k, p, size);
+        h = rf__hash_mix_block(h, k);
+    }
+
+    uint64_t result = rf_hash_u64(h);
+    return result;
+}
+
+rf_internal uint64_t rf__hashmap_fix_hash(uint64_t hash)
+{
+    // 0 marks empty slots so it can't be used as a hash
+    uint64_t result = hash ? hash : 1;
+    return result;
+}
+
+rf_internal rf_bool rf__hashmap_keys_match(const rf_hashmap* map, rf_hashmap_key a, rf_hashmap_key b)
+{
+    if (map->key_type == rf_hashmap_key_u64) return a.u64 == b.u64;
+
+    rf_bool result = a.bytes.size == b.bytes.size && (a.bytes.data == b.bytes.data || memcmp(a.bytes.data, b.bytes.data, a.bytes.size) == 0);
+    return result;
+}
+
+rf_internal rf_int rf__hashmap_probe_distance(const rf_hashmap* map, rf_int slot)
+{
+    rf_int mask = map->capacity - 1;
+    rf_int result = (slot - (rf_int)(map->hashes[slot] & mask)) & mask;
+    return result;
+}
+
+rf_internal rf_int rf__hashmap_find_slot(const rf_hashmap* map, uint64_t hash, rf_hashmap_key key)
+{
+    if (!map->size) return rf_invalid_index;
+
+    rf_int mask = map->capacity - 1;
+    rf_int slot = (rf_int)(hash & mask);
+
+    for (rf_int dist = 0;; dist++)
+    {
+        uint64_t slot_hash = map->hashes[slot];
+
+        // With Robin Hood ordering the key would have displaced any entry closer to its home slot than we are to ours
+        if (slot_hash == 0 || rf__hashmap_probe_distance(map, slot) < dist) return rf_invalid_index;
+        if (slot_hash == hash && rf__hashmap_keys_match(map, map->keys[slot], key)) return slot;
+
+        slot = (slot + 1) & mask;
+    }
+}
+
+rf_internal void rf__hashmap_swap_bytes(char* a, char* b, rf_int size)
+{
+    for (rf_int i = 0; i < size; i++)
+    {
+        char t = a[i];
+        a[i] = b[i];
+        b[i] = t;
+    }
+}
+
+// Inserts a key that is known not to be in the map into a map with a free slot, returns the value of the new entry
+rf_internal void* rf__hashmap_insert_new(rf_hashmap* map, uint64_t hash, rf_hashmap_key key, const void* value)
+{
+    rf_int mask = map->capacity - 1;
+    rf_int slot = (rf_int)(hash & mask);
+    char*  carried_value = rf_hashmap_slot_value(map, map->capacity); // Scratch slot past the end
+
+    if (value) memcpy(carried_value, value, map->value_size);
+    else memset(carried_value, 0, map->value_size);
+
+    void* result = 0;
+
+    for (rf_int dist = 0;; dist++)
+    {
+        char* slot_value = rf_hashmap_slot_value(map, slot);
+
+        if (map->hashes[slot] == 0)
+        {
+            map->hashes[slot] = hash;
+            map->keys[slot] = key;
+            memcpy(slot_value, carried_value, map->value_size);
+            if (!result) result = slot_value;
+            break;
+        }
+
+        // Take the slot from entries that are closer to their home slot and carry them forward instead
+        rf_int slot_dist = rf__hashmap_probe_distance(map, slot);
+        if (slot_dist < dist)
+        {
+            uint64_t slot_hash = map->hashes[slot];
+            rf_hashmap_key slot_key = map->keys[slot];
+
+            map->hashes[slot] = hash;
+            map->keys[slot] = key;
+            rf__hashmap_swap_bytes(slot_value, carried_value, map->value_size);
+            if (!result) result = slot_value;
+
+            hash = slot_hash;
+            key = slot_key;
+            dist = slot_dist;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    map->size++;
+
+    return result;
+}
+
+rf_internal rf_bool rf__hashmap_set_capacity(rf_hashmap* map, rf_int capacity)
+{
+    rf_int hashes_size = capacity * sizeof(uint64_t);
+    rf_int keys_size = capacity * sizeof(rf_hashmap_key);
+    char* memory = rf_alloc(map->allocator, hashes_size + keys_size + (capacity + 1) * map->value_size);
+
+    if (!memory)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate hash map with a capacity of %d entries with values of size %d", (int) capacity, (int) map->value_size);
+        return 0;
+    }
+
+    rf_hashmap old = *map;
+
+    map->hashes = (uint64_t*) memory;
+    map->keys = (rf_hashmap_key*)(memory + hashes_size);
+    map->values = memory + hashes_size + keys_size;
+    map->capacity = capacity;
+    map->size = 0;
+    memset(map->hashes, 0, hashes_size);
+
+    for (rf_int i = 0; i < old.capacity; i++)
+    {
+        if (old.hashes[i])
+        {
+            rf__hashmap_insert_new(map, old.hashes[i], old.keys[i], rf_hashmap_slot_value(&old, i));
+        }
+    }
+
+    if (old.hashes) rf_free(map->allocator, old.hashes);
+
+    return 1;
+}
+
+rf_public rf_hashmap rf_hashmap_make(rf_hashmap_key_type key_type, rf_int value_size, rf_int capacity, rf_allocator allocator)
+{
+    rf_hashmap result = {0};
+    result.key_type = key_type;
+    result.value_size = value_size;
+    result.allocator = allocator;
+
+    if (capacity > 0) rf_hashmap_reserve(&result, capacity);
+
+    return result;
+}
+
+rf_public void rf_hashmap_free(rf_hashmap* map)
+{
+    if (map->hashes) rf_free(map->allocator, map->hashes);
+
+    map->hashes = 0;
+    map->keys = 0;
+    map->values = 0;
+    map->size = 0;
+    map->capacity = 0;
+}
+
+rf_public void rf_hashmap_clear(rf_hashmap* map)
+{
+    if (map->hashes) memset(map->hashes, 0, map->capacity * sizeof(uint64_t));
+    map->size = 0;
+}
+
+rf_public rf_bool rf_hashmap_reserve(rf_hashmap* map, rf_int count)
+{
+    rf_int capacity = map->capacity ? map->capacity : RF_HASHMAP_MIN_CAPACITY;
+    while (count * 100 > capacity * RF_HASHMAP_MAX_LOAD_PERCENT) capacity *= 2;
+
+    if (capacity == map->capacity) return 1;
+
+    rf_bool result = rf__hashmap_set_capacity(map, capacity);
+    return result;
+}
+
+rf_public void* rf_hashmap_get_hashed(const rf_hashmap* map, uint64_t hash, rf_hashmap_key key)
+{
+    rf_int slot = rf__hashmap_find_slot(map, rf__hashmap_fix_hash(hash), key);
+    void* result = slot != rf_invalid_index ? rf_hashmap_slot_value(map, slot) : 0;
+    return result;
+}
+
+rf_public void* rf_hashmap_put_hashed(rf_hashmap* map, uint64_t hash, rf_hashmap_key key, const void* value)
+{
+    hash = rf__hashmap_fix_hash(hash);
+
+    rf_int slot = rf__hashmap_find_slot(map, hash, key);
+    if (slot != rf_invalid_index)
+    {
+        void* result = rf_hashmap_slot_value(map, slot);
+        if (value) memmove(result, value, map->value_size);
+        else memset(result, 0, map->value_size);
+        return result;
+    }
+
+    if ((map->size + 1) * 100 > map->capacity * RF_HASHMAP_MAX_LOAD_PERCENT)
+    {
+        if (!rf_hashmap_reserve(map, map->size + 1)) return 0;
+    }
+
+    void* result = rf__hashmap_insert_new(map, hash, key, value);
+    return result;
+}
+
+rf_public rf_bool rf_hashmap_remove_hashed(rf_hashmap* map, uint64_t hash, rf_hashmap_key key)
+{
+    rf_int slot = rf__hashmap_find_slot(map, rf__hashmap_fix_hash(hash), key);
+    if (slot == rf_invalid_index) return 0;
+
+    // Backward shift deletion, pull the following entries one slot closer to home until one is already there
+    rf_int mask = map->capacity - 1;
+    rf_int next = (slot + 1) & mask;
+
+    while (map->hashes[next] && rf__hashmap_probe_distance(map, next) > 0)
+    {
+        map->hashes[slot] = map->hashes[next];
+        map->keys[slot] = map->keys[next];
+        memcpy(rf_hashmap_slot_value(map, slot), rf_hashmap_slot_value(map, next), map->value_size);
+
+        slot = next;
+        next = (next + 1) & mask;
+    }
+
+    map->hashes[slot] = 0;
+    map->size--;
+
+    return 1;
+}
+
+rf_public void* rf_hashmap_get_u64(const rf_hashmap* map, uint64_t key)
+{
+    rf_hashmap_key k;
+    k.u64 = key;
+
+    void* result = rf_hashmap_get_hashed(map, rf_hash_u64(key), k);
+    return result;
+}
+
+rf_public void* rf_hashmap_put_u64(rf_hashmap* map, uint64_t key, const void* value)
+{
+    rf_hashmap_key k;
+    k.u64 = key;
+
+    void* result = rf_hashmap_put_hashed(map, rf_hash_u64(key), k, value);
+    return result;
+}
+
+rf_public rf_bool rf_hashmap_remove_u64(rf_hashmap* map, uint64_t key)
+{
+    rf_hashmap_key k;
+    k.u64 = key;
+
+    rf_bool result = rf_hashmap_remove_hashed(map, rf_hash_u64(key), k);
+    return result;
+}
+
+rf_public void* rf_hashmap_get_bytes(const rf_hashmap* map, const void* key, rf_int key_size)
+{
+    rf_hashmap_key k;
+    k.bytes.data = key;
+    k.bytes.size = key_size;
+
+    void* result = rf_hashmap_get_hashed(map, rf_hash_bytes(key, key_size), k);
+    return result;
+}
+
+rf_public void* rf_hashmap_put_bytes(rf_hashmap* map, const void* key, rf_int key_size, const void* value)
+{
+    rf_hashmap_key k;
+    k.bytes.data = key;
+    k.bytes.size = key_size;
+
+    void* result = rf_hashmap_put_hashed(map, rf_hash_bytes(key, key_size), k, value);
+    return result;
+}
+
+rf_public rf_bool rf_hashmap_remove_bytes(rf_hashmap* map, const void* key, rf_int key_size)
+{
+    rf_hashmap_key k;
+    k.bytes.data = key;
+    k.bytes.size = key_size;
+
+    rf_bool result = rf_hashmap_remove_hashed(map, rf_hash_bytes(key, key_size), k);
+    return result;
+}
+
+#pragma endregion
@@ -39,6 +39,21 @@ typedef int rf_bool;
     #define rayfork_platform_ios
 #endif
 
+// SIMD code paths are picked at compile time, define rayfork_no_simd to only use the scalar code
+#if !defined(rayfork_no_simd)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define rayfork_sse2
+    #endif
+
+    #if defined(__AVX2__)
+        #define rayfork_avx2
+    #endif
+
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+        #define rayfork_neon
+    #endif
+#endif
+
 
 #ifndef rf_extern
     #ifdef __cplusplus
@@ -179,20 +194,265 @@ rf_public rf_thread_local rf_allocator rf__global_allocator_for_dependencies;
 #define rf_set_global_dependencies_allocator(allocator) rf__global_allocator_for_dependencies = (allocator)
 #pragma endregion
 
+#pragma region arena allocator
+
+#ifndef RF_ARENA_ALIGNMENT
+    #define RF_ARENA_ALIGNMENT (16)
+#endif
+
+/*
+ * Linear allocator over a user provided buffer. Allocations are pointer bumps, reset is O(1).
+ * Free is a no-op unless the pointer is the most recent allocation, in which case the memory is given back.
+ * Realloc of the most recent allocation grows/shrinks it in place when possible.
+ */
+#define rf_arena_allocator(arena) (rf_lit(rf_allocator) { (arena), rf_arena_allocator_proc })
+
+/* Saves the arena state on entry and restores it when the scope is exited normally (don't break/return out of it). */
+#define rf_arena_scope(arena) \
+    for (rf_arena_mark rf_macro_var(mark_) = rf_arena_get_mark(arena), *rf_macro_var(once_) = &rf_macro_var(mark_); \
+         rf_macro_var(once_); \
+         rf_arena_restore((arena), rf_macro_var(mark_)), rf_macro_var(once_) = 0)
+
+typedef struct rf_arena
+{
+    char*  memory;
+    rf_int size;
+    rf_int used;
+    rf_int last_alloc_offset; // Offset of the most recent allocation, used to free/realloc the top allocation
+    rf_int high_water_mark;   // The biggest value `used` has reached since the arena was made
+} rf_arena;
+
+typedef struct rf_arena_mark
+{
+    rf_int used;
+    rf_int last_alloc_offset;
+} rf_arena_mark;
+
+rf_public rf_arena      rf_arena_make(void* memory, rf_int size);
+rf_public void*         rf_arena_alloc(rf_arena* arena, rf_int size);
+rf_public rf_arena_mark rf_arena_get_mark(const rf_arena* arena);
+rf_public void          rf_arena_restore(rf_arena* arena, rf_arena_mark mark);
+rf_public void          rf_arena_reset(rf_arena* arena);
+rf_public rf_int        rf_arena_remaining(const rf_arena* arena);
+rf_public void*         rf_arena_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args);
+#pragma endregion
+
+#pragma region pool allocator
+
+#ifndef RF_POOL_MIN_BLOCK_SIZE
+    #define RF_POOL_MIN_BLOCK_SIZE (16)
+#endif
+
+#ifndef RF_POOL_SIZE_CLASS_COUNT
+    #define RF_POOL_SIZE_CLASS_COUNT (8) // Size classes are powers of two starting from RF_POOL_MIN_BLOCK_SIZE, by default 16..2048 bytes
+#endif
+
+/*
+ * Size class allocator made of fixed size block pools over a user provided buffer.
+ * Each allocation is served from the smallest size class that fits, freed blocks go back to an intrusive free list.
+ * Allocations that are too big or for which the size class is exhausted go to the fallback allocator.
+ * Pools are not synchronized, for multithreaded code use one instance per thread (eg: an rf_thread_local rf_size_class_pools).
+ */
+#define rf_pool_allocator(pools) (rf_lit(rf_allocator) { (pools), rf_pool_allocator_proc })
+
+typedef struct rf_pool
+{
+    char*  memory;
+    rf_int block_size;
+    rf_int block_count;
+    rf_int untouched_index; // Blocks from this index onward were never handed out, this way making a pool doesn't have to touch all the memory
+    rf_int used_blocks;
+    void*  free_list;
+} rf_pool;
+
+typedef struct rf_size_class_pools
+{
+    rf_pool      size_classes[RF_POOL_SIZE_CLASS_COUNT];
+    rf_allocator fallback;
+} rf_size_class_pools;
+
+rf_public rf_pool rf_pool_make(void* memory, rf_int memory_size, rf_int block_size);
+rf_public void*   rf_pool_alloc(rf_pool* pool);
+rf_public void    rf_pool_free(rf_pool* pool, void* block);
+rf_public rf_bool rf_pool_owns(const rf_pool* pool, const void* ptr);
+
+rf_public rf_size_class_pools rf_size_class_pools_make(void* memory, rf_int memory_size, rf_allocator fallback); // The memory is split evenly between the size classes
+rf_public void* rf_pool_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args);
+#pragma endregion
+
+#pragma region tracking allocator
+
+#ifndef RF_TRACKING_ALLOCATOR_MAX_SITES
+    #define RF_TRACKING_ALLOCATOR_MAX_SITES (256) // Must be a power of two. Call sites past this limit are merged into one overflow site.
+#endif
+
+#ifndef RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS
+    #define RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS (16) // Bucket i counts allocations of size [2^i, 2^(i+1)), the last bucket counts everything bigger
+#endif
+
+/*
+ * Wraps another allocator and records statistics for every call site using the rf_source_location passed to the allocator.
+ * Each allocation gets a small header in front of it to remember its size and call site, so the wrapped allocator must also be used for freeing.
+ * The tracker is not synchronized, wrap a thread's allocator with its own tracker in multithreaded code.
+ */
+#define rf_tracking_allocator(tracker) (rf_lit(rf_allocator) { (tracker), rf_tracking_allocator_proc })
+
+typedef enum rf_allocation_sort_key
+{
+    rf_allocation_sort_by_live_bytes = 0,
+    rf_allocation_sort_by_peak_live_bytes,
+    rf_allocation_sort_by_total_bytes,
+    rf_allocation_sort_by_alloc_count,
+} rf_allocation_sort_key;
+
+typedef struct rf_allocation_site_stats
+{
+    rf_source_location source_location;
+    rf_int live_bytes;
+    rf_int peak_live_bytes;
+    rf_int total_bytes;
+    rf_int alloc_count;
+    rf_int realloc_count;
+    rf_int free_count;
+    rf_int size_histogram[RF_TRACKING_ALLOCATOR_HISTOGRAM_BUCKETS];
+} rf_allocation_site_stats;
+
+typedef struct rf_allocation_tracker
+{
+    rf_allocator             wrapped;
+    rf_int                   live_bytes;
+    rf_int                   peak_live_bytes;
+    rf_int                   alloc_count;
+    rf_int                   free_count;
+    rf_int                   sites_count;
+    rf_allocation_site_stats sites[RF_TRACKING_ALLOCATOR_MAX_SITES];
+} rf_allocation_tracker;
+
+rf_public void   rf_allocation_tracker_init(rf_allocation_tracker* tracker, rf_allocator wrapped);
+rf_public rf_int rf_allocation_tracker_get_sorted_sites(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, const rf_allocation_site_stats** dst, rf_int dst_size); // Returns the amount of sites written to dst, sorted in descending order
+rf_public rf_int rf_allocation_tracker_report_to_buffer(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, char* dst, rf_int dst_size); // Human readable table, returns the amount of bytes written without the null terminator
+rf_public rf_int rf_allocation_tracker_csv_to_buffer(const rf_allocation_tracker* tracker, rf_allocation_sort_key sort_by, char* dst, rf_int dst_size); // One row per call site including the size histogram, returns the amount of bytes written without the null terminator
+rf_public void*  rf_tracking_allocator_proc(rf_allocator* this_allocator, rf_source_location source_location, rf_allocator_mode mode, rf_allocator_args args);
+#pragma endregion
+
 #pragma region io
 #define rf_file_size(io, filename)                ((io).file_size_proc((io).user_data, filename))
 #define rf_read_file(io, filename, dst, dst_size) ((io).read_file_proc((io).user_data, filename, dst, dst_size))
-#define rf_default_io                             (rf_lit(rf_io_callbacks) { 0, rf_libc_get_file_size, rf_libc_load_file_into_buffer })
+#define rf_open_stream(io, filename)              ((io).open_stream_proc((io).user_data, filename))
+#define rf_read_stream(io, stream, dst, dst_size) ((io).read_stream_proc((io).user_data, stream, dst, dst_size))
+#define rf_seek_stream(io, stream, offset, origin) ((io).seek_stream_proc((io).user_data, stream, offset, origin))
+#define rf_close_stream(io, stream)               ((io).close_stream_proc((io).user_data, stream))
+#define rf_io_supports_streams(io)                ((io).open_stream_proc && (io).read_stream_proc && (io).seek_stream_proc && (io).close_stream_proc)
+#define rf_write_file(io, filename, src, src_size) ((io).write_file_proc((io).user_data, filename, src, src_size))
+#define rf_default_io                             (rf_lit(rf_io_callbacks) { 0, rf_libc_get_file_size, rf_libc_load_file_into_buffer, 0, 0, rf_libc_open_stream, rf_libc_read_stream, rf_libc_seek_stream, rf_libc_close_stream, rf_libc_write_file })
+#define rf_mmap_io                                (rf_lit(rf_io_callbacks) { 0, rf_mmap_get_file_size, rf_libc_load_file_into_buffer, rf_mmap_map_file, rf_mmap_unmap_file, rf_libc_open_stream, rf_libc_read_stream, rf_libc_seek_stream, rf_libc_close_stream, rf_libc_write_file })
+
+typedef enum rf_io_seek_origin
+{
+    rf_io_seek_set = 0,
+    rf_io_seek_current,
+    rf_io_seek_end,
+} rf_io_seek_origin;
+
+typedef struct rf_file_view
+{
+    const void* data;
+    rf_int      size;
+    void*       handle; // Implementation specific, eg: the OS mapping handle
+    rf_bool     mapped; // True if the data is mapped memory owned by the io callbacks, false if it was read into a temporary buffer
+    rf_bool     valid;
+} rf_file_view;
 
 typedef struct rf_io_callbacks
 {
     void*   user_data;
     rf_int  (*file_size_proc) (void* user_data, const char* filename);
     rf_bool (*read_file_proc) (void* user_data, const char* filename, void* dst, rf_int dst_size); // Returns true if operation was successful
+
+    // Optional, when present loaders decode straight from the mapped memory instead of reading the file into a temporary buffer
+    rf_file_view (*map_file_proc)   (void* user_data, const char* filename);
+    void         (*unmap_file_proc) (void* user_data, rf_file_view view);
+
+    // Optional, when present loaders whose decoders support it read the file incrementally instead of loading it whole
+    void*   (*open_stream_proc)  (void* user_data, const char* filename); // Returns a stream handle or null on failure
+    rf_int  (*read_stream_proc)  (void* user_data, void* stream, void* dst, rf_int dst_size); // Returns the amount of bytes read, less than dst_size only at the end of the stream or on error
+    rf_bool (*seek_stream_proc)  (void* user_data, void* stream, rf_int offset, rf_io_seek_origin origin); // Returns true if operation was successful
+    void    (*close_stream_proc) (void* user_data, void* stream);
+
+    // Optional, used by the few things that save files, eg: csv row indices
+    rf_bool (*write_file_proc) (void* user_data, const char* filename, const void* src, rf_int src_size); // Replaces the file, returns true if all of src was written
 } rf_io_callbacks;
 
+/*
+ * Returns a read-only view of the whole file. If the io callbacks can map files the view points to the mapped memory,
+ * otherwise the file is read into a buffer allocated with temp_allocator. Release it with rf_release_file_view.
+ */
+rf_public rf_file_view rf_view_file(rf_io_callbacks io, const char* filename, rf_allocator temp_allocator);
+rf_public void         rf_release_file_view(rf_io_callbacks io, rf_file_view view, rf_allocator temp_allocator);
+
 rf_public rf_int  rf_libc_get_file_size(void* user_data, const char* filename);
 rf_public rf_bool rf_libc_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size);
+rf_public void*   rf_libc_open_stream(void* user_data, const char* filename);
+rf_public rf_int  rf_libc_read_stream(void* user_data, void* stream, void* dst, rf_int dst_size);
+rf_public rf_bool rf_libc_seek_stream(void* user_data, void* stream, rf_int offset, rf_io_seek_origin origin);
+rf_public void    rf_libc_close_stream(void* user_data, void* stream);
+rf_public rf_bool rf_libc_write_file(void* user_data, const char* filename, const void* src, rf_int src_size);
+
+rf_public rf_int       rf_mmap_get_file_size(void* user_data, const char* filename); // Queries the size without opening the file
+rf_public rf_file_view rf_mmap_map_file(void* user_data, const char* filename);      // Maps the file with mmap/MapViewOfFile, returns an invalid view on unsupported platforms
+rf_public void         rf_mmap_unmap_file(void* user_data, rf_file_view view);
+#pragma endregion
+
+#pragma region time
+rf_public uint64_t rf_get_timestamp_ns(void); // Monotonic high resolution clock, only meaningful relative to other timestamps
+#pragma endregion
+
+#pragma region profiler
+
+#ifndef RF_PROFILER_EVENTS_PER_THREAD
+    #define RF_PROFILER_EVENTS_PER_THREAD (8192) // Must be a power of two. Zones that end while a thread's buffer is full are dropped.
+#endif
+
+#ifndef RF_PROFILER_MAX_ZONE_DEPTH
+    #define RF_PROFILER_MAX_ZONE_DEPTH (64)
+#endif
+
+/*
+ * Profiling zones record a name and high resolution timestamps into a ring buffer owned by the calling thread.
+ * Zones only record anything when rayfork is compiled with rayfork_enable_profiler and rf_profiler_init was called,
+ * otherwise the macros compile to nothing. Zone names must be string literals or otherwise outlive the profiler.
+ * rf_profiler_flush_chrome_trace writes the recorded zones as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev).
+ */
+#if defined(rayfork_enable_profiler)
+    #define rf_profile_zone_begin(name) (rf__profile_zone_begin(name))
+    #define rf_profile_zone_end()       (rf__profile_zone_end())
+#else
+    #define rf_profile_zone_begin(name) ((void) 0)
+    #define rf_profile_zone_end()       ((void) 0)
+#endif
+
+/* Profiles the following block, don't break/return out of it. */
+#define rf_profile_zone(name) \
+    for (int rf_macro_var(once_) = (rf_profile_zone_begin(name), 1); rf_macro_var(once_); rf_profile_zone_end(), rf_macro_var(once_) = 0)
+
+typedef struct rf_profile_event
+{
+    const char* name;
+    uint64_t    begin_ns; // rf_get_timestamp_ns when the zone began
+    uint64_t    duration_ns;
+    uint32_t    depth;
+} rf_profile_event;
+
+typedef void (*rf_profile_write_proc)(void* user_data, const char* data, rf_int size);
+
+rf_public void    rf_profiler_init(rf_allocator allocator); // Thread buffers are allocated with the allocator the first time each thread opens a zone, so it must be thread-safe
+rf_public void    rf_profiler_shutdown(void);               // Frees the thread buffers, no thread may be inside a zone when this is called
+rf_public rf_bool rf_profiler_is_enabled(void);
+rf_public rf_int  rf_profiler_flush_chrome_trace(rf_profile_write_proc write_proc, void* user_data); // Writes every zone recorded since the last flush as one JSON document, returns the amount of zones written
+rf_public rf_int  rf_profiler_flush_chrome_trace_to_file(const char* filename);
+
+rf_public void    rf__profile_zone_begin(const char* name);
+rf_public void    rf__profile_zone_end(void);
 #pragma endregion
 
 #pragma region error
@@ -232,8 +492,16 @@ rf_public rf_thread_local rf_recorded_error rf__last_error;
  this causes issues on some compiler just disable logs with RF_DISABLE_LOGGER.
  Also bear in mind that ##__VA_ARGS__ still works differently between compilers but this code seems to work on all major compilers.
 */
+#ifndef RF_LOG_COMPILE_TIME_FILTER
+    #if defined(RF_DISABLE_LOGGER)
+        #define RF_LOG_COMPILE_TIME_FILTER (0)
+    #else
+        #define RF_LOG_COMPILE_TIME_FILTER (0xF) // Bits of rf_log_type, logs whose type is not in the filter compile out entirely
+    #endif
+#endif
+
 #define rf_default_logger                  (rf_lit(rf_logger) { 0, rf_libc_printf_logger })
-#define rf_log(log_type, msg, ...)         (rf__internal_log(rf_current_source_location, (log_type), (msg), ##__VA_ARGS__))
+#define rf_log(log_type, msg, ...)         (((log_type) & RF_LOG_COMPILE_TIME_FILTER) ? rf__internal_log(rf_current_source_location, (log_type), (msg), ##__VA_ARGS__) : (void) 0)
 #define rf_log_error(error_type, msg, ...) (rf_log(rf_log_type_error, (msg), (error_type), ##__VA_ARGS__), rf__last_error = rf_make_recorded_error(error_type))
 
 typedef enum rf_log_type
@@ -268,6 +536,82 @@ rf_public void rf_libc_printf_logger(struct rf_logger* logger, rf_source_locatio
 rf_public void rf__internal_log(rf_source_location source_location, rf_log_type log_type, const char* msg, ...);
 #pragma endregion
 
+#pragma region async logger
+
+#ifndef RF_ASYNC_LOGGER_MESSAGE_SIZE
+    #define RF_ASYNC_LOGGER_MESSAGE_SIZE (256) // Longer messages are truncated
+#endif
+
+#ifndef RF_ASYNC_LOGGER_RATE_LIMIT_SITES
+    #define RF_ASYNC_LOGGER_RATE_LIMIT_SITES (128) // Must be a power of two. Call sites past this limit are not rate limited.
+#endif
+
+#ifndef RF_ASYNC_LOGGER_DEFAULT_RATE_LIMIT
+    #define RF_ASYNC_LOGGER_DEFAULT_RATE_LIMIT (8) // Messages per call site per second, 0 disables rate limiting
+#endif
+
+/*
+ * Logger that formats messages into a lock-free ring buffer and writes them out from a background thread,
+ * so logging from hot code costs a vsnprintf instead of a blocking write to stdout.
+ * Messages are dropped instead of blocking when the ring is full, and each call site can only log a limited amount of messages per second.
+ * Dropped and rate limited messages are counted and reported with the next message that gets through.
+ */
+#define rf_async_logger(async_logger) (rf_lit(rf_logger) { (async_logger), rf_async_logger_proc })
+
+typedef struct rf_log_message
+{
+    rf_source_location source_location;
+    rf_log_type        log_type;
+    rf_error_type      error_type;
+    rf_int             suppressed_count; // Messages from the same call site dropped by the rate limiter before this one
+    rf_int             dropped_count;    // Messages from any call site dropped because the ring was full before this one
+    char               text[RF_ASYNC_LOGGER_MESSAGE_SIZE];
+} rf_log_message;
+
+typedef void (*rf_log_message_proc)(void* user_data, const rf_log_message* message); // Called from the background thread
+
+typedef struct rf_async_log_cell
+{
+    volatile rf_int sequence;
+    rf_log_message  message;
+} rf_async_log_cell;
+
+typedef struct rf_async_log_site
+{
+    volatile rf_int key; // Hash of the source location, 0 for unused sites
+    volatile rf_int window_start_ms;
+    volatile rf_int count;
+    volatile rf_int suppressed;
+} rf_async_log_site;
+
+typedef struct rf_async_logger
+{
+    rf_async_log_cell*  cells;
+    rf_int              capacity; // A power of two
+    volatile rf_int     enqueue_index;
+    volatile rf_int     dequeue_index;
+    volatile rf_int     dropped;
+
+    rf_int              rate_limit; // Messages per call site per second, 0 disables rate limiting
+    rf_async_log_site   sites[RF_ASYNC_LOGGER_RATE_LIMIT_SITES];
+
+    rf_log_message_proc write_proc;
+    void*               write_user_data;
+
+    void*               thread;
+    volatile rf_int     quit;
+    rf_allocator        allocator;
+    rf_bool             valid;
+} rf_async_logger;
+
+rf_public rf_bool rf_async_logger_init(rf_async_logger* logger, rf_int capacity, rf_log_message_proc write_proc, void* write_user_data, rf_allocator allocator); // Capacity is rounded up to a power of two, a null write_proc writes to stdout
+rf_public void    rf_async_logger_flush(rf_async_logger* logger);    // Blocks until every message logged before the call was written
+rf_public void    rf_async_logger_shutdown(rf_async_logger* logger); // Writes the pending messages and stops the background thread. Unset the logger before calling this.
+
+rf_public void    rf_async_logger_proc(struct rf_logger* logger, rf_source_location source_location, rf_log_type log_type, const char* msg, rf_error_type error_type, va_list args);
+rf_public void    rf_libc_printf_log_message(void* user_data, const rf_log_message* message);
+#pragma endregion
+
 #pragma region assert
 #if !defined(rf_assert) && defined(rayfork_enable_assertions)
     #include "assert.h"
@@ -278,11 +622,111 @@ rf_public void rf__internal_log(rf_source_location source_location, rf_log_type
 #pragma endregion
 
 #pragma region rng
-#define rf_default_rand_proc (rf_libc_rand_wrapper)
+
+#ifndef RF_DEFAULT_RAND_SEED
+    #define RF_DEFAULT_RAND_SEED (0x5EED5EED5EED5EEDull)
+#endif
+
+#define rf_default_rand_proc (rf_default_rand_wrapper)
 
 typedef rf_int (*rf_rand_proc)(rf_int min, rf_int max);
 
-rf_public rf_int rf_libc_rand_wrapper(rf_int min, rf_int max);
+/*
+ * xoshiro256++ generator with explicit state, so it is thread-safe when each thread uses its own and gives the same sequence on every platform.
+ * The bulk fill functions run 4 interleaved xoshiro128++ streams seeded from the generator, with SSE2/NEON when available.
+ * They advance the generator by a fixed amount per call, so the results only depend on the seed and the sequence of calls.
+ */
+typedef struct rf_rand
+{
+    uint64_t state[4];
+} rf_rand;
+
+rf_public rf_rand  rf_rand_make(uint64_t seed);
+rf_public uint64_t rf_rand_next(rf_rand* rng);
+rf_public uint32_t rf_rand_u32(rf_rand* rng);
+rf_public float    rf_rand_float(rf_rand* rng);                       // Uniform in [0, 1)
+rf_public rf_int   rf_rand_range(rf_rand* rng, rf_int min, rf_int max); // Uniform in [min, max], unbiased
+
+rf_public void     rf_rand_fill_u32(rf_rand* rng, uint32_t* dst, rf_int count);
+rf_public void     rf_rand_fill_float(rf_rand* rng, float* dst, rf_int count);            // Uniform in [0, 1)
+rf_public void     rf_rand_fill_range(rf_rand* rng, int* dst, rf_int count, int min, int max); // Uniform in [min, max], the bias is at most (max - min + 1) / 2^32
+
+rf_public rf_rand* rf_get_default_rand(void); // Thread local generator seeded with RF_DEFAULT_RAND_SEED
+rf_public rf_int   rf_default_rand_wrapper(rf_int min, rf_int max); // rf_rand_proc over rf_get_default_rand
+rf_public rf_int   rf_libc_rand_wrapper(rf_int min, rf_int max);
+#pragma endregion
+
+#pragma region hash map
+
+#ifndef RF_HASHMAP_MIN_CAPACITY
+    #define RF_HASHMAP_MIN_CAPACITY (16)
+#endif
+
+// Slots are found by masking the hash with capacity - 1
+#if RF_HASHMAP_MIN_CAPACITY < 1 || (RF_HASHMAP_MIN_CAPACITY & (RF_HASHMAP_MIN_CAPACITY - 1)) != 0
+    #error "RF_HASHMAP_MIN_CAPACITY must be a power of two"
+#endif
+
+#ifndef RF_HASHMAP_MAX_LOAD_PERCENT
+    #define RF_HASHMAP_MAX_LOAD_PERCENT (85)
+#endif
+
+#define rf_hashmap_get_as(T, map, key)                  ((T*) rf_hashmap_get_u64((map), (key)))
+#define rf_hashmap_get_bytes_as(T, map, key, key_size)  ((T*) rf_hashmap_get_bytes((map), (key), (key_size)))
+#define rf_hashmap_slot_is_used(map, i)                 ((map)->hashes[i] != 0)
+#define rf_hashmap_slot_value(map, i)                   ((void*)((map)->values + (i) * (map)->value_size))
+
+typedef enum rf_hashmap_key_type
+{
+    rf_hashmap_key_u64 = 0, // Integer keys, stored in the map
+    rf_hashmap_key_bytes,   // Byte string keys, the map only stores the pointer and size so the key memory must outlive the entry
+} rf_hashmap_key_type;
+
+typedef union rf_hashmap_key
+{
+    uint64_t u64;
+    struct { const char* data; rf_int size; } bytes;
+} rf_hashmap_key;
+
+/*
+ * Open addressing hash map with Robin Hood probing and backward shift deletion, so lookups stay short even at high load.
+ * Values are fixed size blobs stored inline, the functions return pointers to them which are invalidated by any insertion or removal.
+ * To iterate loop over the slots from 0 to capacity and skip the ones for which rf_hashmap_slot_is_used is false.
+ */
+typedef struct rf_hashmap
+{
+    uint64_t*           hashes; // 0 marks an empty slot
+    rf_hashmap_key*     keys;
+    char*               values;
+    rf_int              value_size;
+    rf_int              size;
+    rf_int              capacity; // Always 0 or a power of two
+    rf_hashmap_key_type key_type;
+    rf_allocator        allocator;
+} rf_hashmap;
+
+rf_public uint64_t   rf_hash_u64(uint64_t x);
+rf_public uint64_t   rf_hash_bytes(const void* data, rf_int size);
+
+rf_public rf_hashmap rf_hashmap_make(rf_hashmap_key_type key_type, rf_int value_size, rf_int capacity, rf_allocator allocator); // Reserves space for `capacity` entries, 0 allocates on the first insertion
+rf_public void       rf_hashmap_free(rf_hashmap* map);
+rf_public void       rf_hashmap_clear(rf_hashmap* map);
+rf_public rf_bool    rf_hashmap_reserve(rf_hashmap* map, rf_int count); // Makes space for `count` entries without rehashing
+
+// The put functions insert or overwrite the entry and return a pointer to its value, or null if growing the map failed.
+// A null value zeroes the entry, otherwise it must not point into the map since growing it frees the old entries.
+rf_public void*      rf_hashmap_get_u64(const rf_hashmap* map, uint64_t key);
+rf_public void*      rf_hashmap_put_u64(rf_hashmap* map, uint64_t key, const void* value);
+rf_public rf_bool    rf_hashmap_remove_u64(rf_hashmap* map, uint64_t key);
+
+rf_public void*      rf_hashmap_get_bytes(const rf_hashmap* map, const void* key, rf_int key_size);
+rf_public void*      rf_hashmap_put_bytes(rf_hashmap* map, const void* key, rf_int key_size, const void* value);
+rf_public rf_bool    rf_hashmap_remove_bytes(rf_hashmap* map, const void* key, rf_int key_size);
+
+// Variants for callers that already have the hash of the key from rf_hash_u64 or rf_hash_bytes
+rf_public void*      rf_hashmap_get_hashed(const rf_hashmap* map, uint64_t hash, rf_hashmap_key key);
+rf_public void*      rf_hashmap_put_hashed(rf_hashmap* map, uint64_t hash, rf_hashmap_key key, const void* value);
+rf_public rf_bool    rf_hashmap_remove_hashed(rf_hashmap* map, uint64_t hash, rf_hashmap_key key);
 #pragma endregion
 
 #pragma region min max
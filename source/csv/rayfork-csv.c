@@ -0,0 +1,790 @@
+#include "rayfork-csv.h"
+#include "string.h"
+#include "math.h"
+
+#if defined(rayfork_avx2)
+    #include "immintrin.h"
+#elif defined(rayfork_sse2)
+    #include "emmintrin.h"
+#elif defined(rayfork_neon)
+    #include "arm_neon.h"
+#endif
+
+#pragma region block scanning
+
+// Bit i of quotes is set if block[i] is a quote, bit i of boundaries if it is the separator or a line break
+rf_internal void rf__csv_block_masks(const char* block, char separator, uint64_t* quotes, uint64_t* boundaries)
+{
+    uint64_t quote_bits = 0;
+    uint64_t boundary_bits = 0;
+
+    #if defined(rayfork_avx2)
+    {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i sep   = _mm256_set1_epi8(separator);
+        const __m256i line  = _mm256_set1_epi8('\n');
+
+        for (int i = 0; i < RF_CSV_BLOCK_SIZE; i += 32)
+        {
+            __m256i chars = _mm256_loadu_si256((const __m256i*) (block + i));
+            __m256i is_boundary = _mm256_or_si256(_mm256_cmpeq_epi8(chars, sep), _mm256_cmpeq_epi8(chars, line));
+
+            quote_bits    |= (uint64_t) (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, quote)) << i;
+            boundary_bits |= (uint64_t) (uint32_t) _mm256_movemask_epi8(is_boundary) << i;
+        }
+    }
+    #elif defined(rayfork_sse2)
+    {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i sep   = _mm_set1_epi8(separator);
+        const __m128i line  = _mm_set1_epi8('\n');
+
+        for (int i = 0; i < RF_CSV_BLOCK_SIZE; i += 16)
+        {
+            __m128i chars = _mm_loadu_si128((const __m128i*) (block + i));
+            __m128i is_boundary = _mm_or_si128(_mm_cmpeq_epi8(chars, sep), _mm_cmpeq_epi8(chars, line));
+
+            quote_bits    |= (uint64_t) (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(chars, quote)) << i;
+            boundary_bits |= (uint64_t) (uint32_t) _mm_movemask_epi8(is_boundary) << i;
+        }
+    }
+    #elif defined(rayfork_neon) && (defined(__aarch64__) || defined(_M_ARM64))
+    {
+        // Keep one bit per byte at its position in the byte and add neighbours pairwise until each byte holds 8 flags
+        static const uint8_t bit_values[16] = { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+        const uint8x16_t bits  = vld1q_u8(bit_values);
+        const uint8x16_t quote = vdupq_n_u8('"');
+        const uint8x16_t sep   = vdupq_n_u8((uint8_t) separator);
+        const uint8x16_t line  = vdupq_n_u8('\n');
+
+        uint8x16_t quote_parts[4];
+        uint8x16_t boundary_parts[4];
+
+        for (int i = 0; i < 4; i++)
+        {
+            uint8x16_t chars = vld1q_u8((const uint8_t*) block + i * 16);
+            quote_parts[i]    = vandq_u8(vceqq_u8(chars, quote), bits);
+            boundary_parts[i] = vandq_u8(vorrq_u8(vceqq_u8(chars, sep), vceqq_u8(chars, line)), bits);
+        }
+
+        uint8x16_t quote_sum    = vpaddq_u8(vpaddq_u8(quote_parts[0], quote_parts[1]), vpaddq_u8(quote_parts[2], quote_parts[3]));
+        uint8x16_t boundary_sum = vpaddq_u8(vpaddq_u8(boundary_parts[0], boundary_parts[1]), vpaddq_u8(boundary_parts[2], boundary_parts[3]));
+
+        quote_bits    = vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(quote_sum, quote_sum)), 0);
+        boundary_bits = vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(boundary_sum, boundary_sum)), 0);
+    }
+    #else
+    {
+        for (int i = 0; i < RF_CSV_BLOCK_SIZE; i++)
+        {
+            quote_bits    |= (uint64_t) (block[i] == '"') << i;
+            boundary_bits |= (uint64_t) (block[i] == separator || block[i] == '\n') << i;
+        }
+    }
+    #endif
+
+    *quotes = quote_bits;
+    *boundaries = boundary_bits;
+}
+
+// Bit i of the result is the xor of bits 0...i, so it is set for the bytes from an opening quote up to the closing one
+rf_internal uint64_t rf__csv_prefix_xor(uint64_t bits)
+{
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+
+    return bits;
+}
+
+// Masks of the block starting at block_begin, bits past the end of the source are cleared
+rf_internal void rf__csv_load_block(rf_str src, rf_int block_begin, char separator, uint64_t* quotes, uint64_t* boundaries)
+{
+    const char* block = src.data + block_begin;
+    char padded_block[RF_CSV_BLOCK_SIZE];
+
+    // The last block is copied so the loads don't read past the end of the source
+    rf_int remaining = src.size - block_begin;
+    if (remaining < RF_CSV_BLOCK_SIZE)
+    {
+        memset(padded_block, 0, sizeof(padded_block));
+        memcpy(padded_block, block, remaining);
+        block = padded_block;
+    }
+
+    rf__csv_block_masks(block, separator, quotes, boundaries);
+
+    // A separator of 0 would match the padding
+    if (remaining < RF_CSV_BLOCK_SIZE) *boundaries &= (1ull << remaining) - 1;
+}
+
+rf_internal void rf__csv_scan_block(rf_csv_iter* iter)
+{
+    uint64_t quotes, boundaries;
+    rf__csv_load_block(iter->src, iter->block_begin, iter->separator, &quotes, &boundaries);
+
+    uint64_t inside_quotes = rf__csv_prefix_xor(quotes) ^ iter->inside_quotes;
+
+    // Carry whether the block ended inside quotes over to the next one
+    iter->inside_quotes = 0 - (inside_quotes >> 63);
+    iter->boundaries = boundaries & ~inside_quotes;
+}
+
+// Consumes the next boundary and returns its offset, or the size of the source if there are none left
+rf_internal rf_int rf__csv_next_boundary(rf_csv_iter* iter)
+{
+    while (iter->boundaries == 0)
+    {
+        if (iter->block_begin + RF_CSV_BLOCK_SIZE >= iter->src.size) return iter->src.size;
+
+        iter->block_begin += RF_CSV_BLOCK_SIZE;
+        rf__csv_scan_block(iter);
+    }
+
+    rf_int result = iter->block_begin + rf__count_trailing_zeros_u64(iter->boundaries);
+    iter->boundaries &= iter->boundaries - 1;
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region csv iter
+
+rf_public rf_csv_iter rf_csv_make_iter(rf_str src)
+{
+    rf_csv_iter result = rf_csv_make_iter_ex(src, ',');
+    return result;
+}
+
+rf_public rf_csv_iter rf_csv_make_iter_ex(rf_str src, char separator)
+{
+    rf_csv_iter result = {0};
+
+    if (rf_str_valid(src))
+    {
+        result.src       = src;
+        result.separator = separator;
+        result.row       = -1;
+        result.valid     = 1;
+
+        rf__csv_scan_block(&result);
+    }
+
+    return result;
+}
+
+rf_public rf_bool rf_csv_advance_row(rf_csv_iter* iter)
+{
+    if (!iter->valid) return 0;
+
+    // Skip the elements of the current row that weren't read
+    while (iter->in_row)
+    {
+        rf_int boundary = rf__csv_next_boundary(iter);
+
+        iter->position = boundary < iter->src.size ? boundary + 1 : iter->src.size;
+        iter->in_row = boundary < iter->src.size && iter->src.data[boundary] != '\n';
+    }
+
+    // A line break at the very end doesn't start another row
+    if (iter->position >= iter->src.size)
+    {
+        iter->valid = 0;
+        return 0;
+    }
+
+    iter->row++;
+    iter->in_row = 1;
+
+    return 1;
+}
+
+rf_public rf_bool rf_csv_next_col_element(rf_csv_iter* iter, rf_csv_element* element)
+{
+    if (!iter->valid || !iter->in_row) return 0;
+
+    rf_int begin = iter->position;
+    rf_int end = rf__csv_next_boundary(iter);
+    rf_bool row_ends = end == iter->src.size || iter->src.data[end] == '\n';
+
+    iter->position = end < iter->src.size ? end + 1 : iter->src.size;
+    iter->in_row = !row_ends;
+
+    // The \r of a \r\n line break
+    if (row_ends && end > begin && iter->src.data[end - 1] == '\r') end--;
+
+    rf_csv_element result = {0};
+    result.str = (rf_str) { iter->src.data + begin, end - begin };
+
+    if (result.str.size >= 2 && result.str.data[0] == '"' && result.str.data[result.str.size - 1] == '"')
+    {
+        result.str.data += 1;
+        result.str.size -= 2;
+        result.quoted = 1;
+    }
+
+    *element = result;
+    return 1;
+}
+
+rf_public rf_int rf_csv_unescape_to_buffer(rf_str element, char* dst, rf_int dst_size)
+{
+    rf_int result = 0;
+
+    for (rf_int i = 0; i < element.size && result < dst_size; i++)
+    {
+        dst[result++] = element.data[i];
+
+        // Skip the second quote of a pair
+        if (element.data[i] == '"' && i + 1 < element.size && element.data[i + 1] == '"') i++;
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_csv_col_count(rf_str csv)
+{
+    rf_int result = rf_csv_col_count_ex(csv, ',');
+    return result;
+}
+
+rf_public rf_int rf_csv_col_count_ex(rf_str csv, char separator)
+{
+    rf_int result = 0;
+
+    rf_csv_iter iter = rf_csv_make_iter_ex(csv, separator);
+    if (rf_csv_advance_row(&iter))
+    {
+        rf_csv_element element;
+        while (rf_csv_next_col_element(&iter, &element)) result++;
+    }
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region columns
+
+// Parses the whole cell apart from spaces around it as the column type
+rf_internal rf_bool rf__csv_parse_cell(rf_str cell, rf_csv_column_type type, void* dst)
+{
+    const char* begin = rf__skip_spaces(cell.data, cell.data + cell.size);
+    const char* end = cell.data + cell.size;
+    while (end != begin && rf_is_space(end[-1])) end--;
+
+    if (begin == end) return 0;
+
+    rf_int size = 0;
+    rf_bool overflow = 0;
+    switch (type)
+    {
+        case rf_csv_column_int:    size = rf__parse_int((rf_str) { (char*) begin, end - begin }, dst, &overflow); break;
+        case rf_csv_column_float:  size = rf__parse_float(begin, end, dst); break;
+        case rf_csv_column_double: size = rf__parse_double(begin, end, dst); break;
+        default: break;
+    }
+
+    // Integers that don't fit would only be saturated, which silently changes the data
+    rf_bool result = size == end - begin && !overflow;
+    return result;
+}
+
+rf_public rf_csv_extract_result rf_csv_extract_columns(rf_csv_iter* iter, const rf_csv_column* columns, rf_int columns_count, rf_int max_rows, rf_csv_cell* bad_cells, rf_int bad_cells_size)
+{
+    rf_csv_extract_result result = {0};
+
+    while (result.rows < max_rows && rf_csv_advance_row(iter))
+    {
+        rf_int row = result.rows;
+        rf_bool row_ended = 0;
+
+        for (rf_int col = 0; col < columns_count; col++)
+        {
+            rf_csv_element element = {0};
+            rf_bool present = !row_ended && rf_csv_next_col_element(iter, &element);
+            row_ended = !present;
+
+            void* dst = columns[col].dst;
+            rf_bool good = 1;
+
+            switch (columns[col].type)
+            {
+                case rf_csv_column_int:
+                    good = present && rf__csv_parse_cell(element.str, rf_csv_column_int, (rf_int*) dst + row);
+                    if (!good) ((rf_int*) dst)[row] = 0;
+                    break;
+
+                case rf_csv_column_float:
+                    good = present && rf__csv_parse_cell(element.str, rf_csv_column_float, (float*) dst + row);
+                    if (!good) ((float*) dst)[row] = NAN;
+                    break;
+
+                case rf_csv_column_double:
+                    good = present && rf__csv_parse_cell(element.str, rf_csv_column_double, (double*) dst + row);
+                    if (!good) ((double*) dst)[row] = NAN;
+                    break;
+
+                case rf_csv_column_str:
+                    ((rf_str*) dst)[row] = present ? element.str : (rf_str) { iter->src.data + iter->position, 0 };
+                    good = present;
+                    break;
+
+                default: break;
+            }
+
+            if (!good)
+            {
+                if (result.bad_cells < bad_cells_size) bad_cells[result.bad_cells] = (rf_csv_cell) { iter->row, col };
+                result.bad_cells++;
+            }
+        }
+
+        result.rows++;
+    }
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region row index
+
+typedef struct rf__csv_chunk
+{
+    rf_int  begin;
+    rf_int  end;
+    rf_int  rows[2];              // Rows starting in the chunk if it starts outside [0] or inside [1] quotes
+    rf_bool odd_quotes;
+    rf_bool starts_inside_quotes; // Resolved between the two passes
+    rf_int  first_row;            // Index in the offsets of the first row starting in the chunk
+} rf__csv_chunk;
+
+typedef struct rf__csv_index_data
+{
+    rf_str         src;
+    rf__csv_chunk* chunks;
+    rf_int*        offsets;     // Offsets of every sample_rate-th row
+    rf_int         sample_rate;
+} rf__csv_index_data;
+
+// Line breaks in the block that start a row whether they are inside quotes or not, one at the very end of the source doesn't
+rf_internal uint64_t rf__csv_row_breaks(rf_str src, rf_int block_begin, uint64_t* quotes)
+{
+    uint64_t result;
+    rf__csv_load_block(src, block_begin, '\n', quotes, &result);
+
+    rf_int last = src.size - 1 - block_begin;
+    if (last < RF_CSV_BLOCK_SIZE) result &= ~(1ull << last);
+
+    return result;
+}
+
+rf_internal void rf__csv_count_rows(void* data, rf_int begin, rf_int end)
+{
+    rf__csv_index_data* index = data;
+
+    for (rf_int i = begin; i < end; i++)
+    {
+        rf__csv_chunk* chunk = &index->chunks[i];
+        uint64_t inside_quotes = 0;
+        rf_int rows_outside = 0;
+        rf_int rows_inside = 0;
+
+        for (rf_int block = chunk->begin; block < chunk->end; block += RF_CSV_BLOCK_SIZE)
+        {
+            uint64_t quotes;
+            uint64_t line_breaks = rf__csv_row_breaks(index->src, block, &quotes);
+            uint64_t inside = rf__csv_prefix_xor(quotes) ^ inside_quotes;
+
+            inside_quotes = 0 - (inside >> 63);
+
+            // If the chunk actually starts inside quotes every bit of inside flips
+            rows_outside += rf__popcount_u64(line_breaks & ~inside);
+            rows_inside  += rf__popcount_u64(line_breaks & inside);
+        }
+
+        chunk->rows[0] = rows_outside;
+        chunk->rows[1] = rows_inside;
+        chunk->odd_quotes = inside_quotes != 0;
+    }
+}
+
+rf_internal void rf__csv_write_rows(void* data, rf_int begin, rf_int end)
+{
+    rf__csv_index_data* index = data;
+
+    for (rf_int i = begin; i < end; i++)
+    {
+        rf__csv_chunk* chunk = &index->chunks[i];
+        uint64_t inside_quotes = 0 - (uint64_t) chunk->starts_inside_quotes;
+
+        // Count the rows down to the next one that is kept instead of dividing for each of them
+        rf_int sample = (chunk->first_row + index->sample_rate - 1) / index->sample_rate;
+        rf_int rows_to_sample = sample * index->sample_rate - chunk->first_row;
+        rf_int* dst = index->offsets + sample;
+
+        for (rf_int block = chunk->begin; block < chunk->end; block += RF_CSV_BLOCK_SIZE)
+        {
+            uint64_t quotes;
+            uint64_t line_breaks = rf__csv_row_breaks(index->src, block, &quotes);
+            uint64_t inside = rf__csv_prefix_xor(quotes) ^ inside_quotes;
+
+            inside_quotes = 0 - (inside >> 63);
+            line_breaks &= ~inside;
+
+            while (line_breaks)
+            {
+                if (rows_to_sample == 0)
+                {
+                    *dst++ = block + rf__count_trailing_zeros_u64(line_breaks) + 1;
+                    rows_to_sample = index->sample_rate;
+                }
+
+                rows_to_sample--;
+                line_breaks &= line_breaks - 1;
+            }
+        }
+    }
+}
+
+rf_public rf_csv_rows rf_csv_index_rows(rf_str src, rf_allocator allocator)
+{
+    rf_csv_rows result = rf_csv_index_rows_parallel(src, rf_immediate_scheduler, allocator);
+    return result;
+}
+
+// Offsets of every sample_rate-th row, rows_count gets the number of rows in the source
+rf_internal rf_arr(rf_int) rf__csv_index_rows(rf_str src, rf_int sample_rate, rf_job_scheduler scheduler, rf_allocator allocator, rf_int* rows_count)
+{
+    rf_int chunk_size = (RF_CSV_CHUNK_SIZE + RF_CSV_BLOCK_SIZE - 1) / RF_CSV_BLOCK_SIZE * RF_CSV_BLOCK_SIZE;
+    rf_int chunks_count = (src.size + chunk_size - 1) / chunk_size;
+    rf__csv_chunk* chunks = 0;
+
+    if (chunks_count > 0)
+    {
+        chunks = rf_alloc(allocator, chunks_count * sizeof(rf__csv_chunk));
+
+        if (!chunks)
+        {
+            rf_log_error(rf_bad_alloc, "Failed to allocate %d chunks to index csv rows", (int) chunks_count);
+            return 0;
+        }
+    }
+
+    for (rf_int i = 0; i < chunks_count; i++)
+    {
+        chunks[i] = (rf__csv_chunk) {0};
+        chunks[i].begin = i * chunk_size;
+        chunks[i].end   = chunks[i].begin + chunk_size < src.size ? chunks[i].begin + chunk_size : src.size;
+    }
+
+    rf__csv_index_data data = { src, chunks, 0, sample_rate };
+
+    if (chunks_count > 0) rf_parallel_for(scheduler, 0, chunks_count, 1, rf__csv_count_rows, &data);
+
+    // Row 0 starts at the beginning of the source and every other row right after a line break
+    rf_int rows = src.size > 0;
+    rf_bool inside_quotes = 0;
+
+    for (rf_int i = 0; i < chunks_count; i++)
+    {
+        chunks[i].starts_inside_quotes = inside_quotes;
+        chunks[i].first_row = rows;
+
+        rows += chunks[i].rows[inside_quotes];
+        inside_quotes ^= chunks[i].odd_quotes;
+    }
+
+    rf_int samples_count = (rows + sample_rate - 1) / sample_rate;
+    rf_arr(rf_int) result = rf_arr_make(rf_int, samples_count, allocator);
+
+    if (result)
+    {
+        // The capacity is already there, so this only sets the size without initializing the offsets
+        rf_arr_add_n(result, 0, samples_count);
+        if (samples_count > 0) result[0] = 0;
+
+        data.offsets = result;
+        if (chunks_count > 0) rf_parallel_for(scheduler, 0, chunks_count, 1, rf__csv_write_rows, &data);
+
+        *rows_count = rows;
+    }
+
+    if (chunks) rf_free(allocator, chunks);
+
+    return result;
+}
+
+rf_public rf_csv_rows rf_csv_index_rows_parallel(rf_str src, rf_job_scheduler scheduler, rf_allocator allocator)
+{
+    rf_csv_rows result = {0};
+
+    if (!rf_str_valid(src)) return result;
+
+    rf_int rows_count = 0;
+    result.offsets = rf__csv_index_rows(src, 1, scheduler, allocator, &rows_count);
+
+    if (result.offsets)
+    {
+        result.src   = src;
+        result.valid = 1;
+    }
+
+    return result;
+}
+
+rf_public void rf_csv_rows_free(rf_csv_rows* rows)
+{
+    rf_arr_free(rows->offsets);
+    *rows = (rf_csv_rows) {0};
+}
+
+rf_public rf_int rf_csv_rows_count(const rf_csv_rows* rows)
+{
+    rf_int result = rf_arr_size(rows->offsets);
+    return result;
+}
+
+rf_public rf_str rf_csv_rows_get(const rf_csv_rows* rows, rf_int row)
+{
+    rf_str result = rf_csv_rows_get_range(rows, row, row + 1);
+    return result;
+}
+
+rf_public rf_str rf_csv_rows_get_range(const rf_csv_rows* rows, rf_int begin, rf_int end)
+{
+    rf_str result = {0};
+    rf_int count = rf_csv_rows_count(rows);
+
+    if (!rows->valid || begin < 0 || end > count || begin > end) return result;
+    if (begin == end) return (rf_str) { rows->src.data + (begin < count ? rows->offsets[begin] : rows->src.size), 0 };
+
+    rf_int first = rows->offsets[begin];
+    rf_int last = end < count ? rows->offsets[end] - 1 : rows->src.size;
+
+    // Drop the line break after the last row, which the last row of the source may not have
+    if (end == count && last > first && rows->src.data[last - 1] == '\n') last--;
+    if (last > first && rows->src.data[last - 1] == '\r') last--;
+
+    result = (rf_str) { rows->src.data + first, last - first };
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region row index file
+
+#define RF__CSV_ROW_INDEX_MAGIC   "rfcsvidx"
+#define RF__CSV_ROW_INDEX_VERSION (2)
+#define RF__CSV_ROW_INDEX_HEADER  (7) // Magic, version, sample rate, rows count, source size, fingerprint and samples count, 8 bytes each
+
+rf_internal void rf__csv_store_u64_le(char* dst, uint64_t value)
+{
+    for (int i = 0; i < 8; i++) dst[i] = (char) (value >> (i * 8));
+}
+
+// Hash of the start and the end of the csv, appending or editing rows there changes it even when the size stays the same
+rf_internal uint64_t rf__csv_fingerprint(rf_str src)
+{
+    rf_int size = src.size < RF_CSV_ROW_INDEX_FINGERPRINT_SIZE ? src.size : RF_CSV_ROW_INDEX_FINGERPRINT_SIZE;
+
+    uint64_t head = rf_hash_bytes(src.data, size);
+    uint64_t tail = rf_hash_bytes(src.data + src.size - size, size);
+
+    uint64_t result = head ^ rf_hash_u64(tail);
+    return result;
+}
+
+rf_public rf_csv_row_index rf_csv_build_row_index(rf_str src, rf_int sample_rate, rf_job_scheduler scheduler, rf_allocator allocator)
+{
+    rf_csv_row_index result = {0};
+
+    if (!rf_str_valid(src) || sample_rate < 1) return result;
+
+    rf_int rows_count = 0;
+    result.samples = rf__csv_index_rows(src, sample_rate, scheduler, allocator, &rows_count);
+
+    if (result.samples)
+    {
+        result.sample_rate = sample_rate;
+        result.rows_count  = rows_count;
+        result.src_size    = src.size;
+        result.fingerprint = rf__csv_fingerprint(src);
+        result.valid       = 1;
+    }
+
+    return result;
+}
+
+rf_public void rf_csv_row_index_free(rf_csv_row_index* index)
+{
+    rf_arr_free(index->samples);
+    *index = (rf_csv_row_index) {0};
+}
+
+rf_public rf_csv_iter rf_csv_row_index_make_iter(const rf_csv_row_index* index, rf_str src, char separator, rf_int row)
+{
+    rf_csv_iter result = {0};
+
+    if (!index->valid || src.size != index->src_size || row < 0 || row >= index->rows_count) return result;
+
+    rf_int sample = row / index->sample_rate;
+    rf_int offset = index->samples[sample];
+
+    // Rows start after a line break, anything else means the csv was edited since the index was built
+    if (offset > 0 && src.data[offset - 1] != '\n') return result;
+
+    result = rf_csv_make_iter_ex((rf_str) { src.data + offset, src.size - offset }, separator);
+    result.row = sample * index->sample_rate - 1;
+
+    for (rf_int i = sample * index->sample_rate; i < row; i++) rf_csv_advance_row(&result);
+
+    return result;
+}
+
+rf_public rf_int rf_csv_row_index_to_buffer(const rf_csv_row_index* index, void* dst, rf_int dst_size)
+{
+    if (!index->valid) return 0;
+
+    rf_int samples_count = rf_arr_size(index->samples);
+    rf_int result = (RF__CSV_ROW_INDEX_HEADER + samples_count) * 8;
+
+    if (dst_size < result) return result;
+
+    char* iter = dst;
+    memcpy(iter, RF__CSV_ROW_INDEX_MAGIC, 8);
+    rf__csv_store_u64_le(iter + 8,  RF__CSV_ROW_INDEX_VERSION);
+    rf__csv_store_u64_le(iter + 16, index->sample_rate);
+    rf__csv_store_u64_le(iter + 24, index->rows_count);
+    rf__csv_store_u64_le(iter + 32, index->src_size);
+    rf__csv_store_u64_le(iter + 40, index->fingerprint);
+    rf__csv_store_u64_le(iter + 48, samples_count);
+    iter += RF__CSV_ROW_INDEX_HEADER * 8;
+
+    for (rf_int i = 0; i < samples_count; i++, iter += 8) rf__csv_store_u64_le(iter, index->samples[i]);
+
+    return result;
+}
+
+rf_public rf_csv_row_index rf_csv_row_index_from_buffer(const void* src, rf_int src_size, rf_allocator allocator)
+{
+    rf_csv_row_index result = {0};
+    const char* iter = src;
+
+    if (!src || src_size < RF__CSV_ROW_INDEX_HEADER * 8) return result;
+    if (memcmp(iter, RF__CSV_ROW_INDEX_MAGIC, 8) != 0 || rf__load_u64_le(iter + 8) != RF__CSV_ROW_INDEX_VERSION) return result;
+
+    rf_int sample_rate   = rf__load_u64_le(iter + 16);
+    rf_int rows_count    = rf__load_u64_le(iter + 24);
+    rf_int src_size_csv  = rf__load_u64_le(iter + 32);
+    uint64_t fingerprint = rf__load_u64_le(iter + 40);
+    rf_int samples_count = rf__load_u64_le(iter + 48);
+    iter += RF__CSV_ROW_INDEX_HEADER * 8;
+
+    // Reject truncated or inconsistent files before trusting the counts, a csv can't have more rows than bytes
+    if (sample_rate < 1 || src_size_csv < 0 || rows_count < 0 || rows_count > src_size_csv) return result;
+    if (samples_count != rows_count / sample_rate + (rows_count % sample_rate != 0)) return result;
+    if (samples_count > (src_size - RF__CSV_ROW_INDEX_HEADER * 8) / 8) return result;
+
+    rf_arr(rf_int) samples = rf_arr_make(rf_int, samples_count, allocator);
+    if (!samples) return result;
+
+    rf_arr_add_n(samples, 0, samples_count);
+
+    for (rf_int i = 0; i < samples_count; i++, iter += 8)
+    {
+        samples[i] = rf__load_u64_le(iter);
+
+        if (samples[i] < 0 || samples[i] >= src_size_csv || (i > 0 && samples[i] <= samples[i - 1]))
+        {
+            rf_arr_free(samples);
+            return result;
+        }
+    }
+
+    result.samples     = samples;
+    result.sample_rate = sample_rate;
+    result.rows_count  = rows_count;
+    result.src_size    = src_size_csv;
+    result.fingerprint = fingerprint;
+    result.valid       = 1;
+
+    return result;
+}
+
+rf_public rf_bool rf_csv_row_index_matches(const rf_csv_row_index* index, rf_str src)
+{
+    if (!index->valid || src.size != index->src_size || rf__csv_fingerprint(src) != index->fingerprint) return 0;
+
+    // Every sampled row has to start right after a line break, which catches most edits in the middle that keep the size
+    rf_int samples_count = rf_arr_size(index->samples);
+    for (rf_int i = 0; i < samples_count; i++)
+    {
+        rf_int offset = index->samples[i];
+        if (offset > 0 && src.data[offset - 1] != '\n') return 0;
+    }
+
+    return 1;
+}
+
+rf_public rf_bool rf_csv_save_row_index(const rf_csv_row_index* index, rf_io_callbacks io, const char* csv_filename, rf_allocator temp_allocator)
+{
+    rf_bool result = 0;
+
+    if (!index->valid || !io.write_file_proc) return result;
+
+    rf_strbuf_on_stack(filename, 256, temp_allocator);
+    rf_strbuf_appendf(&filename, "%s%s", csv_filename, RF_CSV_ROW_INDEX_EXTENSION);
+
+    rf_int size = rf_csv_row_index_to_buffer(index, 0, 0);
+    void* buffer = rf_alloc(temp_allocator, size);
+
+    if (buffer && filename.valid)
+    {
+        rf_csv_row_index_to_buffer(index, buffer, size);
+        result = rf_write_file(io, filename.data, buffer, size);
+    }
+    else
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate %d bytes to save a csv row index", (int) size);
+    }
+
+    if (buffer) rf_free(temp_allocator, buffer);
+    rf_strbuf_free(&filename);
+
+    return result;
+}
+
+rf_public rf_csv_row_index rf_csv_load_row_index(rf_io_callbacks io, const char* csv_filename, rf_str src, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    rf_csv_row_index result = {0};
+
+    rf_strbuf_on_stack(filename, 256, temp_allocator);
+    rf_strbuf_appendf(&filename, "%s%s", csv_filename, RF_CSV_ROW_INDEX_EXTENSION);
+
+    if (filename.valid)
+    {
+        rf_file_view view = rf_view_file(io, filename.data, temp_allocator);
+
+        if (view.valid)
+        {
+            result = rf_csv_row_index_from_buffer(view.data, view.size, allocator);
+            rf_release_file_view(io, view, temp_allocator);
+        }
+    }
+
+    // The csv changed since the index was saved
+    if (result.valid && !rf_csv_row_index_matches(&result, src)) rf_csv_row_index_free(&result);
+
+    rf_strbuf_free(&filename);
+
+    return result;
+}
+
+#pragma endregion
@@ -3,50 +3,163 @@
 
 #include "rayfork-core.h"
 #include "rayfork-str.h"
+#include "rayfork-arr.h"
+#include "rayfork-jobs.h"
+
+/*
+ * Zero-copy CSV reader following RFC 4180. Rows end with \n or \r\n, elements are separated by a single byte and can be quoted
+ * with " to contain separators and line breaks, a quote inside a quoted element is written twice.
+ * Elements are returned as views into the source, so the source has to stay alive while they are used. A mapped file view
+ * works well for big files since the reader only goes through the input once.
+ *
+ * The source is scanned 64 bytes at a time with SIMD, which produces bitmasks of the quotes, separators and line breaks.
+ * A prefix xor of the quote bits tells which bytes are inside quotes, the remaining separators and line breaks are the
+ * element boundaries and iterating over them only costs a bit scan per element.
+ *
+ * Usage:
+ *     rf_csv_iter csv = rf_csv_make_iter(src);
+ *     while (rf_csv_advance_row(&csv))
+ *     {
+ *         rf_csv_element element;
+ *         while (rf_csv_next_col_element(&csv, &element)) { ... }
+ *     }
+ *
+ * Big inputs can be split up across threads with rf_csv_index_rows_parallel, which finds where every row starts. The source
+ * is cut into chunks that are scanned in parallel twice. The first pass doesn't know if its chunk starts inside quotes, so it
+ * counts the rows for both cases along with the parity of the quotes, a serial scan over the chunks then picks the right case
+ * for each of them. The second pass writes the row offsets of every chunk straight to their final place in the table.
+ * Rows never start inside quotes, so any range of rows can be read with its own iterator:
+ *     rf_csv_rows rows = rf_csv_index_rows_parallel(src, rf_job_system_scheduler(&jobs), allocator);
+ *     rf_parallel_for(rf_job_system_scheduler(&jobs), 0, rf_csv_rows_count(&rows), 1024, parse_rows, &rows);
+ *     ...
+ *     void parse_rows(void* data, rf_int begin, rf_int end)
+ *     {
+ *         rf_csv_iter csv = rf_csv_make_iter(rf_csv_rows_get_range(data, begin, end));
+ *         ...
+ *     }
+ *
+ * Tables of numbers can be read straight into one array per column with rf_csv_extract_columns. Cells are parsed in place
+ * in the source, cells that are missing or don't parse as their column type are reported instead of stopping the read:
+ *     rf_int ids[1024]; float values[1024]; rf_csv_cell bad_cells[64];
+ *     rf_csv_column columns[] = { { rf_csv_column_int, ids }, { rf_csv_column_skip }, { rf_csv_column_float, values } };
+ *     rf_csv_advance_row(&csv); // Skip the header
+ *     rf_csv_extract_result batch;
+ *     while ((batch = rf_csv_extract_columns(&csv, columns, 3, 1024, bad_cells, 64)).rows) { ... }
+ *
+ * For random access into files that are opened again and again, rf_csv_build_row_index keeps the offset of every Nth row.
+ * Saving it next to the csv lets later opens jump to any row without scanning the file again:
+ *     rf_csv_row_index index = rf_csv_load_row_index(rf_mmap_io, "log.csv", src, allocator, temp_allocator);
+ *     if (!index.valid)
+ *     {
+ *         index = rf_csv_build_row_index(src, 1024, scheduler, allocator);
+ *         rf_csv_save_row_index(&index, rf_mmap_io, "log.csv", temp_allocator);
+ *     }
+ *     rf_csv_iter csv = rf_csv_row_index_make_iter(&index, src, ',', row);
+ */
+
+#define RF_CSV_BLOCK_SIZE (64)
+
+#ifndef RF_CSV_ROW_INDEX_EXTENSION
+    #define RF_CSV_ROW_INDEX_EXTENSION ".rfidx" // Appended to the name of the csv to get the name of its saved row index
+#endif
+
+#ifndef RF_CSV_CHUNK_SIZE
+    #define RF_CSV_CHUNK_SIZE (1024 * 1024) // Bytes per job when indexing rows in parallel, rounded to a multiple of RF_CSV_BLOCK_SIZE
+#endif
+
+#ifndef RF_CSV_ROW_INDEX_FINGERPRINT_SIZE
+    #define RF_CSV_ROW_INDEX_FINGERPRINT_SIZE (4096) // Bytes hashed at each end of the csv to tell if a saved row index is stale
+#endif
+
+typedef struct rf_csv_element
+{
+    rf_str  str;    // Without the surrounding quotes, quotes inside are still doubled, see rf_csv_unescape_to_buffer
+    rf_bool quoted;
+} rf_csv_element;
 
 typedef struct rf_csv_iter
 {
-    rf_str src;
-    rf_str row_separator;
-    rf_str col_separator;
-    rf_bool valid;
+    rf_str   src;
+    char     separator;
+    rf_int   position;      // Start of the next element
+    rf_int   row;           // Index of the current row, -1 before the first call to rf_csv_advance_row
+    rf_bool  in_row;        // False once the last element of the current row was returned
+    rf_bool  valid;
+
+    rf_int   block_begin;   // Offset of the block the masks below are for
+    uint64_t boundaries;    // Separators and line breaks outside of quotes in the block that weren't consumed yet
+    uint64_t inside_quotes; // All ones if the block ends inside quotes
 } rf_csv_iter;
 
-rf_int rf_csv_col_count_ex(rf_str src, rf_str separator)
+typedef struct rf_csv_rows
 {
-    rf_int result = 0;
+    rf_str         src;
+    rf_arr(rf_int) offsets; // Offset of the first byte of each row in row order
+    rf_bool        valid;
+} rf_csv_rows;
 
-    while (rf_str_valid(src))
-    {
-        rf_str_pop_first_split(&src, separator);
-        result++;
-    }
+typedef struct rf_csv_row_index
+{
+    rf_arr(rf_int) samples;     // samples[i] is the offset of row i * sample_rate
+    rf_int         sample_rate;
+    rf_int         rows_count;
+    rf_int         src_size;    // Size of the csv the index was built for, a csv of another size makes the index stale
+    uint64_t       fingerprint; // Hash of both ends of the csv, see RF_CSV_ROW_INDEX_FINGERPRINT_SIZE
+    rf_bool        valid;
+} rf_csv_row_index;
 
-    return result;
-}
+typedef enum rf_csv_column_type
+{
+    rf_csv_column_skip = 0, // Never bad
+    rf_csv_column_int,    // rf_int, 0 for bad cells, values out of range are bad
+    rf_csv_column_float,  // float, NaN for bad cells
+    rf_csv_column_double, // double, NaN for bad cells
+    rf_csv_column_str,    // rf_str into the source like rf_csv_element.str, only bad and empty if the cell is missing
+} rf_csv_column_type;
 
-rf_int rf_csv_col_count(rf_str csv)
+typedef struct rf_csv_column
 {
-    rf_int result = rf_csv_col_count_ex(csv, rf_cstr(","));
-    return result;
-}
+    rf_csv_column_type type;
+    void*              dst; // Room for max_rows values of the column type
+} rf_csv_column;
 
-rf_csv_iter rf_csv_make_iter_ex(rf_str csv)
+typedef struct rf_csv_cell
 {
-    rf_csv_iter iter = {0};
-    return iter;
-}
+    rf_int row; // As counted by the iterator
+    rf_int col;
+} rf_csv_cell;
 
-void test()
+typedef struct rf_csv_extract_result
 {
-    rf_str csv_str = rf_cstr("...");
+    rf_int rows;      // Rows written to every column
+    rf_int bad_cells; // Missing cells and cells that didn't parse, only the first ones are written if there are more than fit
+} rf_csv_extract_result;
+
+rf_public rf_csv_iter rf_csv_make_iter(rf_str src); // Separated by commas
+rf_public rf_csv_iter rf_csv_make_iter_ex(rf_str src, char separator);
+rf_public rf_bool rf_csv_advance_row(rf_csv_iter* iter); // Moves to the next row skipping what is left of the current one, returns false at the end of the input
+rf_public rf_bool rf_csv_next_col_element(rf_csv_iter* iter, rf_csv_element* element); // Returns false at the end of the row
+
+rf_public rf_int rf_csv_unescape_to_buffer(rf_str element, char* dst, rf_int dst_size); // Collapses doubled quotes, returns the size written which is at most element.size
+rf_public rf_int rf_csv_col_count(rf_str csv); // Number of elements in the first row
+rf_public rf_int rf_csv_col_count_ex(rf_str csv, char separator);
+
+rf_public rf_csv_extract_result rf_csv_extract_columns(rf_csv_iter* iter, const rf_csv_column* columns, rf_int columns_count, rf_int max_rows, rf_csv_cell* bad_cells, rf_int bad_cells_size); // Reads up to max_rows rows after the current one, elements past the last column are ignored
+
+rf_public rf_csv_rows rf_csv_index_rows(rf_str src, rf_allocator allocator); // Same as the parallel version on the calling thread
+rf_public rf_csv_rows rf_csv_index_rows_parallel(rf_str src, rf_job_scheduler scheduler, rf_allocator allocator); // The allocator is only used from the calling thread
+rf_public void rf_csv_rows_free(rf_csv_rows* rows);
+rf_public rf_int rf_csv_rows_count(const rf_csv_rows* rows);
+rf_public rf_str rf_csv_rows_get(const rf_csv_rows* rows, rf_int row); // The row without its line break
+rf_public rf_str rf_csv_rows_get_range(const rf_csv_rows* rows, rf_int begin, rf_int end); // Rows [begin, end) with the line breaks between them
 
-    for (rf_csv_iter csv = rf_csv_make_iter(csv); rf_csv_valid(&csv); rf_csv_advance_row(&csv))
-    {
-        for (rf_str element = rf_csv_next_col_element(csv); rf_csv_col_valid(&csv); rf_csv_next_element())
-        {
-        }
-    }
-}
+rf_public rf_csv_row_index rf_csv_build_row_index(rf_str src, rf_int sample_rate, rf_job_scheduler scheduler, rf_allocator allocator); // Scans like rf_csv_index_rows_parallel but only keeps every sample_rate-th row
+rf_public void rf_csv_row_index_free(rf_csv_row_index* index);
+rf_public rf_csv_iter rf_csv_row_index_make_iter(const rf_csv_row_index* index, rf_str src, char separator, rf_int row); // The next rf_csv_advance_row moves to the row after skipping less than sample_rate rows, iter.position is relative to the sample before it. Invalid if the sample doesn't start a line
+rf_public rf_bool rf_csv_row_index_matches(const rf_csv_row_index* index, rf_str src); // Checks the size, the fingerprint and that every sample starts a line
+rf_public rf_int rf_csv_row_index_to_buffer(const rf_csv_row_index* index, void* dst, rf_int dst_size); // Returns the size needed, nothing is written if dst_size is smaller
+rf_public rf_csv_row_index rf_csv_row_index_from_buffer(const void* src, rf_int src_size, rf_allocator allocator);
+rf_public rf_bool rf_csv_save_row_index(const rf_csv_row_index* index, rf_io_callbacks io, const char* csv_filename, rf_allocator temp_allocator); // Writes csv_filename followed by RF_CSV_ROW_INDEX_EXTENSION, needs io.write_file_proc
+rf_public rf_csv_row_index rf_csv_load_row_index(rf_io_callbacks io, const char* csv_filename, rf_str src, rf_allocator allocator, rf_allocator temp_allocator); // Invalid if there is no saved index or rf_csv_row_index_matches fails for src
 
-#endif // RAYFORK_CSV_H
\ No newline at end of file
+#endif // RAYFORK_CSV_H
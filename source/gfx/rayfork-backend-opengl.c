@@ -1645,7 +1645,7 @@ rf_public void rf_gfx_translatef(float x, float y, float z)
     rf_mat mat_translation = rf_mat_translate(x, y, z);
 
     // NOTE: We transpose matrix with multiplication order
-    *rf_ctx.current_matrix = rf_mat_mul(mat_translation, *rf_ctx.current_matrix);
+    rf_mat_mul_ptr(&mat_translation, rf_ctx.current_matrix, rf_ctx.current_matrix);
 }
 
 // Multiply the current matrix by a rotation matrix
@@ -1657,7 +1657,7 @@ rf_public void rf_gfx_rotatef(float angleDeg, float x, float y, float z)
     mat_rotation = rf_mat_rotate(rf_vec3_normalize(axis), angleDeg * rf_deg2rad);
 
     // NOTE: We transpose matrix with multiplication order
-    *rf_ctx.current_matrix = rf_mat_mul(mat_rotation, *rf_ctx.current_matrix);
+    rf_mat_mul_ptr(&mat_rotation, rf_ctx.current_matrix, rf_ctx.current_matrix);
 }
 
 // Multiply the current matrix by a scaling matrix
@@ -1666,7 +1666,7 @@ rf_public void rf_gfx_scalef(float x, float y, float z)
     rf_mat mat_scale = rf_mat_scale(x, y, z);
 
     // NOTE: We transpose matrix with multiplication order
-    *rf_ctx.current_matrix = rf_mat_mul(mat_scale, *rf_ctx.current_matrix);
+    rf_mat_mul_ptr(&mat_scale, rf_ctx.current_matrix, rf_ctx.current_matrix);
 }
 
 // Multiply the current matrix by another matrix
@@ -1678,7 +1678,7 @@ rf_public void rf_gfx_mult_matrixf(float* matf)
                   matf[2], matf[6], matf[10], matf[14],
                   matf[3], matf[7], matf[11], matf[15] };
 
-    *rf_ctx.current_matrix = rf_mat_mul(*rf_ctx.current_matrix, mat);
+    rf_mat_mul_ptr(rf_ctx.current_matrix, &mat, rf_ctx.current_matrix);
 }
 
 // Multiply the current matrix by a perspective matrix generated by parameters
@@ -1686,7 +1686,7 @@ rf_public void rf_gfx_frustum(double left, double right, double bottom, double t
 {
     rf_mat mat_perps = rf_mat_frustum(left, right, bottom, top, znear, zfar);
 
-    *rf_ctx.current_matrix = rf_mat_mul(*rf_ctx.current_matrix, mat_perps);
+    rf_mat_mul_ptr(rf_ctx.current_matrix, &mat_perps, rf_ctx.current_matrix);
 }
 
 // Multiply the current matrix by an orthographic matrix generated by parameters
@@ -1694,7 +1694,7 @@ rf_public void rf_gfx_ortho(double left, double right, double bottom, double top
 {
     rf_mat mat_ortho = rf_mat_ortho(left, right, bottom, top, znear, zfar);
 
-    *rf_ctx.current_matrix = rf_mat_mul(*rf_ctx.current_matrix, mat_ortho);
+    rf_mat_mul_ptr(rf_ctx.current_matrix, &mat_ortho, rf_ctx.current_matrix);
 }
 
 // Set the viewport area (transformation from normalized device coordinates to window coordinates)
@@ -1706,6 +1706,8 @@ void rf_gfx_viewport(int x, int y, int width, int height)
 // Initialize drawing mode (how to organize vertex)
 rf_public void rf_gfx_begin(rf_drawing_mode mode)
 {
+    rf_profile_zone_begin("rf_gfx_begin");
+
     // Draw mode can be GL_LINES, GL_TRIANGLES and GL_QUADS
     // NOTE: In all three cases, vertex are accumulated over default internal vertex buffer
     if (rf_batch.draw_calls[rf_batch.draw_calls_counter - 1].mode != mode)
@@ -1739,11 +1741,15 @@ rf_public void rf_gfx_begin(rf_drawing_mode mode)
         rf_batch.draw_calls[rf_batch.draw_calls_counter - 1].vertex_count = 0;
         rf_batch.draw_calls[rf_batch.draw_calls_counter - 1].texture_id = rf_ctx.default_texture_id;
     }
+
+    rf_profile_zone_end();
 }
 
 // Finish vertex providing
 rf_public void rf_gfx_end()
 {
+    rf_profile_zone_begin("rf_gfx_end");
+
     // Make sure vertex_count is the same for vertices, texcoords, colors and normals
     // NOTE: In OpenGL 1.1, one glColor call can be made for all the subsequent glVertex calls
 
@@ -1792,6 +1798,8 @@ rf_public void rf_gfx_end()
         for (rf_int i = rf_ctx.stack_counter; i >= 0; i--) rf_gfx_pop_matrix();
         rf_gfx_draw();
     }
+
+    rf_profile_zone_end();
 }
 
 // Define one vertex (position)
@@ -1813,7 +1821,7 @@ rf_public void rf_gfx_vertex3f(float x, float y, float z)
     rf_vec3 vec = {x, y, z };
 
     // rf_transform provided vector if required
-    if (rf_ctx.transform_matrix_required) vec = rf_vec3_transform(vec, rf_ctx.transform);
+    if (rf_ctx.transform_matrix_required) vec = rf_vec3_transform_ptr(vec, &rf_ctx.transform);
 
     // Verify that rf_max_batch_elements limit not reached
     if (rf_batch.vertex_buffers[rf_batch.current_buffer].v_counter < (rf_batch.vertex_buffers[rf_batch.current_buffer].elements_count * 4))
@@ -2260,6 +2268,8 @@ rf_public void rf_gfx_close()
 // Update and draw internal buffers
 rf_public void rf_gfx_draw()
 {
+    rf_profile_zone_begin("rf_gfx_draw");
+
     // Only process data if we have data to process
     if (rf_batch.vertex_buffers[rf_batch.current_buffer].v_counter > 0)
     {
@@ -2319,7 +2329,8 @@ rf_public void rf_gfx_draw()
                 rf_gl.UseProgram(rf_ctx.current_shader.id);
 
                 // Create rf_ctx->gl_ctx.modelview-rf_ctx->gl_ctx.projection matrix
-                rf_mat mat_mvp = rf_mat_mul(rf_ctx.modelview, rf_ctx.projection);
+                rf_mat mat_mvp;
+                rf_mat_mul_ptr(&rf_ctx.modelview, &rf_ctx.projection, &mat_mvp);
 
                 rf_gl.UniformMatrix4fv(rf_ctx.current_shader.locs[RF_LOC_MATRIX_MVP], 1, 0, rf_mat_to_float16(mat_mvp).v);
                 rf_gl.Uniform4f(rf_ctx.current_shader.locs[RF_LOC_COLOR_DIFFUSE], 1.0f, 1.0f, 1.0f, 1.0f);
@@ -2397,6 +2408,8 @@ rf_public void rf_gfx_draw()
             if (rf_batch.current_buffer >= RF_DEFAULT_BATCH_VERTEX_BUFFERS_COUNT) rf_batch.current_buffer = 0;
         }
     }
+
+    rf_profile_zone_end();
 }
 
 // Check internal buffer overflow for a given number of vertex
@@ -3230,7 +3243,9 @@ rf_public void rf_gfx_draw_mesh(rf_mesh mesh, rf_material material, rf_mat trans
     //for (rf_int i = rf_ctx->gl_ctx.stack_counter; i > 0; i--) matStackTransform = rf_mat_mul(rf_ctx->gl_ctx.stack[i], matStackTransform);
 
     // rf_transform to camera-space coordinates
-    rf_mat mat_model_view = rf_mat_mul(transform, rf_mat_mul(rf_ctx.transform, mat_view));
+    rf_mat mat_model_view;
+    rf_mat_mul_ptr(&rf_ctx.transform, &mat_view, &mat_model_view);
+    rf_mat_mul_ptr(&transform, &mat_model_view, &mat_model_view);
     //-----------------------------------------------------
 
     // Bind active texture maps (if available)
@@ -3252,7 +3267,8 @@ rf_public void rf_gfx_draw_mesh(rf_mesh mesh, rf_material material, rf_mat trans
     rf_ctx.modelview = mat_model_view;
 
     // Calculate model-view-rf_ctx->gl_ctx.projection matrix (MVP)
-    rf_mat mat_mvp = rf_mat_mul(rf_ctx.modelview, rf_ctx.projection); // rf_transform to screen-space coordinates
+    rf_mat mat_mvp;
+    rf_mat_mul_ptr(&rf_ctx.modelview, &rf_ctx.projection, &mat_mvp); // rf_transform to screen-space coordinates
 
     // Send combined model-view-rf_ctx->gl_ctx.projection matrix to shader
     rf_gl.UniformMatrix4fv(material.shader.locs[RF_LOC_MATRIX_MVP], 1, 0, rf_mat_to_float16(mat_mvp).v);
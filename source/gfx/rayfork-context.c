@@ -260,6 +260,32 @@ rf_public rf_image rf_get_screen_data(rf_color* dst, rf_int dst_size)
     return image;
 }
 
+// Get an allocator whose memory is released at rf_end()
+rf_public rf_allocator rf_get_frame_allocator()
+{
+    return rf_arena_allocator(&rf_ctx.frame_arena);
+}
+
+// Get an allocator whose memory stays valid until the rf_end() of the next frame
+rf_public rf_allocator rf_get_double_buffered_frame_allocator()
+{
+    return rf_arena_allocator(&rf_ctx.double_buffered_frame_arenas[rf_ctx.double_buffered_frame_arena_index]);
+}
+
+// Get the current usage and high water marks of the frame allocators, useful to size the frame memory for the worst frame
+rf_public rf_frame_allocator_stats rf_get_frame_allocator_stats()
+{
+    rf_arena* current = &rf_ctx.double_buffered_frame_arenas[rf_ctx.double_buffered_frame_arena_index];
+
+    rf_frame_allocator_stats result = {0};
+    result.frame_used                      = rf_ctx.frame_arena.used;
+    result.frame_high_water_mark           = rf_ctx.frame_arena.high_water_mark;
+    result.double_buffered_used            = current->used;
+    result.double_buffered_high_water_mark = rf_max_i(rf_ctx.double_buffered_frame_arenas[0].high_water_mark, rf_ctx.double_buffered_frame_arenas[1].high_water_mark);
+
+    return result;
+}
+
 rf_public rf_log_type rf_get_current_log_filter()
 {
     return rf_ctx.logger_filter;
@@ -276,6 +302,17 @@ rf_public void rf_set_shapes_texture(rf_texture2d texture, rf_rec source)
     rf_ctx.rec_tex_shapes = source;
 }
 
+// Provide the memory used by the frame allocators, the double buffered memory is split in two halves
+rf_public void rf_set_frame_allocator_memory(void* frame_memory, rf_int frame_memory_size, void* double_buffered_memory, rf_int double_buffered_memory_size)
+{
+    rf_int half_size = double_buffered_memory_size / 2;
+
+    rf_ctx.frame_arena = rf_arena_make(frame_memory, frame_memory_size);
+    rf_ctx.double_buffered_frame_arenas[0] = rf_arena_make(double_buffered_memory, half_size);
+    rf_ctx.double_buffered_frame_arenas[1] = rf_arena_make(double_buffered_memory ? (char*)double_buffered_memory + half_size : 0, half_size);
+    rf_ctx.double_buffered_frame_arena_index = 0;
+}
+
 // Set the global context pointer
 rf_public void rf_set_global_gfx_context_pointer(rf_gfx_context* ctx)
 {
@@ -53,8 +53,20 @@ typedef struct rf_gfx_context
 
     rf_logger   logger;
     rf_log_type logger_filter;
+
+    rf_arena frame_arena;                       // Scratch memory reset at every rf_end()
+    rf_arena double_buffered_frame_arenas[2];   // Scratch memory that stays valid until the rf_end() of the next frame
+    int      double_buffered_frame_arena_index; // Index of the double buffered arena used in the current frame
 } rf_gfx_context;
 
+typedef struct rf_frame_allocator_stats
+{
+    rf_int frame_used;
+    rf_int frame_high_water_mark;
+    rf_int double_buffered_used;
+    rf_int double_buffered_high_water_mark;
+} rf_frame_allocator_stats;
+
 rf_public void rf_gfx_init(rf_gfx_context* ctx, int screen_width, int screen_height, rf_gfx_backend_data* gfx_data);
 
 rf_public rf_material rf_load_default_material(rf_allocator allocator); // Load default material (Supports: DIFFUSE, SPECULAR, NORMAL maps)
@@ -67,8 +79,13 @@ rf_public rf_texture2d     rf_get_default_texture();                           /
 rf_public rf_gfx_context*  rf_get_gfx_context();                               // Get the context pointer
 rf_public rf_image         rf_get_screen_data(rf_color* dst, rf_int dst_size); // Get pixel data from GPU frontbuffer and return an rf_image (screenshot)
 
+rf_public rf_allocator             rf_get_frame_allocator();                 // Get an allocator whose memory is released at rf_end()
+rf_public rf_allocator             rf_get_double_buffered_frame_allocator(); // Get an allocator whose memory stays valid until the rf_end() of the next frame
+rf_public rf_frame_allocator_stats rf_get_frame_allocator_stats();           // Get the current usage and high water marks of the frame allocators
+
 rf_public void rf_set_global_gfx_context_pointer(rf_gfx_context* ctx);     // Set the global context pointer
 rf_public void rf_set_viewport(int width, int height);                     // Set viewport for a provided width and height
 rf_public void rf_set_shapes_texture(rf_texture2d texture, rf_rec source); // Define default texture used to draw shapes
+rf_public void rf_set_frame_allocator_memory(void* frame_memory, rf_int frame_memory_size, void* double_buffered_memory, rf_int double_buffered_memory_size); // Provide the memory used by the frame allocators, the double buffered memory is split in two halves
 
 #endif // RAYFORK_CONTEXT_H
\ No newline at end of file
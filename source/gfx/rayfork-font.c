@@ -115,6 +115,8 @@ rf_public int rf_compute_ttf_font_atlas_width(int padding, rf_glyph_info* glyph_
 
 rf_public rf_image rf_generate_ttf_font_atlas(rf_ttf_font_info* font_info, int atlas_width, int padding, rf_glyph_info* glyphs, rf_int glyphs_count, rf_font_antialias antialias, unsigned short* dst, rf_int dst_count, rf_allocator temp_allocator)
 {
+    rf_profile_zone_begin("rf_generate_ttf_font_atlas");
+
     rf_image result = {0};
 
     if (font_info && font_info->valid)
@@ -202,6 +204,7 @@ rf_public rf_image rf_generate_ttf_font_atlas(rf_ttf_font_info* font_info, int a
         }
     }
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -261,18 +264,17 @@ rf_public rf_font rf_load_ttf_font_from_file(const char* filename, int font_size
 
     if (rf_is_file_extension(filename, ".ttf") || rf_is_file_extension(filename, ".otf"))
     {
-        int file_size = rf_file_size(io, filename);
-        void* data = rf_alloc(temp_allocator, file_size);
+        rf_file_view file = rf_view_file(io, filename, temp_allocator);
 
-        if (rf_read_file(io, filename, data, file_size))
+        if (file.valid)
         {
-            font = rf_load_ttf_font_from_data(data, RF_DEFAULT_FONT_SIZE, antialias, (int[]) RF_BUILTIN_FONT_CHARS, RF_BUILTIN_CODEPOINTS_COUNT, allocator, temp_allocator);
+            font = rf_load_ttf_font_from_data(file.data, RF_DEFAULT_FONT_SIZE, antialias, (int[]) RF_BUILTIN_FONT_CHARS, RF_BUILTIN_CODEPOINTS_COUNT, allocator, temp_allocator);
 
             // By default we set point filter (best performance)
             rf_set_texture_filter(font.texture, RF_FILTER_POINT);
-        }
 
-        rf_free(temp_allocator, data);
+            rf_release_file_view(io, file, temp_allocator);
+        }
     }
 
     return font;
@@ -433,12 +435,21 @@ rf_public rf_glyph_index rf_get_glyph_index(rf_font font, int character)
 {
     rf_glyph_index result = RF_GLYPH_NOT_FOUND;
 
-    for (rf_int i = 0; i < font.glyphs_count; i++)
+    // Glyphs are usually a contiguous codepoint range, in which case the index is just the offset from the first one
+    rf_int offset = font.glyphs_count > 0 ? (rf_int) character - font.glyphs[0].codepoint : rf_invalid_index;
+    if (offset >= 0 && offset < font.glyphs_count && font.glyphs[offset].codepoint == character)
     {
-        if (font.glyphs[i].codepoint == character)
+        result = (rf_glyph_index) offset;
+    }
+    else
+    {
+        for (rf_int i = 0; i < font.glyphs_count; i++)
         {
-            result = i;
-            break;
+            if (font.glyphs[i].codepoint == character)
+            {
+                result = i;
+                break;
+            }
         }
     }
 
@@ -54,6 +54,11 @@ rf_public void rf_begin()
 rf_public void rf_end()
 {
     rf_gfx_draw();
+
+    // Release this frame's scratch memory and switch to the double buffered arena used two frames ago
+    rf_arena_reset(&rf_ctx.frame_arena);
+    rf_ctx.double_buffered_frame_arena_index = !rf_ctx.double_buffered_frame_arena_index;
+    rf_arena_reset(&rf_ctx.double_buffered_frame_arenas[rf_ctx.double_buffered_frame_arena_index]);
 }
 
 // Initialize 2D mode with custom camera (2D)
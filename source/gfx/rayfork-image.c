@@ -130,8 +130,10 @@ rf_public rf_vec4* rf_image_compute_pixels_to_normalized(rf_image image, rf_allo
 }
 
 // Extract color palette from image to maximum size
-rf_public void rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size)
+rf_public rf_int rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator)
 {
+    rf_int palette_iter = 0;
+
     if (rf_is_uncompressed_format(image.format))
     {
         if (palette_size > 0)
@@ -140,44 +142,48 @@ rf_public void rf_image_extract_palette_to_buffer(rf_image image, rf_color* pale
             int img_bpp  = rf_bytes_per_pixel(image.format);
             const unsigned char* img_data = (unsigned char*) image.data;
 
-            for (rf_int img_iter = 0, palette_iter = 0; img_iter < img_size && palette_iter < palette_size; img_iter += img_bpp)
+            // Set of the colors found so far so each pixel is checked in constant time instead of against the whole palette
+            rf_hashmap colors_found = rf_hashmap_make(rf_hashmap_key_u64, 0, palette_size, temp_allocator);
+
+            for (rf_int img_iter = 0; img_iter < img_size && palette_iter < palette_size; img_iter += img_bpp)
             {
-                rf_color color = rf_format_one_pixel_to_rgba32(img_data, image.format);
+                rf_color color = rf_format_one_pixel_to_rgba32(img_data + img_iter, image.format);
 
-                rf_bool color_found = 0;
+                uint32_t color_key;
+                memcpy(&color_key, &color, sizeof(color_key));
 
-                for (rf_int i = 0; i < palette_iter; i++)
+                if (!rf_hashmap_get_u64(&colors_found, color_key))
                 {
-                    if (rf_color_match(palette_dst[i], color))
-                    {
-                        color_found = 1;
-                        break;
-                    }
-                }
+                    if (!rf_hashmap_put_u64(&colors_found, color_key, 0)) break;
 
-                if (!color_found)
-                {
                     palette_dst[palette_iter] = color;
                     palette_iter++;
                 }
             }
+
+            rf_hashmap_free(&colors_found);
         }
         else rf_log(rf_log_type_warning, "Palette size was 0.");
     }
     else rf_log_error(rf_bad_argument, "Function only works for uncompressed formats but was called with format %d.", image.format);
+
+    return palette_iter;
 }
 
-rf_public rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator)
+rf_public rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator)
 {
     rf_palette result = {0};
 
     if (rf_is_uncompressed_format(image.format))
     {
         rf_color* dst = rf_alloc(allocator, sizeof(rf_color) * palette_size);
-        rf_image_extract_palette_to_buffer(image, dst, palette_size);
 
-        result.colors = dst;
-        result.count = palette_size;
+        if (dst)
+        {
+            result.colors = dst;
+            result.count = rf_image_extract_palette_to_buffer(image, dst, palette_size, temp_allocator);
+        }
+        else rf_log_error(rf_bad_alloc, "Allocation of size %d failed.", (int) (sizeof(rf_color) * palette_size));
     }
 
     return result;
@@ -283,24 +289,11 @@ rf_public rf_image rf_load_image_from_file_data_to_buffer(const void* src, rf_in
     return result;
 }
 
-rf_public rf_image rf_load_image_from_file_data(const void* src, rf_int src_size, rf_desired_channels desired_channels, rf_allocator allocator, rf_allocator temp_allocator)
+// Copies the image decoded by stbi into a buffer allocated with `allocator` and frees the stbi result
+rf_internal rf_image rf__image_from_stbi_result(void* stbi_result, int width, int height, int channels, rf_allocator allocator, rf_allocator temp_allocator)
 {
-    // Preconditions
-    if (!src || src_size <= 0)
-    {
-        rf_log_error(rf_bad_argument, "Argument `src` was null.");
-        return (rf_image) {0};
-    }
-
-    // Compute the result
     rf_image result = {0};
 
-    // Use stb image with the `temp_allocator` to decompress the image and get it's data
-    int width = 0, height = 0, channels = 0;
-    rf_set_global_dependencies_allocator(temp_allocator);
-    void* stbi_result = stbi_load_from_memory(src, src_size, &width, &height, &channels, desired_channels);
-    rf_set_global_dependencies_allocator((rf_allocator) {0});
-
     if (stbi_result && channels)
     {
         // Allocate a result buffer using the `allocator` and copy the data to it
@@ -336,6 +329,32 @@ rf_public rf_image rf_load_image_from_file_data(const void* src, rf_int src_size
     return result;
 }
 
+rf_public rf_image rf_load_image_from_file_data(const void* src, rf_int src_size, rf_desired_channels desired_channels, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    // Preconditions
+    if (!src || src_size <= 0)
+    {
+        rf_log_error(rf_bad_argument, "Argument `src` was null.");
+        return (rf_image) {0};
+    }
+
+    rf_profile_zone_begin("rf_load_image_from_file_data");
+
+    // Compute the result
+    rf_image result = {0};
+
+    // Use stb image with the `temp_allocator` to decompress the image and get it's data
+    int width = 0, height = 0, channels = 0;
+    rf_set_global_dependencies_allocator(temp_allocator);
+    void* stbi_result = stbi_load_from_memory(src, src_size, &width, &height, &channels, desired_channels);
+    rf_set_global_dependencies_allocator((rf_allocator) {0});
+
+    result = rf__image_from_stbi_result(stbi_result, width, height, channels, allocator, temp_allocator);
+
+    rf_profile_zone_end();
+    return result;
+}
+
 rf_public rf_image rf_load_image_from_hdr_file_data_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size, rf_desired_channels channels, rf_allocator temp_allocator)
 {
     rf_image result = {0};
@@ -379,6 +398,8 @@ rf_public rf_image rf_load_image_from_hdr_file_data_to_buffer(const void* src, r
 
 rf_public rf_image rf_load_image_from_hdr_file_data(const void* src, rf_int src_size, rf_allocator allocator, rf_allocator temp_allocator)
 {
+    rf_profile_zone_begin("rf_load_image_from_hdr_file_data");
+
     rf_image result = {0};
 
     if (src && src_size)
@@ -416,6 +437,7 @@ rf_public rf_image rf_load_image_from_hdr_file_data(const void* src, rf_int src_
     }
     else rf_log_error(rf_bad_argument, "Argument `image` was invalid.");
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -439,41 +461,93 @@ rf_public rf_image rf_load_image_from_format_to_buffer(const void* src, rf_int s
     return result;
 }
 
+#pragma region stbi stream callbacks
+typedef struct rf__stbi_stream
+{
+    rf_io_callbacks io;
+    void*           handle;
+    rf_bool         eof;
+} rf__stbi_stream;
+
+rf_internal int rf__stbi_stream_read(void* user, char* data, int size)
+{
+    rf__stbi_stream* stream = user;
+    rf_int read = rf_read_stream(stream->io, stream->handle, data, size);
+    if (read < size) stream->eof = 1;
+    return (int) read;
+}
+
+rf_internal void rf__stbi_stream_skip(void* user, int n)
+{
+    rf__stbi_stream* stream = user;
+    rf_seek_stream(stream->io, stream->handle, n, rf_io_seek_current);
+}
+
+rf_internal int rf__stbi_stream_eof(void* user)
+{
+    rf__stbi_stream* stream = user;
+    return stream->eof;
+}
+
+rf_internal rf_image rf__load_image_from_stream(rf__stbi_stream* stream, rf_allocator allocator, rf_allocator temp_allocator)
+{
+    stbi_io_callbacks callbacks = { rf__stbi_stream_read, rf__stbi_stream_skip, rf__stbi_stream_eof };
+    int width = 0, height = 0, channels = 0;
+
+    rf_set_global_dependencies_allocator(temp_allocator);
+    void* stbi_result = stbi_load_from_callbacks(&callbacks, stream, &width, &height, &channels, RF_ANY_CHANNELS);
+    rf_set_global_dependencies_allocator((rf_allocator) {0});
+
+    rf_image result = rf__image_from_stbi_result(stbi_result, width, height, channels, allocator, temp_allocator);
+    return result;
+}
+#pragma endregion
+
 rf_public rf_image rf_load_image_from_file(const char* filename, rf_allocator allocator, rf_allocator temp_allocator, rf_io_callbacks io)
 {
+    rf_profile_zone_begin("rf_load_image_from_file");
+
     rf_image image = {0};
 
     if (rf_supports_image_file_type(filename))
     {
-        int file_size = rf_file_size(io, filename);
+        rf_bool is_hdr = rf_is_file_extension(filename, ".hdr");
 
-        if (file_size > 0)
+        // Prefer decoding straight from the stream when the io supports it and the file can't be mapped,
+        // this way we only hold the decoder's working set in memory instead of the whole file
+        if (!is_hdr && !io.map_file_proc && rf_io_supports_streams(io))
+        {
+            rf__stbi_stream stream = { io, rf_open_stream(io, filename), 0 };
+
+            if (stream.handle)
+            {
+                image = rf__load_image_from_stream(&stream, allocator, temp_allocator);
+                rf_close_stream(io, stream.handle);
+            }
+            else rf_log_error(rf_bad_io, "Failed to open file %s", filename);
+        }
+        else
         {
-            unsigned char* image_file_buffer = rf_alloc(temp_allocator, file_size);
+            rf_file_view file = rf_view_file(io, filename, temp_allocator);
 
-            if (image_file_buffer)
+            if (file.valid)
             {
-                if (rf_read_file(io, filename, image_file_buffer, file_size))
+                if (is_hdr)
                 {
-                    if (rf_is_file_extension(filename, ".hdr"))
-                    {
-                        image = rf_load_image_from_hdr_file_data(image_file_buffer, file_size, allocator, temp_allocator);
-                    }
-                    else
-                    {
-                        image = rf_load_image_from_file_data(image_file_buffer, file_size, RF_ANY_CHANNELS, allocator, temp_allocator);
-                    }
+                    image = rf_load_image_from_hdr_file_data(file.data, file.size, allocator, temp_allocator);
+                }
+                else
+                {
+                    image = rf_load_image_from_file_data(file.data, file.size, RF_ANY_CHANNELS, allocator, temp_allocator);
                 }
-                else rf_log_error(rf_bad_io, "File size for %s is 0", filename);
 
-                rf_free(temp_allocator, image_file_buffer);
+                rf_release_file_view(io, file, temp_allocator);
             }
-            else rf_log_error(rf_bad_alloc, "Temporary allocation of size %d failed", file_size);
         }
-        else rf_log_error(rf_bad_io, "File size for %s is 0", filename);
     }
     else rf_log_error(rf_unsupported, "Image fileformat not supported", filename);
 
+    rf_profile_zone_end();
     return image;
 }
 
@@ -701,7 +775,7 @@ rf_public rf_image rf_image_resize_to_buffer(rf_image image, int new_width, int
             result.format = image.format;
             result.valid  = 1;
         }
-        else rf_log_error(rf_bad_alloc, "Allocation of size %d failed.", image.width * image.height * sizeof(rf_color));
+        else rf_log_error(rf_bad_alloc, "Allocation of size %d failed.", (int) (image.width * image.height * sizeof(rf_color)));
 
         rf_free(temp_allocator, pixels);
     }
@@ -1791,22 +1865,27 @@ rf_public rf_image rf_gen_image_checked(int width, int height, int checks_x, int
 }
 
 // Generate image: white noise
-rf_public rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float factor, rf_rand_proc rand, rf_color* dst, rf_int dst_size)
+rf_public rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float factor, rf_rand* rng, rf_color* dst, rf_int dst_size)
 {
     int result_image_size = width * height * rf_bytes_per_pixel(rf_pixel_format_r8g8b8a8);
     rf_image result = {0};
 
-    if (dst_size < result_image_size || !rand || result_image_size <= 0) return result;
+    if (dst_size < result_image_size || !rng || result_image_size <= 0) return result;
+
+    // A pixel is white when its random 32 bit value is below factor * 2^32
+    double threshold = (double) factor * 4294967296.0;
+
+    uint32_t random_values[256];
+    rf_int pixel_count = (rf_int) width * height;
 
-    for (rf_int i = 0; i < width * height; i++)
+    for (rf_int i = 0; i < pixel_count; i += 256)
     {
-        if (rand(0, 99) < (int)(factor * 100.0f))
-        {
-            dst[i] = rf_white;
-        }
-        else
+        rf_int batch = pixel_count - i < 256 ? pixel_count - i : 256;
+        rf_rand_fill_u32(rng, random_values, batch);
+
+        for (rf_int j = 0; j < batch; j++)
         {
-            dst[i] = rf_black;
+            dst[i + j] = (double) random_values[j] < threshold ? rf_white : rf_black;
         }
     }
 
@@ -1822,16 +1901,16 @@ rf_public rf_image rf_gen_image_white_noise_to_buffer(int width, int height, flo
     return result;
 }
 
-rf_public rf_image rf_gen_image_white_noise(int width, int height, float factor, rf_rand_proc rand, rf_allocator allocator)
+rf_public rf_image rf_gen_image_white_noise(int width, int height, float factor, rf_rand* rng, rf_allocator allocator)
 {
     rf_image result = {0};
 
     int dst_size = width * height * rf_bytes_per_pixel(rf_pixel_format_r8g8b8a8);
 
-    if (!rand || dst_size <= 0) return result;
+    if (!rng || dst_size <= 0) return result;
 
     rf_color* dst = rf_alloc(allocator, dst_size);
-    result = rf_gen_image_white_noise_to_buffer(width, height, factor, rand, dst, dst_size);
+    result = rf_gen_image_white_noise_to_buffer(width, height, factor, rng, dst, dst_size);
 
     return result;
 }
@@ -1891,25 +1970,33 @@ rf_public rf_image rf_gen_image_perlin_noise(int width, int height, int offset_x
     return result;
 }
 
-rf_public rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, rf_rand_proc rand)
+rf_public rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, uint64_t seed)
 {
     rf_vec2 result = {0};
 
-    int y = (i / seeds_per_row) * tile_size + rand(0, tile_size - 1);
-    int x = (i % seeds_per_row) * tile_size + rand(0, tile_size - 1);
+    // Hash the seed index (splitmix64 finalizer) so a seed can be computed any time without storing all of them
+    uint64_t hash = seed + (uint64_t) i * 0x9E3779B97F4A7C15ull;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    hash = hash ^ (hash >> 31);
+
+    int y = (i / seeds_per_row) * tile_size + (int)(((hash & 0xFFFFFFFFull) * tile_size) >> 32);
+    int x = (i % seeds_per_row) * tile_size + (int)(((hash >> 32) * tile_size) >> 32);
     result = (rf_vec2) { (float) x, (float) y };
 
     return result;
 }
 
 // Generate image: cellular algorithm. Bigger tileSize means bigger cells
-rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand_proc rand, rf_color* dst, rf_int dst_size)
+rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand* rng, rf_color* dst, rf_int dst_size)
 {
     rf_image result = {0};
 
+    if (!rng || tile_size <= 0) return result;
+
     int seeds_per_row = width / tile_size;
     int seeds_per_col = height / tile_size;
-    int seeds_count = seeds_per_row * seeds_per_col;
+    uint64_t seed = rf_rand_next(rng);
 
     if (dst_size >= width * height * rf_bytes_per_pixel(rf_pixel_format_r8g8b8a8))
     {
@@ -1917,13 +2004,12 @@ rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int ti
         {
             int tile_y = y / tile_size;
 
-            for (rf_int x = 0; x < width; x++)
+            for (rf_int tile_x = 0; tile_x * tile_size < width; tile_x++)
             {
-                int tile_x = x / tile_size;
+                // The adjacent seeds are the same for every pixel of the tile on this row
+                rf_vec2 neighbor_seeds[9];
+                int neighbor_count = 0;
 
-                float min_distance = INFINITY;
-
-                // Check all adjacent tiles
                 for (rf_int i = -1; i < 2; i++)
                 {
                     if ((tile_x + i < 0) || (tile_x + i >= seeds_per_row)) continue;
@@ -1932,18 +2018,30 @@ rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int ti
                     {
                         if ((tile_y + j < 0) || (tile_y + j >= seeds_per_col)) continue;
 
-                        rf_vec2 neighbor_seed = rf_get_seed_for_cellular_image(seeds_per_row, tile_size, (tile_y + j) * seeds_per_row + tile_x + i, rand);
-
-                        float dist = (float)hypot(x - (int)neighbor_seed.x, y - (int)neighbor_seed.y);
-                        min_distance = (float)fmin(min_distance, dist);
+                        neighbor_seeds[neighbor_count++] = rf_get_seed_for_cellular_image(seeds_per_row, tile_size, (tile_y + j) * seeds_per_row + tile_x + i, seed);
                     }
                 }
 
-                // I made this up but it seems to give good results at all tile sizes
-                int intensity = (int)(min_distance * 256.0f / tile_size);
-                if (intensity > 255) intensity = 255;
+                rf_int x_end = (tile_x + 1) * tile_size < width ? (tile_x + 1) * tile_size : width;
 
-                dst[y * width + x] = (rf_color) { intensity, intensity, intensity, 255 };
+                for (rf_int x = tile_x * tile_size; x < x_end; x++)
+                {
+                    float min_distance_sqr = INFINITY;
+
+                    for (rf_int i = 0; i < neighbor_count; i++)
+                    {
+                        float dx = (float) x - neighbor_seeds[i].x;
+                        float dy = (float) y - neighbor_seeds[i].y;
+                        float dist_sqr = dx * dx + dy * dy;
+                        if (dist_sqr < min_distance_sqr) min_distance_sqr = dist_sqr;
+                    }
+
+                    // I made this up but it seems to give good results at all tile sizes
+                    int intensity = neighbor_count ? (int)(sqrtf(min_distance_sqr) * 256.0f / tile_size) : 255;
+                    if (intensity > 255) intensity = 255;
+
+                    dst[y * width + x] = (rf_color) { intensity, intensity, intensity, 255 };
+                }
             }
         }
 
@@ -1960,7 +2058,7 @@ rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int ti
     return result;
 }
 
-rf_public rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand_proc rand, rf_allocator allocator)
+rf_public rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand* rng, rf_allocator allocator)
 {
     rf_image result = {0};
 
@@ -1970,7 +2068,7 @@ rf_public rf_image rf_gen_image_cellular(int width, int height, int tile_size, r
 
     if (dst)
     {
-        result = rf_gen_image_cellular_to_buffer(width, height, tile_size, rand, dst, dst_size);
+        result = rf_gen_image_cellular_to_buffer(width, height, tile_size, rng, dst, dst_size);
     }
 
     return result;
@@ -2552,6 +2650,8 @@ rf_public rf_mipmaps_image rf_load_dds_image_to_buffer(const void* src, rf_int s
 
 rf_public rf_mipmaps_image rf_load_dds_image(const void* src, rf_int src_size, rf_allocator allocator)
 {
+    rf_profile_zone_begin("rf_load_dds_image");
+
     rf_mipmaps_image result = {0};
 
     int dst_size = rf_get_dds_image_size(src, src_size);
@@ -2559,6 +2659,7 @@ rf_public rf_mipmaps_image rf_load_dds_image(const void* src, rf_int src_size, r
 
     result = rf_load_dds_image_to_buffer(src, src_size, dst, dst_size);
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -2566,16 +2667,14 @@ rf_public rf_mipmaps_image rf_load_dds_image_from_file(const char* file, rf_allo
 {
     rf_mipmaps_image result = {0};
 
-    int src_size = rf_file_size(io, file);
-    void* src = rf_alloc(temp_allocator, src_size);
+    rf_file_view src = rf_view_file(io, file, temp_allocator);
 
-    if (rf_read_file(io, file, src, src_size))
+    if (src.valid)
     {
-        result = rf_load_dds_image(src, src_size, allocator);
+        result = rf_load_dds_image(src.data, src.size, allocator);
+        rf_release_file_view(io, src, temp_allocator);
     }
 
-    rf_free(temp_allocator, src);
-
     return result;
 }
 #pragma endregion
@@ -2682,6 +2781,8 @@ rf_public rf_image rf_load_pkm_image_to_buffer(const void* src, rf_int src_size,
 
 rf_public rf_image rf_load_pkm_image(const void* src, rf_int src_size, rf_allocator allocator)
 {
+    rf_profile_zone_begin("rf_load_pkm_image");
+
     rf_image result = {0};
 
     if (src && src_size > 0)
@@ -2692,6 +2793,7 @@ rf_public rf_image rf_load_pkm_image(const void* src, rf_int src_size, rf_alloca
         result = rf_load_pkm_image_to_buffer(src, src_size, dst, dst_size);
     }
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -2699,16 +2801,14 @@ rf_public rf_image rf_load_pkm_image_from_file(const char* file, rf_allocator al
 {
     rf_image result = {0};
 
-    int src_size = rf_file_size(io, file);
-    void* src = rf_alloc(temp_allocator, src_size);
+    rf_file_view src = rf_view_file(io, file, temp_allocator);
 
-    if (rf_read_file(io, file, src, src_size))
+    if (src.valid)
     {
-        result = rf_load_pkm_image(src, src_size, allocator);
+        result = rf_load_pkm_image(src.data, src.size, allocator);
+        rf_release_file_view(io, src, temp_allocator);
     }
 
-    rf_free(temp_allocator, src);
-
     return result;
 }
 
@@ -2822,6 +2922,8 @@ rf_public rf_mipmaps_image rf_load_ktx_image_to_buffer(const void* src, rf_int s
 
 rf_public rf_mipmaps_image rf_load_ktx_image(const void* src, rf_int src_size, rf_allocator allocator)
 {
+    rf_profile_zone_begin("rf_load_ktx_image");
+
     rf_mipmaps_image result = {0};
 
     if (src && src_size > 0)
@@ -2832,6 +2934,7 @@ rf_public rf_mipmaps_image rf_load_ktx_image(const void* src, rf_int src_size, r
         result = rf_load_ktx_image_to_buffer(src, src_size, dst, dst_size);
     }
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -2839,16 +2942,14 @@ rf_public rf_mipmaps_image rf_load_ktx_image_from_file(const char* file, rf_allo
 {
     rf_mipmaps_image result = {0};
 
-    int src_size = rf_file_size(io, file);
-    void* src = rf_alloc(temp_allocator, src_size);
+    rf_file_view src = rf_view_file(io, file, temp_allocator);
 
-    if (rf_read_file(io, file, src, src_size))
+    if (src.valid)
     {
-        result = rf_load_ktx_image(src, src_size, allocator);
+        result = rf_load_ktx_image(src.data, src.size, allocator);
+        rf_release_file_view(io, src, temp_allocator);
     }
 
-    rf_free(temp_allocator, src);
-
     return result;
 }
 
@@ -2896,16 +2997,14 @@ rf_public rf_gif rf_load_animated_gif_file(const char* filename, rf_allocator al
 {
     rf_gif result = (rf_gif) {0};
 
-    int file_size = rf_file_size(io, filename);
-    unsigned char* buffer = rf_alloc(temp_allocator, file_size);
+    rf_file_view file = rf_view_file(io, filename, temp_allocator);
 
-    if (rf_read_file(io, filename, buffer, file_size))
+    if (file.valid)
     {
-        result = rf_load_animated_gif(buffer, file_size, allocator, temp_allocator);
+        result = rf_load_animated_gif(file.data, file.size, allocator, temp_allocator);
+        rf_release_file_view(io, file, temp_allocator);
     }
 
-    rf_free(temp_allocator, buffer);
-
     return result;
 }
 
@@ -2960,7 +3059,7 @@ rf_public void rf_unload_gif(rf_gif gif, rf_allocator allocator)
 #pragma region extract image data functions
 rf_public rf_color* rf_image_pixels_to_rgba32_ez(rf_image image) { return rf_image_pixels_to_rgba32(image, rf_default_allocator); }
 rf_public rf_vec4* rf_image_compute_pixels_to_normalized_ez(rf_image image) { return rf_image_compute_pixels_to_normalized(image, rf_default_allocator); }
-rf_public rf_palette rf_image_extract_palette_ez(rf_image image, int palette_size) { return rf_image_extract_palette(image, palette_size, rf_default_allocator); }
+rf_public rf_palette rf_image_extract_palette_ez(rf_image image, int palette_size) { return rf_image_extract_palette(image, palette_size, rf_default_allocator, rf_default_allocator); }
 #pragma endregion
 
 #pragma region loading & unloading functions
@@ -2988,22 +3087,16 @@ rf_public rf_image rf_image_dither_ez(rf_image image, int r_bpp, int g_bpp, int
 rf_public rf_image rf_image_flip_vertical_ez(rf_image image) { return rf_image_flip_vertical(image, rf_default_allocator); }
 rf_public rf_image rf_image_flip_horizontal_ez(rf_image image) { return rf_image_flip_horizontal(image, rf_default_allocator); }
 
-rf_public rf_vec2 rf_get_seed_for_cellular_image_ez(int seeds_per_row, int tile_size, int i) { return rf_get_seed_for_cellular_image(
-        seeds_per_row, tile_size, i, rf_default_rand_proc); }
+rf_public rf_vec2 rf_get_seed_for_cellular_image_ez(int seeds_per_row, int tile_size, int i) { return rf_get_seed_for_cellular_image(seeds_per_row, tile_size, i, RF_DEFAULT_RAND_SEED); }
 
 rf_public rf_image rf_gen_image_color_ez(int width, int height, rf_color color) { return rf_gen_image_color(width, height, color, rf_default_allocator); }
 rf_public rf_image rf_gen_image_gradient_v_ez(int width, int height, rf_color top, rf_color bottom) { return rf_gen_image_gradient_v(width, height, top, bottom, rf_default_allocator); }
 rf_public rf_image rf_gen_image_gradient_h_ez(int width, int height, rf_color left, rf_color right) { return rf_gen_image_gradient_h(width, height, left, right, rf_default_allocator); }
 rf_public rf_image rf_gen_image_gradient_radial_ez(int width, int height, float density, rf_color inner, rf_color outer) { return rf_gen_image_gradient_radial(width, height, density, inner, outer, rf_default_allocator); }
 rf_public rf_image rf_gen_image_checked_ez(int width, int height, int checks_x, int checks_y, rf_color col1, rf_color col2) { return rf_gen_image_checked(width, height, checks_x, checks_y, col1, col2, rf_default_allocator); }
-rf_public rf_image rf_gen_image_white_noise_ez(int width, int height, float factor) { return rf_gen_image_white_noise(
-        width, height, factor, rf_default_rand_proc, rf_default_allocator); }
+rf_public rf_image rf_gen_image_white_noise_ez(int width, int height, float factor) { return rf_gen_image_white_noise(width, height, factor, rf_get_default_rand(), rf_default_allocator); }
 rf_public rf_image rf_gen_image_perlin_noise_ez(int width, int height, int offset_x, int offset_y, float scale) { return rf_gen_image_perlin_noise(width, height, offset_x, offset_y, scale, rf_default_allocator); }
-rf_public rf_image rf_gen_image_cellular_ez(int width, int height, int tile_size) { return rf_gen_image_cellular(width,
-                                                                                                              height,
-                                                                                                              tile_size,
-                                                                                                              rf_default_rand_proc,
-                                                                                                              rf_default_allocator); }
+rf_public rf_image rf_gen_image_cellular_ez(int width, int height, int tile_size) { return rf_gen_image_cellular(width, height, tile_size, rf_get_default_rand(), rf_default_allocator); }
 #pragma endregion
 
 #pragma region mipmaps
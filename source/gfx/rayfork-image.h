@@ -75,8 +75,8 @@ rf_public rf_bool rf_image_get_pixels_as_normalized_to_buffer(rf_image image, rf
 rf_public rf_color* rf_image_pixels_to_rgba32(rf_image image, rf_allocator allocator);
 rf_public rf_vec4* rf_image_compute_pixels_to_normalized(rf_image image, rf_allocator allocator);
 
-rf_public void rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size);
-rf_public rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator);
+rf_public rf_int rf_image_extract_palette_to_buffer(rf_image image, rf_color* palette_dst, rf_int palette_size, rf_allocator temp_allocator); // Returns the amount of colors found
+rf_public rf_palette rf_image_extract_palette(rf_image image, rf_int palette_size, rf_allocator allocator, rf_allocator temp_allocator);
 rf_public rf_rec rf_image_alpha_border(rf_image image, float threshold);
 #pragma endregion
 
@@ -133,7 +133,7 @@ rf_public void rf_unload_gif(rf_gif gif, rf_allocator allocator);
 #pragma endregion
 
 #pragma region image gen
-rf_public rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, rf_rand_proc rand);
+rf_public rf_vec2 rf_get_seed_for_cellular_image(int seeds_per_row, int tile_size, int i, uint64_t seed); // Same seed and i always give the same point
 
 rf_public rf_image rf_gen_image_color_to_buffer(int width, int height, rf_color color, rf_color* dst, rf_int dst_size);
 rf_public rf_image rf_gen_image_color(int width, int height, rf_color color, rf_allocator allocator);
@@ -145,12 +145,12 @@ rf_public rf_image rf_gen_image_gradient_radial_to_buffer(int width, int height,
 rf_public rf_image rf_gen_image_gradient_radial(int width, int height, float density, rf_color inner, rf_color outer, rf_allocator allocator);
 rf_public rf_image rf_gen_image_checked_to_buffer(int width, int height, int checks_x, int checks_y, rf_color col1, rf_color col2, rf_color* dst, rf_int dst_size);
 rf_public rf_image rf_gen_image_checked(int width, int height, int checks_x, int checks_y, rf_color col1, rf_color col2, rf_allocator allocator);
-rf_public rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float factor, rf_rand_proc rand, rf_color* dst, rf_int dst_size);
-rf_public rf_image rf_gen_image_white_noise(int width, int height, float factor, rf_rand_proc rand, rf_allocator allocator);
+rf_public rf_image rf_gen_image_white_noise_to_buffer(int width, int height, float factor, rf_rand* rng, rf_color* dst, rf_int dst_size);
+rf_public rf_image rf_gen_image_white_noise(int width, int height, float factor, rf_rand* rng, rf_allocator allocator);
 rf_public rf_image rf_gen_image_perlin_noise_to_buffer(int width, int height, int offset_x, int offset_y, float scale, rf_color* dst, rf_int dst_size);
 rf_public rf_image rf_gen_image_perlin_noise(int width, int height, int offset_x, int offset_y, float scale, rf_allocator allocator);
-rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand_proc rand, rf_color* dst, rf_int dst_size);
-rf_public rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand_proc rand, rf_allocator allocator);
+rf_public rf_image rf_gen_image_cellular_to_buffer(int width, int height, int tile_size, rf_rand* rng, rf_color* dst, rf_int dst_size);
+rf_public rf_image rf_gen_image_cellular(int width, int height, int tile_size, rf_rand* rng, rf_allocator allocator);
 #pragma endregion
 
 #pragma region image manipulation
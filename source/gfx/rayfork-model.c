@@ -275,6 +275,8 @@ rf_public void rf_unload_mesh(rf_mesh mesh, rf_allocator allocator)
 
 rf_public rf_model rf_load_model(const char* filename, rf_allocator allocator, rf_allocator temp_allocator, rf_io_callbacks io)
 {
+    rf_profile_zone_begin("rf_load_model");
+
     rf_model model = {0};
 
     if (rf_is_file_extension(filename, ".obj"))
@@ -329,12 +331,15 @@ rf_public rf_model rf_load_model(const char* filename, rf_allocator allocator, r
         }
     }
 
+    rf_profile_zone_end();
     return model;
 }
 
 // Load OBJ mesh data. Note: This calls into a library to do io, so we need to ask the user for IO callbacks
 rf_public rf_model rf_load_model_from_obj(const char* filename, rf_allocator allocator, rf_allocator temp_allocator, rf_io_callbacks io)
 {
+    rf_profile_zone_begin("rf_load_model_from_obj");
+
     rf_model model  = {0};
     allocator = allocator;
 
@@ -521,7 +526,10 @@ rf_public rf_model rf_load_model_from_obj(const char* filename, rf_allocator all
     // NOTE: At this point we have all model data loaded
     rf_log(rf_log_type_info, "Model loaded successfully in RAM. Filename: %s", filename);
 
-    return rf_load_meshes_and_materials_for_model(model, allocator, temp_allocator);
+    model = rf_load_meshes_and_materials_for_model(model, allocator, temp_allocator);
+
+    rf_profile_zone_end();
+    return model;
 }
 
 // Load IQM mesh data
@@ -602,6 +610,8 @@ rf_public rf_model rf_load_model_from_iqm(const char* filename, rf_allocator all
     }  rf_iqm_vertex_type;
     #pragma endregion
 
+    rf_profile_zone_begin("rf_load_model_from_iqm");
+
     rf_model model = {0};
 
     size_t data_size = rf_file_size(io, filename);
@@ -628,12 +638,14 @@ rf_public rf_model rf_load_model_from_iqm(const char* filename, rf_allocator all
     if (strncmp(iqm.magic, RF_IQM_MAGIC, sizeof(RF_IQM_MAGIC)))
     {
         rf_log(rf_log_type_warning, "[%s] IQM file does not seem to be valid", filename);
+        rf_profile_zone_end();
         return model;
     }
 
     if (iqm.version != RF_IQM_VERSION)
     {
         rf_log(rf_log_type_warning, "[%s] IQM file version is not supported (%i).", filename, iqm.version);
+        rf_profile_zone_end();
         return model;
     }
 
@@ -846,7 +858,10 @@ rf_public rf_model rf_load_model_from_iqm(const char* filename, rf_allocator all
     rf_free(temp_allocator, blendw);
     rf_free(temp_allocator, ijoint);
 
-    return rf_load_meshes_and_materials_for_model(model, allocator, temp_allocator);
+    model = rf_load_meshes_and_materials_for_model(model, allocator, temp_allocator);
+
+    rf_profile_zone_end();
+    return model;
 }
 
 /***********************************************************************************
@@ -970,6 +985,8 @@ rf_public rf_model rf_load_model_from_gltf(const char* filename, rf_allocator al
         } \
     }
 
+    rf_profile_zone_begin("rf_load_model_from_gltf");
+
     rf_set_global_dependencies_allocator(temp_allocator);
     rf_model model = {0};
 
@@ -982,17 +999,17 @@ rf_public rf_model rf_load_model_from_gltf(const char* filename, rf_allocator al
         }
     };
 
-    int data_size = rf_file_size(io, filename);
-    void* data = rf_alloc(temp_allocator, data_size);
-    if (!rf_read_file(io, filename, data, data_size))
+    // Note: glb files reference their binary chunk from this memory, so it must outlive cgltf_data
+    rf_file_view file = rf_view_file(io, filename, temp_allocator);
+    if (!file.valid)
     {
-        rf_free(temp_allocator, data);
-        rf_set_global_dependencies_allocator(temp_allocator);
+        rf_set_global_dependencies_allocator((rf_allocator) {0});
+        rf_profile_zone_end();
         return model;
     }
 
     cgltf_data* cgltf_data = NULL;
-    cgltf_result result = cgltf_parse(&options, data, data_size, &cgltf_data);
+    cgltf_result result = cgltf_parse(&options, file.data, file.size, &cgltf_data);
 
     if (result == cgltf_result_success)
     {
@@ -1164,8 +1181,10 @@ rf_public rf_model rf_load_model_from_gltf(const char* filename, rf_allocator al
         rf_log(rf_log_type_warning, "[%s] glTF cgltf_data could not be loaded", filename);
     }
 
+    rf_release_file_view(io, file, temp_allocator);
     rf_set_global_dependencies_allocator((rf_allocator) {0});
 
+    rf_profile_zone_end();
     return model;
 
     #undef rf_load_accessor
@@ -1208,34 +1227,39 @@ rf_public rf_ray_hit_info rf_collision_ray_model(rf_ray ray, rf_model model)
             // model->mesh.triangle_count may not be set, vertex_count is more reliable
             int triangle_count = model.meshes[m].vertex_count / 3;
 
-            // Test against all triangles in mesh
-            for (rf_int i = 0; i < triangle_count; i++)
+            rf_vec3 *vertdata = (rf_vec3 *) model.meshes[m].vertices;
+
+            // Transform the triangles in batches so the vertices go through rf_vec3_transform_array instead of one call each
+            rf_vec3 transformed[3 * 64];
+
+            for (rf_int first = 0; first < triangle_count; first += 64)
             {
-                rf_vec3 a, b, c;
-                rf_vec3 *vertdata = (rf_vec3 *) model.meshes[m].vertices;
+                rf_int batch_count = triangle_count - first < 64 ? triangle_count - first : 64;
 
                 if (model.meshes[m].indices)
                 {
-                    a = vertdata[model.meshes[m].indices[i * 3 + 0]];
-                    b = vertdata[model.meshes[m].indices[i * 3 + 1]];
-                    c = vertdata[model.meshes[m].indices[i * 3 + 2]];
-                } else
+                    for (rf_int i = 0; i < batch_count * 3; i++)
+                    {
+                        transformed[i] = vertdata[model.meshes[m].indices[first * 3 + i]];
+                    }
+
+                    rf_vec3_transform_array(&model.transform, transformed, transformed, batch_count * 3);
+                }
+                else
                 {
-                    a = vertdata[i * 3 + 0];
-                    b = vertdata[i * 3 + 1];
-                    c = vertdata[i * 3 + 2];
+                    rf_vec3_transform_array(&model.transform, vertdata + first * 3, transformed, batch_count * 3);
                 }
 
-                a = rf_vec3_transform(a, model.transform);
-                b = rf_vec3_transform(b, model.transform);
-                c = rf_vec3_transform(c, model.transform);
-
-                rf_ray_hit_info tri_hit_info = rf_collision_ray_triangle(ray, a, b, c);
-
-                if (tri_hit_info.hit)
+                // Test against all triangles in the batch
+                for (rf_int i = 0; i < batch_count; i++)
                 {
-                    // Save the closest hit triangle
-                    if ((!result.hit) || (result.distance > tri_hit_info.distance)) result = tri_hit_info;
+                    rf_ray_hit_info tri_hit_info = rf_collision_ray_triangle(ray, transformed[i * 3 + 0], transformed[i * 3 + 1], transformed[i * 3 + 2]);
+
+                    if (tri_hit_info.hit)
+                    {
+                        // Save the closest hit triangle
+                        if ((!result.hit) || (result.distance > tri_hit_info.distance)) result = tri_hit_info;
+                    }
                 }
             }
         }
@@ -1423,6 +1447,8 @@ rf_public rf_model_animation_array rf_load_model_animations_from_iqm(const unsig
         return (rf_model_animation_array){0};
     }
 
+    rf_profile_zone_begin("rf_load_model_animations_from_iqm");
+
     rf_model_animation_array result = {
         .size = iqm.num_anims,
     };
@@ -1573,6 +1599,7 @@ rf_public rf_model_animation_array rf_load_model_animations_from_iqm(const unsig
     rf_free(temp_allocator, poses);
     rf_free(temp_allocator, anim);
 
+    rf_profile_zone_end();
     return result;
 }
 
@@ -1584,6 +1611,8 @@ rf_public void rf_update_model_animation(rf_model model, rf_model_animation anim
         return;
     }
 
+    rf_profile_zone_begin("rf_update_model_animation");
+
     if (frame >= anim.frame_count)
     {
         frame = frame%anim.frame_count;
@@ -1643,6 +1672,8 @@ rf_public void rf_update_model_animation(rf_model model, rf_model_animation anim
         rf_gfx_update_buffer(model.meshes[m].vbo_id[0], model.meshes[m].anim_vertices, model.meshes[m].vertex_count * 3 * sizeof(float)); // Update vertex position
         rf_gfx_update_buffer(model.meshes[m].vbo_id[2], model.meshes[m].anim_vertices, model.meshes[m].vertex_count * 3 * sizeof(float)); // Update vertex normals
     }
+
+    rf_profile_zone_end();
 }
 
 // Check model animation skeleton match. Only number of bones and parent connections are checked
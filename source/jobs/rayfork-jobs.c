@@ -0,0 +1,594 @@
+#include "rayfork-jobs.h"
+
+#include "string.h"
+
+#if defined(rayfork_platform_windows)
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include "windows.h"
+#else
+    #include "pthread.h"
+    #include "unistd.h"
+#endif
+
+// The atomics and spin lock used here live in rayfork-core.c
+
+#pragma region counters and submission
+
+rf_public rf_int rf_get_cpu_count(void)
+{
+    rf_int result = 1;
+
+    #if defined(rayfork_platform_windows)
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        result = info.dwNumberOfProcessors;
+    }
+    #elif defined(_SC_NPROCESSORS_ONLN)
+    {
+        long count = sysconf(_SC_NPROCESSORS_ONLN);
+        if (count > 0) result = count;
+    }
+    #endif
+
+    return result;
+}
+
+rf_public rf_int rf_job_counter_get(const rf_job_counter* counter)
+{
+    rf_int result = counter ? rf__atomic_load(&counter->value) : 0;
+    return result;
+}
+
+rf_public rf_bool rf_job_counter_done(const rf_job_counter* counter)
+{
+    rf_bool result = rf_job_counter_get(counter) == 0;
+    return result;
+}
+
+rf_public void rf_submit_jobs(rf_job_scheduler scheduler, const rf_job* jobs, rf_int jobs_count)
+{
+    if (!jobs || jobs_count <= 0) return;
+
+    // Counters are incremented before any job is submitted so a counter can't reach zero while jobs in its group are still being submitted
+    for (rf_int i = 0; i < jobs_count; i++)
+    {
+        if (jobs[i].counter) rf__atomic_add(&jobs[i].counter->value, 1);
+    }
+
+    scheduler.submit_proc(scheduler.user_data, jobs, jobs_count);
+}
+
+rf_public void rf_submit_job(rf_job_scheduler scheduler, rf_job job)
+{
+    rf_submit_jobs(scheduler, &job, 1);
+}
+
+rf_public void rf_wait_for_counter(rf_job_scheduler scheduler, const rf_job_counter* counter)
+{
+    while (!rf_job_counter_done(counter))
+    {
+        if (!scheduler.help_proc(scheduler.user_data))
+        {
+            rf__thread_yield();
+        }
+    }
+}
+
+rf_public rf_bool rf_run_job(rf_job job)
+{
+    rf_bool result = 0;
+
+    job.proc(job.data);
+
+    if (job.counter)
+    {
+        result = rf__atomic_add(&job.counter->value, -1) == 0;
+    }
+
+    return result;
+}
+
+typedef struct rf__parallel_for_state
+{
+    rf_parallel_for_proc proc;
+    void*                data;
+    volatile rf_int      next;
+    rf_int               end;
+    rf_int               batch_size;
+} rf__parallel_for_state;
+
+// Each job keeps taking batches until the range is exhausted, so fast threads pick up the slack of slow ones
+rf_internal void rf__parallel_for_job(void* data)
+{
+    rf__parallel_for_state* state = data;
+
+    while (1)
+    {
+        rf_int batch_end   = rf__atomic_add(&state->next, state->batch_size);
+        rf_int batch_begin = batch_end - state->batch_size;
+
+        if (batch_begin >= state->end) break;
+        if (batch_end > state->end) batch_end = state->end;
+
+        state->proc(state->data, batch_begin, batch_end);
+    }
+}
+
+rf_public void rf_parallel_for(rf_job_scheduler scheduler, rf_int begin, rf_int end, rf_int min_batch_size, rf_parallel_for_proc proc, void* data)
+{
+    if (!proc || begin >= end) return;
+
+    rf_int count        = end - begin;
+    rf_int worker_count = scheduler.worker_count_proc(scheduler.user_data);
+    rf_int threads      = worker_count + 1; // The calling thread also takes batches
+
+    // Aim for a few batches per thread to balance uneven work
+    rf_int batch_size = count / (threads * 4);
+    if (batch_size < min_batch_size) batch_size = min_batch_size;
+    if (batch_size < 1) batch_size = 1;
+
+    rf_int batch_count = (count + batch_size - 1) / batch_size;
+
+    rf__parallel_for_state state = { proc, data, begin, end, batch_size };
+
+    if (batch_count == 1 || worker_count == 0)
+    {
+        rf__parallel_for_job(&state);
+        return;
+    }
+
+    // Jobs take batches until there are none left, so a custom scheduler with more workers than fit below just gets fewer jobs
+    rf_int jobs_count = batch_count - 1 < worker_count ? batch_count - 1 : worker_count;
+    if (jobs_count > RF_JOBS_MAX_WORKERS) jobs_count = RF_JOBS_MAX_WORKERS;
+    rf_job_counter counter = {0};
+    rf_job jobs[RF_JOBS_MAX_WORKERS];
+
+    for (rf_int i = 0; i < jobs_count; i++)
+    {
+        jobs[i] = (rf_job) { rf__parallel_for_job, &state, &counter, 0 };
+    }
+
+    rf_submit_jobs(scheduler, jobs, jobs_count);
+    rf__parallel_for_job(&state);
+    rf_wait_for_counter(scheduler, &counter);
+}
+
+#pragma endregion
+
+#pragma region job system
+
+// Index of the queue owned by the current thread, threads that are not workers of the system use the shared queue
+rf_internal rf_thread_local rf_job_system* rf__current_job_system;
+rf_internal rf_thread_local rf_int         rf__current_worker_index;
+
+rf_internal rf_int rf__job_system_queue_index(rf_job_system* system)
+{
+    rf_int result = rf__current_job_system == system ? rf__current_worker_index : system->worker_count;
+    return result;
+}
+
+rf_internal rf_bool rf__job_queue_push(rf_job_queue* queue, rf_job job)
+{
+    rf_bool result = 0;
+
+    rf__spin_lock(&queue->lock);
+    if (queue->bottom - queue->top < RF_JOBS_QUEUE_CAPACITY)
+    {
+        queue->jobs[queue->bottom % RF_JOBS_QUEUE_CAPACITY] = job;
+        rf__atomic_store(&queue->bottom, queue->bottom + 1);
+        result = 1;
+    }
+    rf__spin_unlock(&queue->lock);
+
+    return result;
+}
+
+// The owner takes the most recent job, which is likely to still be in cache
+rf_internal rf_bool rf__job_queue_pop(rf_job_queue* queue, rf_job* job)
+{
+    rf_bool result = 0;
+
+    rf__spin_lock(&queue->lock);
+    if (queue->bottom > queue->top)
+    {
+        rf__atomic_store(&queue->bottom, queue->bottom - 1);
+        *job = queue->jobs[queue->bottom % RF_JOBS_QUEUE_CAPACITY];
+        result = 1;
+    }
+    rf__spin_unlock(&queue->lock);
+
+    return result;
+}
+
+// Thieves take the oldest job, which tends to be the biggest chunk of remaining work
+rf_internal rf_bool rf__job_queue_steal(rf_job_queue* queue, rf_job* job)
+{
+    // Peek without the lock so idle threads don't contend on empty queues
+    if (rf__atomic_load(&queue->bottom) <= rf__atomic_load(&queue->top)) return 0;
+
+    rf_bool result = 0;
+
+    rf__spin_lock(&queue->lock);
+    if (queue->bottom > queue->top)
+    {
+        *job = queue->jobs[queue->top % RF_JOBS_QUEUE_CAPACITY];
+        rf__atomic_store(&queue->top, queue->top + 1);
+        result = 1;
+    }
+    rf__spin_unlock(&queue->lock);
+
+    return result;
+}
+
+rf_internal void rf__job_system_wake_workers(rf_job_system* system)
+{
+    if (rf__atomic_load(&system->sleeping_workers) == 0) return;
+
+    #if defined(rayfork_platform_windows)
+        AcquireSRWLockExclusive(system->sleep_mutex);
+        WakeAllConditionVariable(system->sleep_condition);
+        ReleaseSRWLockExclusive(system->sleep_mutex);
+    #else
+        pthread_mutex_lock(system->sleep_mutex);
+        pthread_cond_broadcast(system->sleep_condition);
+        pthread_mutex_unlock(system->sleep_mutex);
+    #endif
+}
+
+rf_internal void rf__job_system_sleep(rf_job_system* system)
+{
+    #if defined(rayfork_platform_windows)
+        AcquireSRWLockExclusive(system->sleep_mutex);
+        rf__atomic_add(&system->sleeping_workers, 1);
+        while (rf__atomic_load(&system->pending_jobs) <= 0 && !rf__atomic_load(&system->quit))
+        {
+            SleepConditionVariableSRW(system->sleep_condition, system->sleep_mutex, INFINITE, 0);
+        }
+        rf__atomic_add(&system->sleeping_workers, -1);
+        ReleaseSRWLockExclusive(system->sleep_mutex);
+    #else
+        pthread_mutex_lock(system->sleep_mutex);
+        rf__atomic_add(&system->sleeping_workers, 1);
+        while (rf__atomic_load(&system->pending_jobs) <= 0 && !rf__atomic_load(&system->quit))
+        {
+            pthread_cond_wait(system->sleep_condition, system->sleep_mutex);
+        }
+        rf__atomic_add(&system->sleeping_workers, -1);
+        pthread_mutex_unlock(system->sleep_mutex);
+    #endif
+}
+
+rf_internal void rf__job_system_run(rf_job_system* system, rf_job job);
+
+rf_internal void rf__job_system_enqueue(rf_job_system* system, rf_job job)
+{
+    rf_int queue_index = rf__job_system_queue_index(system);
+
+    if (rf__job_queue_push(&system->queues[queue_index], job))
+    {
+        rf__atomic_add(&system->pending_jobs, 1);
+        rf__job_system_wake_workers(system);
+    }
+    else
+    {
+        // The queue is full, running the job here also throttles the producer
+        rf__job_system_run(system, job);
+    }
+}
+
+// Moves the jobs whose dependency reached zero to the queues
+rf_internal void rf__job_system_release_waiting_jobs(rf_job_system* system)
+{
+    // Ready jobs are taken out in batches so they are not enqueued while holding the lock, since enqueuing can run a job
+    rf_job ready[64];
+    rf_int ready_count;
+
+    do
+    {
+        ready_count = 0;
+
+        rf__spin_lock(&system->waiting_lock);
+        rf_int i = 0;
+        while (i < system->waiting_jobs_count && ready_count < 64)
+        {
+            if (rf_job_counter_done(system->waiting_jobs[i].dependency))
+            {
+                ready[ready_count++] = system->waiting_jobs[i];
+                system->waiting_jobs[i] = system->waiting_jobs[system->waiting_jobs_count - 1];
+                rf__atomic_store(&system->waiting_jobs_count, system->waiting_jobs_count - 1);
+            }
+            else i++;
+        }
+        rf__spin_unlock(&system->waiting_lock);
+
+        for (rf_int j = 0; j < ready_count; j++)
+        {
+            rf__job_system_enqueue(system, ready[j]);
+        }
+    }
+    while (ready_count == 64);
+}
+
+rf_internal void rf__job_system_run(rf_job_system* system, rf_job job)
+{
+    if (rf_run_job(job) && rf__atomic_load(&system->waiting_jobs_count) > 0)
+    {
+        rf__job_system_release_waiting_jobs(system);
+    }
+}
+
+rf_internal void rf__job_system_wait_for_dependency(rf_job_system* system, rf_job job)
+{
+    rf_bool added = 1;
+
+    rf__spin_lock(&system->waiting_lock);
+    if (system->waiting_jobs_count == system->waiting_jobs_capacity)
+    {
+        rf_int new_capacity = system->waiting_jobs_capacity ? system->waiting_jobs_capacity * 2 : 64;
+        rf_job* new_jobs = rf_realloc(system->allocator, system->waiting_jobs, new_capacity * sizeof(rf_job), system->waiting_jobs_capacity * sizeof(rf_job));
+
+        if (new_jobs)
+        {
+            system->waiting_jobs = new_jobs;
+            system->waiting_jobs_capacity = new_capacity;
+        }
+        else added = 0;
+    }
+    if (added)
+    {
+        system->waiting_jobs[system->waiting_jobs_count] = job;
+        rf__atomic_store(&system->waiting_jobs_count, system->waiting_jobs_count + 1);
+    }
+    rf__spin_unlock(&system->waiting_lock);
+
+    if (!added)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to grow the list of jobs waiting on a dependency, waiting on this thread instead");
+        rf_wait_for_counter(rf_job_system_scheduler(system), job.dependency);
+        rf__job_system_enqueue(system, job);
+    }
+    else if (rf_job_counter_done(job.dependency))
+    {
+        // The dependency may have reached zero before the job was added, in which case nobody else would release it
+        rf__job_system_release_waiting_jobs(system);
+    }
+}
+
+rf_internal rf_bool rf__job_system_take(rf_job_system* system, rf_int queue_index, rf_job* job)
+{
+    rf_int queues_count = system->worker_count + 1;
+
+    if (rf__job_queue_pop(&system->queues[queue_index], job)) return 1;
+
+    for (rf_int i = 1; i < queues_count; i++)
+    {
+        if (rf__job_queue_steal(&system->queues[(queue_index + i) % queues_count], job)) return 1;
+    }
+
+    return 0;
+}
+
+typedef struct rf__job_worker_args
+{
+    rf_job_system* system;
+    rf_int         index;
+} rf__job_worker_args;
+
+rf_internal void rf__job_worker_loop(rf_job_system* system, rf_int index)
+{
+    rf__current_job_system   = system;
+    rf__current_worker_index = index;
+
+    while (!rf__atomic_load(&system->quit))
+    {
+        if (!rf_job_system_help(system))
+        {
+            rf__job_system_sleep(system);
+        }
+    }
+}
+
+#if defined(rayfork_platform_windows)
+rf_internal DWORD WINAPI rf__job_worker_thread(LPVOID param)
+{
+    rf__job_worker_args* args = param;
+    rf__job_worker_loop(args->system, args->index);
+    return 0;
+}
+#else
+rf_internal void* rf__job_worker_thread(void* param)
+{
+    rf__job_worker_args* args = param;
+    rf__job_worker_loop(args->system, args->index);
+    return 0;
+}
+#endif
+
+rf_public rf_bool rf_job_system_init(rf_job_system* system, rf_int worker_count, rf_allocator allocator)
+{
+    if (!system) return 0;
+
+    memset(system, 0, sizeof(rf_job_system));
+
+    if (worker_count <= 0) worker_count = rf_get_cpu_count() - 1;
+    if (worker_count > RF_JOBS_MAX_WORKERS) worker_count = RF_JOBS_MAX_WORKERS;
+
+    system->allocator = allocator;
+
+    rf_job* queue_memory = rf_alloc(allocator, (worker_count + 1) * RF_JOBS_QUEUE_CAPACITY * sizeof(rf_job));
+    rf__job_worker_args* args = rf_alloc(allocator, RF_JOBS_MAX_WORKERS * sizeof(rf__job_worker_args));
+
+    #if defined(rayfork_platform_windows)
+        system->sleep_mutex     = rf_alloc(allocator, sizeof(SRWLOCK));
+        system->sleep_condition = rf_alloc(allocator, sizeof(CONDITION_VARIABLE));
+    #else
+        system->sleep_mutex     = rf_alloc(allocator, sizeof(pthread_mutex_t));
+        system->sleep_condition = rf_alloc(allocator, sizeof(pthread_cond_t));
+    #endif
+
+    if (!queue_memory || !args || !system->sleep_mutex || !system->sleep_condition)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate the job system");
+
+        if (queue_memory)            rf_free(allocator, queue_memory);
+        if (args)                    rf_free(allocator, args);
+        if (system->sleep_mutex)     rf_free(allocator, system->sleep_mutex);
+        if (system->sleep_condition) rf_free(allocator, system->sleep_condition);
+
+        memset(system, 0, sizeof(rf_job_system));
+        return 0;
+    }
+
+    for (rf_int i = 0; i < worker_count + 1; i++)
+    {
+        system->queues[i].jobs = queue_memory + i * RF_JOBS_QUEUE_CAPACITY;
+    }
+
+    #if defined(rayfork_platform_windows)
+        InitializeSRWLock(system->sleep_mutex);
+        InitializeConditionVariable(system->sleep_condition);
+    #else
+        pthread_mutex_init(system->sleep_mutex, 0);
+        pthread_cond_init(system->sleep_condition, 0);
+    #endif
+
+    // The workers read their arguments after this function returns, they are freed on shutdown
+    system->worker_args = args;
+    system->valid = 1;
+
+    // The worker count is set before starting the threads since workers use it to find the queues
+    system->worker_count = worker_count;
+
+    for (rf_int i = 0; i < worker_count; i++)
+    {
+        args[i] = (rf__job_worker_args) { system, i };
+    }
+
+    for (rf_int i = 0; i < worker_count; i++)
+    {
+        #if defined(rayfork_platform_windows)
+            HANDLE thread = CreateThread(0, 0, rf__job_worker_thread, &args[i], 0, 0);
+            if (!thread) break;
+            system->threads[i] = thread;
+        #else
+            pthread_t thread;
+            if (pthread_create(&thread, 0, rf__job_worker_thread, &args[i]) != 0) break;
+            system->threads[i] = (void*) thread;
+        #endif
+    }
+
+    if (worker_count > 0 && !system->threads[worker_count - 1])
+    {
+        rf_log_error(rf_bad_io, "Failed to start the job system worker threads");
+        rf_job_system_shutdown(system);
+        return 0;
+    }
+
+    return 1;
+}
+
+rf_public void rf_job_system_shutdown(rf_job_system* system)
+{
+    if (!system || !system->valid) return;
+
+    rf__atomic_store(&system->quit, 1);
+
+    #if defined(rayfork_platform_windows)
+        AcquireSRWLockExclusive(system->sleep_mutex);
+        WakeAllConditionVariable(system->sleep_condition);
+        ReleaseSRWLockExclusive(system->sleep_mutex);
+
+        for (rf_int i = 0; i < system->worker_count && system->threads[i]; i++)
+        {
+            WaitForSingleObject(system->threads[i], INFINITE);
+            CloseHandle(system->threads[i]);
+        }
+    #else
+        pthread_mutex_lock(system->sleep_mutex);
+        pthread_cond_broadcast(system->sleep_condition);
+        pthread_mutex_unlock(system->sleep_mutex);
+
+        for (rf_int i = 0; i < system->worker_count && system->threads[i]; i++)
+        {
+            pthread_join((pthread_t) system->threads[i], 0);
+        }
+
+        pthread_cond_destroy(system->sleep_condition);
+        pthread_mutex_destroy(system->sleep_mutex);
+    #endif
+
+    rf_free(system->allocator, system->queues[0].jobs);
+    rf_free(system->allocator, system->worker_args);
+    rf_free(system->allocator, system->sleep_mutex);
+    rf_free(system->allocator, system->sleep_condition);
+    if (system->waiting_jobs) rf_free(system->allocator, system->waiting_jobs);
+
+    memset(system, 0, sizeof(rf_job_system));
+}
+
+rf_public void rf_job_system_submit(void* user_data, const rf_job* jobs, rf_int jobs_count)
+{
+    rf_job_system* system = user_data;
+
+    for (rf_int i = 0; i < jobs_count; i++)
+    {
+        if (rf_job_counter_done(jobs[i].dependency))
+        {
+            rf__job_system_enqueue(system, jobs[i]);
+        }
+        else
+        {
+            rf__job_system_wait_for_dependency(system, jobs[i]);
+        }
+    }
+}
+
+rf_public rf_bool rf_job_system_help(void* user_data)
+{
+    rf_job_system* system = user_data;
+    rf_job job;
+
+    rf_bool result = rf__job_system_take(system, rf__job_system_queue_index(system), &job);
+
+    if (result)
+    {
+        rf__atomic_add(&system->pending_jobs, -1);
+        rf__job_system_run(system, job);
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_job_system_worker_count(void* user_data)
+{
+    rf_job_system* system = user_data;
+    return system->worker_count;
+}
+
+rf_public void rf_immediate_submit(void* user_data, const rf_job* jobs, rf_int jobs_count)
+{
+    ((void)user_data);
+
+    // Jobs run in submission order so dependencies submitted earlier are already done
+    for (rf_int i = 0; i < jobs_count; i++)
+    {
+        rf_run_job(jobs[i]);
+    }
+}
+
+rf_public rf_bool rf_immediate_help(void* user_data)
+{
+    ((void)user_data);
+    return 0;
+}
+
+rf_public rf_int rf_immediate_worker_count(void* user_data)
+{
+    ((void)user_data);
+    return 0;
+}
+
+#pragma endregion
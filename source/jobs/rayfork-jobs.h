@@ -0,0 +1,111 @@
+#ifndef RAYFORK_JOBS_H
+#define RAYFORK_JOBS_H
+
+#include "rayfork-core.h"
+
+/*
+ * Jobs are submitted to an rf_job_scheduler, which is a set of callbacks so hosts can plug in their own scheduler.
+ * rayfork comes with rf_job_system, a work stealing thread pool, and rf_immediate_scheduler which runs jobs on submit.
+ *
+ * Counters track groups of jobs: rf_submit_jobs increments the counter of each job and the job decrements it when it finishes.
+ * A job can depend on a counter, in which case it only starts once that counter reaches zero.
+ * Waiting on a counter runs pending jobs on the waiting thread instead of blocking it.
+ */
+
+#ifndef RF_JOBS_MAX_WORKERS
+    #define RF_JOBS_MAX_WORKERS (64)
+#endif
+
+#ifndef RF_JOBS_QUEUE_CAPACITY
+    #define RF_JOBS_QUEUE_CAPACITY (1024) // Per worker, jobs submitted to a full queue run on the submitting thread
+#endif
+
+#define rf_immediate_scheduler (rf_lit(rf_job_scheduler) { 0, rf_immediate_submit, rf_immediate_help, rf_immediate_worker_count })
+#define rf_job_system_scheduler(system) (rf_lit(rf_job_scheduler) { (system), rf_job_system_submit, rf_job_system_help, rf_job_system_worker_count })
+
+typedef struct rf_job_counter
+{
+    volatile rf_int value;
+} rf_job_counter;
+
+typedef void (*rf_job_proc)(void* data);
+typedef void (*rf_parallel_for_proc)(void* data, rf_int begin, rf_int end);
+
+typedef struct rf_job
+{
+    rf_job_proc     proc;
+    void*           data;
+    rf_job_counter* counter;    // Decremented when the job finishes, can be null
+    rf_job_counter* dependency; // The job starts once this counter reaches zero, can be null
+} rf_job;
+
+typedef struct rf_job_scheduler
+{
+    void* user_data;
+    void    (*submit_proc)(void* user_data, const rf_job* jobs, rf_int jobs_count); // Counters were already incremented by rf_submit_jobs, schedulers run jobs with rf_run_job
+    rf_bool (*help_proc)(void* user_data);                                           // Runs one pending job on the calling thread, returns false if there was none
+    rf_int  (*worker_count_proc)(void* user_data);                                   // Number of threads that run jobs, used to split parallel loops
+} rf_job_scheduler;
+
+typedef struct rf_job_queue
+{
+    rf_job*         jobs;
+    volatile rf_int top;
+    volatile rf_int bottom;
+    volatile rf_int lock;
+} rf_job_queue;
+
+typedef struct rf_job_system
+{
+    rf_job_queue    queues[RF_JOBS_MAX_WORKERS + 1]; // The last queue is shared by threads that are not workers
+    void*           threads[RF_JOBS_MAX_WORKERS];
+    void*           worker_args;
+    rf_int          worker_count;
+
+    rf_job*         waiting_jobs; // Jobs whose dependency did not reach zero yet
+    volatile rf_int waiting_jobs_count;
+    rf_int          waiting_jobs_capacity;
+    volatile rf_int waiting_lock;
+
+    void*           sleep_mutex;
+    void*           sleep_condition;
+    volatile rf_int sleeping_workers;
+    volatile rf_int pending_jobs;
+    volatile rf_int submit_index;
+    volatile rf_int quit;
+
+    rf_allocator    allocator;
+    rf_bool         valid;
+} rf_job_system;
+
+#pragma region counters and submission
+
+rf_public rf_int  rf_get_cpu_count(void);
+
+rf_public rf_int  rf_job_counter_get(const rf_job_counter* counter);
+rf_public rf_bool rf_job_counter_done(const rf_job_counter* counter);
+
+rf_public void    rf_submit_jobs(rf_job_scheduler scheduler, const rf_job* jobs, rf_int jobs_count);
+rf_public void    rf_submit_job(rf_job_scheduler scheduler, rf_job job);
+rf_public void    rf_wait_for_counter(rf_job_scheduler scheduler, const rf_job_counter* counter);
+rf_public rf_bool rf_run_job(rf_job job); // Runs the job and decrements its counter, returns true if the counter reached zero
+rf_public void    rf_parallel_for(rf_job_scheduler scheduler, rf_int begin, rf_int end, rf_int min_batch_size, rf_parallel_for_proc proc, void* data); // Returns once all the batches ran
+
+#pragma endregion
+
+#pragma region job system
+
+rf_public rf_bool rf_job_system_init(rf_job_system* system, rf_int worker_count, rf_allocator allocator); // A worker_count of 0 uses one worker per cpu minus the calling thread
+rf_public void    rf_job_system_shutdown(rf_job_system* system); // Waits for the workers to finish the jobs they are running, pending jobs are dropped
+
+rf_public void    rf_job_system_submit(void* user_data, const rf_job* jobs, rf_int jobs_count);
+rf_public rf_bool rf_job_system_help(void* user_data);
+rf_public rf_int  rf_job_system_worker_count(void* user_data);
+
+rf_public void    rf_immediate_submit(void* user_data, const rf_job* jobs, rf_int jobs_count);
+rf_public rf_bool rf_immediate_help(void* user_data);
+rf_public rf_int  rf_immediate_worker_count(void* user_data);
+
+#pragma endregion
+
+#endif // RAYFORK_JOBS_H
@@ -1,5 +1,23 @@
 #include "rayfork-math.h"
 
+#if defined(rayfork_avx2)
+    #include "immintrin.h"
+#elif defined(rayfork_sse2)
+    #include "emmintrin.h"
+#elif defined(rayfork_neon) && (defined(__aarch64__) || defined(_M_ARM64))
+    #include "arm_neon.h"
+#endif
+
+// The simd kernels match the scalar code to the bit, which only holds if the compiler doesn't fuse the scalar multiplies
+// and adds into fma instructions (eg: when building with -mfma or -march=native). gcc ignores the standard pragma, the
+// cmake build passes it -ffp-contract=off instead. msvc only contracts with /fp:contract or /fp:fast, so leaving it off
+// for the rest of the unity build matches its default.
+#if defined(rayfork_clang)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(rayfork_msvc)
+    #pragma fp_contract(off)
+#endif
+
 #pragma region misc
 
 rf_public float rf_next_pot(float it)
@@ -101,6 +119,156 @@ rf_public rf_base64_output rf_decode_base64(const unsigned char* input, rf_alloc
 
 #pragma endregion
 
+#pragma region simd
+
+/*
+ * 4 wide float vectors for the matrix and quaternion kernels. The kernels do the same multiplications and additions in the
+ * same order as the scalar code, only spread over the lanes, so both give the same result to the last bit. Where it helps
+ * a - b is done as a + (-b) and -a * b as (-a) * b, which IEEE arithmetic defines to be exactly the same.
+ * NEON is only used on AArch64 since 32 bit ARM flushes denormals to zero in NEON instructions.
+ */
+#if defined(rayfork_sse2)
+    #define RF__MATH_SIMD
+
+    typedef __m128 rf__f4;
+
+    #define rf__f4_load(src)                  _mm_loadu_ps(src)
+    #define rf__f4_store(dst, a)              _mm_storeu_ps((dst), (a))
+    #define rf__f4_set(x, y, z, w)            _mm_setr_ps((x), (y), (z), (w))
+    #define rf__f4_splat(x)                   _mm_set1_ps(x)
+    #define rf__f4_add(a, b)                  _mm_add_ps((a), (b))
+    #define rf__f4_sub(a, b)                  _mm_sub_ps((a), (b))
+    #define rf__f4_mul(a, b)                  _mm_mul_ps((a), (b))
+    #define rf__f4_xor(a, b)                  _mm_xor_ps((a), (b))
+    #define rf__f4_shuffle(a, x, y, z, w)     _mm_shuffle_ps((a), (a), _MM_SHUFFLE(w, z, y, x))
+    #define rf__f4_shuffle2(a, b, x, y, z, w) _mm_shuffle_ps((a), (b), _MM_SHUFFLE(w, z, y, x)) // Lanes x and y from a, z and w from b
+#elif defined(rayfork_neon) && (defined(__aarch64__) || defined(_M_ARM64))
+    #define RF__MATH_SIMD
+
+    typedef float32x4_t rf__f4;
+
+    rf_internal inline float32x4_t rf__f4_neon_set(float x, float y, float z, float w)
+    {
+        const float lanes[4] = { x, y, z, w };
+        return vld1q_f32(lanes);
+    }
+
+    // Lanes 0 to 3 pick from a and 4 to 7 from b, the byte indices fold to a constant once inlined
+    rf_internal inline float32x4_t rf__f4_neon_shuffle(float32x4_t a, float32x4_t b, int x, int y, int z, int w)
+    {
+        const int lanes[4] = { x, y, z, w };
+        uint8_t bytes[16];
+        for (int i = 0; i < 16; i++) bytes[i] = (uint8_t) (lanes[i / 4] * 4 + i % 4);
+
+        uint8x16x2_t table = { { vreinterpretq_u8_f32(a), vreinterpretq_u8_f32(b) } };
+        return vreinterpretq_f32_u8(vqtbl2q_u8(table, vld1q_u8(bytes)));
+    }
+
+    #define rf__f4_load(src)                  vld1q_f32(src)
+    #define rf__f4_store(dst, a)              vst1q_f32((dst), (a))
+    #define rf__f4_set(x, y, z, w)            rf__f4_neon_set((x), (y), (z), (w))
+    #define rf__f4_splat(x)                   vdupq_n_f32(x)
+    #define rf__f4_add(a, b)                  vaddq_f32((a), (b))
+    #define rf__f4_sub(a, b)                  vsubq_f32((a), (b))
+    #define rf__f4_mul(a, b)                  vmulq_f32((a), (b))
+    #define rf__f4_xor(a, b)                  vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b)))
+    #define rf__f4_shuffle(a, x, y, z, w)     rf__f4_neon_shuffle((a), (a), (x), (y), (z), (w))
+    #define rf__f4_shuffle2(a, b, x, y, z, w) rf__f4_neon_shuffle((a), (b), (x), (y), (z) + 4, (w) + 4) // Lanes x and y from a, z and w from b
+#endif
+
+#if defined(RF__MATH_SIMD)
+
+// The matrix is stored as rows { m0, m4, m8, m12 }... this loads it as { m0, m1, m2, m3 }...
+rf_internal inline void rf__mat_load_columns(const rf_mat* mat, rf__f4 columns[4])
+{
+    const float* src = (const float*) mat;
+
+    rf__f4 r0 = rf__f4_load(src);
+    rf__f4 r1 = rf__f4_load(src + 4);
+    rf__f4 r2 = rf__f4_load(src + 8);
+    rf__f4 r3 = rf__f4_load(src + 12);
+
+    rf__f4 t0 = rf__f4_shuffle2(r0, r1, 0, 1, 0, 1);
+    rf__f4 t1 = rf__f4_shuffle2(r0, r1, 2, 3, 2, 3);
+    rf__f4 t2 = rf__f4_shuffle2(r2, r3, 0, 1, 0, 1);
+    rf__f4 t3 = rf__f4_shuffle2(r2, r3, 2, 3, 2, 3);
+
+    columns[0] = rf__f4_shuffle2(t0, t2, 0, 2, 0, 2);
+    columns[1] = rf__f4_shuffle2(t0, t2, 1, 3, 1, 3);
+    columns[2] = rf__f4_shuffle2(t1, t3, 0, 2, 0, 2);
+    columns[3] = rf__f4_shuffle2(t1, t3, 1, 3, 1, 3);
+}
+
+// The elements of a matrix that transform points, each one splat over all lanes so every lane can hold a different point
+typedef struct rf__mat_lanes
+{
+    rf__f4 m0, m1, m2, m4, m5, m6, m8, m9, m10, m12, m13, m14;
+} rf__mat_lanes;
+
+rf_internal inline rf__mat_lanes rf__mat_lanes_make(const rf_mat* mat)
+{
+    rf__mat_lanes result;
+
+    result.m0  = rf__f4_splat(mat->m0);
+    result.m1  = rf__f4_splat(mat->m1);
+    result.m2  = rf__f4_splat(mat->m2);
+    result.m4  = rf__f4_splat(mat->m4);
+    result.m5  = rf__f4_splat(mat->m5);
+    result.m6  = rf__f4_splat(mat->m6);
+    result.m8  = rf__f4_splat(mat->m8);
+    result.m9  = rf__f4_splat(mat->m9);
+    result.m10 = rf__f4_splat(mat->m10);
+    result.m12 = rf__f4_splat(mat->m12);
+    result.m13 = rf__f4_splat(mat->m13);
+    result.m14 = rf__f4_splat(mat->m14);
+
+    return result;
+}
+
+// Transforms 4 points or directions given as their x, y and z lanes, in the same order of operations as rf_vec3_transform
+rf_internal inline void rf__mat_lanes_transform(const rf__mat_lanes* m, rf_bool translate, rf__f4* x, rf__f4* y, rf__f4* z)
+{
+    rf__f4 rx = rf__f4_add(rf__f4_add(rf__f4_mul(m->m0, *x), rf__f4_mul(m->m4, *y)), rf__f4_mul(m->m8, *z));
+    rf__f4 ry = rf__f4_add(rf__f4_add(rf__f4_mul(m->m1, *x), rf__f4_mul(m->m5, *y)), rf__f4_mul(m->m9, *z));
+    rf__f4 rz = rf__f4_add(rf__f4_add(rf__f4_mul(m->m2, *x), rf__f4_mul(m->m6, *y)), rf__f4_mul(m->m10, *z));
+
+    if (translate)
+    {
+        rx = rf__f4_add(rx, m->m12);
+        ry = rf__f4_add(ry, m->m13);
+        rz = rf__f4_add(rz, m->m14);
+    }
+
+    *x = rx;
+    *y = ry;
+    *z = rz;
+}
+
+// One stored row of a product, see rf_mat_mul_ptr
+rf_internal inline rf__f4 rf__mat_mul_row(rf__f4 l0, rf__f4 l1, rf__f4 l2, rf__f4 l3, rf__f4 right_row)
+{
+    rf__f4 result = rf__f4_mul(l0, rf__f4_shuffle(right_row, 0, 0, 0, 0));
+    result = rf__f4_add(result, rf__f4_mul(l1, rf__f4_shuffle(right_row, 1, 1, 1, 1)));
+    result = rf__f4_add(result, rf__f4_mul(l2, rf__f4_shuffle(right_row, 2, 2, 2, 2)));
+    result = rf__f4_add(result, rf__f4_mul(l3, rf__f4_shuffle(right_row, 3, 3, 3, 3)));
+    return result;
+}
+
+// One stored row of an inverse, the sum of three products of cofactor terms with the signs flipped by the masks
+rf_internal inline rf__f4 rf__mat_invert_row(rf__f4 a, rf__f4 b1, rf__f4 b2, rf__f4 b3, rf__f4 signs_1_3, rf__f4 signs_2, rf__f4 inv_det)
+{
+    rf__f4 t1 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 1, 0, 0, 0), signs_1_3), b1);
+    rf__f4 t2 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 2, 2, 1, 1), signs_2), b2);
+    rf__f4 t3 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 3, 3, 3, 2), signs_1_3), b3);
+
+    rf__f4 result = rf__f4_mul(rf__f4_add(rf__f4_add(t1, t2), t3), inv_det);
+    return result;
+}
+
+#endif
+
+#pragma endregion
+
 #pragma region vec and matrix math
 
 // Add two vectors (v1 + v2)
@@ -342,19 +510,223 @@ rf_public void rf_vec3_ortho_normalize(rf_vec3 *v1, rf_vec3 *v2)
 
 // Transforms a rf_vec3 by a given rf_mat
 rf_public rf_vec3 rf_vec3_transform(rf_vec3 v, rf_mat mat)
+{
+    rf_vec3 result = rf_vec3_transform_ptr(v, &mat);
+    return result;
+}
+
+rf_public rf_vec3 rf_vec3_transform_ptr(rf_vec3 v, const rf_mat* mat)
 {
     rf_vec3 result = {0};
     float x = v.x;
     float y = v.y;
     float z = v.z;
 
-    result.x = mat.m0 * x + mat.m4 * y + mat.m8 * z + mat.m12;
-    result.y = mat.m1 * x + mat.m5 * y + mat.m9 * z + mat.m13;
-    result.z = mat.m2 * x + mat.m6 * y + mat.m10 * z + mat.m14;
+    #if defined(RF__MATH_SIMD)
+    {
+        rf__f4 columns[4];
+        rf__mat_load_columns(mat, columns);
+
+        rf__f4 sum = rf__f4_mul(columns[0], rf__f4_splat(x));
+        sum = rf__f4_add(sum, rf__f4_mul(columns[1], rf__f4_splat(y)));
+        sum = rf__f4_add(sum, rf__f4_mul(columns[2], rf__f4_splat(z)));
+        sum = rf__f4_add(sum, columns[3]);
+
+        float lanes[4];
+        rf__f4_store(lanes, sum);
+
+        result.x = lanes[0];
+        result.y = lanes[1];
+        result.z = lanes[2];
+    }
+    #else
+    {
+        result.x = mat->m0 * x + mat->m4 * y + mat->m8 * z + mat->m12;
+        result.y = mat->m1 * x + mat->m5 * y + mat->m9 * z + mat->m13;
+        result.z = mat->m2 * x + mat->m6 * y + mat->m10 * z + mat->m14;
+    }
+    #endif
 
     return result;
 }
 
+rf_internal inline void rf__vec3_transform_scalar(const rf_mat* mat, rf_bool translate, const float* src, float* dst)
+{
+    float x = src[0];
+    float y = src[1];
+    float z = src[2];
+
+    if (translate)
+    {
+        dst[0] = mat->m0 * x + mat->m4 * y + mat->m8 * z + mat->m12;
+        dst[1] = mat->m1 * x + mat->m5 * y + mat->m9 * z + mat->m13;
+        dst[2] = mat->m2 * x + mat->m6 * y + mat->m10 * z + mat->m14;
+    }
+    else
+    {
+        dst[0] = mat->m0 * x + mat->m4 * y + mat->m8 * z;
+        dst[1] = mat->m1 * x + mat->m5 * y + mat->m9 * z;
+        dst[2] = mat->m2 * x + mat->m6 * y + mat->m10 * z;
+    }
+}
+
+rf_internal void rf__vec3_transform_array(const rf_mat* mat, rf_bool translate, const void* src, rf_int src_stride, void* dst, rf_int dst_stride, rf_int count)
+{
+    const char* src_bytes = src;
+    char* dst_bytes = dst;
+    rf_int i = 0;
+
+    #if defined(RF__MATH_SIMD)
+    rf__mat_lanes m = rf__mat_lanes_make(mat);
+
+    if (src_stride == sizeof(rf_vec3) && dst_stride == sizeof(rf_vec3))
+    {
+        // 4 packed points are 3 vectors { x0 y0 z0 x1 } { y1 z1 x2 y2 } { z2 x3 y3 z3 } which get shuffled to x, y and z lanes and back
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* in = (const float*) (src_bytes + i * sizeof(rf_vec3));
+            float* out = (float*) (dst_bytes + i * sizeof(rf_vec3));
+
+            rf__f4 v0 = rf__f4_load(in);
+            rf__f4 v1 = rf__f4_load(in + 4);
+            rf__f4 v2 = rf__f4_load(in + 8);
+
+            rf__f4 x = rf__f4_shuffle2(v0, rf__f4_shuffle2(v1, v2, 2, 2, 1, 1), 0, 3, 0, 2);
+            rf__f4 y = rf__f4_shuffle2(rf__f4_shuffle2(v0, v1, 1, 1, 0, 0), rf__f4_shuffle2(v1, v2, 3, 3, 2, 2), 0, 2, 0, 2);
+            rf__f4 z = rf__f4_shuffle2(rf__f4_shuffle2(v0, v1, 2, 2, 1, 1), v2, 0, 2, 0, 3);
+
+            rf__mat_lanes_transform(&m, translate, &x, &y, &z);
+
+            rf__f4_store(out,     rf__f4_shuffle2(rf__f4_shuffle2(x, y, 0, 0, 0, 0), rf__f4_shuffle2(z, x, 0, 0, 1, 1), 0, 2, 0, 2));
+            rf__f4_store(out + 4, rf__f4_shuffle2(rf__f4_shuffle2(y, z, 1, 1, 1, 1), rf__f4_shuffle2(x, y, 2, 2, 2, 2), 0, 2, 0, 2));
+            rf__f4_store(out + 8, rf__f4_shuffle2(rf__f4_shuffle2(z, x, 2, 2, 3, 3), rf__f4_shuffle2(y, z, 3, 3, 3, 3), 0, 2, 0, 2));
+        }
+    }
+    else
+    {
+        for (; i + 4 <= count; i += 4)
+        {
+            const float* p0 = (const float*) (src_bytes + (i + 0) * src_stride);
+            const float* p1 = (const float*) (src_bytes + (i + 1) * src_stride);
+            const float* p2 = (const float*) (src_bytes + (i + 2) * src_stride);
+            const float* p3 = (const float*) (src_bytes + (i + 3) * src_stride);
+
+            rf__f4 x = rf__f4_set(p0[0], p1[0], p2[0], p3[0]);
+            rf__f4 y = rf__f4_set(p0[1], p1[1], p2[1], p3[1]);
+            rf__f4 z = rf__f4_set(p0[2], p1[2], p2[2], p3[2]);
+
+            rf__mat_lanes_transform(&m, translate, &x, &y, &z);
+
+            float lanes[3][4];
+            rf__f4_store(lanes[0], x);
+            rf__f4_store(lanes[1], y);
+            rf__f4_store(lanes[2], z);
+
+            for (int j = 0; j < 4; j++)
+            {
+                float* out = (float*) (dst_bytes + (i + j) * dst_stride);
+                out[0] = lanes[0][j];
+                out[1] = lanes[1][j];
+                out[2] = lanes[2][j];
+            }
+        }
+    }
+    #endif
+
+    for (; i < count; i++)
+    {
+        rf__vec3_transform_scalar(mat, translate, (const float*) (src_bytes + i * src_stride), (float*) (dst_bytes + i * dst_stride));
+    }
+}
+
+rf_public void rf_vec3_transform_array(const rf_mat* mat, const rf_vec3* src, rf_vec3* dst, rf_int count)
+{
+    rf__vec3_transform_array(mat, 1, src, sizeof(rf_vec3), dst, sizeof(rf_vec3), count);
+}
+
+rf_public void rf_vec3_transform_array_strided(const rf_mat* mat, const void* src, rf_int src_stride, void* dst, rf_int dst_stride, rf_int count)
+{
+    rf__vec3_transform_array(mat, 1, src, src_stride, dst, dst_stride, count);
+}
+
+rf_public void rf_vec3_transform_normals_array(const rf_mat* mat, const rf_vec3* src, rf_vec3* dst, rf_int count)
+{
+    rf__vec3_transform_array(mat, 0, src, sizeof(rf_vec3), dst, sizeof(rf_vec3), count);
+}
+
+rf_public void rf_vec3_transform_normals_array_strided(const rf_mat* mat, const void* src, rf_int src_stride, void* dst, rf_int dst_stride, rf_int count)
+{
+    rf__vec3_transform_array(mat, 0, src, src_stride, dst, dst_stride, count);
+}
+
+rf_public void rf_vec3_transform_array_soa(const rf_mat* mat, const float* x, const float* y, const float* z, float* dst_x, float* dst_y, float* dst_z, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF__MATH_SIMD)
+    rf__mat_lanes m = rf__mat_lanes_make(mat);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        rf__f4 lanes_x = rf__f4_load(x + i);
+        rf__f4 lanes_y = rf__f4_load(y + i);
+        rf__f4 lanes_z = rf__f4_load(z + i);
+
+        rf__mat_lanes_transform(&m, 1, &lanes_x, &lanes_y, &lanes_z);
+
+        rf__f4_store(dst_x + i, lanes_x);
+        rf__f4_store(dst_y + i, lanes_y);
+        rf__f4_store(dst_z + i, lanes_z);
+    }
+    #endif
+
+    for (; i < count; i++)
+    {
+        float point[3] = { x[i], y[i], z[i] };
+        rf__vec3_transform_scalar(mat, 1, point, point);
+
+        dst_x[i] = point[0];
+        dst_y[i] = point[1];
+        dst_z[i] = point[2];
+    }
+}
+
+rf_public void rf_vec2_transform_array(const rf_mat* mat, const rf_vec2* src, rf_vec2* dst, rf_int count)
+{
+    rf_int i = 0;
+
+    #if defined(RF__MATH_SIMD)
+    rf__f4 m0 = rf__f4_splat(mat->m0), m1 = rf__f4_splat(mat->m1);
+    rf__f4 m4 = rf__f4_splat(mat->m4), m5 = rf__f4_splat(mat->m5);
+    rf__f4 m12 = rf__f4_splat(mat->m12), m13 = rf__f4_splat(mat->m13);
+
+    // 4 packed points are 2 vectors { x0 y0 x1 y1 } { x2 y2 x3 y3 }
+    for (; i + 4 <= count; i += 4)
+    {
+        rf__f4 v0 = rf__f4_load(&src[i].x);
+        rf__f4 v1 = rf__f4_load(&src[i + 2].x);
+
+        rf__f4 x = rf__f4_shuffle2(v0, v1, 0, 2, 0, 2);
+        rf__f4 y = rf__f4_shuffle2(v0, v1, 1, 3, 1, 3);
+
+        rf__f4 rx = rf__f4_add(rf__f4_add(rf__f4_mul(m0, x), rf__f4_mul(m4, y)), m12);
+        rf__f4 ry = rf__f4_add(rf__f4_add(rf__f4_mul(m1, x), rf__f4_mul(m5, y)), m13);
+
+        rf__f4_store(&dst[i].x,     rf__f4_shuffle(rf__f4_shuffle2(rx, ry, 0, 1, 0, 1), 0, 2, 1, 3));
+        rf__f4_store(&dst[i + 2].x, rf__f4_shuffle(rf__f4_shuffle2(rx, ry, 2, 3, 2, 3), 0, 2, 1, 3));
+    }
+    #endif
+
+    for (; i < count; i++)
+    {
+        float x = src[i].x;
+        float y = src[i].y;
+
+        dst[i].x = mat->m0 * x + mat->m4 * y + mat->m12;
+        dst[i].y = mat->m1 * x + mat->m5 * y + mat->m13;
+    }
+}
+
 // rf_transform a vector by quaternion rotation
 rf_public rf_vec3 rf_vec3_rotate_by_quaternion(rf_vec3 v, rf_quaternion q)
 {
@@ -506,50 +878,109 @@ rf_public rf_mat rf_mat_transpose(rf_mat mat)
 // Invert provided matrix
 rf_public rf_mat rf_mat_invert(rf_mat mat)
 {
-    rf_mat result = {0};
-
-// Cache the matrix values (speed optimization)
-    float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
-    float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
-    float a20 = mat.m8, a21 = mat.m9, a22 = mat.m10, a23 = mat.m11;
-    float a30 = mat.m12, a31 = mat.m13, a32 = mat.m14, a33 = mat.m15;
-
-    float b00 = a00 * a11 - a01 * a10;
-    float b01 = a00 * a12 - a02 * a10;
-    float b02 = a00 * a13 - a03 * a10;
-    float b03 = a01 * a12 - a02 * a11;
-    float b04 = a01 * a13 - a03 * a11;
-    float b05 = a02 * a13 - a03 * a12;
-    float b06 = a20 * a31 - a21 * a30;
-    float b07 = a20 * a32 - a22 * a30;
-    float b08 = a20 * a33 - a23 * a30;
-    float b09 = a21 * a32 - a22 * a31;
-    float b10 = a21 * a33 - a23 * a31;
-    float b11 = a22 * a33 - a23 * a32;
-
-// Calculate the invert determinant (inlined to avoid double-caching)
-    float invDet = 1.0f / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06);
-
-    result.m0 = (a11 * b11 - a12 * b10 + a13 * b09) * invDet;
-    result.m1 = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet;
-    result.m2 = (a31 * b05 - a32 * b04 + a33 * b03) * invDet;
-    result.m3 = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet;
-    result.m4 = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet;
-    result.m5 = (a00 * b11 - a02 * b08 + a03 * b07) * invDet;
-    result.m6 = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet;
-    result.m7 = (a20 * b05 - a22 * b02 + a23 * b01) * invDet;
-    result.m8 = (a10 * b10 - a11 * b08 + a13 * b06) * invDet;
-    result.m9 = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet;
-    result.m10 = (a30 * b04 - a31 * b02 + a33 * b00) * invDet;
-    result.m11 = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet;
-    result.m12 = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet;
-    result.m13 = (a00 * b09 - a01 * b07 + a02 * b06) * invDet;
-    result.m14 = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet;
-    result.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
-
+    rf_mat result;
+    rf_mat_invert_ptr(&mat, &result);
     return result;
 }
 
+rf_public void rf_mat_invert_ptr(const rf_mat* mat, rf_mat* dst)
+{
+    #if defined(RF__MATH_SIMD)
+    {
+        // a[i] holds a_i0 to a_i3 of the scalar version below
+        rf__f4 a[4];
+        rf__mat_load_columns(mat, a);
+
+        // b00 to b03, b04 to b07 and b08 to b11
+        rf__f4 b_lo  = rf__f4_sub(rf__f4_mul(rf__f4_shuffle(a[0], 0, 0, 0, 1), rf__f4_shuffle(a[1], 1, 2, 3, 2)), rf__f4_mul(rf__f4_shuffle(a[0], 1, 2, 3, 2), rf__f4_shuffle(a[1], 0, 0, 0, 1)));
+        rf__f4 b_mid = rf__f4_sub(rf__f4_mul(rf__f4_shuffle2(a[0], a[2], 1, 2, 0, 0), rf__f4_shuffle2(a[1], a[3], 3, 3, 1, 2)), rf__f4_mul(rf__f4_shuffle2(a[0], a[2], 3, 3, 1, 2), rf__f4_shuffle2(a[1], a[3], 1, 2, 0, 0)));
+        rf__f4 b_hi  = rf__f4_sub(rf__f4_mul(rf__f4_shuffle(a[2], 0, 1, 1, 2), rf__f4_shuffle(a[3], 3, 2, 3, 3)), rf__f4_mul(rf__f4_shuffle(a[2], 3, 2, 3, 3), rf__f4_shuffle(a[3], 0, 1, 1, 2)));
+
+        // The determinant is a chain of dependent operations, so it stays scalar
+        float b[12];
+        rf__f4_store(b, b_lo);
+        rf__f4_store(b + 4, b_mid);
+        rf__f4_store(b + 8, b_hi);
+
+        float inv_det = 1.0f / (b[0] * b[11] - b[1] * b[10] + b[2] * b[9] + b[3] * b[8] - b[4] * b[7] + b[5] * b[6]);
+
+        // The b terms each product uses, the same for rows 0 and 1 and for rows 2 and 3
+        rf__f4 t;
+        rf__f4 b01_1 = rf__f4_shuffle(b_hi, 3, 3, 2, 1);
+        t = rf__f4_shuffle2(b_hi, b_mid, 0, 0, 3, 3);
+        rf__f4 b01_2 = rf__f4_shuffle2(b_hi, t, 2, 0, 1, 2);
+        t = rf__f4_shuffle2(b_hi, b_mid, 1, 1, 3, 2);
+        rf__f4 b01_3 = rf__f4_shuffle(t, 0, 2, 3, 3);
+
+        t = rf__f4_shuffle2(b_mid, b_lo, 0, 0, 3, 3);
+        rf__f4 b23_1 = rf__f4_shuffle2(b_mid, t, 1, 1, 1, 2);
+        t = rf__f4_shuffle2(b_mid, b_lo, 0, 0, 2, 1);
+        rf__f4 b23_2 = rf__f4_shuffle(t, 0, 2, 2, 3);
+        rf__f4 b23_3 = rf__f4_shuffle(b_lo, 3, 1, 0, 0);
+
+        const rf__f4 flip_odd  = rf__f4_set(0.0f, -0.0f, 0.0f, -0.0f);
+        const rf__f4 flip_even = rf__f4_set(-0.0f, 0.0f, -0.0f, 0.0f);
+        const rf__f4 inv_det4  = rf__f4_splat(inv_det);
+
+        float* result = (float*) dst;
+        rf__f4 r0 = rf__mat_invert_row(a[1], b01_1, b01_2, b01_3, flip_odd,  flip_even, inv_det4);
+        rf__f4 r1 = rf__mat_invert_row(a[0], b01_1, b01_2, b01_3, flip_even, flip_odd,  inv_det4);
+        rf__f4 r2 = rf__mat_invert_row(a[3], b23_1, b23_2, b23_3, flip_odd,  flip_even, inv_det4);
+        rf__f4 r3 = rf__mat_invert_row(a[2], b23_1, b23_2, b23_3, flip_even, flip_odd,  inv_det4);
+
+        rf__f4_store(result, r0);
+        rf__f4_store(result + 4, r1);
+        rf__f4_store(result + 8, r2);
+        rf__f4_store(result + 12, r3);
+    }
+    #else
+    {
+        rf_mat result = {0};
+
+        // Cache the matrix values (speed optimization)
+        float a00 = mat->m0, a01 = mat->m1, a02 = mat->m2, a03 = mat->m3;
+        float a10 = mat->m4, a11 = mat->m5, a12 = mat->m6, a13 = mat->m7;
+        float a20 = mat->m8, a21 = mat->m9, a22 = mat->m10, a23 = mat->m11;
+        float a30 = mat->m12, a31 = mat->m13, a32 = mat->m14, a33 = mat->m15;
+
+        float b00 = a00 * a11 - a01 * a10;
+        float b01 = a00 * a12 - a02 * a10;
+        float b02 = a00 * a13 - a03 * a10;
+        float b03 = a01 * a12 - a02 * a11;
+        float b04 = a01 * a13 - a03 * a11;
+        float b05 = a02 * a13 - a03 * a12;
+        float b06 = a20 * a31 - a21 * a30;
+        float b07 = a20 * a32 - a22 * a30;
+        float b08 = a20 * a33 - a23 * a30;
+        float b09 = a21 * a32 - a22 * a31;
+        float b10 = a21 * a33 - a23 * a31;
+        float b11 = a22 * a33 - a23 * a32;
+
+        // Calculate the invert determinant (inlined to avoid double-caching)
+        float invDet = 1.0f / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06);
+
+        result.m0 = (a11 * b11 - a12 * b10 + a13 * b09) * invDet;
+        result.m1 = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet;
+        result.m2 = (a31 * b05 - a32 * b04 + a33 * b03) * invDet;
+        result.m3 = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet;
+        result.m4 = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet;
+        result.m5 = (a00 * b11 - a02 * b08 + a03 * b07) * invDet;
+        result.m6 = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet;
+        result.m7 = (a20 * b05 - a22 * b02 + a23 * b01) * invDet;
+        result.m8 = (a10 * b10 - a11 * b08 + a13 * b06) * invDet;
+        result.m9 = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet;
+        result.m10 = (a30 * b04 - a31 * b02 + a33 * b00) * invDet;
+        result.m11 = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet;
+        result.m12 = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet;
+        result.m13 = (a00 * b09 - a01 * b07 + a02 * b06) * invDet;
+        result.m14 = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet;
+        result.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
+
+        *dst = result;
+    }
+    #endif
+}
+
 // Normalize provided matrix
 rf_public rf_mat rf_mat_normalize(rf_mat mat)
 {
@@ -784,28 +1215,88 @@ rf_public rf_mat rf_mat_scale(float x, float y, float z)
 // NOTE: When multiplying matrices... the order matters!
 rf_public rf_mat rf_mat_mul(rf_mat left, rf_mat right)
 {
-    rf_mat result = {0};
-
-    result.m0 = left.m0 * right.m0 + left.m1 * right.m4 + left.m2 * right.m8 + left.m3 * right.m12;
-    result.m1 = left.m0 * right.m1 + left.m1 * right.m5 + left.m2 * right.m9 + left.m3 * right.m13;
-    result.m2 = left.m0 * right.m2 + left.m1 * right.m6 + left.m2 * right.m10 + left.m3 * right.m14;
-    result.m3 = left.m0 * right.m3 + left.m1 * right.m7 + left.m2 * right.m11 + left.m3 * right.m15;
-    result.m4 = left.m4 * right.m0 + left.m5 * right.m4 + left.m6 * right.m8 + left.m7 * right.m12;
-    result.m5 = left.m4 * right.m1 + left.m5 * right.m5 + left.m6 * right.m9 + left.m7 * right.m13;
-    result.m6 = left.m4 * right.m2 + left.m5 * right.m6 + left.m6 * right.m10 + left.m7 * right.m14;
-    result.m7 = left.m4 * right.m3 + left.m5 * right.m7 + left.m6 * right.m11 + left.m7 * right.m15;
-    result.m8 = left.m8 * right.m0 + left.m9 * right.m4 + left.m10 * right.m8 + left.m11 * right.m12;
-    result.m9 = left.m8 * right.m1 + left.m9 * right.m5 + left.m10 * right.m9 + left.m11 * right.m13;
-    result.m10 = left.m8 * right.m2 + left.m9 * right.m6 + left.m10 * right.m10 + left.m11 * right.m14;
-    result.m11 = left.m8 * right.m3 + left.m9 * right.m7 + left.m10 * right.m11 + left.m11 * right.m15;
-    result.m12 = left.m12 * right.m0 + left.m13 * right.m4 + left.m14 * right.m8 + left.m15 * right.m12;
-    result.m13 = left.m12 * right.m1 + left.m13 * right.m5 + left.m14 * right.m9 + left.m15 * right.m13;
-    result.m14 = left.m12 * right.m2 + left.m13 * right.m6 + left.m14 * right.m10 + left.m15 * right.m14;
-    result.m15 = left.m12 * right.m3 + left.m13 * right.m7 + left.m14 * right.m11 + left.m15 * right.m15;
-
+    rf_mat result;
+    rf_mat_mul_ptr(&left, &right, &result);
     return result;
 }
 
+rf_public void rf_mat_mul_ptr(const rf_mat* left, const rf_mat* right, rf_mat* dst)
+{
+    // Stored row r of the result is the sum of the stored rows k of left times element k of stored row r of right
+    #if defined(rayfork_avx2)
+    {
+        const float* l = (const float*) left;
+        const float* r = (const float*) right;
+
+        __m256 l0 = _mm256_broadcast_ps((const __m128*) l);
+        __m256 l1 = _mm256_broadcast_ps((const __m128*) (l + 4));
+        __m256 l2 = _mm256_broadcast_ps((const __m128*) (l + 8));
+        __m256 l3 = _mm256_broadcast_ps((const __m128*) (l + 12));
+
+        // Matrices passed by value are usually just copied to the stack with 16 byte stores, a 32 byte load of them would stall
+        __m256 r01 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r)), _mm_loadu_ps(r + 4), 1);
+        __m256 r23 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(r + 8)), _mm_loadu_ps(r + 12), 1);
+
+        // Two rows at a time, the permutes broadcast element k within each half
+        __m256 result01 = _mm256_mul_ps(l0, _mm256_permute_ps(r01, 0x00));
+        result01 = _mm256_add_ps(result01, _mm256_mul_ps(l1, _mm256_permute_ps(r01, 0x55)));
+        result01 = _mm256_add_ps(result01, _mm256_mul_ps(l2, _mm256_permute_ps(r01, 0xaa)));
+        result01 = _mm256_add_ps(result01, _mm256_mul_ps(l3, _mm256_permute_ps(r01, 0xff)));
+
+        __m256 result23 = _mm256_mul_ps(l0, _mm256_permute_ps(r23, 0x00));
+        result23 = _mm256_add_ps(result23, _mm256_mul_ps(l1, _mm256_permute_ps(r23, 0x55)));
+        result23 = _mm256_add_ps(result23, _mm256_mul_ps(l2, _mm256_permute_ps(r23, 0xaa)));
+        result23 = _mm256_add_ps(result23, _mm256_mul_ps(l3, _mm256_permute_ps(r23, 0xff)));
+
+        _mm256_storeu_ps((float*) dst, result01);
+        _mm256_storeu_ps((float*) dst + 8, result23);
+    }
+    #elif defined(RF__MATH_SIMD)
+    {
+        const float* l = (const float*) left;
+        const float* r = (const float*) right;
+
+        rf__f4 l0 = rf__f4_load(l);
+        rf__f4 l1 = rf__f4_load(l + 4);
+        rf__f4 l2 = rf__f4_load(l + 8);
+        rf__f4 l3 = rf__f4_load(l + 12);
+
+        rf__f4 result0 = rf__mat_mul_row(l0, l1, l2, l3, rf__f4_load(r));
+        rf__f4 result1 = rf__mat_mul_row(l0, l1, l2, l3, rf__f4_load(r + 4));
+        rf__f4 result2 = rf__mat_mul_row(l0, l1, l2, l3, rf__f4_load(r + 8));
+        rf__f4 result3 = rf__mat_mul_row(l0, l1, l2, l3, rf__f4_load(r + 12));
+
+        rf__f4_store((float*) dst, result0);
+        rf__f4_store((float*) dst + 4, result1);
+        rf__f4_store((float*) dst + 8, result2);
+        rf__f4_store((float*) dst + 12, result3);
+    }
+    #else
+    {
+        rf_mat result = {0};
+
+        result.m0 = left->m0 * right->m0 + left->m1 * right->m4 + left->m2 * right->m8 + left->m3 * right->m12;
+        result.m1 = left->m0 * right->m1 + left->m1 * right->m5 + left->m2 * right->m9 + left->m3 * right->m13;
+        result.m2 = left->m0 * right->m2 + left->m1 * right->m6 + left->m2 * right->m10 + left->m3 * right->m14;
+        result.m3 = left->m0 * right->m3 + left->m1 * right->m7 + left->m2 * right->m11 + left->m3 * right->m15;
+        result.m4 = left->m4 * right->m0 + left->m5 * right->m4 + left->m6 * right->m8 + left->m7 * right->m12;
+        result.m5 = left->m4 * right->m1 + left->m5 * right->m5 + left->m6 * right->m9 + left->m7 * right->m13;
+        result.m6 = left->m4 * right->m2 + left->m5 * right->m6 + left->m6 * right->m10 + left->m7 * right->m14;
+        result.m7 = left->m4 * right->m3 + left->m5 * right->m7 + left->m6 * right->m11 + left->m7 * right->m15;
+        result.m8 = left->m8 * right->m0 + left->m9 * right->m4 + left->m10 * right->m8 + left->m11 * right->m12;
+        result.m9 = left->m8 * right->m1 + left->m9 * right->m5 + left->m10 * right->m9 + left->m11 * right->m13;
+        result.m10 = left->m8 * right->m2 + left->m9 * right->m6 + left->m10 * right->m10 + left->m11 * right->m14;
+        result.m11 = left->m8 * right->m3 + left->m9 * right->m7 + left->m10 * right->m11 + left->m11 * right->m15;
+        result.m12 = left->m12 * right->m0 + left->m13 * right->m4 + left->m14 * right->m8 + left->m15 * right->m12;
+        result.m13 = left->m12 * right->m1 + left->m13 * right->m5 + left->m14 * right->m9 + left->m15 * right->m13;
+        result.m14 = left->m12 * right->m2 + left->m13 * right->m6 + left->m14 * right->m10 + left->m15 * right->m14;
+        result.m15 = left->m12 * right->m3 + left->m13 * right->m7 + left->m14 * right->m11 + left->m15 * right->m15;
+
+        *dst = result;
+    }
+    #endif
+}
+
 // Returns perspective GL_PROJECTION matrix
 rf_public rf_mat rf_mat_frustum(double left, double right, double bottom, double top, double near_val, double far_val)
 {
@@ -993,13 +1484,30 @@ rf_public rf_quaternion rf_quaternion_mul(rf_quaternion q1, rf_quaternion q2)
 {
     rf_quaternion result = {0};
 
-    float qax = q1.x, qay = q1.y, qaz = q1.z, qaw = q1.w;
-    float qbx = q2.x, qby = q2.y, qbz = q2.z, qbw = q2.w;
+    #if defined(RF__MATH_SIMD)
+    {
+        rf__f4 a = rf__f4_load(&q1.x);
+        rf__f4 b = rf__f4_load(&q2.x);
+
+        // The terms of x, y, z and w below in columns, w subtracts from its second term on
+        rf__f4 t1 = rf__f4_mul(a, rf__f4_shuffle(b, 3, 3, 3, 3));
+        rf__f4 t2 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 3, 3, 3, 0), rf__f4_set(0.0f, 0.0f, 0.0f, -0.0f)), rf__f4_shuffle(b, 0, 1, 2, 0));
+        rf__f4 t3 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 1, 2, 0, 1), rf__f4_set(0.0f, 0.0f, 0.0f, -0.0f)), rf__f4_shuffle(b, 2, 0, 1, 1));
+        rf__f4 t4 = rf__f4_mul(rf__f4_xor(rf__f4_shuffle(a, 2, 0, 1, 2), rf__f4_splat(-0.0f)), rf__f4_shuffle(b, 1, 2, 0, 2));
+
+        rf__f4_store(&result.x, rf__f4_add(rf__f4_add(rf__f4_add(t1, t2), t3), t4));
+    }
+    #else
+    {
+        float qax = q1.x, qay = q1.y, qaz = q1.z, qaw = q1.w;
+        float qbx = q2.x, qby = q2.y, qbz = q2.z, qbw = q2.w;
 
-    result.x = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
-    result.y = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
-    result.z = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
-    result.w = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+        result.x = qax * qbw + qaw * qbx + qay * qbz - qaz * qby;
+        result.y = qay * qbw + qaw * qby + qaz * qbx - qax * qbz;
+        result.z = qaz * qbw + qaw * qbz + qax * qby - qay * qbx;
+        result.w = qaw * qbw - qax * qbx - qay * qby - qaz * qbz;
+    }
+    #endif
 
     return result;
 }
@@ -1655,4 +2163,8 @@ rf_public rf_ray_hit_info rf_collision_ray_ground(rf_ray ray, float ground_heigh
     return result;
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#if defined(rayfork_clang)
+    #pragma STDC FP_CONTRACT DEFAULT
+#endif
@@ -122,6 +122,15 @@ rf_public rf_vec3 rf_vec3_div_v(rf_vec3 v1, rf_vec3 v2); // Divide vector by vec
 rf_public rf_vec3 rf_vec3_normalize(rf_vec3 v); // Normalize provided vector
 rf_public void rf_vec3_ortho_normalize(rf_vec3* v1, rf_vec3* v2); // Orthonormalize provided vectors. Makes vectors normalized and orthogonal to each other. Gram-Schmidt function implementation
 rf_public rf_vec3 rf_vec3_transform(rf_vec3 v, rf_mat mat); // Transforms a rf_vec3 by a given rf_mat
+rf_public rf_vec3 rf_vec3_transform_ptr(rf_vec3 v, const rf_mat* mat); // Same as rf_vec3_transform without copying the matrix
+
+// Transform arrays of points 4 at a time with the same results as rf_vec3_transform (with fma contraction off, see rayfork-math.c), dst can be src. Strides are in bytes, eg: for positions in interleaved vertices
+rf_public void rf_vec3_transform_array(const rf_mat* mat, const rf_vec3* src, rf_vec3* dst, rf_int count);
+rf_public void rf_vec3_transform_array_strided(const rf_mat* mat, const void* src, rf_int src_stride, void* dst, rf_int dst_stride, rf_int count);
+rf_public void rf_vec3_transform_array_soa(const rf_mat* mat, const float* x, const float* y, const float* z, float* dst_x, float* dst_y, float* dst_z, rf_int count);
+rf_public void rf_vec3_transform_normals_array(const rf_mat* mat, const rf_vec3* src, rf_vec3* dst, rf_int count); // Without the translation and without normalizing, use the inverse transpose for matrices with non uniform scale
+rf_public void rf_vec3_transform_normals_array_strided(const rf_mat* mat, const void* src, rf_int src_stride, void* dst, rf_int dst_stride, rf_int count);
+rf_public void rf_vec2_transform_array(const rf_mat* mat, const rf_vec2* src, rf_vec2* dst, rf_int count); // Points on the z = 0 plane, the z of the results is dropped
 rf_public rf_vec3 rf_vec3_rotate_by_quaternion(rf_vec3 v, rf_quaternion q); // rf_transform a vector by quaternion rotation
 rf_public rf_vec3 rf_vec3_lerp(rf_vec3 v1, rf_vec3 v2, float amount); // Calculate linear interpolation between two vectors
 rf_public rf_vec3 rf_vec3_reflect(rf_vec3 v, rf_vec3 normal); // Calculate reflected vector to normal
@@ -133,6 +142,7 @@ rf_public float rf_mat_determinant(rf_mat mat); // Compute matrix determinant
 rf_public float rf_mat_trace(rf_mat mat); // Returns the trace of the matrix (sum of the values along the diagonal)
 rf_public rf_mat rf_mat_transpose(rf_mat mat); // Transposes provided matrix
 rf_public rf_mat rf_mat_invert(rf_mat mat); // Invert provided matrix
+rf_public void rf_mat_invert_ptr(const rf_mat* mat, rf_mat* dst); // Same as rf_mat_invert without copying the matrices, dst can be mat
 rf_public rf_mat rf_mat_normalize(rf_mat mat); // Normalize provided matrix
 rf_public rf_mat rf_mat_identity(void); // Returns identity matrix
 rf_public rf_mat rf_mat_add(rf_mat left, rf_mat right); // Add two matrices
@@ -145,6 +155,7 @@ rf_public rf_mat rf_mat_rotate_y(float angle); // Returns y-rotation matrix (ang
 rf_public rf_mat rf_mat_rotate_z(float angle); // Returns z-rotation matrix (angle in radians)
 rf_public rf_mat rf_mat_scale(float x, float y, float z); // Returns scaling matrix
 rf_public rf_mat rf_mat_mul(rf_mat left, rf_mat right); // Returns two matrix multiplication. NOTE: When multiplying matrices... the order matters!
+rf_public void rf_mat_mul_ptr(const rf_mat* left, const rf_mat* right, rf_mat* dst); // Same as rf_mat_mul without copying the matrices, dst can be left or right
 rf_public rf_mat rf_mat_frustum(double left, double right, double bottom, double top, double near_val, double far_val); // Returns perspective GL_PROJECTION matrix
 rf_public rf_mat rf_mat_perspective(double fovy, double aspect, double near_val, double far_val); // Returns perspective GL_PROJECTION matrix. NOTE: Angle should be provided in radians
 rf_public rf_mat rf_mat_ortho(double left, double right, double bottom, double top, double near_val, double far_val); // Returns orthographic GL_PROJECTION matrix
@@ -0,0 +1,758 @@
+#include "rayfork-pack.h"
+#include "string.h"
+
+#pragma region lz4
+
+#define rf__lz4_min_match    (4)
+#define rf__lz4_last_literals (5)  // The last 5 bytes of a block are always literals
+#define rf__lz4_match_limit  (12) // The last match must start at least 12 bytes before the end of the block
+#define rf__lz4_hash_bits    (12)
+
+rf_internal uint32_t rf__lz4_read32(const unsigned char* p)
+{
+    uint32_t result;
+    memcpy(&result, p, sizeof(result));
+    return result;
+}
+
+rf_internal unsigned char* rf__lz4_write_length(unsigned char* op, rf_int length)
+{
+    while (length >= 255)
+    {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (unsigned char) length;
+    return op;
+}
+
+rf_public rf_int rf_lz4_compress_bound(rf_int src_size)
+{
+    rf_int result = src_size + (src_size / 255) + 16;
+    return result;
+}
+
+rf_public rf_int rf_lz4_compress_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size)
+{
+    if (!src || src_size < 0 || !dst || dst_size < rf_lz4_compress_bound(src_size)) return 0;
+
+    const unsigned char* in     = src;
+    const unsigned char* anchor = in;
+    const unsigned char* ip     = in;
+    const unsigned char* end    = in + src_size;
+    unsigned char*       op     = dst;
+
+    // Positions are stored plus one so that 0 means empty
+    uint32_t table[1 << rf__lz4_hash_bits] = {0};
+
+    if (src_size > rf__lz4_match_limit)
+    {
+        const unsigned char* match_limit = end - rf__lz4_match_limit;
+
+        while (ip < match_limit)
+        {
+            uint32_t sequence = rf__lz4_read32(ip);
+            uint32_t hash     = (sequence * 2654435761u) >> (32 - rf__lz4_hash_bits);
+            rf_int   ref_pos  = (rf_int) table[hash] - 1;
+            table[hash] = (uint32_t)(ip - in) + 1;
+
+            const unsigned char* ref = in + ref_pos;
+
+            if (ref_pos < 0 || ip - ref > 65535 || rf__lz4_read32(ref) != sequence)
+            {
+                ip++;
+                continue;
+            }
+
+            // Extend the match as far as we can while keeping the last bytes as literals
+            rf_int match_length = rf__lz4_min_match;
+            while (ip + match_length < end - rf__lz4_last_literals && ref[match_length] == ip[match_length])
+            {
+                match_length++;
+            }
+
+            rf_int literals_length = ip - anchor;
+            unsigned char* token = op++;
+
+            *token = (unsigned char)((literals_length >= 15 ? 15 : literals_length) << 4);
+            if (literals_length >= 15) op = rf__lz4_write_length(op, literals_length - 15);
+
+            memcpy(op, anchor, literals_length);
+            op += literals_length;
+
+            rf_int offset = ip - ref;
+            *op++ = (unsigned char)(offset & 0xff);
+            *op++ = (unsigned char)(offset >> 8);
+
+            rf_int encoded_match_length = match_length - rf__lz4_min_match;
+            *token |= (unsigned char)(encoded_match_length >= 15 ? 15 : encoded_match_length);
+            if (encoded_match_length >= 15) op = rf__lz4_write_length(op, encoded_match_length - 15);
+
+            ip += match_length;
+            anchor = ip;
+        }
+    }
+
+    // Last sequence, literals only
+    rf_int literals_length = end - anchor;
+    *op++ = (unsigned char)((literals_length >= 15 ? 15 : literals_length) << 4);
+    if (literals_length >= 15) op = rf__lz4_write_length(op, literals_length - 15);
+    memcpy(op, anchor, literals_length);
+    op += literals_length;
+
+    rf_int result = op - (unsigned char*) dst;
+    return result;
+}
+
+rf_public rf_int rf_lz4_decompress_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size)
+{
+    if (!src || src_size <= 0 || !dst || dst_size < 0) return rf_invalid_index;
+
+    const unsigned char* ip     = src;
+    const unsigned char* in_end = ip + src_size;
+    unsigned char*       op     = dst;
+    unsigned char*       out_end = op + dst_size;
+
+    while (ip < in_end)
+    {
+        unsigned token = *ip++;
+
+        rf_int literals_length = token >> 4;
+        if (literals_length == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= in_end) return rf_invalid_index;
+                b = *ip++;
+                literals_length += b;
+            } while (b == 255);
+        }
+
+        if (literals_length > in_end - ip || literals_length > out_end - op) return rf_invalid_index;
+        memcpy(op, ip, literals_length);
+        ip += literals_length;
+        op += literals_length;
+
+        // The last sequence only has literals
+        if (ip >= in_end) break;
+
+        if (in_end - ip < 2) return rf_invalid_index;
+        rf_int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+
+        if (offset == 0 || offset > op - (unsigned char*) dst) return rf_invalid_index;
+
+        rf_int match_length = token & 15;
+        if (match_length == 15)
+        {
+            unsigned char b;
+            do
+            {
+                if (ip >= in_end) return rf_invalid_index;
+                b = *ip++;
+                match_length += b;
+            } while (b == 255);
+        }
+        match_length += rf__lz4_min_match;
+
+        if (match_length > out_end - op) return rf_invalid_index;
+
+        // Matches can overlap with the output so we copy byte by byte
+        const unsigned char* match = op - offset;
+        for (rf_int i = 0; i < match_length; i++)
+        {
+            op[i] = match[i];
+        }
+        op += match_length;
+    }
+
+    rf_int result = op - (unsigned char*) dst;
+    return result;
+}
+
+#pragma endregion
+
+#pragma region pack reading
+
+rf_internal char rf__pack_normalize_path_char(char c)
+{
+    return c == '\\' ? '/' : c;
+}
+
+rf_internal const char* rf__pack_skip_path_prefix(const char* path)
+{
+    while (path[0] == '.' && (path[1] == '/' || path[1] == '\\')) path += 2;
+    return path;
+}
+
+rf_public uint64_t rf_pack_hash_path(const char* path, rf_int path_size)
+{
+    // FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ull;
+
+    for (rf_int i = 0; i < path_size; i++)
+    {
+        hash ^= (unsigned char) rf__pack_normalize_path_char(path[i]);
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+rf_internal rf_bool rf__pack_path_match(const char* stored, rf_int stored_size, const char* path, rf_int path_size)
+{
+    if (stored_size != path_size) return 0;
+
+    for (rf_int i = 0; i < path_size; i++)
+    {
+        if (rf__pack_normalize_path_char(stored[i]) != rf__pack_normalize_path_char(path[i])) return 0;
+    }
+
+    return 1;
+}
+
+// Archives are little endian whatever the host is, so the header and the index are written and read field by field
+#define rf__pack_header_size (40)
+#define rf__pack_entry_size  (48)
+
+rf_internal rf_bool rf__pack_host_is_little_endian(void)
+{
+    uint16_t one = 1;
+    unsigned char first_byte;
+    memcpy(&first_byte, &one, 1);
+
+    rf_bool result = first_byte == 1;
+    return result;
+}
+
+rf_internal uint64_t rf__pack_load_le(const char* src, rf_int size)
+{
+    uint64_t result = 0;
+    for (rf_int i = 0; i < size; i++) result |= (uint64_t)(unsigned char) src[i] << (i * 8);
+    return result;
+}
+
+rf_internal void rf__pack_store_le(char* dst, uint64_t value, rf_int size)
+{
+    for (rf_int i = 0; i < size; i++) dst[i] = (char)(value >> (i * 8));
+}
+
+rf_internal rf_pack_header rf__pack_load_header(const char* src)
+{
+    rf_pack_header result = {0};
+
+    memcpy(result.magic, src, 4);
+    result.version        = (uint32_t) rf__pack_load_le(src + 4,  4);
+    result.entry_count    = (uint32_t) rf__pack_load_le(src + 8,  4);
+    result.bucket_count   = (uint32_t) rf__pack_load_le(src + 12, 4);
+    result.index_offset   = rf__pack_load_le(src + 16, 8);
+    result.strings_offset = rf__pack_load_le(src + 24, 8);
+    result.strings_size   = rf__pack_load_le(src + 32, 8);
+
+    return result;
+}
+
+rf_internal void rf__pack_store_header(char* dst, const rf_pack_header* header)
+{
+    memcpy(dst, header->magic, 4);
+    rf__pack_store_le(dst + 4,  header->version,        4);
+    rf__pack_store_le(dst + 8,  header->entry_count,    4);
+    rf__pack_store_le(dst + 12, header->bucket_count,   4);
+    rf__pack_store_le(dst + 16, header->index_offset,   8);
+    rf__pack_store_le(dst + 24, header->strings_offset, 8);
+    rf__pack_store_le(dst + 32, header->strings_size,   8);
+}
+
+rf_internal rf_pack_entry rf__pack_load_entry(const char* src)
+{
+    rf_pack_entry result = {0};
+
+    result.path_hash     = rf__pack_load_le(src,      8);
+    result.data_offset   = rf__pack_load_le(src + 8,  8);
+    result.stored_size   = rf__pack_load_le(src + 16, 8);
+    result.original_size = rf__pack_load_le(src + 24, 8);
+    result.path_offset   = (uint32_t) rf__pack_load_le(src + 32, 4);
+    result.path_size     = (uint32_t) rf__pack_load_le(src + 36, 4);
+    result.compression   = (uint32_t) rf__pack_load_le(src + 40, 4);
+    result.reserved      = (uint32_t) rf__pack_load_le(src + 44, 4);
+
+    return result;
+}
+
+rf_internal void rf__pack_store_entry(char* dst, const rf_pack_entry* entry)
+{
+    rf__pack_store_le(dst,      entry->path_hash,     8);
+    rf__pack_store_le(dst + 8,  entry->data_offset,   8);
+    rf__pack_store_le(dst + 16, entry->stored_size,   8);
+    rf__pack_store_le(dst + 24, entry->original_size, 8);
+    rf__pack_store_le(dst + 32, entry->path_offset,   4);
+    rf__pack_store_le(dst + 36, entry->path_size,     4);
+    rf__pack_store_le(dst + 40, entry->compression,   4);
+    rf__pack_store_le(dst + 44, entry->reserved,      4);
+}
+
+// Checks that the header describes a well formed archive of the given size
+rf_internal rf_bool rf__pack_validate_header(const rf_pack_header* header, rf_int archive_size)
+{
+    uint64_t size       = archive_size;
+    uint64_t index_size = (uint64_t) header->bucket_count * rf__pack_entry_size;
+
+    rf_bool result = memcmp(header->magic, RF_PACK_MAGIC, 4) == 0 &&
+                     header->version == RF_PACK_VERSION &&
+                     header->bucket_count > 0 && (header->bucket_count & (header->bucket_count - 1)) == 0 &&
+                     header->entry_count < header->bucket_count &&
+                     header->index_offset <= size && index_size <= size - header->index_offset &&
+                     header->strings_offset <= size && header->strings_size <= size - header->strings_offset;
+
+    return result;
+}
+
+// The index comes from the archive so every entry is checked once on open, lookups and reads can then trust it
+rf_internal rf_bool rf__pack_validate_entries(const rf_pack_entry* entries, const rf_pack_header* header, rf_int archive_size)
+{
+    uint64_t size = archive_size;
+    rf_int occupied = 0;
+
+    for (rf_int i = 0; i < header->bucket_count; i++)
+    {
+        const rf_pack_entry* entry = &entries[i];
+        if (entry->path_size == 0) continue;
+
+        rf_bool valid = entry->data_offset <= size && entry->stored_size <= size - entry->data_offset &&
+                        (uint64_t) entry->path_offset + entry->path_size <= header->strings_size &&
+                        (entry->compression != rf_pack_compression_none || entry->original_size == entry->stored_size);
+
+        if (!valid) return 0;
+
+        occupied++;
+    }
+
+    rf_bool result = occupied == header->entry_count;
+    return result;
+}
+
+rf_public rf_pack rf_pack_open_from_memory(const void* data, rf_int size)
+{
+    rf_pack result = {0};
+
+    if (data && size >= rf__pack_header_size)
+    {
+        rf_pack_header header = rf__pack_load_header(data);
+
+        if (rf__pack_validate_header(&header, size))
+        {
+            // The index is used in place, which only matches the layout of rf_pack_entry on little endian hosts
+            const rf_pack_entry* entries = (const rf_pack_entry*)((const char*) data + header.index_offset);
+
+            if (!rf__pack_host_is_little_endian())
+            {
+                rf_log_error(rf_unsupported, "Archives in memory can only be opened on little endian hosts, use rf_pack_open_file with a stream io");
+            }
+            else if (rf__pack_validate_entries(entries, &header, size))
+            {
+                result.memory       = data;
+                result.entries      = entries;
+                result.strings      = (const char*) data + header.strings_offset;
+                result.bucket_count = header.bucket_count;
+                result.entry_count  = header.entry_count;
+                result.valid        = 1;
+            }
+            else rf_log_error(rf_bad_format, "Invalid rayfork pack index");
+        }
+        else rf_log_error(rf_bad_format, "Invalid rayfork pack header");
+    }
+    else rf_log_error(rf_bad_argument, "Argument `data` was invalid.");
+
+    return result;
+}
+
+// Converts the index read from a stream to the layout of rf_pack_entry on the host, the serialized and native sizes are the same
+rf_internal const rf_pack_entry* rf__pack_decode_entries_in_place(char* index, rf_int bucket_count)
+{
+    for (rf_int i = 0; i < bucket_count; i++)
+    {
+        rf_pack_entry entry = rf__pack_load_entry(index + i * rf__pack_entry_size);
+        memcpy(index + i * rf__pack_entry_size, &entry, sizeof(entry));
+    }
+
+    const rf_pack_entry* result = (const rf_pack_entry*) index;
+    return result;
+}
+
+rf_public rf_pack rf_pack_open_file(const char* filename, rf_io_callbacks io, rf_allocator allocator)
+{
+    rf_pack result = {0};
+
+    // Without map support we only read the index and read the entries at their offsets when they are needed
+    if (!io.map_file_proc && rf_io_supports_streams(io))
+    {
+        void* stream = rf_open_stream(io, filename);
+
+        if (stream)
+        {
+            char   header_bytes[rf__pack_header_size];
+            rf_int archive_size = rf_file_size(io, filename);
+            rf_bool header_read = rf_read_stream(io, stream, header_bytes, rf__pack_header_size) == rf__pack_header_size;
+            rf_pack_header header = rf__pack_load_header(header_bytes);
+
+            if (header_read && rf__pack_validate_header(&header, archive_size))
+            {
+                rf_int index_size   = header.bucket_count * sizeof(rf_pack_entry);
+                rf_int strings_size = header.strings_size;
+                char*  index_memory = rf_alloc(allocator, index_size + strings_size);
+
+                if (index_memory &&
+                    rf_seek_stream(io, stream, header.index_offset, rf_io_seek_set) &&
+                    rf_read_stream(io, stream, index_memory, index_size) == index_size &&
+                    rf_seek_stream(io, stream, header.strings_offset, rf_io_seek_set) &&
+                    rf_read_stream(io, stream, index_memory + index_size, strings_size) == strings_size &&
+                    rf__pack_validate_entries(rf__pack_decode_entries_in_place(index_memory, header.bucket_count), &header, archive_size))
+                {
+                    result.entries      = (const rf_pack_entry*) index_memory;
+                    result.strings      = index_memory + index_size;
+                    result.bucket_count = header.bucket_count;
+                    result.entry_count  = header.entry_count;
+                    result.io           = io;
+                    result.stream       = stream;
+                    result.index_memory = index_memory;
+                    result.allocator    = allocator;
+                    result.valid        = 1;
+
+                    return result;
+                }
+                else rf_log_error(rf_bad_format, "Failed to read a valid index from %s", filename);
+
+                if (index_memory) rf_free(allocator, index_memory);
+            }
+            else rf_log_error(rf_bad_format, "Invalid rayfork pack header in %s", filename);
+
+            rf_close_stream(io, stream);
+        }
+        else rf_log_error(rf_bad_io, "Failed to open file %s", filename);
+    }
+    else
+    {
+        rf_file_view view = rf_view_file(io, filename, allocator);
+
+        if (view.valid)
+        {
+            result = rf_pack_open_from_memory(view.data, view.size);
+
+            if (result.valid)
+            {
+                result.io        = io;
+                result.view      = view;
+                result.allocator = allocator;
+            }
+            else rf_release_file_view(io, view, allocator);
+        }
+    }
+
+    return result;
+}
+
+rf_public void rf_pack_close(rf_pack* pack)
+{
+    if (!pack->valid) return;
+
+    if (pack->stream)       rf_close_stream(pack->io, pack->stream);
+    if (pack->index_memory) rf_free(pack->allocator, pack->index_memory);
+    if (pack->view.valid)   rf_release_file_view(pack->io, pack->view, pack->allocator);
+
+    *pack = (rf_pack) {0};
+}
+
+rf_public const rf_pack_entry* rf_pack_find(const rf_pack* pack, const char* path)
+{
+    if (!pack || !pack->valid || !path) return 0;
+
+    path = rf__pack_skip_path_prefix(path);
+
+    rf_int   path_size = strlen(path);
+    uint64_t hash      = rf_pack_hash_path(path, path_size);
+    rf_int   mask      = pack->bucket_count - 1;
+
+    // Archives written by rf_pack_build_to_buffer always have an empty bucket, the probe is still bounded in case the index was tampered with
+    rf_int bucket = hash & mask;
+    for (rf_int probes = 0; probes < pack->bucket_count; probes++, bucket = (bucket + 1) & mask)
+    {
+        const rf_pack_entry* entry = &pack->entries[bucket];
+
+        if (entry->path_size == 0) return 0;
+
+        if (entry->path_hash == hash && rf__pack_path_match(pack->strings + entry->path_offset, entry->path_size, path, path_size))
+        {
+            return entry;
+        }
+    }
+
+    return 0;
+}
+
+rf_internal rf_bool rf__pack_decompress(const rf_pack_entry* entry, const void* src, void* dst, rf_int dst_size)
+{
+    rf_bool result = 0;
+
+    switch (entry->compression)
+    {
+        case rf_pack_compression_none:
+            memcpy(dst, src, entry->stored_size);
+            result = 1;
+            break;
+
+        case rf_pack_compression_lz4:
+            result = rf_lz4_decompress_to_buffer(src, entry->stored_size, dst, dst_size) == (rf_int) entry->original_size;
+            break;
+
+        default:
+            rf_log_error(rf_unsupported, "Unsupported pack compression %d", entry->compression);
+            break;
+    }
+
+    return result;
+}
+
+rf_public rf_bool rf_pack_read_entry(rf_pack* pack, const rf_pack_entry* entry, void* dst, rf_int dst_size)
+{
+    if (!pack || !pack->valid || !entry || !dst || dst_size < (rf_int) entry->original_size) return 0;
+
+    rf_bool result = 0;
+
+    if (pack->memory)
+    {
+        result = rf__pack_decompress(entry, pack->memory + entry->data_offset, dst, dst_size);
+    }
+    else if (rf_seek_stream(pack->io, pack->stream, entry->data_offset, rf_io_seek_set))
+    {
+        if (entry->compression == rf_pack_compression_none)
+        {
+            result = rf_read_stream(pack->io, pack->stream, dst, entry->stored_size) == (rf_int) entry->stored_size;
+        }
+        else
+        {
+            void* compressed = rf_alloc(pack->allocator, entry->stored_size);
+
+            if (compressed)
+            {
+                if (rf_read_stream(pack->io, pack->stream, compressed, entry->stored_size) == (rf_int) entry->stored_size)
+                {
+                    result = rf__pack_decompress(entry, compressed, dst, dst_size);
+                }
+
+                rf_free(pack->allocator, compressed);
+            }
+            else rf_log_error(rf_bad_alloc, "Temporary allocation of size %d failed", (rf_int) entry->stored_size);
+        }
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_pack_get_file_size(void* user_data, const char* filename)
+{
+    const rf_pack_entry* entry = rf_pack_find(user_data, filename);
+    rf_int result = entry ? (rf_int) entry->original_size : 0;
+    return result;
+}
+
+rf_public rf_bool rf_pack_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size)
+{
+    rf_pack* pack = user_data;
+    rf_bool result = rf_pack_read_entry(pack, rf_pack_find(pack, filename), dst, dst_size);
+    return result;
+}
+
+rf_public rf_file_view rf_pack_map_file(void* user_data, const char* filename)
+{
+    rf_pack* pack = user_data;
+    rf_file_view result = {0};
+
+    const rf_pack_entry* entry = rf_pack_find(pack, filename);
+
+    if (entry && pack->memory && entry->compression == rf_pack_compression_none)
+    {
+        result.data   = pack->memory + entry->data_offset;
+        result.size   = entry->original_size;
+        result.mapped = 1;
+        result.valid  = 1;
+    }
+
+    return result;
+}
+
+rf_public void rf_pack_unmap_file(void* user_data, rf_file_view view)
+{
+    // Views point inside of the archive which stays alive until rf_pack_close
+    ((void)user_data);
+    ((void)view);
+}
+
+#pragma endregion
+
+#pragma region pack building
+
+rf_internal rf_int rf__pack_align(rf_int offset, rf_int alignment)
+{
+    rf_int result = (offset + alignment - 1) / alignment * alignment;
+    return result;
+}
+
+rf_internal rf_int rf__pack_bucket_count(rf_int entry_count)
+{
+    // Keep the load factor at or below 0.5
+    rf_int result = 2;
+    while (result < entry_count * 2) result *= 2;
+    return result;
+}
+
+rf_public rf_int rf_pack_build_bound(const rf_pack_source* sources, rf_int sources_count, rf_int alignment)
+{
+    if (alignment <= 0) alignment = RF_PACK_DEFAULT_ALIGNMENT;
+
+    rf_int result = rf__pack_header_size;
+
+    for (rf_int i = 0; i < sources_count; i++)
+    {
+        result = rf__pack_align(result, alignment);
+        result += sources[i].compress ? rf_lz4_compress_bound(sources[i].size) : sources[i].size;
+    }
+
+    result = rf__pack_align(result, sizeof(uint64_t));
+    result += rf__pack_bucket_count(sources_count) * sizeof(rf_pack_entry);
+
+    for (rf_int i = 0; i < sources_count; i++)
+    {
+        result += strlen(rf__pack_skip_path_prefix(sources[i].path));
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_pack_build_to_buffer(const rf_pack_source* sources, rf_int sources_count, rf_int alignment, void* dst, rf_int dst_size)
+{
+    if (alignment <= 0) alignment = RF_PACK_DEFAULT_ALIGNMENT;
+
+    if (!dst || dst_size < rf_pack_build_bound(sources, sources_count, alignment))
+    {
+        rf_log_error(rf_bad_buffer_size, "The buffer is smaller than rf_pack_build_bound");
+        return 0;
+    }
+
+    char*  out          = dst;
+    rf_int bucket_count = rf__pack_bucket_count(sources_count);
+    rf_int offset       = rf__pack_header_size;
+
+    // The index is built at the end of the buffer while the blobs are written, then moved right after them
+    rf_int index_size = bucket_count * sizeof(rf_pack_entry);
+    rf_pack_entry* entries = (rf_pack_entry*)(out + ((dst_size - index_size) & ~(rf_int)(sizeof(uint64_t) - 1)));
+    memset(entries, 0, index_size);
+
+    rf_int entry_count = 0;
+
+    for (rf_int i = 0; i < sources_count; i++)
+    {
+        const rf_pack_source* source = &sources[i];
+        const char* path      = rf__pack_skip_path_prefix(source->path);
+        rf_int      path_size = strlen(path);
+        uint64_t    hash      = rf_pack_hash_path(path, path_size);
+
+        offset = rf__pack_align(offset, alignment);
+
+        rf_pack_entry entry = {0};
+        entry.path_hash     = hash;
+        entry.data_offset   = offset;
+        entry.original_size = source->size;
+        entry.stored_size   = source->size;
+        entry.path_offset   = (uint32_t) i; // Holds the source index until the strings are written
+        entry.path_size     = path_size;
+
+        if (source->compress && source->size > 0)
+        {
+            rf_int compressed_size = rf_lz4_compress_to_buffer(source->data, source->size, out + offset, rf_lz4_compress_bound(source->size));
+
+            // Store the data as is if compressing doesn't help
+            if (compressed_size > 0 && compressed_size < source->size)
+            {
+                entry.stored_size = compressed_size;
+                entry.compression = rf_pack_compression_lz4;
+            }
+        }
+
+        if (entry.compression == rf_pack_compression_none && source->size > 0)
+        {
+            memcpy(out + offset, source->data, source->size);
+        }
+
+        offset += entry.stored_size;
+
+        // A later source with the same path replaces the previous one
+        rf_int mask = bucket_count - 1;
+        for (rf_int bucket = hash & mask; ; bucket = (bucket + 1) & mask)
+        {
+            rf_pack_entry* it = &entries[bucket];
+
+            if (it->path_size == 0)
+            {
+                *it = entry;
+                entry_count++;
+                break;
+            }
+
+            const char* it_path = rf__pack_skip_path_prefix(sources[it->path_offset].path);
+            if (it->path_hash == hash && rf__pack_path_match(it_path, it->path_size, path, path_size))
+            {
+                *it = entry;
+                break;
+            }
+        }
+    }
+
+    // Move the index right after the blobs
+    rf_int index_offset = rf__pack_align(offset, sizeof(uint64_t));
+    memmove(out + index_offset, entries, index_size);
+    entries = (rf_pack_entry*)(out + index_offset);
+
+    // Write the paths and resolve the path offsets
+    rf_int strings_offset = index_offset + index_size;
+    rf_int strings_size   = 0;
+
+    for (rf_int bucket = 0; bucket < bucket_count; bucket++)
+    {
+        rf_pack_entry* entry = &entries[bucket];
+        if (entry->path_size == 0) continue;
+
+        const char* path     = rf__pack_skip_path_prefix(sources[entry->path_offset].path);
+        char*       dst_path = out + strings_offset + strings_size;
+
+        for (rf_int c = 0; c < entry->path_size; c++)
+        {
+            dst_path[c] = rf__pack_normalize_path_char(path[c]);
+        }
+
+        entry->path_offset = (uint32_t) strings_size;
+        strings_size += entry->path_size;
+    }
+
+    // The index was built in the host layout, serialize it in place now that the path offsets are final
+    for (rf_int bucket = 0; bucket < bucket_count; bucket++)
+    {
+        rf_pack_entry entry = entries[bucket];
+        rf__pack_store_entry(out + index_offset + bucket * rf__pack_entry_size, &entry);
+    }
+
+    rf_pack_header header = {0};
+    memcpy(header.magic, RF_PACK_MAGIC, 4);
+    header.version        = RF_PACK_VERSION;
+    header.entry_count    = (uint32_t) entry_count;
+    header.bucket_count   = (uint32_t) bucket_count;
+    header.index_offset   = index_offset;
+    header.strings_offset = strings_offset;
+    header.strings_size   = strings_size;
+    rf__pack_store_header(out, &header);
+
+    rf_int result = strings_offset + strings_size;
+    return result;
+}
+
+#pragma endregion
@@ -0,0 +1,104 @@
+#ifndef RAYFORK_PACK_H
+#define RAYFORK_PACK_H
+
+#include "rayfork-core.h"
+
+/*
+ * rayfork pack format (all values little endian, the header and entries are serialized field by field in struct order):
+ *   [rf_pack_header][blobs, each aligned to the alignment chosen when building][rf_pack_entry index][path strings]
+ *
+ * Every entry of the index is checked against the size of the archive when it is opened, so corrupt archives are rejected
+ * up front instead of being read out of bounds later. Archives in memory use their index in place, which needs a little
+ * endian host, archives read through a stream decode their index and open on any host.
+ *
+ * The index is an open addressing hash table of `bucket_count` entries (a power of two) keyed by the FNV-1a hash of the path,
+ * so finding a file is O(1) and reading it is a single read at a known offset. Empty buckets have a path_size of 0.
+ * Paths are stored with '/' separators, lookups treat '\' as '/'.
+ */
+
+#define RF_PACK_MAGIC   "RFPK"
+#define RF_PACK_VERSION (1)
+
+#ifndef RF_PACK_DEFAULT_ALIGNMENT
+    #define RF_PACK_DEFAULT_ALIGNMENT (16)
+#endif
+
+/* Lets an archive be used anywhere rf_io_callbacks are expected. The pack must outlive the callbacks. */
+#define rf_pack_io(pack) (rf_lit(rf_io_callbacks) { (pack), rf_pack_get_file_size, rf_pack_load_file_into_buffer, rf_pack_map_file, rf_pack_unmap_file })
+
+typedef enum rf_pack_compression
+{
+    rf_pack_compression_none = 0,
+    rf_pack_compression_lz4  = 1, // LZ4 block format
+} rf_pack_compression;
+
+typedef struct rf_pack_header
+{
+    char     magic[4];
+    uint32_t version;
+    uint32_t entry_count;
+    uint32_t bucket_count;
+    uint64_t index_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+} rf_pack_header;
+
+typedef struct rf_pack_entry
+{
+    uint64_t path_hash;
+    uint64_t data_offset;
+    uint64_t stored_size;
+    uint64_t original_size;
+    uint32_t path_offset;
+    uint32_t path_size;
+    uint32_t compression;
+    uint32_t reserved;
+} rf_pack_entry;
+
+typedef struct rf_pack
+{
+    const char*          memory;       // The whole archive when it is mapped or in memory, null when entries are read through a stream
+    const rf_pack_entry* entries;      // `bucket_count` buckets
+    const char*          strings;
+    rf_int               bucket_count;
+    rf_int               entry_count;
+
+    rf_io_callbacks      io;           // Used when the archive was opened from a file
+    rf_file_view         view;
+    void*                stream;
+    void*                index_memory; // Index and strings read from the stream
+    rf_allocator         allocator;
+
+    rf_bool              valid;
+} rf_pack;
+
+typedef struct rf_pack_source
+{
+    const char* path;
+    const void* data;
+    rf_int      size;
+    rf_bool     compress;
+} rf_pack_source;
+
+rf_public uint64_t rf_pack_hash_path(const char* path, rf_int path_size);
+
+rf_public rf_pack rf_pack_open_from_memory(const void* data, rf_int size); // The memory must outlive the pack
+rf_public rf_pack rf_pack_open_file(const char* filename, rf_io_callbacks io, rf_allocator allocator); // Maps the archive if the io supports it, otherwise only the index is read and entries are read through a stream when possible
+rf_public void    rf_pack_close(rf_pack* pack);
+
+rf_public const rf_pack_entry* rf_pack_find(const rf_pack* pack, const char* path);
+rf_public rf_bool              rf_pack_read_entry(rf_pack* pack, const rf_pack_entry* entry, void* dst, rf_int dst_size); // Decompresses if needed, dst_size must be at least entry->original_size
+
+rf_public rf_int       rf_pack_get_file_size(void* user_data, const char* filename);
+rf_public rf_bool      rf_pack_load_file_into_buffer(void* user_data, const char* filename, void* dst, rf_int dst_size);
+rf_public rf_file_view rf_pack_map_file(void* user_data, const char* filename); // Only uncompressed entries of archives in memory can be viewed without a copy
+rf_public void         rf_pack_unmap_file(void* user_data, rf_file_view view);
+
+rf_public rf_int rf_pack_build_bound(const rf_pack_source* sources, rf_int sources_count, rf_int alignment);
+rf_public rf_int rf_pack_build_to_buffer(const rf_pack_source* sources, rf_int sources_count, rf_int alignment, void* dst, rf_int dst_size); // Returns the size of the archive or 0 on failure
+
+rf_public rf_int rf_lz4_compress_bound(rf_int src_size);
+rf_public rf_int rf_lz4_compress_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size);   // Returns the compressed size or 0 on failure
+rf_public rf_int rf_lz4_decompress_to_buffer(const void* src, rf_int src_size, void* dst, rf_int dst_size); // Returns the decompressed size or rf_invalid_index on malformed input
+
+#endif // RAYFORK_PACK_H
@@ -2,7 +2,11 @@
 
 #include "rayfork-core.c"
 #include "rayfork-str.c"
+#include "rayfork-csv.c"
 #include "rayfork-math.c"
+#include "rayfork-arr.c"
+#include "rayfork-pack.c"
+#include "rayfork-jobs.c"
 
 #if !defined(RAYFORK_NO_GFX)
 #include "rayfork-gfx.c"
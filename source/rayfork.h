@@ -3,9 +3,11 @@
 
 #include "rayfork-core.h"
 #include "rayfork-str.h"
-//#include "rayfork-csv.h"
+#include "rayfork-csv.h"
 #include "rayfork-math.h"
 #include "rayfork-arr.h"
+#include "rayfork-pack.h"
+#include "rayfork-jobs.h"
 
 #if !defined(rayfork_no_gfx)
 #include "rayfork-gfx.h"
@@ -1,5 +1,14 @@
 #include "rayfork-str.h"
 #include "string.h"
+#include "float.h"
+
+#if defined(rayfork_avx2)
+    #include "immintrin.h"
+#elif defined(rayfork_sse2)
+    #include "emmintrin.h"
+#elif defined(rayfork_neon)
+    #include "arm_neon.h"
+#endif
 
 #pragma region unicode
 /*
@@ -36,10 +45,7 @@ rf_public rf_decoded_rune rf_decode_utf8_char(const char* src, rf_int size)
         // Only one byte (ASCII range x00-7F)
         const int code = src[0];
 
-        // Codepoints after U+10ffff are invalid
-        const int valid = code > 0x10ffff;
-
-        return (rf_decoded_rune) { valid ? RF_INVALID_CODEPOINT : code, .bytes_processed = 1, .valid = valid };
+        return (rf_decoded_rune) { code, .bytes_processed = 1, .valid = 1 };
     }
     else if ((byte & 0xe0) == 0xc0)
     {
@@ -63,9 +69,9 @@ rf_public rf_decoded_rune rf_decode_utf8_char(const char* src, rf_int size)
             const int code = ((byte & 0x1f) << 6) | (byte1 & 0x3f);
 
             // Codepoints after U+10ffff are invalid
-            const int valid = code > 0x10ffff;
+            const int valid = code <= 0x10ffff;
 
-            return (rf_decoded_rune) { valid ? RF_INVALID_CODEPOINT : code, .bytes_processed = 2, .valid = valid };
+            return (rf_decoded_rune) { valid ? code : RF_INVALID_CODEPOINT, .bytes_processed = 2, .valid = valid };
         }
     }
     else if ((byte & 0xf0) == 0xe0)
@@ -109,8 +115,8 @@ rf_public rf_decoded_rune rf_decode_utf8_char(const char* src, rf_int size)
             const int code = ((byte & 0xf) << 12) | ((byte1 & 0x3f) << 6) | (byte2 & 0x3f);
 
             // Codepoints after U+10ffff are invalid
-            const int valid = code > 0x10ffff;
-            return (rf_decoded_rune) { valid ? RF_INVALID_CODEPOINT : code, .bytes_processed = 3, .valid = valid };
+            const int valid = code <= 0x10ffff;
+            return (rf_decoded_rune) { valid ? code : RF_INVALID_CODEPOINT, .bytes_processed = 3, .valid = valid };
         }
     }
     else if ((byte & 0xf8) == 0xf0)
@@ -163,34 +169,322 @@ rf_public rf_decoded_rune rf_decode_utf8_char(const char* src, rf_int size)
             const int code = ((byte & 0x7) << 18) | ((byte1 & 0x3f) << 12) | ((byte2 & 0x3f) << 6) | (byte3 & 0x3f);
 
             // Codepoints after U+10ffff are invalid
-            const int valid = code > 0x10ffff;
-            return (rf_decoded_rune) { valid ? RF_INVALID_CODEPOINT : code, .bytes_processed = 4, .valid = valid };
+            const int valid = code <= 0x10ffff;
+            return (rf_decoded_rune) { valid ? code : RF_INVALID_CODEPOINT, .bytes_processed = 4, .valid = valid };
         }
     }
 
     return (rf_decoded_rune) { .codepoint = RF_INVALID_CODEPOINT, .bytes_processed = 1 };
 }
 
-rf_public rf_utf8_stats rf_count_utf8_chars(const char* src, rf_int size)
+/*
+ * Block validation, finds the longest prefix of the input that is valid UTF-8 and ends on a character boundary so it can be
+ * counted and decoded without per byte checks. With AVX2 or AArch64 NEON whole blocks are validated with the lookup table
+ * algorithm from "Validating UTF-8 In Less Than One Instruction Per Byte" (Keiser & Lemire), otherwise only ASCII blocks are
+ * skipped and the rest goes through rf_decode_utf8_char. Both accept exactly the sequences rf_decode_utf8_char reports as valid.
+ */
+#if defined(rayfork_avx2) || (defined(rayfork_neon) && (defined(__aarch64__) || defined(_M_ARM64)))
+    #define RF__UTF8_LOOKUP_VALIDATION
+
+    // Error bits set by the lookup tables, a byte pair is invalid if the 3 lookups share a bit
+    #define RF__UTF8_TOO_SHORT      (1 << 0)
+    #define RF__UTF8_TOO_LONG       (1 << 1)
+    #define RF__UTF8_OVERLONG_3     (1 << 2)
+    #define RF__UTF8_TOO_LARGE      (1 << 3)
+    #define RF__UTF8_SURROGATE      (1 << 4)
+    #define RF__UTF8_OVERLONG_2     (1 << 5)
+    #define RF__UTF8_TOO_LARGE_1000 (1 << 6)
+    #define RF__UTF8_OVERLONG_4     (1 << 6)
+    #define RF__UTF8_TWO_CONTS      (1 << 7)
+    #define RF__UTF8_CARRY          (RF__UTF8_TOO_SHORT | RF__UTF8_TOO_LONG | RF__UTF8_TWO_CONTS)
+
+    // Indexed by the high nibble of the first byte of a pair
+    #define RF__UTF8_BYTE_1_HIGH_TABLE \
+        RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, \
+        RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, RF__UTF8_TOO_LONG, \
+        RF__UTF8_TWO_CONTS, RF__UTF8_TWO_CONTS, RF__UTF8_TWO_CONTS, RF__UTF8_TWO_CONTS, \
+        RF__UTF8_TOO_SHORT | RF__UTF8_OVERLONG_2, \
+        RF__UTF8_TOO_SHORT, \
+        RF__UTF8_TOO_SHORT | RF__UTF8_OVERLONG_3 | RF__UTF8_SURROGATE, \
+        RF__UTF8_TOO_SHORT | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000 | RF__UTF8_OVERLONG_4
+
+    // Indexed by the low nibble of the first byte of a pair
+    #define RF__UTF8_BYTE_1_LOW_TABLE \
+        RF__UTF8_CARRY | RF__UTF8_OVERLONG_3 | RF__UTF8_OVERLONG_2 | RF__UTF8_OVERLONG_4, \
+        RF__UTF8_CARRY | RF__UTF8_OVERLONG_2, \
+        RF__UTF8_CARRY, \
+        RF__UTF8_CARRY, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000 | RF__UTF8_SURROGATE, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000, \
+        RF__UTF8_CARRY | RF__UTF8_TOO_LARGE | RF__UTF8_TOO_LARGE_1000
+
+    // Indexed by the high nibble of the second byte of a pair
+    #define RF__UTF8_BYTE_2_HIGH_TABLE \
+        RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, \
+        RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, \
+        RF__UTF8_TOO_LONG | RF__UTF8_OVERLONG_2 | RF__UTF8_TWO_CONTS | RF__UTF8_OVERLONG_3 | RF__UTF8_TOO_LARGE_1000 | RF__UTF8_OVERLONG_4, \
+        RF__UTF8_TOO_LONG | RF__UTF8_OVERLONG_2 | RF__UTF8_TWO_CONTS | RF__UTF8_OVERLONG_3 | RF__UTF8_TOO_LARGE, \
+        RF__UTF8_TOO_LONG | RF__UTF8_OVERLONG_2 | RF__UTF8_TWO_CONTS | RF__UTF8_SURROGATE | RF__UTF8_TOO_LARGE, \
+        RF__UTF8_TOO_LONG | RF__UTF8_OVERLONG_2 | RF__UTF8_TWO_CONTS | RF__UTF8_SURROGATE | RF__UTF8_TOO_LARGE, \
+        RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT, RF__UTF8_TOO_SHORT
+#endif
+
+#if defined(RF__UTF8_LOOKUP_VALIDATION) && defined(rayfork_avx2)
+    #define RF__UTF8_BLOCK_SIZE (32)
+
+    // Returns the input shifted right by n bytes across the block boundary, with the bytes of the previous block shifted in
+    #define rf__utf8_prev(input, prev_input, n) (_mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev_input), (input), 0x21), 16 - (n)))
+
+    rf_internal rf_int rf__utf8_valid_blocks_size(const char* src, rf_int size)
+    {
+        const __m256i byte_1_high_table = _mm256_setr_epi8(RF__UTF8_BYTE_1_HIGH_TABLE, RF__UTF8_BYTE_1_HIGH_TABLE);
+        const __m256i byte_1_low_table  = _mm256_setr_epi8(RF__UTF8_BYTE_1_LOW_TABLE,  RF__UTF8_BYTE_1_LOW_TABLE);
+        const __m256i byte_2_high_table = _mm256_setr_epi8(RF__UTF8_BYTE_2_HIGH_TABLE, RF__UTF8_BYTE_2_HIGH_TABLE);
+        const __m256i low_nibble_mask   = _mm256_set1_epi8(0x0f);
+
+        // Bytes that start a sequence which can't end in the same block if they are in the last 3 positions
+        const __m256i max_complete_value = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1));
+
+        __m256i prev_input = _mm256_setzero_si256();
+        __m256i prev_incomplete = _mm256_setzero_si256();
+        rf_int i = 0;
+
+        for (; i + RF__UTF8_BLOCK_SIZE <= size; i += RF__UTF8_BLOCK_SIZE)
+        {
+            __m256i input = _mm256_loadu_si256((const __m256i*)(src + i));
+            __m256i error = prev_incomplete;
+
+            if (_mm256_movemask_epi8(input))
+            {
+                __m256i prev1 = rf__utf8_prev(input, prev_input, 1);
+                __m256i byte_1_high = _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble_mask));
+                __m256i byte_1_low  = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble_mask));
+                __m256i byte_2_high = _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble_mask));
+                __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+                // The third and fourth bytes of 3 and 4 byte sequences must be continuations, which the pair checks can't see
+                __m256i is_third_byte  = _mm256_subs_epu8(rf__utf8_prev(input, prev_input, 2), _mm256_set1_epi8((char)(0xe0 - 0x80)));
+                __m256i is_fourth_byte = _mm256_subs_epu8(rf__utf8_prev(input, prev_input, 3), _mm256_set1_epi8((char)(0xf0 - 0x80)));
+                __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8((char) 0x80));
+
+                error = _mm256_xor_si256(must_be_continuation, special_cases);
+                prev_incomplete = _mm256_subs_epu8(input, max_complete_value);
+            }
+            else prev_incomplete = _mm256_setzero_si256();
+
+            if (!_mm256_testz_si256(error, error)) break;
+
+            prev_input = input;
+        }
+
+        return i;
+    }
+#elif defined(RF__UTF8_LOOKUP_VALIDATION) && defined(rayfork_neon)
+    #define RF__UTF8_BLOCK_SIZE (16)
+
+    rf_internal rf_int rf__utf8_valid_blocks_size(const char* src, rf_int size)
+    {
+        static const uint8_t byte_1_high_values[16] = { RF__UTF8_BYTE_1_HIGH_TABLE };
+        static const uint8_t byte_1_low_values[16]  = { RF__UTF8_BYTE_1_LOW_TABLE };
+        static const uint8_t byte_2_high_values[16] = { RF__UTF8_BYTE_2_HIGH_TABLE };
+        static const uint8_t max_complete_values[16] = { 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xf0 - 1, 0xe0 - 1, 0xc0 - 1 };
+
+        const uint8x16_t byte_1_high_table  = vld1q_u8(byte_1_high_values);
+        const uint8x16_t byte_1_low_table   = vld1q_u8(byte_1_low_values);
+        const uint8x16_t byte_2_high_table  = vld1q_u8(byte_2_high_values);
+        const uint8x16_t max_complete_value = vld1q_u8(max_complete_values);
+
+        uint8x16_t prev_input = vdupq_n_u8(0);
+        uint8x16_t prev_incomplete = vdupq_n_u8(0);
+        rf_int i = 0;
+
+        for (; i + RF__UTF8_BLOCK_SIZE <= size; i += RF__UTF8_BLOCK_SIZE)
+        {
+            uint8x16_t input = vld1q_u8((const uint8_t*)(src + i));
+            uint8x16_t error = prev_incomplete;
+
+            if (vmaxvq_u8(input) >= 0x80)
+            {
+                uint8x16_t prev1 = vextq_u8(prev_input, input, 16 - 1);
+                uint8x16_t byte_1_high = vqtbl1q_u8(byte_1_high_table, vshrq_n_u8(prev1, 4));
+                uint8x16_t byte_1_low  = vqtbl1q_u8(byte_1_low_table, vandq_u8(prev1, vdupq_n_u8(0x0f)));
+                uint8x16_t byte_2_high = vqtbl1q_u8(byte_2_high_table, vshrq_n_u8(input, 4));
+                uint8x16_t special_cases = vandq_u8(vandq_u8(byte_1_high, byte_1_low), byte_2_high);
+
+                // The third and fourth bytes of 3 and 4 byte sequences must be continuations, which the pair checks can't see
+                uint8x16_t is_third_byte  = vqsubq_u8(vextq_u8(prev_input, input, 16 - 2), vdupq_n_u8(0xe0 - 0x80));
+                uint8x16_t is_fourth_byte = vqsubq_u8(vextq_u8(prev_input, input, 16 - 3), vdupq_n_u8(0xf0 - 0x80));
+                uint8x16_t must_be_continuation = vandq_u8(vorrq_u8(is_third_byte, is_fourth_byte), vdupq_n_u8(0x80));
+
+                error = veorq_u8(must_be_continuation, special_cases);
+                prev_incomplete = vqsubq_u8(input, max_complete_value);
+            }
+            else prev_incomplete = vdupq_n_u8(0);
+
+            if (vmaxvq_u8(error)) break;
+
+            prev_input = input;
+        }
+
+        return i;
+    }
+#else
+    #define RF__UTF8_BLOCK_SIZE (16)
+
+    rf_internal rf_int rf__utf8_valid_blocks_size(const char* src, rf_int size)
+    {
+        rf_int i = 0;
+
+        for (; i + RF__UTF8_BLOCK_SIZE <= size; i += RF__UTF8_BLOCK_SIZE)
+        {
+            uint64_t block[2];
+            memcpy(block, src + i, sizeof(block));
+            if ((block[0] | block[1]) & 0x8080808080808080ull) break;
+        }
+
+        return i;
+    }
+#endif
+
+// Returns the size of the longest prefix made of whole blocks that is valid UTF-8, minus a sequence cut by the end of the last block
+rf_internal rf_int rf__utf8_valid_prefix_size(const char* src, rf_int size)
 {
-    rf_utf8_stats result = {0};
+    rf_int result = rf__utf8_valid_blocks_size(src, size);
 
-    if (src && size > 0)
+    // Step back to the start of a sequence that runs past the validated blocks
+    for (rf_int back = 1; back <= 3 && back <= result; back++)
+    {
+        unsigned char byte = src[result - back];
+        if ((byte & 0xc0) != 0x80)
+        {
+            rf_int sequence_size = byte < 0x80 ? 1 : byte < 0xe0 ? 2 : byte < 0xf0 ? 3 : 4;
+            if (sequence_size > back) result -= back;
+            break;
+        }
+    }
+
+    return result;
+}
+
+rf_internal rf_int rf__utf8_count_valid(const char* src, rf_int size)
+{
+    // Every byte that isn't a continuation starts a rune, written so compilers vectorize it
+    rf_int result = 0;
+    for (rf_int i = 0; i < size; i++)
+    {
+        result += (signed char) src[i] > (signed char) 0xbf;
+    }
+
+    return result;
+}
+
+// Decodes input that is known to be valid, returns the amount of runes written
+rf_internal rf_int rf__utf8_decode_valid(const char* src, rf_int size, rf_rune* dst)
+{
+    const unsigned char* in = (const unsigned char*) src;
+    rf_int out = 0;
+    rf_int i = 0;
+
+    while (i < size)
     {
-        while (size > 0)
+        // Widen runs of ASCII 16 bytes at a time
+        if (i + 16 <= size)
+        {
+            uint64_t block[2];
+            memcpy(block, in + i, sizeof(block));
+
+            if (!((block[0] | block[1]) & 0x8080808080808080ull))
+            {
+                #if defined(rayfork_sse2)
+                    __m128i bytes = _mm_loadu_si128((const __m128i*)(in + i));
+                    __m128i zero  = _mm_setzero_si128();
+                    __m128i low   = _mm_unpacklo_epi8(bytes, zero);
+                    __m128i high  = _mm_unpackhi_epi8(bytes, zero);
+                    _mm_storeu_si128((__m128i*)(dst + out +  0), _mm_unpacklo_epi16(low, zero));
+                    _mm_storeu_si128((__m128i*)(dst + out +  4), _mm_unpackhi_epi16(low, zero));
+                    _mm_storeu_si128((__m128i*)(dst + out +  8), _mm_unpacklo_epi16(high, zero));
+                    _mm_storeu_si128((__m128i*)(dst + out + 12), _mm_unpackhi_epi16(high, zero));
+                #elif defined(rayfork_neon)
+                    uint8x16_t bytes = vld1q_u8(in + i);
+                    uint16x8_t low   = vmovl_u8(vget_low_u8(bytes));
+                    uint16x8_t high  = vmovl_u8(vget_high_u8(bytes));
+                    vst1q_u32(dst + out +  0, vmovl_u16(vget_low_u16(low)));
+                    vst1q_u32(dst + out +  4, vmovl_u16(vget_high_u16(low)));
+                    vst1q_u32(dst + out +  8, vmovl_u16(vget_low_u16(high)));
+                    vst1q_u32(dst + out + 12, vmovl_u16(vget_high_u16(high)));
+                #else
+                    for (rf_int j = 0; j < 16; j++) dst[out + j] = in[i + j];
+                #endif
+
+                i += 16;
+                out += 16;
+                continue;
+            }
+        }
+
+        unsigned char byte = in[i];
+        if (byte < 0x80)
+        {
+            dst[out] = byte;
+            i += 1;
+        }
+        else if (byte < 0xe0)
+        {
+            dst[out] = ((byte & 0x1f) << 6) | (in[i + 1] & 0x3f);
+            i += 2;
+        }
+        else if (byte < 0xf0)
+        {
+            dst[out] = ((byte & 0x0f) << 12) | ((in[i + 1] & 0x3f) << 6) | (in[i + 2] & 0x3f);
+            i += 3;
+        }
+        else
         {
-            rf_decoded_rune decoded_rune = rf_decode_utf8_char(src, size);
+            dst[out] = ((byte & 0x07) << 18) | ((in[i + 1] & 0x3f) << 12) | ((in[i + 2] & 0x3f) << 6) | (in[i + 3] & 0x3f);
+            i += 4;
+        }
+
+        out++;
+    }
+
+    return out;
+}
+
+rf_public rf_bool rf_validate_utf8(const char* src, rf_int size)
+{
+    if (!src || size <= 0) return size == 0;
 
-            src += decoded_rune.bytes_processed;
-            size  -= decoded_rune.bytes_processed;
+    rf_int i = 0;
+    while (i < size)
+    {
+        i += rf__utf8_valid_prefix_size(src + i, size - i);
 
-            result.bytes_processed  += decoded_rune.bytes_processed;
-            result.invalid_bytes    += decoded_rune.valid ? 0 : decoded_rune.bytes_processed;
-            result.valid_rune_count += decoded_rune.valid ? 1 : 0;
-            result.total_rune_count += 1;
+        // Either the tail or the block that failed validation is left, check it one rune at a time before trying blocks again
+        rf_int block_end = i + RF__UTF8_BLOCK_SIZE;
+        while (i < size && i < block_end)
+        {
+            rf_decoded_rune decoded_rune = rf_decode_utf8_char(src + i, size - i);
+            if (!decoded_rune.valid) return 0;
+            i += decoded_rune.bytes_processed;
         }
     }
 
+    return 1;
+}
+
+rf_public rf_utf8_stats rf_count_utf8_chars(const char* src, rf_int size)
+{
+    rf_utf8_stats result = rf_count_utf8_chars_til(src, size, size);
     return result;
 }
 
@@ -202,16 +496,30 @@ rf_public rf_utf8_stats rf_count_utf8_chars_til(const char* src, rf_int size, rf
     {
         while (size > 0 && n > 0)
         {
-            rf_decoded_rune decoded_rune = rf_decode_utf8_char(src, size);
+            // A valid prefix of at most n bytes has at most n runes
+            rf_int valid_size = rf__utf8_valid_prefix_size(src, size < n ? size : n);
+            rf_int valid_runes = rf__utf8_count_valid(src, valid_size);
+
+            src  += valid_size;
+            size -= valid_size;
+            n    -= valid_runes;
+
+            result.bytes_processed  += valid_size;
+            result.valid_rune_count += valid_runes;
+            result.total_rune_count += valid_runes;
+
+            for (rf_int block_end = result.bytes_processed + RF__UTF8_BLOCK_SIZE; size > 0 && n > 0 && result.bytes_processed < block_end; n--)
+            {
+                rf_decoded_rune decoded_rune = rf_decode_utf8_char(src, size);
 
-            src  += decoded_rune.bytes_processed;
-            size -= decoded_rune.bytes_processed;
-            n    -= 1;
+                src  += decoded_rune.bytes_processed;
+                size -= decoded_rune.bytes_processed;
 
-            result.bytes_processed  += decoded_rune.bytes_processed;
-            result.invalid_bytes    += decoded_rune.valid ? 0 : decoded_rune.bytes_processed;
-            result.valid_rune_count += decoded_rune.valid ? 1 : 0;
-            result.total_rune_count += 1;
+                result.bytes_processed  += decoded_rune.bytes_processed;
+                result.invalid_bytes    += decoded_rune.valid ? 0 : decoded_rune.bytes_processed;
+                result.valid_rune_count += decoded_rune.valid ? 1 : 0;
+                result.total_rune_count += 1;
+            }
         }
     }
 
@@ -226,23 +534,33 @@ rf_public rf_decoded_string rf_decode_utf8_to_buffer(const char* src, rf_int siz
 
     if (src && size > 0 && dst && dst_size > 0)
     {
-        int dst_i = 0;
-        int invalid_bytes = 0;
+        rf_int dst_i = 0;
+        rf_int invalid_bytes = 0;
 
         while (size > 0 && dst_i < dst_size)
         {
-            rf_decoded_rune decoding_result = rf_decode_utf8_char(src, size);
+            // A valid prefix of at most dst_size - dst_i bytes can't overflow dst
+            rf_int valid_size = rf__utf8_valid_prefix_size(src, size < dst_size - dst_i ? size : dst_size - dst_i);
+            dst_i += rf__utf8_decode_valid(src, valid_size, dst + dst_i);
 
-            // Count the invalid bytes
-            if (!decoding_result.valid)
+            src  += valid_size;
+            size -= valid_size;
+
+            for (const char* block_end = src + RF__UTF8_BLOCK_SIZE; size > 0 && dst_i < dst_size && src < block_end;)
             {
-                invalid_bytes += decoding_result.bytes_processed;
-            }
+                rf_decoded_rune decoding_result = rf_decode_utf8_char(src, size);
 
-            src += decoding_result.bytes_processed;
-            size  -= decoding_result.bytes_processed;
+                // Count the invalid bytes
+                if (!decoding_result.valid)
+                {
+                    invalid_bytes += decoding_result.bytes_processed;
+                }
 
-            dst[dst_i++] = decoding_result.codepoint;
+                src  += decoding_result.bytes_processed;
+                size -= decoding_result.bytes_processed;
+
+                dst[dst_i++] = decoding_result.codepoint;
+            }
         }
 
         result.size = dst_i;
@@ -266,32 +584,19 @@ rf_public rf_decoded_string rf_decode_utf8(const char* src, rf_int size, rf_allo
 #pragma endregion
 
 #pragma region ascii
-rf_int rf_str_to_int(rf_str src)
+rf_public rf_int rf_str_to_int(rf_str src)
 {
     rf_int result = 0;
-    rf_int sign   = 1;
-
-    src = rf_str_eat_spaces(src);
-
-    if (rf_str_valid(src) && src.data[0] == '-')
-    {
-        sign = -1;
-        src = rf_str_advance_b(src, 1);
-    }
-
-    while (rf_str_valid(src) && rf_is_digit(src.data[0]))
-    {
-        result *= 10;
-        result += rf_to_digit(src.data[0]);
-        src     = rf_str_advance_b(src, 1);
-    }
-
-    result *= sign;
-
+    rf_str_parse_int(src, &result);
     return result;
 }
 
-float rf_str_to_float(rf_str src);
+rf_public float rf_str_to_float(rf_str src)
+{
+    float result = 0;
+    rf_str_parse_float(src, &result);
+    return result;
+}
 
 int rf_to_digit(char c)
 {
@@ -302,7 +607,7 @@ int rf_to_digit(char c)
 char rf_to_upper(char c)
 {
     char result = c;
-    if (rf_is_upper(c)) {
+    if (rf_is_lower(c)) {
         result = c + 'A' - 'a';
     }
     return result;
@@ -311,7 +616,7 @@ char rf_to_upper(char c)
 char rf_to_lower(char c)
 {
     char result = c;
-    if (rf_is_lower(c)) {
+    if (rf_is_upper(c)) {
         result = c + 'a' - 'A';
     }
     return result;
@@ -360,183 +665,2947 @@ rf_bool rf_is_space(char c)
 }
 #pragma endregion
 
-#pragma region strbuf
-rf_public rf_strbuf rf_strbuf_make_ex(rf_int initial_amount, rf_allocator allocator)
-{
-    rf_strbuf result = {0};
-
-    void* data = rf_alloc(allocator, initial_amount);
+#pragma region format
 
-    if (data)
-    {
-        result.data      = data;
-        result.capacity  = initial_amount;
-        result.allocator = allocator;
-        result.valid     = 1;
-    }
+/*
+ * printf compatible formatter that doesn't go through the libc locale machinery. Supports the flags, width, precision and
+ * length modifiers of C99 for the d i u o x X c s p f F e E g G a A and % conversions, %n is ignored. Unknown conversions
+ * are written out as they appear in the format.
+ * Floating point conversions are exact and round half to even like glibc, they expand the value into the rf__decimal used
+ * by the float parser and round that.
+ */
 
-    return result;
-}
+typedef void (*rf__format_write_proc)(void* user_data, const char* data, rf_int size);
 
-rf_public rf_strbuf rf_strbuf_clone_ex(rf_strbuf this_buf, rf_allocator allocator)
+typedef struct rf__format_spec
 {
-    rf_strbuf result = {0};
+    rf_bool left_align;
+    rf_bool plus_sign;
+    rf_bool space_sign;
+    rf_bool alternate_form;
+    rf_bool zero_pad;
+    int     width;
+    int     precision; // -1 if not specified
+} rf__format_spec;
+
+typedef struct rf__format_output
+{
+    rf__format_write_proc write;
+    void*                 user_data;
+    rf_int                size;
+} rf__format_output;
 
-    if (this_buf.valid)
+rf_internal void rf__format_out(rf__format_output* out, const char* data, rf_int size)
+{
+    if (size > 0)
     {
-        result = rf_strbuf_make_ex(this_buf.capacity, allocator);
-        rf_strbuf_append(&result, rf_strbuf_to_str(this_buf));
+        out->write(out->user_data, data, size);
+        out->size += size;
     }
-
-    return result;
 }
 
-rf_public rf_str rf_strbuf_to_str(rf_strbuf src)
+rf_internal void rf__format_pad(rf__format_output* out, char c, rf_int amount)
 {
-    rf_str result = {0};
+    char padding[32];
+    memset(padding, c, sizeof(padding));
 
-    if (src.valid)
+    while (amount > 0)
     {
-        result.data = src.data;
-        result.size = src.size;
+        rf_int chunk = amount < (rf_int) sizeof(padding) ? amount : (rf_int) sizeof(padding);
+        rf__format_out(out, padding, chunk);
+        amount -= chunk;
     }
-
-    return result;
 }
 
-rf_public rf_int rf_strbuf_remaining_capacity(const rf_strbuf* this_buf)
+// Writes the digits of value right aligned ending at end, returns the first digit
+rf_internal char* rf__format_u64(uint64_t value, char* end, int base, rf_bool uppercase)
 {
-    rf_int result = this_buf->capacity - this_buf->size;
-    return result;
-}
+    const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
 
-rf_public void rf_strbuf_reserve(rf_strbuf* this_buf, rf_int new_capacity)
-{
-    if (new_capacity > this_buf->capacity)
+    if (base == 10)
     {
-        char* new_buf = rf_realloc(this_buf->allocator, this_buf->data, new_capacity, this_buf->capacity);
-        if (new_buf)
+        // Two digits at a time, the divisions by constants compile to multiplications
+        static const char pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        while (value >= 100)
         {
-            this_buf->data = new_buf;
-            this_buf->valid = 1;
+            uint64_t pair = value % 100;
+            value /= 100;
+            *--end = pairs[pair * 2 + 1];
+            *--end = pairs[pair * 2];
         }
-        else
+
+        if (value >= 10)
         {
-            this_buf->valid = 0;
+            *--end = pairs[value * 2 + 1];
+            *--end = pairs[value * 2];
         }
+        else *--end = (char)('0' + value);
+    }
+    else
+    {
+        int shift = base == 16 ? 4 : 3;
+        do
+        {
+            *--end = digits[value & (base - 1)];
+            value >>= shift;
+        } while (value);
     }
+
+    return end;
 }
 
-rf_public void rf_strbuf_ensure_capacity_for(rf_strbuf* this_buf, rf_int size)
+// Pads and writes a formatted number made of a prefix (sign or 0x) and digits
+rf_internal void rf__format_number(rf__format_output* out, rf__format_spec spec, const char* prefix, rf_int prefix_size, const char* digits, rf_int digits_size, rf_int leading_zeros)
 {
-    rf_int remaining_capacity = rf_strbuf_remaining_capacity(this_buf);
-    if (remaining_capacity < size)
-    {
-        // We either increase the buffer to capacity * 2 or to the necessary size to fit the size plus one for the null terminator
-        rf_int amount_to_reserve = rf_max_i(this_buf->capacity * 2, this_buf->capacity + (size - remaining_capacity) + 1);
-        rf_strbuf_reserve(this_buf, amount_to_reserve);
-    }
+    rf_int size = prefix_size + leading_zeros + digits_size;
+    rf_int padding = spec.width > size ? spec.width - size : 0;
+
+    if (!spec.left_align && !spec.zero_pad) rf__format_pad(out, ' ', padding);
+    rf__format_out(out, prefix, prefix_size);
+    if (!spec.left_align && spec.zero_pad) rf__format_pad(out, '0', padding);
+    rf__format_pad(out, '0', leading_zeros);
+    rf__format_out(out, digits, digits_size);
+    if (spec.left_align) rf__format_pad(out, ' ', padding);
 }
 
-rf_public void rf_strbuf_append(rf_strbuf* this_buf, rf_str it)
+rf_internal void rf__format_integer(rf__format_output* out, rf__format_spec spec, uint64_t value, rf_bool negative, char conversion)
 {
-    rf_strbuf_ensure_capacity_for(this_buf, it.size);
+    char buf[32];
+    char* end = buf + sizeof(buf);
+    char* begin = end;
 
-    memcpy(this_buf->data + this_buf->size, it.data, it.size);
-    this_buf->size += it.size;
-    this_buf->data[this_buf->size] = 0;
+    int base = conversion == 'o' ? 8 : (conversion == 'x' || conversion == 'X') ? 16 : 10;
+
+    // A precision of 0 with a value of 0 prints no digits
+    if (value || spec.precision != 0) begin = rf__format_u64(value, end, base, conversion == 'X');
+
+    char prefix[2];
+    rf_int prefix_size = 0;
+
+    if (negative) prefix[prefix_size++] = '-';
+    else if ((conversion == 'd' || conversion == 'i') && spec.plus_sign) prefix[prefix_size++] = '+';
+    else if ((conversion == 'd' || conversion == 'i') && spec.space_sign) prefix[prefix_size++] = ' ';
+
+    if (spec.alternate_form && base == 16 && value)
+    {
+        prefix[prefix_size++] = '0';
+        prefix[prefix_size++] = conversion;
+    }
+
+    rf_int digits_size = end - begin;
+    rf_int leading_zeros = spec.precision > digits_size ? spec.precision - digits_size : 0;
+
+    // The alternate form of octal forces a leading 0
+    if (spec.alternate_form && base == 8 && leading_zeros == 0 && (digits_size == 0 || *begin != '0')) leading_zeros = 1;
+
+    // The 0 flag is ignored when a precision is given
+    if (spec.precision >= 0) spec.zero_pad = 0;
+
+    rf__format_number(out, spec, prefix, prefix_size, begin, digits_size, leading_zeros);
 }
 
-rf_public void rf_strbuf_prepend(rf_strbuf* this_buf, rf_str it)
+rf_internal void rf__format_string(rf__format_output* out, rf__format_spec spec, const char* str, rf_int size)
 {
-    rf_strbuf_ensure_capacity_for(this_buf, it.size);
+    rf_int padding = spec.width > size ? spec.width - size : 0;
 
-    memmove(this_buf->data + it.size, this_buf->data, this_buf->size);
-    memcpy(this_buf->data, it.data, it.size);
-    this_buf->size += it.size;
-    this_buf->data[this_buf->size] = 0;
+    if (!spec.left_align) rf__format_pad(out, ' ', padding);
+    rf__format_out(out, str, size);
+    if (spec.left_align) rf__format_pad(out, ' ', padding);
 }
 
-rf_public void rf_strbuf_insert_utf8(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at)
+// Defined with the number conversions since it prints the exact decimal expansion kept by rf__decimal
+rf_internal void rf__format_double(rf__format_output* out, rf__format_spec spec, double value, char conversion);
+
+// %a prints the mantissa bits as hex digits, the leading digit is 1 for normal numbers and 0 for subnormals
+rf_internal void rf__format_hex_double(rf__format_output* out, rf__format_spec spec, double value, char conversion)
 {
-    rf_strbuf_ensure_capacity_for(this_buf, str_to_insert.size);
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
 
-    // Iterate over utf8 until we find the byte to insert at
-    rf_int insertion_point = rf_count_utf8_chars_til(this_buf->data, this_buf->size, insert_at).bytes_processed;
+    int ieee_exponent = (int)((bits >> 52) & 0x7ff);
+    if (ieee_exponent == 0x7ff)
+    {
+        rf__format_double(out, spec, value, conversion);
+        return;
+    }
+
+    rf_bool uppercase = conversion == 'A';
+    const char* hex_digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    char prefix[3];
+    rf_int prefix_size = 0;
+    if (bits >> 63) prefix[prefix_size++] = '-';
+    else if (spec.plus_sign) prefix[prefix_size++] = '+';
+    else if (spec.space_sign) prefix[prefix_size++] = ' ';
+    prefix[prefix_size++] = '0';
+    prefix[prefix_size++] = uppercase ? 'X' : 'x';
+
+    uint64_t mantissa = bits & ((1ull << 52) - 1); // 13 hex digits after the point
+    int lead = ieee_exponent ? 1 : 0;
+    int exponent = ieee_exponent ? ieee_exponent - 1023 : (mantissa ? -1022 : 0);
 
-    if (insertion_point && insertion_point < this_buf->size)
+    int precision = spec.precision;
+    if (precision < 0)
     {
-        // Move all bytes from the insertion point ahead by the size of the string we need to insert
-        {
-            char*  dst = this_buf->data + insertion_point + str_to_insert.size;
-            char*  src = this_buf->data + insertion_point;
-            rf_int src_size = this_buf->size - insertion_point;
-            memmove(dst, src, src_size);
-        }
+        // Only as many digits as needed to be exact
+        precision = 13;
+        while (precision > 0 && !((mantissa >> (4 * (13 - precision))) & 0xf)) precision--;
+    }
+    else if (precision < 13)
+    {
+        // Round half to even on the dropped digits, a carry out of the digits goes into the leading digit
+        int dropped_bits = 4 * (13 - precision);
+        uint64_t dropped = mantissa & ((1ull << dropped_bits) - 1);
+        uint64_t half = 1ull << (dropped_bits - 1);
+        mantissa >>= dropped_bits;
 
-        // Copy the string to insert
+        if (dropped > half || (dropped == half && (precision ? mantissa & 1 : lead & 1))) mantissa++;
+
+        if (mantissa >> (4 * precision))
         {
-            char* dst = this_buf->data + insertion_point;
-            memmove(dst, str_to_insert.data, str_to_insert.size);
+            mantissa &= (1ull << (4 * precision)) - 1;
+            lead++;
         }
 
-        this_buf->size += str_to_insert.size;
-        this_buf->data[this_buf->size] = 0;
+        mantissa <<= dropped_bits;
     }
+
+    char digits[16];
+    rf_int digits_size = 0;
+    digits[digits_size++] = hex_digits[lead];
+    if (precision > 0 || spec.alternate_form) digits[digits_size++] = '.';
+    for (int i = 0; i < precision && i < 13; i++) digits[digits_size++] = hex_digits[(mantissa >> (4 * (12 - i))) & 0xf];
+    rf_int trailing_zeros = precision > 13 ? precision - 13 : 0;
+
+    char exponent_buf[8];
+    char* exponent_end = exponent_buf + sizeof(exponent_buf);
+    char* exponent_begin = rf__format_u64(exponent < 0 ? -exponent : exponent, exponent_end, 10, 0);
+    *--exponent_begin = exponent < 0 ? '-' : '+';
+    *--exponent_begin = uppercase ? 'P' : 'p';
+
+    rf_int size = prefix_size + digits_size + trailing_zeros + (exponent_end - exponent_begin);
+    rf_int padding = spec.width > size ? spec.width - size : 0;
+
+    if (!spec.left_align && !spec.zero_pad) rf__format_pad(out, ' ', padding);
+    rf__format_out(out, prefix, prefix_size);
+    if (!spec.left_align && spec.zero_pad) rf__format_pad(out, '0', padding);
+    rf__format_out(out, digits, digits_size);
+    rf__format_pad(out, '0', trailing_zeros);
+    rf__format_out(out, exponent_begin, exponent_end - exponent_begin);
+    if (spec.left_align) rf__format_pad(out, ' ', padding);
 }
 
-rf_public void rf_strbuf_insert_b(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at)
+rf_internal void rf__format_v(rf__format_output* out, const char* format, va_list args)
 {
-    if (rf_str_valid(str_to_insert) && insert_at > 0)
+    const char* c = format;
+
+    while (*c)
     {
-        rf_strbuf_ensure_capacity_for(this_buf, str_to_insert.size);
+        // Copy the literal text up to the next conversion in one go
+        const char* literal = c;
+        while (*c && *c != '%') c++;
+        rf__format_out(out, literal, c - literal);
 
-        // Move all bytes from the insertion point ahead by the size of the string we need to insert
+        if (!*c) break;
+        const char* spec_begin = c++;
+
+        rf__format_spec spec = {0};
+        spec.precision = -1;
+
+        for (;; c++)
         {
-            char* dst = this_buf->data + insert_at + str_to_insert.size;
-            char* src = this_buf->data + insert_at;
-            rf_int src_size = this_buf->size - insert_at;
-            memmove(dst, src, src_size);
+            if      (*c == '-') spec.left_align = 1;
+            else if (*c == '+') spec.plus_sign = 1;
+            else if (*c == ' ') spec.space_sign = 1;
+            else if (*c == '#') spec.alternate_form = 1;
+            else if (*c == '0') spec.zero_pad = 1;
+            else break;
         }
 
-        // Copy the string to insert
+        if (*c == '*')
         {
-            char* dst = this_buf->data + insert_at;
-            memcpy(dst, str_to_insert.data, str_to_insert.size);
+            spec.width = va_arg(args, int);
+            if (spec.width < 0) { spec.left_align = 1; spec.width = -spec.width; }
+            c++;
         }
+        else while (*c >= '0' && *c <= '9') spec.width = spec.width * 10 + (*c++ - '0');
 
-        this_buf->size += str_to_insert.size;
-        this_buf->data[this_buf->size] = 0;
-    }
-}
+        if (*c == '.')
+        {
+            c++;
+            spec.precision = 0;
+            if (*c == '*')
+            {
+                spec.precision = va_arg(args, int);
+                if (spec.precision < 0) spec.precision = -1;
+                c++;
+            }
+            else while (*c >= '0' && *c <= '9') spec.precision = spec.precision * 10 + (*c++ - '0');
+        }
 
-rf_public void rf_strbuf_remove_range(rf_strbuf*, rf_int begin, rf_int end);
+        if (spec.left_align) spec.zero_pad = 0;
 
-rf_public void rf_strbuf_remove_range_b(rf_strbuf*, rf_int begin, rf_int end);
+        // Length modifiers, the sizes that matter are int, long, long long and the pointer sized types
+        int length = 0; // -2 hh, -1 h, 0 int, 1 long, 2 long long, 3 size_t/ptrdiff_t/intmax_t, 4 long double
+        for (;; c++)
+        {
+            if      (*c == 'h') length = length == -1 ? -2 : -1;
+            else if (*c == 'l') length = length == 1 ? 2 : 1;
+            else if (*c == 'j') length = 2;
+            else if (*c == 'z' || *c == 't') length = 3;
+            else if (*c == 'L') length = 4;
+            else break;
+        }
 
-rf_public void rf_strbuf_free(rf_strbuf* this_buf)
-{
-    rf_free(this_buf->allocator, this_buf->data);
+        char conversion = *c;
+        if (!conversion) break;
+        c++;
 
-    this_buf->size = 0;
-    this_buf->capacity = 0;
-}
-#pragma endregion
+        switch (conversion)
+        {
+            case 'd':
+            case 'i':
+            {
+                int64_t value;
+                if      (length == 1) value = va_arg(args, long);
+                else if (length == 2) value = va_arg(args, long long);
+                else if (length == 3) value = va_arg(args, ptrdiff_t);
+                else value = va_arg(args, int);
 
-#pragma region str
-rf_public rf_bool rf_str_valid(rf_str src)
-{
-    return src.size != 0 && src.data;
-}
+                if      (length == -1) value = (short) value;
+                else if (length == -2) value = (signed char) value;
 
-rf_public rf_int rf_str_len(rf_str src)
-{
-    rf_utf8_stats stats = rf_count_utf8_chars(src.data, src.size);
+                uint64_t magnitude = value < 0 ? 0 - (uint64_t) value : (uint64_t) value;
+                rf__format_integer(out, spec, magnitude, value < 0, conversion);
+            }
+            break;
 
-    return stats.total_rune_count;
-}
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            {
+                uint64_t value;
+                if      (length == 1) value = va_arg(args, unsigned long);
+                else if (length == 2) value = va_arg(args, unsigned long long);
+                else if (length == 3) value = va_arg(args, size_t);
+                else value = va_arg(args, unsigned int);
 
-rf_public rf_str rf_cstr(const char* src)
+                if      (length == -1) value = (unsigned short) value;
+                else if (length == -2) value = (unsigned char) value;
+
+                rf__format_integer(out, spec, value, 0, conversion);
+            }
+            break;
+
+            case 'p':
+            {
+                void* ptr = va_arg(args, void*);
+                spec.alternate_form = 1;
+                if (ptr) rf__format_integer(out, spec, (uint64_t)(uintptr_t) ptr, 0, 'x');
+                else rf__format_string(out, spec, "(nil)", 5);
+            }
+            break;
+
+            case 'c':
+            {
+                char ch = (char) va_arg(args, int);
+                rf__format_string(out, spec, &ch, 1);
+            }
+            break;
+
+            case 's':
+            {
+                const char* str = va_arg(args, const char*);
+                if (!str) str = "(null)";
+
+                // With a precision the string doesn't need to be null terminated
+                rf_int size = 0;
+                if (spec.precision >= 0) while (size < spec.precision && str[size]) size++;
+                else size = strlen(str);
+
+                rf__format_string(out, spec, str, size);
+            }
+            break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            {
+                double value = length == 4 ? (double) va_arg(args, long double) : va_arg(args, double);
+                rf__format_double(out, spec, value, conversion);
+            }
+            break;
+
+            case 'a':
+            case 'A':
+            {
+                double value = length == 4 ? (double) va_arg(args, long double) : va_arg(args, double);
+                rf__format_hex_double(out, spec, value, conversion);
+            }
+            break;
+
+            case 'n':
+                (void) va_arg(args, void*);
+                break;
+
+            case '%':
+                rf__format_out(out, "%", 1);
+                break;
+
+            default:
+                // Unknown conversions are written out as is along with their flags, width and precision
+                rf__format_out(out, spec_begin, c - spec_begin);
+                break;
+        }
+    }
+}
+
+typedef struct rf__format_buffer
+{
+    char*  dst;
+    rf_int dst_size;
+    rf_int written;
+} rf__format_buffer;
+
+rf_internal void rf__format_write_to_buffer(void* user_data, const char* data, rf_int size)
+{
+    rf__format_buffer* buffer = user_data;
+
+    // Keep space for the null terminator
+    rf_int space = buffer->dst_size - 1 - buffer->written;
+    rf_int amount = size < space ? size : space;
+
+    if (amount > 0)
+    {
+        memcpy(buffer->dst + buffer->written, data, amount);
+        buffer->written += amount;
+    }
+}
+
+rf_public rf_int rf_format_to_buffer_v(char* dst, rf_int dst_size, const char* format, va_list args)
+{
+    rf__format_buffer buffer = { dst, dst_size, 0 };
+    rf__format_output out = { rf__format_write_to_buffer, &buffer, 0 };
+
+    rf__format_v(&out, format, args);
+
+    if (dst && dst_size > 0) dst[buffer.written] = 0;
+
+    return out.size;
+}
+
+rf_public rf_int rf_format_to_buffer(char* dst, rf_int dst_size, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    rf_int result = rf_format_to_buffer_v(dst, dst_size, format, args);
+    va_end(args);
+
+    return result;
+}
+#pragma endregion
+
+#pragma region numbers
+
+/*
+ * Floats are parsed with Clinger's fast path when the decimal mantissa and the power of ten are both exact, then with the
+ * Eisel-Lemire algorithm which settles nearly every other input with one or two 64x64 bit multiplications, and in the rare
+ * cases it can't decide with an exact conversion on a big decimal number ported from the Go standard library.
+ * Shortest round trip formatting uses Raffaello Giulietti's Schubfach algorithm, both share the table of powers of ten below.
+ */
+
+#define RF__POW10_MIN_EXPONENT (-348)
+#define RF__POW10_MAX_EXPONENT (347)
+#define RF__MAX_MANTISSA_DIGITS (19)
+#define RF__DECIMAL_MAX_DIGITS (800)
+
+// Significands of 10^k rounded down to 128 bits and normalized so that the top bit is set, stored as { high, low }
+rf_internal const uint64_t rf__pow10_significands[RF__POW10_MAX_EXPONENT - RF__POW10_MIN_EXPONENT + 1][2] =
+{
+    { 0xfa8fd5a0081c0288ull, 0x1732c869cd60e453ull }, { 0x9c99e58405118195ull, 0x0e7fbd42205c8eb4ull },
+    { 0xc3c05ee50655e1faull, 0x521fac92a873b261ull }, { 0xf4b0769e47eb5a78ull, 0xe6a797b752909ef9ull },
+    { 0x98ee4a22ecf3188bull, 0x9028bed2939a635cull }, { 0xbf29dcaba82fdeaeull, 0x7432ee873880fc33ull },
+    { 0xeef453d6923bd65aull, 0x113faa2906a13b3full }, { 0x9558b4661b6565f8ull, 0x4ac7ca59a424c507ull },
+    { 0xbaaee17fa23ebf76ull, 0x5d79bcf00d2df649ull }, { 0xe95a99df8ace6f53ull, 0xf4d82c2c107973dcull },
+    { 0x91d8a02bb6c10594ull, 0x79071b9b8a4be869ull }, { 0xb64ec836a47146f9ull, 0x9748e2826cdee284ull },
+    { 0xe3e27a444d8d98b7ull, 0xfd1b1b2308169b25ull }, { 0x8e6d8c6ab0787f72ull, 0xfe30f0f5e50e20f7ull },
+    { 0xb208ef855c969f4full, 0xbdbd2d335e51a935ull }, { 0xde8b2b66b3bc4723ull, 0xad2c788035e61382ull },
+    { 0x8b16fb203055ac76ull, 0x4c3bcb5021afcc31ull }, { 0xaddcb9e83c6b1793ull, 0xdf4abe242a1bbf3dull },
+    { 0xd953e8624b85dd78ull, 0xd71d6dad34a2af0dull }, { 0x87d4713d6f33aa6bull, 0x8672648c40e5ad68ull },
+    { 0xa9c98d8ccb009506ull, 0x680efdaf511f18c2ull }, { 0xd43bf0effdc0ba48ull, 0x0212bd1b2566def2ull },
+    { 0x84a57695fe98746dull, 0x014bb630f7604b57ull }, { 0xa5ced43b7e3e9188ull, 0x419ea3bd35385e2dull },
+    { 0xcf42894a5dce35eaull, 0x52064cac828675b9ull }, { 0x818995ce7aa0e1b2ull, 0x7343efebd1940993ull },
+    { 0xa1ebfb4219491a1full, 0x1014ebe6c5f90bf8ull }, { 0xca66fa129f9b60a6ull, 0xd41a26e077774ef6ull },
+    { 0xfd00b897478238d0ull, 0x8920b098955522b4ull }, { 0x9e20735e8cb16382ull, 0x55b46e5f5d5535b0ull },
+    { 0xc5a890362fddbc62ull, 0xeb2189f734aa831dull }, { 0xf712b443bbd52b7bull, 0xa5e9ec7501d523e4ull },
+    { 0x9a6bb0aa55653b2dull, 0x47b233c92125366eull }, { 0xc1069cd4eabe89f8ull, 0x999ec0bb696e840aull },
+    { 0xf148440a256e2c76ull, 0xc00670ea43ca250dull }, { 0x96cd2a865764dbcaull, 0x380406926a5e5728ull },
+    { 0xbc807527ed3e12bcull, 0xc605083704f5ecf2ull }, { 0xeba09271e88d976bull, 0xf7864a44c633682eull },
+    { 0x93445b8731587ea3ull, 0x7ab3ee6afbe0211dull }, { 0xb8157268fdae9e4cull, 0x5960ea05bad82964ull },
+    { 0xe61acf033d1a45dfull, 0x6fb92487298e33bdull }, { 0x8fd0c16206306babull, 0xa5d3b6d479f8e056ull },
+    { 0xb3c4f1ba87bc8696ull, 0x8f48a4899877186cull }, { 0xe0b62e2929aba83cull, 0x331acdabfe94de87ull },
+    { 0x8c71dcd9ba0b4925ull, 0x9ff0c08b7f1d0b14ull }, { 0xaf8e5410288e1b6full, 0x07ecf0ae5ee44dd9ull },
+    { 0xdb71e91432b1a24aull, 0xc9e82cd9f69d6150ull }, { 0x892731ac9faf056eull, 0xbe311c083a225cd2ull },
+    { 0xab70fe17c79ac6caull, 0x6dbd630a48aaf406ull }, { 0xd64d3d9db981787dull, 0x092cbbccdad5b108ull },
+    { 0x85f0468293f0eb4eull, 0x25bbf56008c58ea5ull }, { 0xa76c582338ed2621ull, 0xaf2af2b80af6f24eull },
+    { 0xd1476e2c07286faaull, 0x1af5af660db4aee1ull }, { 0x82cca4db847945caull, 0x50d98d9fc890ed4dull },
+    { 0xa37fce126597973cull, 0xe50ff107bab528a0ull }, { 0xcc5fc196fefd7d0cull, 0x1e53ed49a96272c8ull },
+    { 0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7aull }, { 0x9faacf3df73609b1ull, 0x77b191618c54e9acull },
+    { 0xc795830d75038c1dull, 0xd59df5b9ef6a2417ull }, { 0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1dull },
+    { 0x9becce62836ac577ull, 0x4ee367f9430aec32ull }, { 0xc2e801fb244576d5ull, 0x229c41f793cda73full },
+    { 0xf3a20279ed56d48aull, 0x6b43527578c1110full }, { 0x9845418c345644d6ull, 0x830a13896b78aaa9ull },
+    { 0xbe5691ef416bd60cull, 0x23cc986bc656d553ull }, { 0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa8ull },
+    { 0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6a9ull }, { 0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc53ull },
+    { 0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff68ull }, { 0x91376c36d99995beull, 0x23100809b9c21fa1ull },
+    { 0xb58547448ffffb2dull, 0xabd40a0c2832a78aull }, { 0xe2e69915b3fff9f9ull, 0x16c90c8f323f516cull },
+    { 0x8dd01fad907ffc3bull, 0xae3da7d97f6792e3ull }, { 0xb1442798f49ffb4aull, 0x99cd11cfdf41779cull },
+    { 0xdd95317f31c7fa1dull, 0x40405643d711d583ull }, { 0x8a7d3eef7f1cfc52ull, 0x482835ea666b2572ull },
+    { 0xad1c8eab5ee43b66ull, 0xda3243650005eecfull }, { 0xd863b256369d4a40ull, 0x90bed43e40076a82ull },
+    { 0x873e4f75e2224e68ull, 0x5a7744a6e804a291ull }, { 0xa90de3535aaae202ull, 0x711515d0a205cb36ull },
+    { 0xd3515c2831559a83ull, 0x0d5a5b44ca873e03ull }, { 0x8412d9991ed58091ull, 0xe858790afe9486c2ull },
+    { 0xa5178fff668ae0b6ull, 0x626e974dbe39a872ull }, { 0xce5d73ff402d98e3ull, 0xfb0a3d212dc8128full },
+    { 0x80fa687f881c7f8eull, 0x7ce66634bc9d0b99ull }, { 0xa139029f6a239f72ull, 0x1c1fffc1ebc44e80ull },
+    { 0xc987434744ac874eull, 0xa327ffb266b56220ull }, { 0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa8ull },
+    { 0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4a9ull }, { 0xc4ce17b399107c22ull, 0xcb550fb4384d21d3ull },
+    { 0xf6019da07f549b2bull, 0x7e2a53a146606a48ull }, { 0x99c102844f94e0fbull, 0x2eda7444cbfc426dull },
+    { 0xc0314325637a1939ull, 0xfa911155fefb5308ull }, { 0xf03d93eebc589f88ull, 0x793555ab7eba27caull },
+    { 0x96267c7535b763b5ull, 0x4bc1558b2f3458deull }, { 0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f16ull },
+    { 0xea9c227723ee8bcbull, 0x465e15a979c1cadcull }, { 0x92a1958a7675175full, 0x0bfacd89ec191ec9ull },
+    { 0xb749faed14125d36ull, 0xcef980ec671f667bull }, { 0xe51c79a85916f484ull, 0x82b7e12780e7401aull },
+    { 0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908810ull }, { 0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa15ull },
+    { 0xdfbdcece67006ac9ull, 0x67a791e093e1d49aull }, { 0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e0ull },
+    { 0xaecc49914078536dull, 0x58fae9f773886e18ull }, { 0xda7f5bf590966848ull, 0xaf39a475506a899eull },
+    { 0x888f99797a5e012dull, 0x6d8406c952429603ull }, { 0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b83ull },
+    { 0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a64ull }, { 0x855c3be0a17fcd26ull, 0x5cf2eea09a55067full },
+    { 0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481eull }, { 0xd0601d8efc57b08bull, 0xf13b94daf124da26ull },
+    { 0x823c12795db6ce57ull, 0x76c53d08d6b70858ull }, { 0xa2cb1717b52481edull, 0x54768c4b0c64ca6eull },
+    { 0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd09ull }, { 0xfe5d54150b090b02ull, 0xd3f93b35435d7c4cull },
+    { 0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6dafull }, { 0xc6b8e9b0709f109aull, 0x359ab6419ca1091bull },
+    { 0xf867241c8cc6d4c0ull, 0xc30163d203c94b62ull }, { 0x9b407691d7fc44f8ull, 0x79e0de63425dcf1dull },
+    { 0xc21094364dfb5636ull, 0x985915fc12f542e4ull }, { 0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939dull },
+    { 0x979cf3ca6cec5b5aull, 0xa705992ceecf9c42ull }, { 0xbd8430bd08277231ull, 0x50c6ff782a838353ull },
+    { 0xece53cec4a314ebdull, 0xa4f8bf5635246428ull }, { 0x940f4613ae5ed136ull, 0x871b7795e136be99ull },
+    { 0xb913179899f68584ull, 0x28e2557b59846e3full }, { 0xe757dd7ec07426e5ull, 0x331aeada2fe589cfull },
+    { 0x9096ea6f3848984full, 0x3ff0d2c85def7621ull }, { 0xb4bca50b065abe63ull, 0x0fed077a756b53a9ull },
+    { 0xe1ebce4dc7f16dfbull, 0xd3e8495912c62894ull }, { 0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95cull },
+    { 0xb080392cc4349decull, 0xbd8d794d96aacfb3ull }, { 0xdca04777f541c567ull, 0xecf0d7a0fc5583a0ull },
+    { 0x89e42caaf9491b60ull, 0xf41686c49db57244ull }, { 0xac5d37d5b79b6239ull, 0x311c2875c522ced5ull },
+    { 0xd77485cb25823ac7ull, 0x7d633293366b828bull }, { 0x86a8d39ef77164bcull, 0xae5dff9c02033197ull },
+    { 0xa8530886b54dbdebull, 0xd9f57f830283fdfcull }, { 0xd267caa862a12d66ull, 0xd072df63c324fd7bull },
+    { 0x8380dea93da4bc60ull, 0x4247cb9e59f71e6dull }, { 0xa46116538d0deb78ull, 0x52d9be85f074e608ull },
+    { 0xcd795be870516656ull, 0x67902e276c921f8bull }, { 0x806bd9714632dff6ull, 0x00ba1cd8a3db53b6ull },
+    { 0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a4ull }, { 0xc8a883c0fdaf7df0ull, 0x6122cd128006b2cdull },
+    { 0xfad2a4b13d1b5d6cull, 0x796b805720085f81ull }, { 0x9cc3a6eec6311a63ull, 0xcbe3303674053bb0ull },
+    { 0xc3f490aa77bd60fcull, 0xbedbfc4411068a9cull }, { 0xf4f1b4d515acb93bull, 0xee92fb5515482d44ull },
+    { 0x991711052d8bf3c5ull, 0x751bdd152d4d1c4aull }, { 0xbf5cd54678eef0b6ull, 0xd262d45a78a0635dull },
+    { 0xef340a98172aace4ull, 0x86fb897116c87c34ull }, { 0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da0ull },
+    { 0xbae0a846d2195712ull, 0x8974836059cca109ull }, { 0xe998d258869facd7ull, 0x2bd1a438703fc94bull },
+    { 0x91ff83775423cc06ull, 0x7b6306a34627ddcfull }, { 0xb67f6455292cbf08ull, 0x1a3bc84c17b1d542ull },
+    { 0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a93ull }, { 0x8e938662882af53eull, 0x547eb47b7282ee9cull },
+    { 0xb23867fb2a35b28dull, 0xe99e619a4f23aa43ull }, { 0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d4ull },
+    { 0x8b3c113c38f9f37eull, 0xde83bc408dd3dd04ull }, { 0xae0b158b4738705eull, 0x9624ab50b148d445ull },
+    { 0xd98ddaee19068c76ull, 0x3badd624dd9b0957ull }, { 0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d6ull },
+    { 0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4cull }, { 0xd47487cc8470652bull, 0x7647c3200069671full },
+    { 0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e073ull }, { 0xa5fb0a17c777cf09ull, 0xf468107100525890ull },
+    { 0xcf79cc9db955c2ccull, 0x7182148d4066eeb4ull }, { 0x81ac1fe293d599bfull, 0xc6f14cd848405530ull },
+    { 0xa21727db38cb002full, 0xb8ada00e5a506a7cull }, { 0xca9cf1d206fdc03bull, 0xa6d90811f0e4851cull },
+    { 0xfd442e4688bd304aull, 0x908f4a166d1da663ull }, { 0x9e4a9cec15763e2eull, 0x9a598e4e043287feull },
+    { 0xc5dd44271ad3cdbaull, 0x40eff1e1853f29fdull }, { 0xf7549530e188c128ull, 0xd12bee59e68ef47cull },
+    { 0x9a94dd3e8cf578b9ull, 0x82bb74f8301958ceull }, { 0xc13a148e3032d6e7ull, 0xe36a52363c1faf01ull },
+    { 0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac1ull }, { 0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0b9ull },
+    { 0xbcb2b812db11a5deull, 0x7415d448f6b6f0e7ull }, { 0xebdf661791d60f56ull, 0x111b495b3464ad21ull },
+    { 0x936b9fcebb25c995ull, 0xcab10dd900beec34ull }, { 0xb84687c269ef3bfbull, 0x3d5d514f40eea742ull },
+    { 0xe65829b3046b0afaull, 0x0cb4a5a3112a5112ull }, { 0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72abull },
+    { 0xb3f4e093db73a093ull, 0x59ed216765690f56ull }, { 0xe0f218b8d25088b8ull, 0x306869c13ec3532cull },
+    { 0x8c974f7383725573ull, 0x1e414218c73a13fbull }, { 0xafbd2350644eeacfull, 0xe5d1929ef90898faull },
+    { 0xdbac6c247d62a583ull, 0xdf45f746b74abf39ull }, { 0x894bc396ce5da772ull, 0x6b8bba8c328eb783ull },
+    { 0xab9eb47c81f5114full, 0x066ea92f3f326564ull }, { 0xd686619ba27255a2ull, 0xc80a537b0efefebdull },
+    { 0x8613fd0145877585ull, 0xbd06742ce95f5f36ull }, { 0xa798fc4196e952e7ull, 0x2c48113823b73704ull },
+    { 0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c5ull }, { 0x82ef85133de648c4ull, 0x9a984d73dbe722fbull },
+    { 0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbaull }, { 0xcc963fee10b7d1b3ull, 0x318df905079926a8ull },
+    { 0xffbbcfe994e5c61full, 0xfdf17746497f7052ull }, { 0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa633ull },
+    { 0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc0ull }, { 0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b0ull },
+    { 0x9c1661a651213e2dull, 0x06bea10ca65c084eull }, { 0xc31bfa0fe5698db8ull, 0x486e494fcff30a62ull },
+    { 0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfaull }, { 0x986ddb5c6b3a76b7ull, 0xf89629465a75e01cull },
+    { 0xbe89523386091465ull, 0xf6bbb397f1135823ull }, { 0xee2ba6c0678b597full, 0x746aa07ded582e2cull },
+    { 0x94db483840b717efull, 0xa8c2a44eb4571cdcull }, { 0xba121a4650e4ddebull, 0x92f34d62616ce413ull },
+    { 0xe896a0d7e51e1566ull, 0x77b020baf9c81d17ull }, { 0x915e2486ef32cd60ull, 0x0ace1474dc1d122eull },
+    { 0xb5b5ada8aaff80b8ull, 0x0d819992132456baull }, { 0xe3231912d5bf60e6ull, 0x10e1fff697ed6c69ull },
+    { 0x8df5efabc5979c8full, 0xca8d3ffa1ef463c1ull }, { 0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb2ull },
+    { 0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdeull }, { 0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96bull },
+    { 0xad4ab7112eb3929dull, 0x86c16c98d2c953c6ull }, { 0xd89d64d57a607744ull, 0xe871c7bf077ba8b7ull },
+    { 0x87625f056c7c4a8bull, 0x11471cd764ad4972ull }, { 0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bcfull },
+    { 0xd389b47879823479ull, 0x4aff1d108d4ec2c3ull }, { 0x843610cb4bf160cbull, 0xcedf722a585139baull },
+    { 0xa54394fe1eedb8feull, 0xc2974eb4ee658828ull }, { 0xce947a3da6a9273eull, 0x733d226229feea32ull },
+    { 0x811ccc668829b887ull, 0x0806357d5a3f525full }, { 0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f7ull },
+    { 0xc9bcff6034c13052ull, 0xfc89b393dd02f0b5ull }, { 0xfc2c3f3841f17c67ull, 0xbbac2078d443ace2ull },
+    { 0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0dull }, { 0xc5029163f384a931ull, 0x0a9e795e65d4df11ull },
+    { 0xf64335bcf065d37dull, 0x4d4617b5ff4a16d5ull }, { 0x99ea0196163fa42eull, 0x504bced1bf8e4e45ull },
+    { 0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d6ull }, { 0xf07da27a82c37088ull, 0x5d767327bb4e5a4cull },
+    { 0x964e858c91ba2655ull, 0x3a6a07f8d510f86full }, { 0xbbe226efb628afeaull, 0x890489f70a55368bull },
+    { 0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842eull }, { 0x92c8ae6b464fc96full, 0x3b0b8bc90012929dull },
+    { 0xb77ada0617e3bbcbull, 0x09ce6ebb40173744ull }, { 0xe55990879ddcaabdull, 0xcc420a6a101d0515ull },
+    { 0x8f57fa54c2a9eab6ull, 0x9fa946824a12232dull }, { 0xb32df8e9f3546564ull, 0x47939822dc96abf9ull },
+    { 0xdff9772470297ebdull, 0x59787e2b93bc56f7ull }, { 0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65aull },
+    { 0xaefae51477a06b03ull, 0xede622920b6b23f1ull }, { 0xdab99e59958885c4ull, 0xe95fab368e45ecedull },
+    { 0x88b402f7fd75539bull, 0x11dbcb0218ebb414ull }, { 0xaae103b5fcd2a881ull, 0xd652bdc29f26a119ull },
+    { 0xd59944a37c0752a2ull, 0x4be76d3346f0495full }, { 0x857fcae62d8493a5ull, 0x6f70a4400c562ddbull },
+    { 0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb952ull }, { 0xd097ad07a71f26b2ull, 0x7e2000a41346a7a7ull },
+    { 0x825ecc24c873782full, 0x8ed400668c0c28c8ull }, { 0xa2f67f2dfa90563bull, 0x728900802f0f32faull },
+    { 0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffb9ull }, { 0xfea126b7d78186bcull, 0xe2f610c84987bfa8ull },
+    { 0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7c9ull }, { 0xc6ede63fa05d3143ull, 0x91503d1c79720dbbull },
+    { 0xf8a95fcf88747d94ull, 0x75a44c6397ce912aull }, { 0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abaull },
+    { 0xc24452da229b021bull, 0xfbe85badce996168ull }, { 0xf2d56790ab41c2a2ull, 0xfae27299423fb9c3ull },
+    { 0x97c560ba6b0919a5ull, 0xdccd879fc967d41aull }, { 0xbdb6b8e905cb600full, 0x5400e987bbc1c920ull },
+    { 0xed246723473e3813ull, 0x290123e9aab23b68ull }, { 0x9436c0760c86e30bull, 0xf9a0b6720aaf6521ull },
+    { 0xb94470938fa89bceull, 0xf808e40e8d5b3e69ull }, { 0xe7958cb87392c2c2ull, 0xb60b1d1230b20e04ull },
+    { 0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c2ull }, { 0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af3ull },
+    { 0xe2280b6c20dd5232ull, 0x25c6da63c38de1b0ull }, { 0x8d590723948a535full, 0x579c487e5a38ad0eull },
+    { 0xb0af48ec79ace837ull, 0x2d835a9df0c6d851ull }, { 0xdcdb1b2798182244ull, 0xf8e431456cf88e65ull },
+    { 0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b58ffull }, { 0xac8b2d36eed2dac5ull, 0xe272467e3d222f3full },
+    { 0xd7adf884aa879177ull, 0x5b0ed81dcc6abb0full }, { 0x86ccbb52ea94baeaull, 0x98e947129fc2b4e9ull },
+    { 0xa87fea27a539e9a5ull, 0x3f2398d747b36224ull }, { 0xd29fe4b18e88640eull, 0x8eec7f0d19a03aadull },
+    { 0x83a3eeeef9153e89ull, 0x1953cf68300424acull }, { 0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd7ull },
+    { 0xcdb02555653131b6ull, 0x3792f412cb06794dull }, { 0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd0ull },
+    { 0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec4ull }, { 0xc8de047564d20a8bull, 0xf245825a5a445275ull },
+    { 0xfb158592be068d2eull, 0xeed6e2f0f0d56712ull }, { 0x9ced737bb6c4183dull, 0x55464dd69685606bull },
+    { 0xc428d05aa4751e4cull, 0xaa97e14c3c26b886ull }, { 0xf53304714d9265dfull, 0xd53dd99f4b3066a8ull },
+    { 0x993fe2c6d07b7fabull, 0xe546a8038efe4029ull }, { 0xbf8fdb78849a5f96ull, 0xde98520472bdd033ull },
+    { 0xef73d256a5c0f77cull, 0x963e66858f6d4440ull }, { 0x95a8637627989aadull, 0xdde7001379a44aa8ull },
+    { 0xbb127c53b17ec159ull, 0x5560c018580d5d52ull }, { 0xe9d71b689dde71afull, 0xaab8f01e6e10b4a6ull },
+    { 0x9226712162ab070dull, 0xcab3961304ca70e8ull }, { 0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d22ull },
+    { 0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506aull }, { 0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb242ull },
+    { 0xb267ed1940f1c61cull, 0x55f038b237591ed3ull }, { 0xdf01e85f912e37a3ull, 0x6b6c46dec52f6688ull },
+    { 0x8b61313bbabce2c6ull, 0x2323ac4b3b3da015ull }, { 0xae397d8aa96c1b77ull, 0xabec975e0a0d081aull },
+    { 0xd9c7dced53c72255ull, 0x96e7bd358c904a21ull }, { 0x881cea14545c7575ull, 0x7e50d64177da2e54ull },
+    { 0xaa242499697392d2ull, 0xdde50bd1d5d0b9e9ull }, { 0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e864ull },
+    { 0x84ec3c97da624ab4ull, 0xbd5af13bef0b113eull }, { 0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58eull },
+    { 0xcfb11ead453994baull, 0x67de18eda5814af2ull }, { 0x81ceb32c4b43fcf4ull, 0x80eacf948770ced7ull },
+    { 0xa2425ff75e14fc31ull, 0xa1258379a94d028dull }, { 0xcad2f7f5359a3b3eull, 0x096ee45813a04330ull },
+    { 0xfd87b5f28300ca0dull, 0x8bca9d6e188853fcull }, { 0x9e74d1b791e07e48ull, 0x775ea264cf55347dull },
+    { 0xc612062576589ddaull, 0x95364afe032a819dull }, { 0xf79687aed3eec551ull, 0x3a83ddbd83f52204ull },
+    { 0x9abe14cd44753b52ull, 0xc4926a9672793542ull }, { 0xc16d9a0095928a27ull, 0x75b7053c0f178293ull },
+    { 0xf1c90080baf72cb1ull, 0x5324c68b12dd6338ull }, { 0x971da05074da7beeull, 0xd3f6fc16ebca5e03ull },
+    { 0xbce5086492111aeaull, 0x88f4bb1ca6bcf584ull }, { 0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e5ull },
+    { 0x9392ee8e921d5d07ull, 0x3aff322e62439fcfull }, { 0xb877aa3236a4b449ull, 0x09befeb9fad487c2ull },
+    { 0xe69594bec44de15bull, 0x4c2ebe687989a9b3ull }, { 0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a10ull },
+    { 0xb424dc35095cd80full, 0x538484c19ef38c94ull }, { 0xe12e13424bb40e13ull, 0x2865a5f206b06fb9ull },
+    { 0x8cbccc096f5088cbull, 0xf93f87b7442e45d3ull }, { 0xafebff0bcb24aafeull, 0xf78f69a51539d748ull },
+    { 0xdbe6fecebdedd5beull, 0xb573440e5a884d1bull }, { 0x89705f4136b4a597ull, 0x31680a88f8953030ull },
+    { 0xabcc77118461cefcull, 0xfdc20d2b36ba7c3dull }, { 0xd6bf94d5e57a42bcull, 0x3d32907604691b4cull },
+    { 0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b10full }, { 0xa7c5ac471b478423ull, 0x0fcf80dc33721d53ull },
+    { 0xd1b71758e219652bull, 0xd3c36113404ea4a8ull }, { 0x83126e978d4fdf3bull, 0x645a1cac083126e9ull },
+    { 0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a3ull }, { 0xccccccccccccccccull, 0xccccccccccccccccull },
+    { 0x8000000000000000ull, 0x0000000000000000ull }, { 0xa000000000000000ull, 0x0000000000000000ull },
+    { 0xc800000000000000ull, 0x0000000000000000ull }, { 0xfa00000000000000ull, 0x0000000000000000ull },
+    { 0x9c40000000000000ull, 0x0000000000000000ull }, { 0xc350000000000000ull, 0x0000000000000000ull },
+    { 0xf424000000000000ull, 0x0000000000000000ull }, { 0x9896800000000000ull, 0x0000000000000000ull },
+    { 0xbebc200000000000ull, 0x0000000000000000ull }, { 0xee6b280000000000ull, 0x0000000000000000ull },
+    { 0x9502f90000000000ull, 0x0000000000000000ull }, { 0xba43b74000000000ull, 0x0000000000000000ull },
+    { 0xe8d4a51000000000ull, 0x0000000000000000ull }, { 0x9184e72a00000000ull, 0x0000000000000000ull },
+    { 0xb5e620f480000000ull, 0x0000000000000000ull }, { 0xe35fa931a0000000ull, 0x0000000000000000ull },
+    { 0x8e1bc9bf04000000ull, 0x0000000000000000ull }, { 0xb1a2bc2ec5000000ull, 0x0000000000000000ull },
+    { 0xde0b6b3a76400000ull, 0x0000000000000000ull }, { 0x8ac7230489e80000ull, 0x0000000000000000ull },
+    { 0xad78ebc5ac620000ull, 0x0000000000000000ull }, { 0xd8d726b7177a8000ull, 0x0000000000000000ull },
+    { 0x878678326eac9000ull, 0x0000000000000000ull }, { 0xa968163f0a57b400ull, 0x0000000000000000ull },
+    { 0xd3c21bcecceda100ull, 0x0000000000000000ull }, { 0x84595161401484a0ull, 0x0000000000000000ull },
+    { 0xa56fa5b99019a5c8ull, 0x0000000000000000ull }, { 0xcecb8f27f4200f3aull, 0x0000000000000000ull },
+    { 0x813f3978f8940984ull, 0x4000000000000000ull }, { 0xa18f07d736b90be5ull, 0x5000000000000000ull },
+    { 0xc9f2c9cd04674edeull, 0xa400000000000000ull }, { 0xfc6f7c4045812296ull, 0x4d00000000000000ull },
+    { 0x9dc5ada82b70b59dull, 0xf020000000000000ull }, { 0xc5371912364ce305ull, 0x6c28000000000000ull },
+    { 0xf684df56c3e01bc6ull, 0xc732000000000000ull }, { 0x9a130b963a6c115cull, 0x3c7f400000000000ull },
+    { 0xc097ce7bc90715b3ull, 0x4b9f100000000000ull }, { 0xf0bdc21abb48db20ull, 0x1e86d40000000000ull },
+    { 0x96769950b50d88f4ull, 0x1314448000000000ull }, { 0xbc143fa4e250eb31ull, 0x17d955a000000000ull },
+    { 0xeb194f8e1ae525fdull, 0x5dcfab0800000000ull }, { 0x92efd1b8d0cf37beull, 0x5aa1cae500000000ull },
+    { 0xb7abc627050305adull, 0xf14a3d9e40000000ull }, { 0xe596b7b0c643c719ull, 0x6d9ccd05d0000000ull },
+    { 0x8f7e32ce7bea5c6full, 0xe4820023a2000000ull }, { 0xb35dbf821ae4f38bull, 0xdda2802c8a800000ull },
+    { 0xe0352f62a19e306eull, 0xd50b2037ad200000ull }, { 0x8c213d9da502de45ull, 0x4526f422cc340000ull },
+    { 0xaf298d050e4395d6ull, 0x9670b12b7f410000ull }, { 0xdaf3f04651d47b4cull, 0x3c0cdd765f114000ull },
+    { 0x88d8762bf324cd0full, 0xa5880a69fb6ac800ull }, { 0xab0e93b6efee0053ull, 0x8eea0d047a457a00ull },
+    { 0xd5d238a4abe98068ull, 0x72a4904598d6d880ull }, { 0x85a36366eb71f041ull, 0x47a6da2b7f864750ull },
+    { 0xa70c3c40a64e6c51ull, 0x999090b65f67d924ull }, { 0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6dull },
+    { 0x82818f1281ed449full, 0xbff8f10e7a8921a4ull }, { 0xa321f2d7226895c7ull, 0xaff72d52192b6a0dull },
+    { 0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764490ull }, { 0xfee50b7025c36a08ull, 0x02f236d04753d5b4ull },
+    { 0x9f4f2726179a2245ull, 0x01d762422c946590ull }, { 0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef5ull },
+    { 0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb2ull }, { 0x9b934c3b330c8577ull, 0x63cc55f49f88eb2full },
+    { 0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fbull }, { 0xf316271c7fc3908aull, 0x8bef464e3945ef7aull },
+    { 0x97edd871cfda3a56ull, 0x97758bf0e3cbb5acull }, { 0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea317ull },
+    { 0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bddull }, { 0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6aull },
+    { 0xb975d6b6ee39e436ull, 0xb3e2fd538e122b44ull }, { 0xe7d34c64a9c85d44ull, 0x60dbbca87196b616ull },
+    { 0x90e40fbeea1d3a4aull, 0xbc8955e946fe31cdull }, { 0xb51d13aea4a488ddull, 0x6babab6398bdbe41ull },
+    { 0xe264589a4dcdab14ull, 0xc696963c7eed2dd1ull }, { 0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca2ull },
+    { 0xb0de65388cc8ada8ull, 0x3b25a55f43294bcbull }, { 0xdd15fe86affad912ull, 0x49ef0eb713f39ebeull },
+    { 0x8a2dbf142dfcc7abull, 0x6e3569326c784337ull }, { 0xacb92ed9397bf996ull, 0x49c2c37f07965404ull },
+    { 0xd7e77a8f87daf7fbull, 0xdc33745ec97be906ull }, { 0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a3ull },
+    { 0xa8acd7c0222311bcull, 0xc40832ea0d68ce0cull }, { 0xd2d80db02aabd62bull, 0xf50a3fa490c30190ull },
+    { 0x83c7088e1aab65dbull, 0x792667c6da79e0faull }, { 0xa4b8cab1a1563f52ull, 0x577001b891185938ull },
+    { 0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f86ull }, { 0x80b05e5ac60b6178ull, 0x544f8158315b05b4ull },
+    { 0xa0dc75f1778e39d6ull, 0x696361ae3db1c721ull }, { 0xc913936dd571c84cull, 0x03bc3a19cd1e38e9ull },
+    { 0xfb5878494ace3a5full, 0x04ab48a04065c723ull }, { 0x9d174b2dcec0e47bull, 0x62eb0d64283f9c76ull },
+    { 0xc45d1df942711d9aull, 0x3ba5d0bd324f8394ull }, { 0xf5746577930d6500ull, 0xca8f44ec7ee36479ull },
+    { 0x9968bf6abbe85f20ull, 0x7e998b13cf4e1ecbull }, { 0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67eull },
+    { 0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101eull }, { 0x95d04aee3b80ece5ull, 0xbba1f1d158724a12ull },
+    { 0xbb445da9ca61281full, 0x2a8a6e45ae8edc97ull }, { 0xea1575143cf97226ull, 0xf52d09d71a3293bdull },
+    { 0x924d692ca61be758ull, 0x593c2626705f9c56ull }, { 0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836cull },
+    { 0xe498f455c38b997aull, 0x0b6dfb9c0f956447ull }, { 0x8edf98b59a373fecull, 0x4724bd4189bd5eacull },
+    { 0xb2977ee300c50fe7ull, 0x58edec91ec2cb657ull }, { 0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3edull },
+    { 0x8b865b215899f46cull, 0xbd79e0d20082ee74ull }, { 0xae67f1e9aec07187ull, 0xecd8590680a3aa11ull },
+    { 0xda01ee641a708de9ull, 0xe80e6f4820cc9495ull }, { 0x884134fe908658b2ull, 0x3109058d147fdcddull },
+    { 0xaa51823e34a7eedeull, 0xbd4b46f0599fd415ull }, { 0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91aull },
+    { 0x850fadc09923329eull, 0x03e2cf6bc604ddb0ull }, { 0xa6539930bf6bff45ull, 0x84db8346b786151cull },
+    { 0xcfe87f7cef46ff16ull, 0xe612641865679a63ull }, { 0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07eull },
+    { 0xa26da3999aef7749ull, 0xe3be5e330f38f09dull }, { 0xcb090c8001ab551cull, 0x5cadf5bfd3072cc5ull },
+    { 0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f6ull }, { 0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afaull },
+    { 0xc646d63501a1511dull, 0xb281e1fd541501b8ull }, { 0xf7d88bc24209a565ull, 0x1f225a7ca91a4226ull },
+    { 0x9ae757596946075full, 0x3375788de9b06958ull }, { 0xc1a12d2fc3978937ull, 0x0052d6b1641c83aeull },
+    { 0xf209787bb47d6b84ull, 0xc0678c5dbd23a49aull }, { 0x9745eb4d50ce6332ull, 0xf840b7ba963646e0ull },
+    { 0xbd176620a501fbffull, 0xb650e5a93bc3d898ull }, { 0xec5d3fa8ce427affull, 0xa3e51f138ab4cebeull },
+    { 0x93ba47c980e98cdfull, 0xc66f336c36b10137ull }, { 0xb8a8d9bbe123f017ull, 0xb80b0047445d4184ull },
+    { 0xe6d3102ad96cec1dull, 0xa60dc059157491e5ull }, { 0x9043ea1ac7e41392ull, 0x87c89837ad68db2full },
+    { 0xb454e4a179dd1877ull, 0x29babe4598c311fbull }, { 0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67aull },
+    { 0x8ce2529e2734bb1dull, 0x1899e4a65f58660cull }, { 0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f8full },
+    { 0xdc21a1171d42645dull, 0x76707543f4fa1f73ull }, { 0x899504ae72497ebaull, 0x6a06494a791c53a8ull },
+    { 0xabfa45da0edbde69ull, 0x0487db9d17636892ull }, { 0xd6f8d7509292d603ull, 0x45a9d2845d3c42b6ull },
+    { 0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b2ull }, { 0xa7f26836f282b732ull, 0x8e6cac7768d7141eull },
+    { 0xd1ef0244af2364ffull, 0x3207d795430cd926ull }, { 0x8335616aed761f1full, 0x7f44e6bd49e807b8ull },
+    { 0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a6ull }, { 0xcd036837130890a1ull, 0x36dba887c37a8c0full },
+    { 0x802221226be55a64ull, 0xc2494954da2c9789ull }, { 0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6cull },
+    { 0xc83553c5c8965d3dull, 0x6f92829494e5acc7ull }, { 0xfa42a8b73abbf48cull, 0xcb772339ba1f17f9ull },
+    { 0x9c69a97284b578d7ull, 0xff2a760414536efbull }, { 0xc38413cf25e2d70dull, 0xfef5138519684abaull },
+    { 0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d69ull }, { 0x98bf2f79d5993802ull, 0xef2f773ffbd97a61ull },
+    { 0xbeeefb584aff8603ull, 0xaafb550ffacfd8faull }, { 0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf38ull },
+    { 0x952ab45cfa97a0b2ull, 0xdd945a747bf26183ull }, { 0xba756174393d88dfull, 0x94f971119aeef9e4ull },
+    { 0xe912b9d1478ceb17ull, 0x7a37cd5601aab85dull }, { 0x91abb422ccb812eeull, 0xac62e055c10ab33aull },
+    { 0xb616a12b7fe617aaull, 0x577b986b314d6009ull }, { 0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80bull },
+    { 0x8e41ade9fbebc27dull, 0x14588f13be847307ull }, { 0xb1d219647ae6b31cull, 0x596eb2d8ae258fc8ull },
+    { 0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bbull }, { 0x8aec23d680043beeull, 0x25de7bb9480d5854ull },
+    { 0xada72ccc20054ae9ull, 0xaf561aa79a10ae6aull }, { 0xd910f7ff28069da4ull, 0x1b2ba1518094da04ull },
+    { 0x87aa9aff79042286ull, 0x90fb44d2f05d0842ull }, { 0xa99541bf57452b28ull, 0x353a1607ac744a53ull },
+    { 0xd3fa922f2d1675f2ull, 0x42889b8997915ce8ull }, { 0x847c9b5d7c2e09b7ull, 0x69956135febada11ull },
+    { 0xa59bc234db398c25ull, 0x43fab9837e699095ull }, { 0xcf02b2c21207ef2eull, 0x94f967e45e03f4bbull },
+    { 0x8161afb94b44f57dull, 0x1d1be0eebac278f5ull }, { 0xa1ba1ba79e1632dcull, 0x6462d92a69731732ull },
+    { 0xca28a291859bbf93ull, 0x7d7b8f7503cfdcfeull }, { 0xfcb2cb35e702af78ull, 0x5cda735244c3d43eull },
+    { 0x9defbf01b061adabull, 0x3a0888136afa64a7ull }, { 0xc56baec21c7a1916ull, 0x088aaa1845b8fdd0ull },
+    { 0xf6c69a72a3989f5bull, 0x8aad549e57273d45ull }, { 0x9a3c2087a63f6399ull, 0x36ac54e2f678864bull },
+    { 0xc0cb28a98fcf3c7full, 0x84576a1bb416a7ddull }, { 0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d5ull },
+    { 0x969eb7c47859e743ull, 0x9f644ae5a4b1b325ull }, { 0xbc4665b596706114ull, 0x873d5d9f0dde1feeull },
+    { 0xeb57ff22fc0c7959ull, 0xa90cb506d155a7eaull }, { 0x9316ff75dd87cbd8ull, 0x09a7f12442d588f2ull },
+    { 0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb2full }, { 0xe5d3ef282a242e81ull, 0x8f1668c8a86da5faull },
+    { 0x8fa475791a569d10ull, 0xf96e017d694487bcull }, { 0xb38d92d760ec4455ull, 0x37c981dcc395a9acull },
+    { 0xe070f78d3927556aull, 0x85bbe253f47b1417ull }, { 0x8c469ab843b89562ull, 0x93956d7478ccec8eull },
+    { 0xaf58416654a6babbull, 0x387ac8d1970027b2ull }, { 0xdb2e51bfe9d0696aull, 0x06997b05fcc0319eull },
+    { 0x88fcf317f22241e2ull, 0x441fece3bdf81f03ull }, { 0xab3c2fddeeaad25aull, 0xd527e81cad7626c3ull },
+    { 0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b074ull }, { 0x85c7056562757456ull, 0xf6872d5667844e49ull },
+    { 0xa738c6bebb12d16cull, 0xb428f8ac016561dbull }, { 0xd106f86e69d785c7ull, 0xe13336d701beba52ull },
+    { 0x82a45b450226b39cull, 0xecc0024661173473ull }, { 0xa34d721642b06084ull, 0x27f002d7f95d0190ull },
+    { 0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f4ull }, { 0xff290242c83396ceull, 0x7e67047175a15271ull },
+    { 0x9f79a169bd203e41ull, 0x0f0062c6e984d386ull }, { 0xc75809c42c684dd1ull, 0x52c07b78a3e60868ull },
+    { 0xf92e0c3537826145ull, 0xa7709a56ccdf8a82ull }, { 0x9bbcc7a142b17ccbull, 0x88a66076400bb691ull },
+    { 0xc2abf989935ddbfeull, 0x6acff893d00ea435ull }, { 0xf356f7ebf83552feull, 0x0583f6b8c4124d43ull },
+    { 0x98165af37b2153deull, 0xc3727a337a8b704aull }, { 0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5cull },
+    { 0xeda2ee1c7064130cull, 0x1162def06f79df73ull }, { 0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba8ull },
+    { 0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173692ull }, { 0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0437ull },
+    { 0x910ab1d4db9914a0ull, 0x1d9c9892400a22a2ull }, { 0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4bull },
+    { 0xe2a0b5dc971f303aull, 0x2e44ae64840fd61dull }, { 0x8da471a9de737e24ull, 0x5ceaecfed289e5d2ull },
+    { 0xb10d8e1456105dadull, 0x7425a83e872c5f47ull }, { 0xdd50f1996b947518ull, 0xd12f124e28f77719ull },
+    { 0x8a5296ffe33cc92full, 0x82bd6b70d99aaa6full }, { 0xace73cbfdc0bfb7bull, 0x636cc64d1001550bull },
+    { 0xd8210befd30efa5aull, 0x3c47f7e05401aa4eull }, { 0x8714a775e3e95c78ull, 0x65acfaec34810a71ull },
+    { 0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0dull }, { 0xd31045a8341ca07cull, 0x1ede48111209a050ull },
+    { 0x83ea2b892091e44dull, 0x934aed0aab460432ull }, { 0xa4e4b66b68b65d60ull, 0xf81da84d5617853full },
+    { 0xce1de40642e3f4b9ull, 0x36251260ab9d668eull }, { 0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b426019ull },
+    { 0xa1075a24e4421730ull, 0xb24cf65b8612f81full }, { 0xc94930ae1d529cfcull, 0xdee033f26797b627ull },
+    { 0xfb9b7cd9a4a7443cull, 0x169840ef017da3b1ull }, { 0x9d412e0806e88aa5ull, 0x8e1f289560ee864eull },
+    { 0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e2ull }, { 0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dbull },
+    { 0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef29ull }, { 0xbff610b0cc6edd3full, 0x17fd090a58d32af3ull },
+    { 0xeff394dcff8a948eull, 0xddfc4b4cef07f5b0ull }, { 0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98eull },
+    { 0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f1ull }, { 0xea53df5fd18d5513ull, 0x84c86189216dc5edull },
+    { 0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb4ull }, { 0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a1ull },
+    { 0xe4d5e82392a40515ull, 0x0fabaf3feaa5334aull }, { 0x8f05b1163ba6832dull, 0x29cb4d87f2a7400eull },
+    { 0xb2c71d5bca9023f8ull, 0x743e20e9ef511012ull }, { 0xdf78e4b2bd342cf6ull, 0x914da9246b255416ull },
+    { 0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548eull }, { 0xae9672aba3d0c320ull, 0xa184ac2473b529b1ull },
+    { 0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741eull }, { 0x8865899617fb1871ull, 0x7e2fa67c7a658892ull },
+    { 0xaa7eebfb9df9de8dull, 0xddbb901b98feeab7ull }, { 0xd51ea6fa85785631ull, 0x552a74227f3ea565ull },
+    { 0x8533285c936b35deull, 0xd53a88958f87275full }, { 0xa67ff273b8460356ull, 0x8a892abaf368f137ull },
+    { 0xd01fef10a657842cull, 0x2d2b7569b0432d85ull }, { 0x8213f56a67f6b29bull, 0x9c3b29620e29fc73ull },
+    { 0xa298f2c501f45f42ull, 0x8349f3ba91b47b8full }, { 0xcb3f2f7642717713ull, 0x241c70a936219a73ull },
+    { 0xfe0efb53d30dd4d7ull, 0xed238cd383aa0110ull }, { 0x9ec95d1463e8a506ull, 0xf4363804324a40aaull },
+    { 0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d5ull }, { 0xf81aa16fdc1b81daull, 0xdd94b7868e94050aull },
+    { 0x9b10a4e5e9913128ull, 0xca7cf2b4191c8326ull }, { 0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f0ull },
+    { 0xf24a01a73cf2dccfull, 0xbc633b39673c8cecull }, { 0x976e41088617ca01ull, 0xd5be0503e085d813ull },
+    { 0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e18ull }, { 0xec9c459d51852ba2ull, 0xddf8e7d60ed1219eull },
+    { 0x93e1ab8252f33b45ull, 0xcabb90e5c942b503ull }, { 0xb8da1662e7b00a17ull, 0x3d6a751f3b936243ull },
+    { 0xe7109bfba19c0c9dull, 0x0cc512670a783ad4ull }, { 0x906a617d450187e2ull, 0x27fb2b80668b24c5ull },
+    { 0xb484f9dc9641e9daull, 0xb1f9f660802dedf6ull }, { 0xe1a63853bbd26451ull, 0x5e7873f8a0396973ull },
+    { 0x8d07e33455637eb2ull, 0xdb0b487b6423e1e8ull }, { 0xb049dc016abc5e5full, 0x91ce1a9a3d2cda62ull },
+    { 0xdc5c5301c56b75f7ull, 0x7641a140cc7810fbull }, { 0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9dull },
+    { 0xac2820d9623bf429ull, 0x546345fa9fbdcd44ull }, { 0xd732290fbacaf133ull, 0xa97c177947ad4095ull },
+    { 0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485dull }, { 0xa81f301449ee8c70ull, 0x5c68f256bfff5a74ull },
+    { 0xd226fc195c6a2f8cull, 0x73832eec6fff3111ull }, { 0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eabull },
+    { 0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e55ull }, { 0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ebull },
+    { 0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b3ull }, { 0xa0555e361951c366ull, 0xd7e105bcc332621full },
+    { 0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa7ull }, { 0xfa856334878fc150ull, 0xb14f98f6f0feb951ull },
+    { 0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d3ull }, { 0xc3b8358109e84f07ull, 0x0a862f80ec4700c8ull },
+    { 0xf4a642e14c6262c8ull, 0xcd27bb612758c0faull }, { 0x98e7e9cccfbd7dbdull, 0x8038d51cb897789cull },
+    { 0xbf21e44003acdd2cull, 0xe0470a63e6bd56c3ull }, { 0xeeea5d5004981478ull, 0x1858ccfce06cac74ull },
+    { 0x95527a5202df0ccbull, 0x0f37801e0c43ebc8ull }, { 0xbaa718e68396cffdull, 0xd30560258f54e6baull },
+    { 0xe950df20247c83fdull, 0x47c6b82ef32a2069ull }, { 0x91d28b7416cdd27eull, 0x4cdc331d57fa5441ull },
+    { 0xb6472e511c81471dull, 0xe0133fe4adf8e952ull }, { 0xe3d8f9e563a198e5ull, 0x58180fddd97723a6ull },
+    { 0x8e679c2f5e44ff8full, 0x570f09eaa7ea7648ull }, { 0xb201833b35d63f73ull, 0x2cd2cc6551e513daull },
+    { 0xde81e40a034bcf4full, 0xf8077f7ea65e58d1ull }, { 0x8b112e86420f6191ull, 0xfb04afaf27faf782ull },
+    { 0xadd57a27d29339f6ull, 0x79c5db9af1f9b563ull }, { 0xd94ad8b1c7380874ull, 0x18375281ae7822bcull },
+    { 0x87cec76f1c830548ull, 0x8f2293910d0b15b5ull }, { 0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb22ull },
+    { 0xd433179d9c8cb841ull, 0x5fa60692a46151ebull }, { 0x849feec281d7f328ull, 0xdbc7c41ba6bcd333ull },
+    { 0xa5c7ea73224deff3ull, 0x12b9b522906c0800ull }, { 0xcf39e50feae16befull, 0xd768226b34870a00ull },
+    { 0x81842f29f2cce375ull, 0xe6a1158300d46640ull }, { 0xa1e53af46f801c53ull, 0x60495ae3c1097fd0ull },
+    { 0xca5e89b18b602368ull, 0x385bb19cb14bdfc4ull }, { 0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b5ull },
+    { 0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d1ull }, { 0xc5a05277621be293ull, 0xc7098b7305241885ull },
+    { 0xf70867153aa2db38ull, 0xb8cbee4fc66d1ea7ull }, { 0x9a65406d44a5c903ull, 0x737f74f1dc043328ull },
+    { 0xc0fe908895cf3b44ull, 0x505f522e53053ff2ull }, { 0xf13e34aabb430a15ull, 0x647726b9e7c68fefull },
+    { 0x96c6e0eab509e64dull, 0x5eca783430dc19f5ull }, { 0xbc789925624c5fe0ull, 0xb67d16413d132072ull },
+    { 0xeb96bf6ebadf77d8ull, 0xe41c5bd18c57e88full }, { 0x933e37a534cbaae7ull, 0x8e91b962f7b6f159ull },
+    { 0xb80dc58e81fe95a1ull, 0x723627bbb5a4adb0ull }, { 0xe61136f2227e3b09ull, 0xcec3b1aaa30dd91cull },
+    { 0x8fcac257558ee4e6ull, 0x213a4f0aa5e8a7b1ull }, { 0xb3bd72ed2af29e1full, 0xa988e2cd4f62d19dull },
+    { 0xe0accfa875af45a7ull, 0x93eb1b80a33b8605ull }, { 0x8c6c01c9498d8b88ull, 0xbc72f130660533c3ull },
+    { 0xaf87023b9bf0ee6aull, 0xeb8fad7c7f8680b4ull }, { 0xdb68c2ca82ed2a05ull, 0xa67398db9f6820e1ull },
+    { 0x892179be91d43a43ull, 0x88083f8943a1148cull }, { 0xab69d82e364948d4ull, 0x6a0a4f6b948959b0ull },
+    { 0xd6444e39c3db9b09ull, 0x848ce34679abb01cull }, { 0x85eab0e41a6940e5ull, 0xf2d80e0c0c0b4e11ull },
+    { 0xa7655d1d2103911full, 0x6f8e118f0f0e2195ull }, { 0xd13eb46469447567ull, 0x4b7195f2d2d1a9fbull },
+};
+
+typedef struct rf__float_format
+{
+    int mantissa_bits;
+    int exponent_bits;
+    int bias;
+} rf__float_format;
+
+rf_internal const rf__float_format rf__f64_format = { 52, 11, 1023 };
+rf_internal const rf__float_format rf__f32_format = { 23, 8, 127 };
+
+// Full 64x64 bit multiplication, returns the low half of the product
+rf_internal uint64_t rf__mul_u64(uint64_t a, uint64_t b, uint64_t* high)
+{
+    #if defined(__SIZEOF_INT128__)
+        unsigned __int128 product = (unsigned __int128) a * b;
+        *high = (uint64_t) (product >> 64);
+        return (uint64_t) product;
+    #elif defined(rayfork_msvc) && defined(_M_X64)
+        return _umul128(a, b, high);
+    #else
+        uint64_t a_low = (uint32_t) a, a_high = a >> 32;
+        uint64_t b_low = (uint32_t) b, b_high = b >> 32;
+        uint64_t low_low = a_low * b_low;
+        uint64_t cross = (low_low >> 32) + (uint32_t) (a_high * b_low) + a_low * b_high;
+        *high = a_high * b_high + ((a_high * b_low) >> 32) + (cross >> 32);
+        return (cross << 32) | (uint32_t) low_low;
+    #endif
+}
+
+rf_internal uint64_t rf__load_u64_le(const char* src)
+{
+    uint64_t result;
+    memcpy(&result, src, sizeof(result));
+
+    #if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        result = __builtin_bswap64(result);
+    #endif
+
+    return result;
+}
+
+rf_internal rf_bool rf__is_eight_digits(uint64_t chars)
+{
+    rf_bool result = (((chars + 0x4646464646464646ull) | (chars - 0x3030303030303030ull)) & 0x8080808080808080ull) == 0;
+    return result;
+}
+
+// Combines the digits pairwise, then in groups of four and then eight, with the most significant digit in the lowest byte
+rf_internal uint32_t rf__parse_eight_digits(uint64_t chars)
+{
+    const uint64_t mask = 0x000000ff000000ffull;
+    const uint64_t mul1 = 100 + (1000000ull << 32);
+    const uint64_t mul2 = 1 + (10000ull << 32);
+
+    chars -= 0x3030303030303030ull;
+    chars = (chars * 10) + (chars >> 8);
+    chars = (((chars & mask) * mul1) + (((chars >> 16) & mask) * mul2)) >> 32;
+
+    return (uint32_t) chars;
+}
+
+// Accumulates the digits at the start of [src, end) into value, wrapping around on overflow, returns the end of the digits
+rf_internal const char* rf__parse_digits(const char* src, const char* end, uint64_t* value)
+{
+    uint64_t result = *value;
+
+    while (end - src >= 8 && rf__is_eight_digits(rf__load_u64_le(src)))
+    {
+        result = result * 100000000 + rf__parse_eight_digits(rf__load_u64_le(src));
+        src += 8;
+    }
+
+    while (src != end && rf_is_digit(*src))
+    {
+        result = result * 10 + (*src - '0');
+        src++;
+    }
+
+    *value = result;
+    return src;
+}
+
+typedef struct rf__parsed_number
+{
+    uint64_t    mantissa;          // The first 19 significant digits
+    int64_t     exponent;          // The value is mantissa * 10^exponent, or a bit more than that if truncated
+    int64_t     explicit_exponent; // The part after the e
+    rf_bool     negative;
+    rf_bool     truncated;         // Nonzero digits after the first 19 significant ones were left out of the mantissa
+    const char* integer_begin;
+    const char* integer_end;
+    const char* fraction_begin;
+    const char* fraction_end;
+    rf_int      size;              // Bytes consumed, 0 if there is no number
+} rf__parsed_number;
+
+// Parses [+-]digits[.digits][(e|E)[+-]digits] where either the integer or the fraction digits can be left out
+rf_internal rf__parsed_number rf__parse_number(const char* src, const char* end)
+{
+    rf__parsed_number result = {0};
+    const char* begin = src;
+
+    if (src != end && (*src == '-' || *src == '+'))
+    {
+        result.negative = *src == '-';
+        src++;
+    }
+
+    uint64_t mantissa = 0;
+    result.integer_begin = src;
+    src = rf__parse_digits(src, end, &mantissa);
+    result.integer_end = src;
+    result.fraction_begin = src;
+    result.fraction_end = src;
+
+    int64_t digit_count = result.integer_end - result.integer_begin;
+    int64_t exponent = 0;
+
+    if (src != end && *src == '.')
+    {
+        src++;
+        result.fraction_begin = src;
+        src = rf__parse_digits(src, end, &mantissa);
+        result.fraction_end = src;
+
+        exponent = result.fraction_begin - result.fraction_end;
+        digit_count -= exponent;
+    }
+
+    if (digit_count == 0) return result;
+
+    if (src != end && (*src == 'e' || *src == 'E'))
+    {
+        const char* exponent_src = src + 1;
+        rf_bool negative_exponent = 0;
+
+        if (exponent_src != end && (*exponent_src == '-' || *exponent_src == '+'))
+        {
+            negative_exponent = *exponent_src == '-';
+            exponent_src++;
+        }
+
+        // An e without digits after it isn't part of the number
+        if (exponent_src != end && rf_is_digit(*exponent_src))
+        {
+            int64_t explicit_exponent = 0;
+
+            while (exponent_src != end && rf_is_digit(*exponent_src))
+            {
+                // Saturate, anything this big is way out of range anyway
+                if (explicit_exponent < 0x100000000ll) explicit_exponent = explicit_exponent * 10 + (*exponent_src - '0');
+                exponent_src++;
+            }
+
+            result.explicit_exponent = negative_exponent ? -explicit_exponent : explicit_exponent;
+            exponent += result.explicit_exponent;
+            src = exponent_src;
+        }
+    }
+
+    if (digit_count > RF__MAX_MANTISSA_DIGITS)
+    {
+        // Leading zeros are not significant
+        const char* iter = result.integer_begin;
+        while (iter != result.fraction_end && (*iter == '0' || *iter == '.'))
+        {
+            if (*iter == '0') digit_count--;
+            iter++;
+        }
+
+        if (digit_count > RF__MAX_MANTISSA_DIGITS)
+        {
+            const uint64_t min_19_digit_mantissa = 1000000000000000000ull;
+
+            result.truncated = 1;
+            mantissa = 0;
+
+            iter = result.integer_begin;
+            while (mantissa < min_19_digit_mantissa && iter != result.integer_end)
+            {
+                mantissa = mantissa * 10 + (*iter - '0');
+                iter++;
+            }
+
+            if (mantissa >= min_19_digit_mantissa)
+            {
+                exponent = result.integer_end - iter;
+            }
+            else
+            {
+                iter = result.fraction_begin;
+                while (mantissa < min_19_digit_mantissa && iter != result.fraction_end)
+                {
+                    mantissa = mantissa * 10 + (*iter - '0');
+                    iter++;
+                }
+
+                exponent = result.fraction_begin - iter;
+            }
+
+            exponent += result.explicit_exponent;
+        }
+    }
+
+    result.mantissa = mantissa;
+    result.exponent = exponent;
+    result.size = src - begin;
+
+    return result;
+}
+
+// Compares the start of [src, end) with a lower case literal ignoring case
+rf_internal rf_bool rf__match_lower(const char* src, const char* end, const char* lower)
+{
+    rf_int size = (rf_int) strlen(lower);
+    if (end - src < size) return 0;
+
+    for (rf_int i = 0; i < size; i++)
+    {
+        if (rf_to_lower(src[i]) != lower[i]) return 0;
+    }
+
+    return 1;
+}
+
+// Matches [+-](inf|infinity|nan) ignoring case, returns the size of the match or 0
+rf_internal rf_int rf__parse_special_float(const char* src, const char* end, rf_bool* negative, rf_bool* nan)
+{
+    const char* begin = src;
+
+    *negative = 0;
+    *nan = 0;
+    if (src != end && (*src == '-' || *src == '+'))
+    {
+        *negative = *src == '-';
+        src++;
+    }
+
+    if (rf__match_lower(src, end, "infinity")) return src + 8 - begin;
+    if (rf__match_lower(src, end, "inf")) return src + 3 - begin;
+
+    if (rf__match_lower(src, end, "nan"))
+    {
+        *nan = 1;
+        return src + 3 - begin;
+    }
+
+    return 0;
+}
+
+// Returns the bits of the correctly rounded float closest to mantissa * 10^exponent, or false if that can't be decided cheaply
+rf_internal rf_bool rf__eisel_lemire(uint64_t mantissa, int64_t exponent, rf__float_format format, uint64_t* bits)
+{
+    if (mantissa == 0)
+    {
+        *bits = 0;
+        return 1;
+    }
+
+    if (exponent < RF__POW10_MIN_EXPONENT || exponent > RF__POW10_MAX_EXPONENT) return 0;
+
+    // We keep 3 more bits than the float mantissa, one for the implicit bit, one to find the top bit and one to round
+    const int shift = 64 - format.mantissa_bits - 3;
+    const uint64_t low_bits = (1ull << shift) - 1;
+    const uint64_t* pow10 = rf__pow10_significands[exponent - RF__POW10_MIN_EXPONENT];
+
+    int leading_zeros = rf__count_leading_zeros_u64(mantissa);
+    mantissa <<= leading_zeros;
+
+    // 217706 / 2^16 is log2(10)
+    uint64_t result_exponent = (uint64_t) (((217706 * exponent) >> 16) + 64 + format.bias) - leading_zeros;
+
+    uint64_t high;
+    uint64_t low = rf__mul_u64(mantissa, pow10[0], &high);
+
+    // If the bits we'd drop are all ones the truncated low half of the power might change the result, so look at it too
+    if ((high & low_bits) == low_bits && low + mantissa < mantissa)
+    {
+        uint64_t extra_high;
+        uint64_t extra_low = rf__mul_u64(mantissa, pow10[1], &extra_high);
+        uint64_t merged_high = high;
+        uint64_t merged_low = low + extra_high;
+        if (merged_low < low) merged_high++;
+
+        if ((merged_high & low_bits) == low_bits && merged_low + 1 == 0 && extra_low + mantissa < mantissa) return 0;
+
+        high = merged_high;
+        low = merged_low;
+    }
+
+    uint64_t top_bit = high >> 63;
+    uint64_t result_mantissa = high >> (top_bit + shift);
+    result_exponent -= 1 ^ top_bit;
+
+    // Exactly halfway between two floats as far as we can tell, let the slow path break the tie
+    if (low == 0 && (high & low_bits) == 0 && (result_mantissa & 3) == 1) return 0;
+
+    result_mantissa += result_mantissa & 1;
+    result_mantissa >>= 1;
+    if (result_mantissa >> (format.mantissa_bits + 1))
+    {
+        result_mantissa >>= 1;
+        result_exponent++;
+    }
+
+    // Subnormals, infinities and underflow to zero are left to the slow path
+    if (result_exponent - 1 >= (1ull << format.exponent_bits) - 2) return 0;
+
+    *bits = (result_exponent << format.mantissa_bits) | (result_mantissa & ((1ull << format.mantissa_bits) - 1));
+    return 1;
+}
+
+typedef struct rf__decimal
+{
+    uint8_t digits[RF__DECIMAL_MAX_DIGITS]; // Most significant first, without leading or trailing zeros
+    rf_int  count;
+    int64_t point;                          // The value is 0.digits * 10^point
+    rf_bool truncated;                      // Nonzero digits were dropped after the last one stored
+} rf__decimal;
+
+// For a left shift by k, how many digits it adds and the digits of 5^k, it adds one less when the number is smaller than those
+typedef struct rf__decimal_left_shift_info
+{
+    int         new_digits;
+    const char* cutoff;
+} rf__decimal_left_shift_info;
+
+rf_internal const rf__decimal_left_shift_info rf__decimal_left_shifts[] =
+{
+    { 0, "" },
+    { 1, "5" },
+    { 1, "25" },
+    { 1, "125" },
+    { 2, "625" },
+    { 2, "3125" },
+    { 2, "15625" },
+    { 3, "78125" },
+    { 3, "390625" },
+    { 3, "1953125" },
+    { 4, "9765625" },
+    { 4, "48828125" },
+    { 4, "244140625" },
+    { 4, "1220703125" },
+    { 5, "6103515625" },
+    { 5, "30517578125" },
+    { 5, "152587890625" },
+    { 6, "762939453125" },
+    { 6, "3814697265625" },
+    { 6, "19073486328125" },
+    { 7, "95367431640625" },
+    { 7, "476837158203125" },
+    { 7, "2384185791015625" },
+    { 7, "11920928955078125" },
+    { 8, "59604644775390625" },
+    { 8, "298023223876953125" },
+    { 8, "1490116119384765625" },
+    { 9, "7450580596923828125" },
+    { 9, "37252902984619140625" },
+    { 9, "186264514923095703125" },
+    { 10, "931322574615478515625" },
+    { 10, "4656612873077392578125" },
+    { 10, "23283064365386962890625" },
+    { 10, "116415321826934814453125" },
+    { 11, "582076609134674072265625" },
+    { 11, "2910383045673370361328125" },
+    { 11, "14551915228366851806640625" },
+    { 12, "72759576141834259033203125" },
+    { 12, "363797880709171295166015625" },
+    { 12, "1818989403545856475830078125" },
+    { 13, "9094947017729282379150390625" },
+    { 13, "45474735088646411895751953125" },
+    { 13, "227373675443232059478759765625" },
+    { 13, "1136868377216160297393798828125" },
+    { 14, "5684341886080801486968994140625" },
+    { 14, "28421709430404007434844970703125" },
+    { 14, "142108547152020037174224853515625" },
+    { 15, "710542735760100185871124267578125" },
+    { 15, "3552713678800500929355621337890625" },
+    { 15, "17763568394002504646778106689453125" },
+    { 16, "88817841970012523233890533447265625" },
+    { 16, "444089209850062616169452667236328125" },
+    { 16, "2220446049250313080847263336181640625" },
+    { 16, "11102230246251565404236316680908203125" },
+    { 17, "55511151231257827021181583404541015625" },
+    { 17, "277555756156289135105907917022705078125" },
+    { 17, "1387778780781445675529539585113525390625" },
+    { 18, "6938893903907228377647697925567626953125" },
+    { 18, "34694469519536141888238489627838134765625" },
+    { 18, "173472347597680709441192448139190673828125" },
+    { 19, "867361737988403547205962240695953369140625" },
+};
+
+rf_internal void rf__decimal_trim(rf__decimal* decimal)
+{
+    while (decimal->count > 0 && decimal->digits[decimal->count - 1] == 0) decimal->count--;
+    if (decimal->count == 0) decimal->point = 0;
+}
+
+rf_internal void rf__decimal_push_digit(rf__decimal* decimal, char c)
+{
+    if (decimal->count < RF__DECIMAL_MAX_DIGITS) decimal->digits[decimal->count++] = (uint8_t) (c - '0');
+    else if (c != '0') decimal->truncated = 1;
+}
+
+rf_internal void rf__decimal_from_number(rf__decimal* decimal, const rf__parsed_number* number)
+{
+    decimal->count = 0;
+    decimal->truncated = 0;
+
+    const char* iter = number->integer_begin;
+    while (iter != number->integer_end && *iter == '0') iter++;
+
+    decimal->point = number->integer_end - iter;
+    for (; iter != number->integer_end; iter++) rf__decimal_push_digit(decimal, *iter);
+
+    iter = number->fraction_begin;
+    if (decimal->count == 0)
+    {
+        while (iter != number->fraction_end && *iter == '0')
+        {
+            decimal->point--;
+            iter++;
+        }
+    }
+    for (; iter != number->fraction_end; iter++) rf__decimal_push_digit(decimal, *iter);
+
+    decimal->point += number->explicit_exponent;
+    rf__decimal_trim(decimal);
+}
+
+// Divides by 2^k, k must be at most 60 so that n * 10 fits in 64 bits
+rf_internal void rf__decimal_right_shift(rf__decimal* decimal, int k)
+{
+    rf_int read = 0;
+    rf_int write = 0;
+    uint64_t n = 0;
+
+    // Read until the first digit of the result
+    for (; (n >> k) == 0; read++)
+    {
+        if (read >= decimal->count)
+        {
+            if (n == 0)
+            {
+                decimal->count = 0;
+                return;
+            }
+
+            while ((n >> k) == 0)
+            {
+                n *= 10;
+                read++;
+            }
+            break;
+        }
+
+        n = n * 10 + decimal->digits[read];
+    }
+
+    decimal->point -= read - 1;
+
+    uint64_t mask = (1ull << k) - 1;
+
+    for (; read < decimal->count; read++)
+    {
+        uint64_t digit = n >> k;
+        n &= mask;
+        decimal->digits[write++] = (uint8_t) digit;
+        n = n * 10 + decimal->digits[read];
+    }
+
+    while (n > 0)
+    {
+        uint64_t digit = n >> k;
+        n &= mask;
+
+        if (write < RF__DECIMAL_MAX_DIGITS) decimal->digits[write++] = (uint8_t) digit;
+        else if (digit > 0) decimal->truncated = 1;
+
+        n *= 10;
+    }
+
+    decimal->count = write;
+    rf__decimal_trim(decimal);
+}
+
+// Multiplies by 2^k, k must be at most 60
+rf_internal void rf__decimal_left_shift(rf__decimal* decimal, int k)
+{
+    const char* cutoff = rf__decimal_left_shifts[k].cutoff;
+    rf_int new_digits = rf__decimal_left_shifts[k].new_digits;
+
+    for (rf_int i = 0; cutoff[i]; i++)
+    {
+        if (i >= decimal->count || decimal->digits[i] != cutoff[i] - '0')
+        {
+            if (i >= decimal->count || decimal->digits[i] < cutoff[i] - '0') new_digits--;
+            break;
+        }
+    }
+
+    rf_int read = decimal->count;
+    rf_int write = decimal->count + new_digits;
+    uint64_t n = 0;
+
+    for (read--; read >= 0; read--)
+    {
+        n += (uint64_t) decimal->digits[read] << k;
+        uint64_t quotient = n / 10;
+        uint64_t remainder = n - 10 * quotient;
+
+        write--;
+        if (write < RF__DECIMAL_MAX_DIGITS) decimal->digits[write] = (uint8_t) remainder;
+        else if (remainder != 0) decimal->truncated = 1;
+
+        n = quotient;
+    }
+
+    while (n > 0)
+    {
+        uint64_t quotient = n / 10;
+        uint64_t remainder = n - 10 * quotient;
+
+        write--;
+        if (write < RF__DECIMAL_MAX_DIGITS) decimal->digits[write] = (uint8_t) remainder;
+        else if (remainder != 0) decimal->truncated = 1;
+
+        n = quotient;
+    }
+
+    decimal->count += new_digits;
+    if (decimal->count > RF__DECIMAL_MAX_DIGITS) decimal->count = RF__DECIMAL_MAX_DIGITS;
+    decimal->point += new_digits;
+    rf__decimal_trim(decimal);
+}
+
+rf_internal void rf__decimal_shift(rf__decimal* decimal, int k)
+{
+    const int max_shift = 60;
+
+    if (decimal->count == 0) return;
+
+    if (k > 0)
+    {
+        for (; k > max_shift; k -= max_shift) rf__decimal_left_shift(decimal, max_shift);
+        rf__decimal_left_shift(decimal, k);
+    }
+    else if (k < 0)
+    {
+        for (; k < -max_shift; k += max_shift) rf__decimal_right_shift(decimal, max_shift);
+        rf__decimal_right_shift(decimal, -k);
+    }
+}
+
+// The integer part rounded half to even, saturates at 2^64 - 1
+rf_internal uint64_t rf__decimal_rounded_integer(const rf__decimal* decimal)
+{
+    if (decimal->point > 20) return UINT64_MAX;
+
+    uint64_t result = 0;
+    rf_int i = 0;
+
+    for (; i < decimal->point && i < decimal->count; i++) result = result * 10 + decimal->digits[i];
+    for (; i < decimal->point; i++) result *= 10;
+
+    rf_int next = decimal->point;
+    if (next >= 0 && next < decimal->count)
+    {
+        rf_bool round_up = decimal->digits[next] >= 5;
+
+        // Exactly halfway
+        if (decimal->digits[next] == 5 && next + 1 == decimal->count && !decimal->truncated)
+        {
+            round_up = next > 0 && (decimal->digits[next - 1] & 1);
+        }
+
+        result += round_up;
+    }
+
+    return result;
+}
+
+// Exact conversion, scales the decimal by powers of two until it is in [1/2, 1) and then reads the mantissa bits out of it
+rf_internal uint64_t rf__decimal_to_float_bits(rf__decimal* decimal, rf__float_format format)
+{
+    // Powers of two that keep the shifted number below 10 for a decimal point at 0...8
+    static const int shifts[] = { 1, 3, 6, 9, 13, 16, 19, 23, 26 };
+    const int max_shift = 27;
+    const int64_t max_biased_exponent = (1ll << format.exponent_bits) - 1;
+    const int64_t min_exponent = 1 - format.bias;
+    const uint64_t infinity = (uint64_t) max_biased_exponent << format.mantissa_bits;
+
+    if (decimal->count == 0 || decimal->point < -330) return 0;
+    if (decimal->point > 310) return infinity;
+
+    int64_t exponent = 0;
+
+    while (decimal->point > 0)
+    {
+        int n = decimal->point >= 9 ? max_shift : shifts[decimal->point];
+        rf__decimal_shift(decimal, -n);
+        exponent += n;
+    }
+
+    while (decimal->point < 0 || (decimal->point == 0 && decimal->digits[0] < 5))
+    {
+        int n = -decimal->point >= 9 ? max_shift : shifts[-decimal->point];
+        rf__decimal_shift(decimal, n);
+        exponent -= n;
+    }
+
+    // The decimal is in [1/2, 1) but floats are in [1, 2)
+    exponent--;
+
+    if (exponent < min_exponent)
+    {
+        rf__decimal_shift(decimal, (int) (exponent - min_exponent));
+        exponent = min_exponent;
+    }
+
+    if (exponent + format.bias >= max_biased_exponent) return infinity;
+
+    rf__decimal_shift(decimal, 1 + format.mantissa_bits);
+    uint64_t mantissa = rf__decimal_rounded_integer(decimal);
+
+    // Rounding carried into a new bit
+    if (mantissa == (2ull << format.mantissa_bits))
+    {
+        mantissa >>= 1;
+        exponent++;
+        if (exponent + format.bias >= max_biased_exponent) return infinity;
+    }
+
+    // Subnormal
+    if (!(mantissa & (1ull << format.mantissa_bits))) exponent = -format.bias;
+
+    uint64_t result = (mantissa & ((1ull << format.mantissa_bits) - 1)) | ((uint64_t) (exponent + format.bias) << format.mantissa_bits);
+    return result;
+}
+
+// Bits of the correctly rounded float without the sign
+rf_internal uint64_t rf__number_to_float_bits(const rf__parsed_number* number, rf__float_format format)
+{
+    uint64_t result;
+
+    if (rf__eisel_lemire(number->mantissa, number->exponent, format, &result))
+    {
+        // The digits left out are between mantissa and mantissa + 1, if both round to the same float so does the real number
+        if (!number->truncated) return result;
+
+        uint64_t upper;
+        if (rf__eisel_lemire(number->mantissa + 1, number->exponent, format, &upper) && upper == result) return result;
+    }
+
+    rf__decimal decimal;
+    rf__decimal_from_number(&decimal, number);
+    result = rf__decimal_to_float_bits(&decimal, format);
+
+    return result;
+}
+
+rf_internal rf_int rf__parse_double(const char* src, const char* end, double* dst)
+{
+    // Powers of ten that are exact as doubles
+    static const double exact_pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    rf__parsed_number number = rf__parse_number(src, end);
+
+    if (!number.size)
+    {
+        rf_bool negative, nan;
+        rf_int size = rf__parse_special_float(src, end, &negative, &nan);
+        if (size)
+        {
+            uint64_t bits = (nan ? 0x7ff8000000000000ull : 0x7ff0000000000000ull) | ((uint64_t) negative << 63);
+            memcpy(dst, &bits, sizeof(bits));
+        }
+        return size;
+    }
+
+    double value;
+
+    #if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!number.truncated && number.mantissa <= (1ull << 53) && number.exponent >= -22 && number.exponent <= 22)
+    {
+        // Both the mantissa and the power are exact so the single multiplication or division rounds correctly
+        value = (double) number.mantissa;
+        value = number.exponent < 0 ? value / exact_pow10[-number.exponent] : value * exact_pow10[number.exponent];
+    }
+    else
+    #endif
+    {
+        uint64_t bits = rf__number_to_float_bits(&number, rf__f64_format);
+        memcpy(&value, &bits, sizeof(value));
+    }
+
+    *dst = number.negative ? -value : value;
+    return number.size;
+}
+
+rf_internal rf_int rf__parse_float(const char* src, const char* end, float* dst)
+{
+    static const float exact_pow10[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+    rf__parsed_number number = rf__parse_number(src, end);
+
+    if (!number.size)
+    {
+        rf_bool negative, nan;
+        rf_int size = rf__parse_special_float(src, end, &negative, &nan);
+        if (size)
+        {
+            uint32_t bits = (nan ? 0x7fc00000u : 0x7f800000u) | ((uint32_t) negative << 31);
+            memcpy(dst, &bits, sizeof(bits));
+        }
+        return size;
+    }
+
+    float value;
+
+    #if !defined(FLT_EVAL_METHOD) || FLT_EVAL_METHOD == 0
+    if (!number.truncated && number.mantissa <= (1ull << 24) && number.exponent >= -10 && number.exponent <= 10)
+    {
+        value = (float) number.mantissa;
+        value = number.exponent < 0 ? value / exact_pow10[-number.exponent] : value * exact_pow10[number.exponent];
+    }
+    else
+    #endif
+    {
+        uint32_t bits = (uint32_t) rf__number_to_float_bits(&number, rf__f32_format);
+        memcpy(&value, &bits, sizeof(value));
+    }
+
+    *dst = number.negative ? -value : value;
+    return number.size;
+}
+
+rf_internal const char* rf__skip_spaces(const char* src, const char* end)
+{
+    while (src != end && rf_is_space(*src)) src++;
+    return src;
+}
+
+// Skips the spaces and the delimiter after a number, returns null if something else follows it
+rf_internal const char* rf__skip_delimiter(const char* src, const char* end, char delimiter)
+{
+    const char* after_number = src;
+    src = rf__skip_spaces(src, end);
+
+    if (src == end) return src;
+    if (*src == delimiter) return src + 1;
+
+    // A run of spaces counts as a single space delimiter
+    if (src != after_number && rf_is_space(delimiter)) return src;
+
+    return 0;
+}
+
+// Same as rf_str_parse_int, overflow is set when the value had to be saturated
+rf_internal rf_int rf__parse_int(rf_str src, rf_int* dst, rf_bool* overflow)
+{
+    *overflow = 0;
+
+    rf_str number = rf_str_eat_spaces(src);
+    if (!rf_str_valid(number)) return 0;
+
+    const char* begin = number.data;
+    const char* end = number.data + number.size;
+    const char* iter = begin;
+
+    rf_bool negative = 0;
+    if (*iter == '-' || *iter == '+')
+    {
+        negative = *iter == '-';
+        iter++;
+    }
+
+    const char* digits_begin = iter;
+    uint64_t value = 0;
+    const char* digits_end = rf__parse_digits(iter, end, &value);
+
+    if (digits_end == digits_begin) return 0;
+
+    // The value wrapped around if there were more than 19 significant digits, recount them before trusting it
+    const uint64_t max_value = negative ? (uint64_t) PTRDIFF_MAX + 1 : (uint64_t) PTRDIFF_MAX;
+    if (digits_end - digits_begin > RF__MAX_MANTISSA_DIGITS)
+    {
+        while (digits_begin != digits_end && *digits_begin == '0') digits_begin++;
+        if (digits_end - digits_begin > RF__MAX_MANTISSA_DIGITS)
+        {
+            value = max_value;
+            *overflow = 1;
+        }
+    }
+
+    if (value > max_value)
+    {
+        value = max_value;
+        *overflow = 1;
+    }
+
+    if (dst) *dst = negative ? (rf_int) (0 - value) : (rf_int) value;
+
+    rf_int result = (src.size - number.size) + (digits_end - begin);
+    return result;
+}
+
+rf_public rf_int rf_str_parse_int(rf_str src, rf_int* dst)
+{
+    rf_bool overflow;
+    rf_int result = rf__parse_int(src, dst, &overflow);
+    return result;
+}
+
+rf_public rf_int rf_str_parse_double(rf_str src, double* dst)
+{
+    rf_str number = rf_str_eat_spaces(src);
+    if (!rf_str_valid(number)) return 0;
+
+    double value;
+    rf_int result = rf__parse_double(number.data, number.data + number.size, &value);
+
+    if (result)
+    {
+        result += src.size - number.size;
+        if (dst) *dst = value;
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_str_parse_float(rf_str src, float* dst)
+{
+    rf_str number = rf_str_eat_spaces(src);
+    if (!rf_str_valid(number)) return 0;
+
+    float value;
+    rf_int result = rf__parse_float(number.data, number.data + number.size, &value);
+
+    if (result)
+    {
+        result += src.size - number.size;
+        if (dst) *dst = value;
+    }
+
+    return result;
+}
+
+rf_public double rf_str_to_double(rf_str src)
+{
+    double result = 0;
+    rf_str_parse_double(src, &result);
+    return result;
+}
+
+rf_public rf_int rf_str_parse_doubles(rf_str src, char delimiter, double* dst, rf_int dst_size)
+{
+    rf_int result = 0;
+    if (!rf_str_valid(src)) return result;
+
+    const char* iter = src.data;
+    const char* end = src.data + src.size;
+
+    while (iter && result < dst_size)
+    {
+        iter = rf__skip_spaces(iter, end);
+
+        rf_int size = rf__parse_double(iter, end, &dst[result]);
+        if (!size) break;
+
+        result++;
+        iter = rf__skip_delimiter(iter + size, end, delimiter);
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_str_parse_floats(rf_str src, char delimiter, float* dst, rf_int dst_size)
+{
+    rf_int result = 0;
+    if (!rf_str_valid(src)) return result;
+
+    const char* iter = src.data;
+    const char* end = src.data + src.size;
+
+    while (iter && result < dst_size)
+    {
+        iter = rf__skip_spaces(iter, end);
+
+        rf_int size = rf__parse_float(iter, end, &dst[result]);
+        if (!size) break;
+
+        result++;
+        iter = rf__skip_delimiter(iter + size, end, delimiter);
+    }
+
+    return result;
+}
+
+// Rounds g * cp / 2^128 (g * cp / 2^96 for floats) to odd, which is enough to get the rounding right afterwards
+rf_internal uint64_t rf__round_to_odd_u64(const uint64_t g[2], uint64_t cp)
+{
+    uint64_t x_high;
+    rf__mul_u64(g[1], cp, &x_high);
+
+    uint64_t y_high;
+    uint64_t y_low = rf__mul_u64(g[0], cp, &y_high);
+
+    uint64_t z = y_low + x_high;
+    uint64_t carry = z < y_low;
+
+    uint64_t result = (y_high + carry) | (z > 1);
+    return result;
+}
+
+rf_internal uint32_t rf__round_to_odd_u32(uint64_t g, uint32_t cp)
+{
+    uint64_t high;
+    uint64_t low = rf__mul_u64(g, cp, &high);
+
+    uint32_t result = (uint32_t) high | ((uint32_t) (low >> 32) > 1);
+    return result;
+}
+
+// floor(log10(2^e)) when closer_lower_bound is false, floor(log10(3/4 * 2^e)) when true
+rf_internal int rf__floor_log10_pow2(int e, rf_bool closer_lower_bound)
+{
+    int result = (e * 1262611 - (closer_lower_bound ? 524031 : 0)) >> 22;
+    return result;
+}
+
+rf_internal int rf__floor_log2_pow10(int e)
+{
+    int result = (e * 1741647) >> 19;
+    return result;
+}
+
+// Picks the shortest decimal in the rounding interval of the float with the given ieee fields, the closest one if there are several
+rf_internal uint64_t rf__shortest_decimal_f64(uint64_t ieee_mantissa, int ieee_exponent, int* exponent)
+{
+    const int exponent_bias = 1023 + 52;
+    uint64_t c;
+    int q;
+
+    if (ieee_exponent != 0)
+    {
+        c = (1ull << 52) | ieee_mantissa;
+        q = ieee_exponent - exponent_bias;
+
+        // Small integers
+        if (q <= 0 && -q < 53 && (c & ((1ull << -q) - 1)) == 0)
+        {
+            *exponent = 0;
+            return c >> -q;
+        }
+    }
+    else
+    {
+        c = ieee_mantissa;
+        q = 1 - exponent_bias;
+    }
+
+    rf_bool even = (c & 1) == 0;
+    rf_bool closer_lower_bound = ieee_mantissa == 0 && ieee_exponent > 1;
+
+    // The float and the bounds of its rounding interval, times 4
+    uint64_t cbl = 4 * c - 2 + closer_lower_bound;
+    uint64_t cb  = 4 * c;
+    uint64_t cbr = 4 * c + 2;
+
+    int k = rf__floor_log10_pow2(q, closer_lower_bound);
+    int h = q + rf__floor_log2_pow10(-k) + 1;
+
+    const uint64_t* table_entry = rf__pow10_significands[-k - RF__POW10_MIN_EXPONENT];
+    uint64_t g[2] = { table_entry[0], table_entry[1] + 1 };
+    if (g[1] == 0) g[0]++;
+
+    uint64_t vbl = rf__round_to_odd_u64(g, cbl << h);
+    uint64_t vb  = rf__round_to_odd_u64(g, cb << h);
+    uint64_t vbr = rf__round_to_odd_u64(g, cbr << h);
+
+    uint64_t lower = vbl + !even;
+    uint64_t upper = vbr - !even;
+
+    uint64_t s = vb / 4;
+
+    // One digit less if either s or s + 1 with the last digit dropped is inside the interval
+    if (s >= 10)
+    {
+        uint64_t sp = s / 10;
+        rf_bool up_inside = lower <= 40 * sp;
+        rf_bool wp_inside = 40 * sp + 40 <= upper;
+
+        if (up_inside != wp_inside)
+        {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+
+    rf_bool u_inside = lower <= 4 * s;
+    rf_bool w_inside = 4 * s + 4 <= upper;
+
+    *exponent = k;
+
+    if (u_inside != w_inside) return s + w_inside;
+
+    // Both are inside, pick the closest one rounding half to even
+    uint64_t mid = 4 * s + 2;
+    rf_bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+
+    return s + round_up;
+}
+
+rf_internal uint32_t rf__shortest_decimal_f32(uint32_t ieee_mantissa, int ieee_exponent, int* exponent)
+{
+    const int exponent_bias = 127 + 23;
+    uint32_t c;
+    int q;
+
+    if (ieee_exponent != 0)
+    {
+        c = (1u << 23) | ieee_mantissa;
+        q = ieee_exponent - exponent_bias;
+
+        if (q <= 0 && -q < 24 && (c & ((1u << -q) - 1)) == 0)
+        {
+            *exponent = 0;
+            return c >> -q;
+        }
+    }
+    else
+    {
+        c = ieee_mantissa;
+        q = 1 - exponent_bias;
+    }
+
+    rf_bool even = (c & 1) == 0;
+    rf_bool closer_lower_bound = ieee_mantissa == 0 && ieee_exponent > 1;
+
+    uint32_t cbl = 4 * c - 2 + closer_lower_bound;
+    uint32_t cb  = 4 * c;
+    uint32_t cbr = 4 * c + 2;
+
+    int k = rf__floor_log10_pow2(q, closer_lower_bound);
+    int h = q + rf__floor_log2_pow10(-k) + 1;
+
+    // The high half of the table entry is the significand rounded down to 64 bits
+    uint64_t g = rf__pow10_significands[-k - RF__POW10_MIN_EXPONENT][0] + 1;
+
+    uint32_t vbl = rf__round_to_odd_u32(g, cbl << h);
+    uint32_t vb  = rf__round_to_odd_u32(g, cb << h);
+    uint32_t vbr = rf__round_to_odd_u32(g, cbr << h);
+
+    uint32_t lower = vbl + !even;
+    uint32_t upper = vbr - !even;
+
+    uint32_t s = vb / 4;
+
+    if (s >= 10)
+    {
+        uint32_t sp = s / 10;
+        rf_bool up_inside = lower <= 40 * sp;
+        rf_bool wp_inside = 40 * sp + 40 <= upper;
+
+        if (up_inside != wp_inside)
+        {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+
+    rf_bool u_inside = lower <= 4 * s;
+    rf_bool w_inside = 4 * s + 4 <= upper;
+
+    *exponent = k;
+
+    if (u_inside != w_inside) return s + w_inside;
+
+    uint32_t mid = 4 * s + 2;
+    rf_bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+
+    return s + round_up;
+}
+
+#define RF__SHORTEST_FLOAT_BUFFER_SIZE (32)
+
+// Writes digits * 10^exponent in plain notation when the decimal point is close to the digits and in scientific notation otherwise
+rf_internal rf_int rf__write_decimal(char* dst, rf_bool negative, uint64_t digits, int exponent)
+{
+    char* iter = dst;
+    if (negative) *iter++ = '-';
+
+    while (digits % 10 == 0)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    char digits_buffer[24];
+    char* digits_end = digits_buffer + sizeof(digits_buffer);
+    char* digits_begin = rf__format_u64(digits, digits_end, 10, 0);
+    int digits_count = (int) (digits_end - digits_begin);
+
+    // Exponent of the first digit in scientific notation
+    int scientific_exponent = digits_count - 1 + exponent;
+
+    if (scientific_exponent >= 21 || scientific_exponent <= -7)
+    {
+        *iter++ = digits_begin[0];
+        if (digits_count > 1)
+        {
+            *iter++ = '.';
+            memcpy(iter, digits_begin + 1, digits_count - 1);
+            iter += digits_count - 1;
+        }
+
+        *iter++ = 'e';
+        *iter++ = scientific_exponent < 0 ? '-' : '+';
+
+        char exponent_buffer[8];
+        char* exponent_end = exponent_buffer + sizeof(exponent_buffer);
+        char* exponent_begin = rf__format_u64(scientific_exponent < 0 ? -scientific_exponent : scientific_exponent, exponent_end, 10, 0);
+        memcpy(iter, exponent_begin, exponent_end - exponent_begin);
+        iter += exponent_end - exponent_begin;
+    }
+    else if (exponent >= 0)
+    {
+        memcpy(iter, digits_begin, digits_count);
+        iter += digits_count;
+        memset(iter, '0', exponent);
+        iter += exponent;
+    }
+    else if (scientific_exponent >= 0)
+    {
+        memcpy(iter, digits_begin, scientific_exponent + 1);
+        iter += scientific_exponent + 1;
+        *iter++ = '.';
+        memcpy(iter, digits_begin + scientific_exponent + 1, digits_count - scientific_exponent - 1);
+        iter += digits_count - scientific_exponent - 1;
+    }
+    else
+    {
+        *iter++ = '0';
+        *iter++ = '.';
+        memset(iter, '0', -scientific_exponent - 1);
+        iter += -scientific_exponent - 1;
+        memcpy(iter, digits_begin, digits_count);
+        iter += digits_count;
+    }
+
+    rf_int result = iter - dst;
+    return result;
+}
+
+// Writes inf, -inf, nan, 0 or -0 and returns the size, or returns 0 for other values
+rf_internal rf_int rf__write_special_float(char* dst, rf_bool negative, rf_bool max_exponent, rf_bool zero_mantissa, rf_bool zero_exponent)
+{
+    const char* text = 0;
+
+    if (max_exponent) text = zero_mantissa ? (negative ? "-inf" : "inf") : "nan";
+    else if (zero_exponent && zero_mantissa) text = negative ? "-0" : "0";
+
+    rf_int result = text ? (rf_int) strlen(text) : 0;
+    memcpy(dst, text ? text : "", result);
+
+    return result;
+}
+
+// The exact value of mantissa * 2^exponent, a double has at most 767 significant decimal digits so nothing is truncated
+rf_internal void rf__decimal_from_binary(rf__decimal* decimal, uint64_t mantissa, int exponent)
+{
+    char buf[20];
+    char* end = buf + sizeof(buf);
+    char* begin = rf__format_u64(mantissa, end, 10, 0);
+
+    decimal->count = 0;
+    decimal->truncated = 0;
+    decimal->point = end - begin;
+
+    for (; begin != end; begin++) rf__decimal_push_digit(decimal, *begin);
+
+    rf__decimal_trim(decimal);
+    rf__decimal_shift(decimal, exponent);
+}
+
+// Keeps the first `keep` digits rounding half to even, keep can be negative or past the last digit
+rf_internal void rf__decimal_round(rf__decimal* decimal, rf_int keep)
+{
+    if (keep >= decimal->count) return;
+
+    if (keep < 0)
+    {
+        decimal->count = 0;
+        decimal->point = 0;
+        return;
+    }
+
+    // Digits are trimmed, so a 5 as the last digit is exactly half way
+    rf_bool round_up;
+    if (decimal->digits[keep] == 5 && keep + 1 == decimal->count)
+    {
+        round_up = decimal->truncated || (keep > 0 && (decimal->digits[keep - 1] & 1));
+    }
+    else round_up = decimal->digits[keep] >= 5;
+
+    decimal->count = keep;
+
+    if (round_up)
+    {
+        while (decimal->count > 0 && decimal->digits[decimal->count - 1] == 9) decimal->count--;
+
+        if (decimal->count == 0)
+        {
+            // All nines carry into a new leading digit
+            decimal->digits[0] = 1;
+            decimal->count = 1;
+            decimal->point++;
+        }
+        else decimal->digits[decimal->count - 1]++;
+    }
+
+    rf__decimal_trim(decimal);
+}
+
+// Writes the digits in [begin, end) where the first stored digit is at 0, positions outside of the stored digits are zeros
+rf_internal void rf__format_decimal_digits(rf__format_output* out, const rf__decimal* decimal, rf_int begin, rf_int end)
+{
+    char buf[64];
+    rf_int size = 0;
+
+    for (rf_int i = begin; i < end; i++)
+    {
+        buf[size++] = (char)('0' + (i >= 0 && i < decimal->count ? decimal->digits[i] : 0));
+
+        if (size == (rf_int) sizeof(buf))
+        {
+            rf__format_out(out, buf, size);
+            size = 0;
+        }
+    }
+
+    rf__format_out(out, buf, size);
+}
+
+rf_internal void rf__format_double(rf__format_output* out, rf__format_spec spec, double value, char conversion)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    char prefix[1];
+    rf_int prefix_size = 1;
+    if (bits >> 63) prefix[0] = '-';
+    else if (spec.plus_sign) prefix[0] = '+';
+    else if (spec.space_sign) prefix[0] = ' ';
+    else prefix_size = 0;
+
+    int ieee_exponent = (int)((bits >> 52) & 0x7ff);
+    uint64_t mantissa = bits & ((1ull << 52) - 1);
+    rf_bool uppercase = !(conversion & 32);
+
+    if (ieee_exponent == 0x7ff)
+    {
+        const char* str = mantissa ? (uppercase ? "NAN" : "nan") : (uppercase ? "INF" : "inf");
+        spec.zero_pad = 0;
+        rf__format_number(out, spec, prefix, prefix_size, str, 3, 0);
+        return;
+    }
+
+    int exponent = ieee_exponent ? ieee_exponent - 1075 : -1074;
+    if (ieee_exponent) mantissa |= 1ull << 52;
+
+    // Dropping the trailing zero bits makes the shifts shorter
+    if (mantissa)
+    {
+        int zeros = rf__count_trailing_zeros_u64(mantissa);
+        mantissa >>= zeros;
+        exponent += zeros;
+    }
+
+    rf__decimal decimal;
+    rf__decimal_from_binary(&decimal, mantissa, exponent);
+
+    char lower_conversion = conversion | 32;
+    int precision = spec.precision < 0 ? 6 : spec.precision;
+
+    if (lower_conversion == 'g')
+    {
+        // Pick %e or %f from the exponent the value has once rounded to the significant digits asked for
+        int significant = precision ? precision : 1;
+        rf__decimal_round(&decimal, significant);
+        rf_int decimal_exponent = decimal.count ? decimal.point - 1 : 0;
+
+        if (decimal_exponent < significant && decimal_exponent >= -4)
+        {
+            lower_conversion = 'f';
+            precision = (int) (significant - 1 - decimal_exponent);
+            if (!spec.alternate_form && precision > decimal.count - decimal.point) precision = (int) (decimal.count - decimal.point);
+        }
+        else
+        {
+            lower_conversion = 'e';
+            precision = significant - 1;
+            if (!spec.alternate_form && precision > decimal.count - 1) precision = (int) (decimal.count - 1);
+        }
+
+        if (precision < 0) precision = 0;
+    }
+    else if (lower_conversion == 'f') rf__decimal_round(&decimal, decimal.point + precision);
+    else rf__decimal_round(&decimal, precision + 1);
+
+    rf_bool has_point = precision > 0 || spec.alternate_form;
+    rf_int size = prefix_size + has_point + precision;
+
+    char exponent_buf[8];
+    char* exponent_end = exponent_buf + sizeof(exponent_buf);
+    char* exponent_begin = exponent_end;
+
+    if (lower_conversion == 'f')
+    {
+        size += decimal.point > 0 ? decimal.point : 1;
+    }
+    else
+    {
+        rf_int decimal_exponent = decimal.count ? decimal.point - 1 : 0;
+        uint64_t exponent_magnitude = decimal_exponent < 0 ? -decimal_exponent : decimal_exponent;
+
+        exponent_begin = rf__format_u64(exponent_magnitude, exponent_end, 10, 0);
+        if (exponent_magnitude < 10) *--exponent_begin = '0';
+        *--exponent_begin = decimal_exponent < 0 ? '-' : '+';
+        *--exponent_begin = uppercase ? 'E' : 'e';
+
+        size += 1 + (exponent_end - exponent_begin);
+    }
+
+    rf_int padding = spec.width > size ? spec.width - size : 0;
+    if (!spec.left_align && !spec.zero_pad) rf__format_pad(out, ' ', padding);
+    rf__format_out(out, prefix, prefix_size);
+    if (!spec.left_align && spec.zero_pad) rf__format_pad(out, '0', padding);
+
+    if (lower_conversion == 'f')
+    {
+        // Digit i of the decimal is at position point - 1 - i from the radix point
+        if (decimal.point > 0) rf__format_decimal_digits(out, &decimal, 0, decimal.point);
+        else rf__format_out(out, "0", 1);
+
+        if (has_point) rf__format_out(out, ".", 1);
+        rf__format_decimal_digits(out, &decimal, decimal.point, decimal.point + precision);
+    }
+    else
+    {
+        rf__format_decimal_digits(out, &decimal, 0, 1);
+        if (has_point) rf__format_out(out, ".", 1);
+        rf__format_decimal_digits(out, &decimal, 1, 1 + precision);
+        rf__format_out(out, exponent_begin, exponent_end - exponent_begin);
+    }
+
+    if (spec.left_align) rf__format_pad(out, ' ', padding);
+}
+
+rf_internal rf_int rf__copy_number_to_buffer(char* dst, rf_int dst_size, const char* text, rf_int size)
+{
+    if (dst && dst_size > 0)
+    {
+        rf_int amount = size < dst_size - 1 ? size : dst_size - 1;
+        memcpy(dst, text, amount);
+        dst[amount] = 0;
+    }
+
+    return size;
+}
+
+rf_public rf_int rf_format_double(char* dst, rf_int dst_size, double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    rf_bool negative = bits >> 63;
+    uint64_t ieee_mantissa = bits & ((1ull << 52) - 1);
+    int ieee_exponent = (int) ((bits >> 52) & 0x7ff);
+
+    char text[RF__SHORTEST_FLOAT_BUFFER_SIZE];
+    rf_int size = rf__write_special_float(text, negative, ieee_exponent == 0x7ff, ieee_mantissa == 0, ieee_exponent == 0);
+
+    if (!size)
+    {
+        int exponent;
+        uint64_t digits = rf__shortest_decimal_f64(ieee_mantissa, ieee_exponent, &exponent);
+        size = rf__write_decimal(text, negative, digits, exponent);
+    }
+
+    rf_int result = rf__copy_number_to_buffer(dst, dst_size, text, size);
+    return result;
+}
+
+rf_public rf_int rf_format_float(char* dst, rf_int dst_size, float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    rf_bool negative = bits >> 31;
+    uint32_t ieee_mantissa = bits & ((1u << 23) - 1);
+    int ieee_exponent = (int) ((bits >> 23) & 0xff);
+
+    char text[RF__SHORTEST_FLOAT_BUFFER_SIZE];
+    rf_int size = rf__write_special_float(text, negative, ieee_exponent == 0xff, ieee_mantissa == 0, ieee_exponent == 0);
+
+    if (!size)
+    {
+        int exponent;
+        uint32_t digits = rf__shortest_decimal_f32(ieee_mantissa, ieee_exponent, &exponent);
+        size = rf__write_decimal(text, negative, digits, exponent);
+    }
+
+    rf_int result = rf__copy_number_to_buffer(dst, dst_size, text, size);
+    return result;
+}
+
+rf_public rf_int rf_format_int(char* dst, rf_int dst_size, int64_t value)
+{
+    char text[24];
+    char* end = text + sizeof(text);
+
+    // Negate as unsigned so INT64_MIN doesn't overflow
+    char* begin = rf__format_u64(value < 0 ? 0 - (uint64_t) value : (uint64_t) value, end, 10, 0);
+    if (value < 0) *--begin = '-';
+
+    rf_int result = rf__copy_number_to_buffer(dst, dst_size, begin, end - begin);
+    return result;
+}
+
+#pragma endregion
+
+#pragma region strbuf
+rf_public rf_strbuf rf_strbuf_make_ex(rf_int initial_amount, rf_allocator allocator)
+{
+    rf_strbuf result = {0};
+
+    void* data = rf_alloc(allocator, initial_amount);
+
+    if (data)
+    {
+        result.data      = data;
+        result.capacity  = initial_amount;
+        result.allocator = allocator;
+        result.owns_data = 1;
+        result.valid     = 1;
+    }
+
+    return result;
+}
+
+rf_public rf_strbuf rf_strbuf_make_on_buffer(char* buffer, rf_int buffer_size, rf_allocator allocator)
+{
+    rf_strbuf result = {0};
+
+    if (buffer && buffer_size > 0)
+    {
+        buffer[0] = 0;
+
+        result.data      = buffer;
+        result.capacity  = buffer_size;
+        result.allocator = allocator;
+        result.valid     = 1;
+    }
+
+    return result;
+}
+
+rf_public rf_strbuf rf_strbuf_clone_ex(rf_strbuf this_buf, rf_allocator allocator)
+{
+    rf_strbuf result = {0};
+
+    if (this_buf.valid)
+    {
+        result = rf_strbuf_make_ex(this_buf.capacity, allocator);
+        rf_strbuf_append(&result, rf_strbuf_to_str(this_buf));
+    }
+
+    return result;
+}
+
+rf_public rf_str rf_strbuf_to_str(rf_strbuf src)
+{
+    rf_str result = {0};
+
+    if (src.valid)
+    {
+        result.data = src.data;
+        result.size = src.size;
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_strbuf_remaining_capacity(const rf_strbuf* this_buf)
+{
+    rf_int result = this_buf->capacity - this_buf->size;
+    return result;
+}
+
+rf_public void rf_strbuf_reserve(rf_strbuf* this_buf, rf_int new_capacity)
+{
+    if (new_capacity > this_buf->capacity)
+    {
+        // Grow geometrically so repeated appends are amortized O(1)
+        rf_int grown_capacity = this_buf->capacity + this_buf->capacity / 2;
+        if (new_capacity < grown_capacity) new_capacity = grown_capacity;
+
+        char* new_buf = 0;
+        if (this_buf->owns_data)
+        {
+            new_buf = rf_realloc(this_buf->allocator, this_buf->data, new_capacity, this_buf->capacity);
+        }
+        else
+        {
+            // Move out of the caller's buffer the first time it is outgrown
+            new_buf = rf_alloc(this_buf->allocator, new_capacity);
+            if (new_buf && this_buf->data) memcpy(new_buf, this_buf->data, this_buf->capacity);
+        }
+
+        if (new_buf)
+        {
+            this_buf->data = new_buf;
+            this_buf->capacity = new_capacity;
+            this_buf->owns_data = 1;
+            this_buf->valid = 1;
+        }
+        else
+        {
+            rf_log_error(rf_bad_alloc, "Failed to grow strbuf to a capacity of %d", (int) new_capacity);
+            this_buf->valid = 0;
+        }
+    }
+}
+
+rf_public void rf_strbuf_ensure_capacity_for(rf_strbuf* this_buf, rf_int size)
+{
+    // Plus one for the null terminator
+    if (rf_strbuf_remaining_capacity(this_buf) < size + 1)
+    {
+        rf_strbuf_reserve(this_buf, this_buf->size + size + 1);
+    }
+}
+
+rf_public void rf_strbuf_append(rf_strbuf* this_buf, rf_str it)
+{
+    if (!this_buf->valid) return;
+    rf_strbuf_ensure_capacity_for(this_buf, it.size);
+    if (!this_buf->valid) return;
+
+    memcpy(this_buf->data + this_buf->size, it.data, it.size);
+    this_buf->size += it.size;
+    this_buf->data[this_buf->size] = 0;
+}
+
+rf_internal void rf__strbuf_format_write(void* user_data, const char* data, rf_int size)
+{
+    rf_strbuf_append(user_data, (rf_str) { (char*) data, size });
+}
+
+rf_public void rf_strbuf_appendf_v(rf_strbuf* this_buf, const char* format, va_list args)
+{
+    // The formatter writes its output in chunks straight into the strbuf, no temporary buffer is needed
+    rf__format_output out = { rf__strbuf_format_write, this_buf, 0 };
+    rf__format_v(&out, format, args);
+}
+
+rf_public void rf_strbuf_appendf(rf_strbuf* this_buf, const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    rf_strbuf_appendf_v(this_buf, format, args);
+    va_end(args);
+}
+
+rf_public void rf_strbuf_prepend(rf_strbuf* this_buf, rf_str it)
+{
+    if (!this_buf->valid) return;
+    rf_strbuf_ensure_capacity_for(this_buf, it.size);
+    if (!this_buf->valid) return;
+
+    memmove(this_buf->data + it.size, this_buf->data, this_buf->size);
+    memcpy(this_buf->data, it.data, it.size);
+    this_buf->size += it.size;
+    this_buf->data[this_buf->size] = 0;
+}
+
+rf_public void rf_strbuf_insert_utf8(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at)
+{
+    if (!this_buf->valid || !rf_str_valid(str_to_insert) || insert_at < 0) return;
+
+    rf_strbuf_ensure_capacity_for(this_buf, str_to_insert.size);
+
+    // Iterate over utf8 until we find the byte to insert at
+    rf_int insertion_point = rf_count_utf8_chars_til(this_buf->data, this_buf->size, insert_at).bytes_processed;
+
+    if (this_buf->valid)
+    {
+        // Move all bytes from the insertion point ahead by the size of the string we need to insert
+        {
+            char*  dst = this_buf->data + insertion_point + str_to_insert.size;
+            char*  src = this_buf->data + insertion_point;
+            rf_int src_size = this_buf->size - insertion_point;
+            memmove(dst, src, src_size);
+        }
+
+        // Copy the string to insert
+        {
+            char* dst = this_buf->data + insertion_point;
+            memmove(dst, str_to_insert.data, str_to_insert.size);
+        }
+
+        this_buf->size += str_to_insert.size;
+        this_buf->data[this_buf->size] = 0;
+    }
+}
+
+rf_public void rf_strbuf_insert_b(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at)
+{
+    // Negative positions count from the end and positions past the end append
+    if (insert_at < 0) insert_at += this_buf->size;
+    if (insert_at < 0) insert_at = 0;
+    if (insert_at > this_buf->size) insert_at = this_buf->size;
+
+    if (this_buf->valid && rf_str_valid(str_to_insert))
+    {
+        rf_strbuf_ensure_capacity_for(this_buf, str_to_insert.size);
+        if (!this_buf->valid) return;
+
+        // Move all bytes from the insertion point ahead by the size of the string we need to insert
+        {
+            char* dst = this_buf->data + insert_at + str_to_insert.size;
+            char* src = this_buf->data + insert_at;
+            rf_int src_size = this_buf->size - insert_at;
+            memmove(dst, src, src_size);
+        }
+
+        // Copy the string to insert
+        {
+            char* dst = this_buf->data + insert_at;
+            memcpy(dst, str_to_insert.data, str_to_insert.size);
+        }
+
+        this_buf->size += str_to_insert.size;
+        this_buf->data[this_buf->size] = 0;
+    }
+}
+
+rf_public void rf_strbuf_remove_range_utf8(rf_strbuf* this_buf, rf_int begin, rf_int end)
+{
+    if (!this_buf->valid || begin < 0 || end <= begin) return;
+
+    // Count from where the range begins instead of scanning from the start twice
+    rf_int begin_b = rf_count_utf8_chars_til(this_buf->data, this_buf->size, begin).bytes_processed;
+    rf_int end_b = begin_b + rf_count_utf8_chars_til(this_buf->data + begin_b, this_buf->size - begin_b, end - begin).bytes_processed;
+
+    rf_strbuf_remove_range_b(this_buf, begin_b, end_b);
+}
+
+rf_public void rf_strbuf_remove_range_b(rf_strbuf* this_buf, rf_int begin, rf_int end)
+{
+    if (!this_buf->valid) return;
+
+    if (begin < 0) begin = 0;
+    if (end > this_buf->size) end = this_buf->size;
+    if (begin >= end) return;
+
+    memmove(this_buf->data + begin, this_buf->data + end, this_buf->size - end);
+
+    this_buf->size -= end - begin;
+    this_buf->data[this_buf->size] = 0;
+}
+
+rf_public void rf_strbuf_free(rf_strbuf* this_buf)
+{
+    if (this_buf->owns_data) rf_free(this_buf->allocator, this_buf->data);
+
+    this_buf->data = 0;
+    this_buf->owns_data = 0;
+
+    this_buf->size = 0;
+    this_buf->capacity = 0;
+}
+#pragma endregion
+
+#pragma region textbuf
+
+rf_internal rf_int rf__textbuf_gap_size(const rf_textbuf* this_buf)
+{
+    rf_int result = this_buf->gap_end - this_buf->gap_begin;
+    return result;
+}
+
+rf_internal char rf__textbuf_byte_at(const rf_textbuf* this_buf, rf_int offset)
+{
+    char result = this_buf->data[offset < this_buf->gap_begin ? offset : offset + rf__textbuf_gap_size(this_buf)];
+    return result;
+}
+
+rf_internal rf_bool rf__is_utf8_continuation(char c)
+{
+    rf_bool result = (c & 0xc0) == 0x80;
+    return result;
+}
+
+// Moves the text after the gap to the end of a bigger allocation so that the gap can fit at least size bytes
+rf_internal rf_bool rf__textbuf_reserve_gap(rf_textbuf* this_buf, rf_int size)
+{
+    if (rf__textbuf_gap_size(this_buf) >= size) return 1;
+
+    rf_int new_capacity = this_buf->capacity + this_buf->capacity / 2;
+    rf_int required = rf_textbuf_size(this_buf) + size + RF_TEXTBUF_MIN_GAP;
+    if (new_capacity < required) new_capacity = required;
+
+    char* new_data = rf_realloc(this_buf->allocator, this_buf->data, new_capacity, this_buf->capacity);
+    if (!new_data)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to grow textbuf to a capacity of %d", (int) new_capacity);
+        return 0;
+    }
+
+    rf_int after_size = this_buf->capacity - this_buf->gap_end;
+    memmove(new_data + new_capacity - after_size, new_data + this_buf->gap_end, after_size);
+
+    this_buf->data     = new_data;
+    this_buf->gap_end  = new_capacity - after_size;
+    this_buf->capacity = new_capacity;
+
+    return 1;
+}
+
+rf_internal rf_bool rf__textbuf_reserve_lines(rf_textbuf* this_buf, rf_int count)
+{
+    rf_int used = this_buf->lines_before_cursor + this_buf->lines_after_cursor;
+    if (used + count <= this_buf->line_starts_capacity) return 1;
+
+    rf_int new_capacity = this_buf->line_starts_capacity + this_buf->line_starts_capacity / 2;
+    if (new_capacity < used + count + 64) new_capacity = used + count + 64;
+
+    rf_int* new_line_starts = this_buf->line_starts
+        ? rf_realloc(this_buf->allocator, this_buf->line_starts, new_capacity * sizeof(rf_int), this_buf->line_starts_capacity * sizeof(rf_int))
+        : rf_alloc(this_buf->allocator, new_capacity * sizeof(rf_int));
+
+    if (!new_line_starts)
+    {
+        rf_log_error(rf_bad_alloc, "Failed to grow the line index of a textbuf to %d lines", (int) new_capacity);
+        return 0;
+    }
+
+    memmove(new_line_starts + new_capacity - this_buf->lines_after_cursor, new_line_starts + this_buf->line_starts_capacity - this_buf->lines_after_cursor, this_buf->lines_after_cursor * sizeof(rf_int));
+
+    this_buf->line_starts          = new_line_starts;
+    this_buf->line_starts_capacity = new_capacity;
+
+    return 1;
+}
+
+// Start of the first line after the cursor, stored as its distance to the end of the text
+rf_internal rf_int rf__textbuf_first_line_after_cursor(const rf_textbuf* this_buf)
+{
+    rf_int result = rf_textbuf_size(this_buf) - this_buf->line_starts[this_buf->line_starts_capacity - this_buf->lines_after_cursor];
+    return result;
+}
+
+rf_internal void rf__textbuf_remove_before_cursor(rf_textbuf* this_buf, rf_int size)
+{
+    this_buf->gap_begin -= size;
+
+    // Lines whose line break was removed
+    while (this_buf->lines_before_cursor > 0 && this_buf->line_starts[this_buf->lines_before_cursor - 1] > this_buf->gap_begin)
+    {
+        this_buf->lines_before_cursor--;
+    }
+}
+
+rf_internal void rf__textbuf_remove_after_cursor(rf_textbuf* this_buf, rf_int size)
+{
+    while (this_buf->lines_after_cursor > 0 && rf__textbuf_first_line_after_cursor(this_buf) <= this_buf->gap_begin + size)
+    {
+        this_buf->lines_after_cursor--;
+    }
+
+    this_buf->gap_end += size;
+}
+
+rf_public rf_textbuf rf_textbuf_make(rf_int capacity, rf_allocator allocator)
+{
+    rf_textbuf result = {0};
+
+    if (capacity < RF_TEXTBUF_MIN_GAP) capacity = RF_TEXTBUF_MIN_GAP;
+
+    result.data = rf_alloc(allocator, capacity);
+
+    if (result.data)
+    {
+        result.capacity  = capacity;
+        result.gap_end   = capacity;
+        result.allocator = allocator;
+        result.valid     = 1;
+    }
+    else
+    {
+        rf_log_error(rf_bad_alloc, "Failed to allocate textbuf with a capacity of %d", (int) capacity);
+    }
+
+    return result;
+}
+
+rf_public rf_textbuf rf_textbuf_make_from_str(rf_str text, rf_allocator allocator)
+{
+    rf_textbuf result = rf_textbuf_make(text.size + RF_TEXTBUF_MIN_GAP, allocator);
+
+    if (result.valid && !rf_textbuf_insert(&result, text))
+    {
+        rf_textbuf_free(&result);
+    }
+
+    return result;
+}
+
+rf_public void rf_textbuf_free(rf_textbuf* this_buf)
+{
+    if (this_buf->data) rf_free(this_buf->allocator, this_buf->data);
+    if (this_buf->line_starts) rf_free(this_buf->allocator, this_buf->line_starts);
+
+    rf_textbuf empty = {0};
+    *this_buf = empty;
+}
+
+rf_public rf_int rf_textbuf_size(const rf_textbuf* this_buf)
+{
+    rf_int result = this_buf->capacity - rf__textbuf_gap_size(this_buf);
+    return result;
+}
+
+rf_public rf_int rf_textbuf_cursor(const rf_textbuf* this_buf)
+{
+    rf_int result = this_buf->gap_begin;
+    return result;
+}
+
+rf_public void rf_textbuf_set_cursor(rf_textbuf* this_buf, rf_int offset)
+{
+    if (!this_buf->valid) return;
+
+    rf_int size = rf_textbuf_size(this_buf);
+    if (offset < 0) offset = 0;
+    if (offset > size) offset = size;
+
+    if (offset < this_buf->gap_begin)
+    {
+        rf_int amount = this_buf->gap_begin - offset;
+        memmove(this_buf->data + this_buf->gap_end - amount, this_buf->data + offset, amount);
+        this_buf->gap_begin = offset;
+        this_buf->gap_end  -= amount;
+
+        // Lines that are now after the cursor get stored from the end
+        while (this_buf->lines_before_cursor > 0 && this_buf->line_starts[this_buf->lines_before_cursor - 1] > offset)
+        {
+            this_buf->lines_after_cursor++;
+            this_buf->lines_before_cursor--;
+            this_buf->line_starts[this_buf->line_starts_capacity - this_buf->lines_after_cursor] = size - this_buf->line_starts[this_buf->lines_before_cursor];
+        }
+    }
+    else if (offset > this_buf->gap_begin)
+    {
+        rf_int amount = offset - this_buf->gap_begin;
+        memmove(this_buf->data + this_buf->gap_begin, this_buf->data + this_buf->gap_end, amount);
+        this_buf->gap_begin += amount;
+        this_buf->gap_end   += amount;
+
+        while (this_buf->lines_after_cursor > 0 && rf__textbuf_first_line_after_cursor(this_buf) <= offset)
+        {
+            this_buf->line_starts[this_buf->lines_before_cursor] = rf__textbuf_first_line_after_cursor(this_buf);
+            this_buf->lines_before_cursor++;
+            this_buf->lines_after_cursor--;
+        }
+    }
+}
+
+rf_public rf_int rf_textbuf_next_rune(const rf_textbuf* this_buf, rf_int offset)
+{
+    rf_int size = rf_textbuf_size(this_buf);
+    if (offset >= size) return size;
+    if (offset < 0) return 0;
+
+    // Skip at most 3 continuation bytes so that invalid UTF-8 still moves one byte at a time
+    rf_int result = offset + 1;
+    for (int i = 0; i < 3 && result < size && rf__is_utf8_continuation(rf__textbuf_byte_at(this_buf, result)); i++) result++;
+
+    return result;
+}
+
+rf_public rf_int rf_textbuf_prev_rune(const rf_textbuf* this_buf, rf_int offset)
+{
+    rf_int size = rf_textbuf_size(this_buf);
+    if (offset <= 0) return 0;
+    if (offset > size) return size;
+
+    rf_int result = offset - 1;
+    for (int i = 0; i < 3 && result > 0 && rf__is_utf8_continuation(rf__textbuf_byte_at(this_buf, result)); i++) result--;
+
+    return result;
+}
+
+rf_public rf_bool rf_textbuf_insert(rf_textbuf* this_buf, rf_str text)
+{
+    if (!this_buf->valid) return 0;
+    if (!rf_str_valid(text)) return 1;
+
+    // Reserve everything first so that a failed allocation leaves the text as it was
+    rf_int line_count = 0;
+    for (const char* iter = text.data, *end = text.data + text.size; (iter = memchr(iter, '\n', end - iter)); iter++) line_count++;
+
+    if (!rf__textbuf_reserve_gap(this_buf, text.size) || !rf__textbuf_reserve_lines(this_buf, line_count)) return 0;
+
+    memcpy(this_buf->data + this_buf->gap_begin, text.data, text.size);
+
+    for (const char* iter = text.data, *end = text.data + text.size; (iter = memchr(iter, '\n', end - iter)); iter++)
+    {
+        this_buf->line_starts[this_buf->lines_before_cursor++] = this_buf->gap_begin + (iter - text.data) + 1;
+    }
+
+    this_buf->gap_begin += text.size;
+
+    return 1;
+}
+
+rf_public rf_bool rf_textbuf_insert_at(rf_textbuf* this_buf, rf_str text, rf_int offset)
+{
+    rf_textbuf_set_cursor(this_buf, offset);
+
+    rf_bool result = rf_textbuf_insert(this_buf, text);
+    return result;
+}
+
+rf_public rf_int rf_textbuf_delete_backward(rf_textbuf* this_buf, rf_int rune_count)
+{
+    if (!this_buf->valid) return 0;
+
+    rf_int begin = this_buf->gap_begin;
+    for (; rune_count > 0 && begin > 0; rune_count--) begin = rf_textbuf_prev_rune(this_buf, begin);
+
+    rf_int result = this_buf->gap_begin - begin;
+    rf__textbuf_remove_before_cursor(this_buf, result);
+
+    return result;
+}
+
+rf_public rf_int rf_textbuf_delete_forward(rf_textbuf* this_buf, rf_int rune_count)
+{
+    if (!this_buf->valid) return 0;
+
+    rf_int size = rf_textbuf_size(this_buf);
+    rf_int end = this_buf->gap_begin;
+    for (; rune_count > 0 && end < size; rune_count--) end = rf_textbuf_next_rune(this_buf, end);
+
+    rf_int result = end - this_buf->gap_begin;
+    rf__textbuf_remove_after_cursor(this_buf, result);
+
+    return result;
+}
+
+rf_public void rf_textbuf_remove_range(rf_textbuf* this_buf, rf_int begin, rf_int end)
+{
+    if (!this_buf->valid) return;
+
+    rf_int size = rf_textbuf_size(this_buf);
+    if (begin < 0) begin = 0;
+    if (end > size) end = size;
+    if (begin >= end) return;
+
+    // Only move the cursor if it is outside of the range
+    if (this_buf->gap_begin < begin) rf_textbuf_set_cursor(this_buf, begin);
+    if (this_buf->gap_begin > end) rf_textbuf_set_cursor(this_buf, end);
+
+    rf_int after = end - this_buf->gap_begin;
+    rf__textbuf_remove_before_cursor(this_buf, this_buf->gap_begin - begin);
+    rf__textbuf_remove_after_cursor(this_buf, after);
+}
+
+rf_public rf_int rf_textbuf_line_count(const rf_textbuf* this_buf)
+{
+    rf_int result = 1 + this_buf->lines_before_cursor + this_buf->lines_after_cursor;
+    return result;
+}
+
+rf_public rf_int rf_textbuf_line_begin(const rf_textbuf* this_buf, rf_int line)
+{
+    rf_int result = 0;
+
+    if (line > 0)
+    {
+        rf_int index = line - 1;
+
+        if (index < this_buf->lines_before_cursor)
+        {
+            result = this_buf->line_starts[index];
+        }
+        else if (index - this_buf->lines_before_cursor < this_buf->lines_after_cursor)
+        {
+            index -= this_buf->lines_before_cursor;
+            result = rf_textbuf_size(this_buf) - this_buf->line_starts[this_buf->line_starts_capacity - this_buf->lines_after_cursor + index];
+        }
+        else
+        {
+            result = rf_textbuf_size(this_buf);
+        }
+    }
+
+    return result;
+}
+
+rf_public rf_int rf_textbuf_line_end(const rf_textbuf* this_buf, rf_int line)
+{
+    rf_int result = line + 1 < rf_textbuf_line_count(this_buf) ? rf_textbuf_line_begin(this_buf, line + 1) - 1 : rf_textbuf_size(this_buf);
+    return result;
+}
+
+rf_public rf_int rf_textbuf_line_at(const rf_textbuf* this_buf, rf_int offset)
+{
+    // Last line that begins at or before the offset
+    rf_int low = 0;
+    rf_int high = rf_textbuf_line_count(this_buf) - 1;
+
+    while (low < high)
+    {
+        rf_int mid = low + (high - low + 1) / 2;
+
+        if (rf_textbuf_line_begin(this_buf, mid) <= offset) low = mid;
+        else high = mid - 1;
+    }
+
+    return low;
+}
+
+rf_public rf_int rf_textbuf_column_at(const rf_textbuf* this_buf, rf_int offset)
+{
+    rf_int line_begin = rf_textbuf_line_begin(this_buf, rf_textbuf_line_at(this_buf, offset));
+    rf_textbuf_slice slice = rf_textbuf_get_slice(this_buf, line_begin, offset);
+
+    // Count the bytes that start a rune since a rune can be split between the two parts
+    rf_int result = 0;
+    for (rf_int i = 0; i < slice.first.size; i++) result += !rf__is_utf8_continuation(slice.first.data[i]);
+    for (rf_int i = 0; i < slice.second.size; i++) result += !rf__is_utf8_continuation(slice.second.data[i]);
+
+    return result;
+}
+
+rf_public rf_int rf_textbuf_offset_at(const rf_textbuf* this_buf, rf_int line, rf_int column)
+{
+    rf_int result = rf_textbuf_line_begin(this_buf, line);
+    rf_int line_end = rf_textbuf_line_end(this_buf, line);
+
+    for (; column > 0 && result < line_end; column--) result = rf_textbuf_next_rune(this_buf, result);
+
+    return result;
+}
+
+rf_public rf_textbuf_slice rf_textbuf_get_slice(const rf_textbuf* this_buf, rf_int begin, rf_int end)
+{
+    rf_textbuf_slice result = {0};
+
+    rf_int size = rf_textbuf_size(this_buf);
+    if (begin < 0) begin = 0;
+    if (end > size) end = size;
+    if (begin >= end) return result;
+
+    rf_int gap_size = rf__textbuf_gap_size(this_buf);
+
+    if (end <= this_buf->gap_begin)
+    {
+        result.first = (rf_str) { this_buf->data + begin, end - begin };
+    }
+    else if (begin >= this_buf->gap_begin)
+    {
+        result.first = (rf_str) { this_buf->data + gap_size + begin, end - begin };
+    }
+    else
+    {
+        result.first  = (rf_str) { this_buf->data + begin, this_buf->gap_begin - begin };
+        result.second = (rf_str) { this_buf->data + this_buf->gap_end, end - this_buf->gap_begin };
+    }
+
+    return result;
+}
+
+rf_public rf_textbuf_slice rf_textbuf_get_line(const rf_textbuf* this_buf, rf_int line)
+{
+    rf_textbuf_slice result = rf_textbuf_get_slice(this_buf, rf_textbuf_line_begin(this_buf, line), rf_textbuf_line_end(this_buf, line));
+    return result;
+}
+
+rf_public rf_strbuf rf_textbuf_to_strbuf(const rf_textbuf* this_buf, rf_allocator allocator)
+{
+    rf_strbuf result = {0};
+
+    if (this_buf->valid)
+    {
+        rf_textbuf_slice all = rf_textbuf_get_slice(this_buf, 0, rf_textbuf_size(this_buf));
+
+        result = rf_strbuf_make_ex(rf_textbuf_size(this_buf) + 1, allocator);
+        rf_strbuf_append(&result, all.first);
+        rf_strbuf_append(&result, all.second);
+    }
+
+    return result;
+}
+
+#pragma endregion
+
+#pragma region str
+rf_public rf_bool rf_str_valid(rf_str src)
+{
+    return src.size != 0 && src.data;
+}
+
+rf_public rf_int rf_str_len(rf_str src)
+{
+    rf_utf8_stats stats = rf_count_utf8_chars(src.data, src.size);
+
+    return stats.total_rune_count;
+}
+
+rf_public rf_str rf_cstr(const char* src)
 {
     rf_int size = strlen(src);
     rf_str result = {
@@ -662,47 +3731,272 @@ rf_public rf_bool rf_str_match_suffix(rf_str str, rf_str suffix)
     return cmp == 0;
 }
 
-rf_public rf_int rf_str_find_first(rf_str haystack, rf_str needle)
+/*
+ * Candidate positions are found by comparing a block of haystack bytes against the first byte of the needle and the block
+ * (needle size - 1) bytes later against the last byte, only the positions where both match are verified with memcmp.
+ * The masks have RF__STR_SIMD_BITS_PER_BYTE bits set for every matching byte.
+ */
+#if defined(rayfork_avx2)
+    #define RF__STR_SIMD_WIDTH (32)
+    #define RF__STR_SIMD_BITS_PER_BYTE (1)
+
+    rf_internal uint64_t rf__str_candidates(const char* first_block, const char* last_block, char first, char last)
+    {
+        __m256i first_eq = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) first_block), _mm256_set1_epi8(first));
+        __m256i last_eq  = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*) last_block), _mm256_set1_epi8(last));
+        uint64_t result = (uint32_t) _mm256_movemask_epi8(_mm256_and_si256(first_eq, last_eq));
+        return result;
+    }
+#elif defined(rayfork_sse2)
+    #define RF__STR_SIMD_WIDTH (16)
+    #define RF__STR_SIMD_BITS_PER_BYTE (1)
+
+    rf_internal uint64_t rf__str_candidates(const char* first_block, const char* last_block, char first, char last)
+    {
+        __m128i first_eq = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) first_block), _mm_set1_epi8(first));
+        __m128i last_eq  = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*) last_block), _mm_set1_epi8(last));
+        uint64_t result = (uint16_t) _mm_movemask_epi8(_mm_and_si128(first_eq, last_eq));
+        return result;
+    }
+#elif defined(rayfork_neon)
+    #define RF__STR_SIMD_WIDTH (16)
+    #define RF__STR_SIMD_BITS_PER_BYTE (4)
+
+    rf_internal uint64_t rf__str_candidates(const char* first_block, const char* last_block, char first, char last)
+    {
+        uint8x16_t first_eq = vceqq_u8(vld1q_u8((const uint8_t*) first_block), vdupq_n_u8((uint8_t) first));
+        uint8x16_t last_eq  = vceqq_u8(vld1q_u8((const uint8_t*) last_block), vdupq_n_u8((uint8_t) last));
+
+        // NEON has no movemask, narrowing by 4 bits leaves a nibble per byte
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vandq_u8(first_eq, last_eq)), 4);
+        uint64_t result = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+        return result;
+    }
+#endif
+
+#define RF__STR_SIMD_LANE_MASK ((((uint64_t) 1) << RF__STR_SIMD_BITS_PER_BYTE) - 1)
+
+// Checks the needle bytes between the first and the last one, which the callers already compared
+rf_internal rf_bool rf__str_verify_candidate(const char* at, const char* needle, rf_int needle_size)
 {
-    rf_int result = rf_invalid_index;
-    if (needle.size <= haystack.size)
+    rf_bool result = needle_size <= 2 || memcmp(at + 1, needle + 1, needle_size - 2) == 0;
+    return result;
+}
+
+rf_internal rf_int rf__str_find_first_filtered(const char* haystack, rf_int haystack_size, const char* needle, rf_int needle_size)
+{
+    char first = needle[0];
+    char last  = needle[needle_size - 1];
+    rf_int i = 0;
+
+    #if defined(RF__STR_SIMD_WIDTH)
+    for (; i + needle_size - 1 + RF__STR_SIMD_WIDTH <= haystack_size; i += RF__STR_SIMD_WIDTH)
     {
-        rf_int char_ct = 0;
-        for (rf_str sub = haystack; sub.size >= needle.size; sub = rf_str_sub_b(sub, 1, 0))
+        uint64_t mask = rf__str_candidates(haystack + i, haystack + i + needle_size - 1, first, last);
+
+        while (mask)
         {
-            if (rf_str_match_prefix(sub, needle))
-            {
-                result = char_ct;
-                break;
-            }
-            else
+            rf_int offset = rf__count_trailing_zeros_u64(mask) / RF__STR_SIMD_BITS_PER_BYTE;
+            if (rf__str_verify_candidate(haystack + i + offset, needle, needle_size)) return i + offset;
+            mask &= ~(RF__STR_SIMD_LANE_MASK << (offset * RF__STR_SIMD_BITS_PER_BYTE));
+        }
+    }
+    #endif
+
+    for (; i + needle_size <= haystack_size; i++)
+    {
+        if (haystack[i] == first && haystack[i + needle_size - 1] == last && rf__str_verify_candidate(haystack + i, needle, needle_size)) return i;
+    }
+
+    return rf_invalid_index;
+}
+
+rf_internal rf_int rf__str_find_last_filtered(const char* haystack, rf_int haystack_size, const char* needle, rf_int needle_size)
+{
+    char first = needle[0];
+    char last  = needle[needle_size - 1];
+    rf_int i = haystack_size - needle_size; // The last position the needle can start at
+
+    #if defined(RF__STR_SIMD_WIDTH)
+    for (; i - RF__STR_SIMD_WIDTH + 1 >= 0; i -= RF__STR_SIMD_WIDTH)
+    {
+        rf_int block = i - RF__STR_SIMD_WIDTH + 1;
+        uint64_t mask = rf__str_candidates(haystack + block, haystack + block + needle_size - 1, first, last);
+
+        while (mask)
+        {
+            rf_int offset = (63 - rf__count_leading_zeros_u64(mask)) / RF__STR_SIMD_BITS_PER_BYTE;
+            if (rf__str_verify_candidate(haystack + block + offset, needle, needle_size)) return block + offset;
+            mask &= ~(RF__STR_SIMD_LANE_MASK << (offset * RF__STR_SIMD_BITS_PER_BYTE));
+        }
+    }
+    #endif
+
+    for (; i >= 0; i--)
+    {
+        if (haystack[i] == first && haystack[i + needle_size - 1] == last && rf__str_verify_candidate(haystack + i, needle, needle_size)) return i;
+    }
+
+    return rf_invalid_index;
+}
+
+/*
+ * Two-Way string matching (Crochemore & Perrin), linear time and constant space regardless of the input, with a bad character
+ * shift on the last byte of the window. Used for long needles where verifying every filtered candidate could go quadratic.
+ * The inputs are read through a step of 1 or -1 from their first byte, so searching the mirrored haystack for the mirrored
+ * needle finds the last match with the same code.
+ */
+
+// Start minus one and period of the maximal suffix of the needle, for the byte order or its reverse when flip_order is set
+rf_internal rf_int rf__str_two_way_max_suffix(const unsigned char* needle, rf_int needle_size, rf_int step, rf_bool flip_order, rf_int* period)
+{
+    rf_int suffix    = -1; // The best suffix so far starts right after this
+    rf_int candidate = 0;  // The suffix compared against it starts right after this
+    rf_int offset    = 1;
+
+    *period = 1;
+
+    while (candidate + offset < needle_size)
+    {
+        unsigned char a = needle[(suffix + offset) * step];
+        unsigned char b = needle[(candidate + offset) * step];
+
+        if (a == b)
+        {
+            // Both agree for a whole period, move the candidate on by one period
+            if (offset == *period)
             {
-                char_ct++;
+                candidate += *period;
+                offset = 1;
             }
+            else offset++;
+        }
+        else if (flip_order ? a < b : a > b)
+        {
+            // The candidate is smaller, skip past the mismatch and the period grows to cover it
+            candidate += offset;
+            offset = 1;
+            *period = candidate - suffix;
+        }
+        else
+        {
+            // The candidate is larger and becomes the best suffix
+            suffix = candidate;
+            candidate++;
+            offset = 1;
+            *period = 1;
         }
     }
+
+    return suffix;
+}
+
+// Returns the first position of the needle in the haystack as seen through the step. The search is stamped out once per
+// direction so the step is a constant in the inner loops, indexing through a variable step makes the forward search much slower
+#define RF__STR_DEFINE_TWO_WAY(name, step)                                                                                    \
+rf_internal rf_int name(const unsigned char* haystack, rf_int haystack_size, const unsigned char* needle, rf_int needle_size) \
+{                                                                                                                             \
+    /* One past the last position of each byte in the needle, 0 if the byte doesn't appear in it */                           \
+    rf_int last_position[256] = {0};                                                                                          \
+    for (rf_int i = 0; i < needle_size; i++) last_position[needle[i * step]] = i + 1;                                         \
+                                                                                                                              \
+    /* The critical factorization splits the needle after the later of the two maximal suffixes */                            \
+    rf_int period, flipped_period;                                                                                            \
+    rf_int split         = rf__str_two_way_max_suffix(needle, needle_size, step, 0, &period);                                 \
+    rf_int flipped_split = rf__str_two_way_max_suffix(needle, needle_size, step, 1, &flipped_period);                         \
+                                                                                                                              \
+    if (flipped_split > split)                                                                                                \
+    {                                                                                                                         \
+        split = flipped_split;                                                                                                \
+        period = flipped_period;                                                                                              \
+    }                                                                                                                         \
+                                                                                                                              \
+    /* If the left part repeats with the period the whole needle is periodic, then after a shift by the period the */         \
+    /* first needle_size - period bytes are known to match and don't need to be compared again */                             \
+    rf_bool periodic = 1;                                                                                                     \
+    for (rf_int i = 0; i <= split && periodic; i++) periodic = needle[i * step] == needle[(i + period) * step];               \
+                                                                                                                              \
+    rf_int remembered_after_shift = 0;                                                                                        \
+    if (periodic) remembered_after_shift = needle_size - period;                                                              \
+    else period = rf_max_i(split + 1, needle_size - split - 1) + 1;                                                           \
+                                                                                                                              \
+    rf_int remembered = 0;                                                                                                    \
+                                                                                                                              \
+    for (rf_int pos = 0; pos + needle_size <= haystack_size;)                                                                 \
+    {                                                                                                                         \
+        const unsigned char* window = haystack + pos * step;                                                                  \
+                                                                                                                              \
+        rf_int last = last_position[window[(needle_size - 1) * step]];                                                        \
+        if (last != needle_size)                                                                                              \
+        {                                                                                                                     \
+            rf_int skip = needle_size - last;                                                                                 \
+            if (skip < remembered) skip = remembered;                                                                         \
+            pos += skip;                                                                                                      \
+            remembered = 0;                                                                                                   \
+            continue;                                                                                                         \
+        }                                                                                                                     \
+                                                                                                                              \
+        /* Compare the right part first, a mismatch there shifts past it */                                                   \
+        rf_int i = split + 1 > remembered ? split + 1 : remembered;                                                           \
+        while (i < needle_size && needle[i * step] == window[i * step]) i++;                                                  \
+                                                                                                                              \
+        if (i < needle_size)                                                                                                  \
+        {                                                                                                                     \
+            pos += i - split;                                                                                                 \
+            remembered = 0;                                                                                                   \
+            continue;                                                                                                         \
+        }                                                                                                                     \
+                                                                                                                              \
+        /* Then the left part down to the bytes remembered from the previous window */                                        \
+        i = split + 1;                                                                                                        \
+        while (i > remembered && needle[(i - 1) * step] == window[(i - 1) * step]) i--;                                       \
+                                                                                                                              \
+        if (i <= remembered) return pos;                                                                                      \
+                                                                                                                              \
+        pos += period;                                                                                                        \
+        remembered = remembered_after_shift;                                                                                  \
+    }                                                                                                                         \
+                                                                                                                              \
+    return rf_invalid_index;                                                                                                  \
+}
+
+RF__STR_DEFINE_TWO_WAY(rf__str_two_way_forward, 1)
+RF__STR_DEFINE_TWO_WAY(rf__str_two_way_backward, -1)
+
+rf_public rf_int rf_str_find_first(rf_str haystack, rf_str needle)
+{
+    rf_int result = rf_invalid_index;
+
+    if (needle.size == 0) result = haystack.size >= 0 ? 0 : rf_invalid_index;
+    else if (needle.size <= haystack.size)
+    {
+        if (needle.size < RF_STR_TWO_WAY_MIN_NEEDLE_SIZE) result = rf__str_find_first_filtered(haystack.data, haystack.size, needle.data, needle.size);
+        else result = rf__str_two_way_forward((const unsigned char*) haystack.data, haystack.size, (const unsigned char*) needle.data, needle.size);
+    }
+
     return result;
 }
 
 rf_public rf_int rf_str_find_last(rf_str haystack, rf_str needle)
 {
     rf_int result = rf_invalid_index;
-    if (needle.size <= haystack.size)
+
+    // An empty needle matches at the end, the same way rf_str_find_first matches it at 0
+    if (needle.size == 0) result = haystack.size >= 0 ? haystack.size : rf_invalid_index;
+    else if (needle.size <= haystack.size)
     {
-        rf_int char_ct = haystack.size - 1;
-        for (rf_str sub = haystack; rf_str_valid(sub); sub = rf_str_sub_b(sub, 0, -1))
+        if (needle.size < RF_STR_TWO_WAY_MIN_NEEDLE_SIZE) result = rf__str_find_last_filtered(haystack.data, haystack.size, needle.data, needle.size);
+        else
         {
-            if (rf_str_match_suffix(sub, needle))
-            {
-                result = char_ct;
-                break;
-            }
-            else
-            {
-                char_ct--;
-            }
+            // Searching both mirrored finds the last match, its position is counted from the end
+            const unsigned char* haystack_end = (const unsigned char*) haystack.data + haystack.size - 1;
+            const unsigned char* needle_end   = (const unsigned char*) needle.data + needle.size - 1;
+
+            rf_int mirrored = rf__str_two_way_backward(haystack_end, haystack.size, needle_end, needle.size);
+            if (mirrored != rf_invalid_index) result = haystack.size - needle.size - mirrored;
         }
     }
+
     return result;
 }
 
@@ -740,9 +4034,9 @@ rf_public rf_str rf_str_pop_last_split(rf_str* src, rf_str split_by)
     rf_int i = rf_str_find_last(*src, split_by);
     if (i != rf_invalid_index)
     {
-        result.data  = src->data + i;
-        result.size  = src->size - i;
-        src->size   -= src->size - i - split_by.size;
+        result.data  = src->data + i + split_by.size;
+        result.size  = src->size - i - split_by.size;
+        src->size    = i;
     }
     else
     {
@@ -768,4 +4062,165 @@ rf_public rf_rune rf_utf8_char_to_rune(rf_utf8_char src)
     result = r.codepoint;
     return result;
 }
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region str hash map
+rf_public uint64_t rf_str_hash(rf_str src)
+{
+    uint64_t result = rf_hash_bytes(src.data, src.size);
+    return result;
+}
+
+rf_public void* rf_hashmap_get_str(const rf_hashmap* map, rf_str key)
+{
+    void* result = rf_hashmap_get_bytes(map, key.data, key.size);
+    return result;
+}
+
+rf_public void* rf_hashmap_put_str(rf_hashmap* map, rf_str key, const void* value)
+{
+    void* result = rf_hashmap_put_bytes(map, key.data, key.size, value);
+    return result;
+}
+
+rf_public rf_bool rf_hashmap_remove_str(rf_hashmap* map, rf_str key)
+{
+    rf_bool result = rf_hashmap_remove_bytes(map, key.data, key.size);
+    return result;
+}
+#pragma endregion
+
+#pragma region str pool
+rf_internal void rf__str_pool_lock(rf_str_pool* pool)
+{
+    if (pool->thread_safe) rf__spin_lock(&pool->lock);
+}
+
+rf_internal void rf__str_pool_unlock(rf_str_pool* pool)
+{
+    if (pool->thread_safe) rf__spin_unlock(&pool->lock);
+}
+
+rf_internal rf_interned_str* rf__str_pool_find_hashed(rf_str_pool* pool, rf_str src, uint64_t hash)
+{
+    rf_hashmap_key key;
+    key.bytes.data = src.data;
+    key.bytes.size = src.size;
+
+    rf_interned_str** found = rf_hashmap_get_hashed(&pool->map, hash, key);
+    rf_interned_str* result = found ? *found : 0;
+    return result;
+}
+
+rf_internal rf_interned_str* rf__str_pool_copy(rf_str_pool* pool, rf_str src, uint64_t hash)
+{
+    rf_int size = sizeof(rf_interned_str) + src.size + 1;
+    rf_interned_str* result = pool->blocks ? rf_arena_alloc(&pool->blocks->arena, size) : 0;
+
+    if (!result)
+    {
+        // Strings bigger than a block get a block of their own
+        rf_int block_size = sizeof(rf_str_pool_block) + RF_ARENA_ALIGNMENT + rf_max_i(size, RF_STR_POOL_BLOCK_SIZE);
+        rf_str_pool_block* block = rf_alloc(pool->allocator, block_size);
+
+        if (!block)
+        {
+            rf_log_error(rf_bad_alloc, "Failed to allocate a string pool block of size %d", (int) block_size);
+            return 0;
+        }
+
+        block->next = pool->blocks;
+        block->arena = rf_arena_make(block + 1, block_size - sizeof(rf_str_pool_block));
+        pool->blocks = block;
+
+        result = rf_arena_alloc(&block->arena, size);
+    }
+
+    char* data = (char*)(result + 1);
+    memcpy(data, src.data, src.size);
+    data[src.size] = 0;
+
+    result->data = data;
+    result->size = src.size;
+    result->hash = hash;
+
+    return result;
+}
+
+rf_public rf_str_pool rf_str_pool_make(rf_bool thread_safe, rf_allocator allocator)
+{
+    rf_str_pool result = {0};
+    result.map = rf_hashmap_make(rf_hashmap_key_bytes, sizeof(rf_interned_str*), 0, allocator);
+    result.allocator = allocator;
+    result.thread_safe = thread_safe;
+    return result;
+}
+
+rf_public void rf_str_pool_free(rf_str_pool* pool)
+{
+    rf_hashmap_free(&pool->map);
+
+    while (pool->blocks)
+    {
+        rf_str_pool_block* next = pool->blocks->next;
+        rf_free(pool->allocator, pool->blocks);
+        pool->blocks = next;
+    }
+}
+
+rf_public const rf_interned_str* rf_str_pool_intern(rf_str_pool* pool, rf_str src)
+{
+    if (src.size < 0 || (!src.data && src.size)) return 0;
+
+    uint64_t hash = rf_str_hash(src);
+
+    rf__str_pool_lock(pool);
+
+    rf_interned_str* result = rf__str_pool_find_hashed(pool, src, hash);
+    if (!result)
+    {
+        result = rf__str_pool_copy(pool, src, hash);
+
+        if (result)
+        {
+            // Key the map with the pool's copy since src may not outlive the entry
+            rf_hashmap_key key;
+            key.bytes.data = result->data;
+            key.bytes.size = result->size;
+
+            // If the map can't grow the copy is leaked into the arena until the pool is freed, which is harmless
+            if (!rf_hashmap_put_hashed(&pool->map, hash, key, &result)) result = 0;
+        }
+    }
+
+    rf__str_pool_unlock(pool);
+
+    return result;
+}
+
+rf_public const rf_interned_str* rf_str_pool_intern_cstr(rf_str_pool* pool, const char* src)
+{
+    const rf_interned_str* result = rf_str_pool_intern(pool, rf_cstr(src));
+    return result;
+}
+
+rf_public const rf_interned_str* rf_str_pool_find(rf_str_pool* pool, rf_str src)
+{
+    uint64_t hash = rf_str_hash(src);
+
+    rf__str_pool_lock(pool);
+    const rf_interned_str* result = rf__str_pool_find_hashed(pool, src, hash);
+    rf__str_pool_unlock(pool);
+
+    return result;
+}
+
+rf_public rf_int rf_str_pool_count(rf_str_pool* pool)
+{
+    rf__str_pool_lock(pool);
+    rf_int result = pool->map.size;
+    rf__str_pool_unlock(pool);
+
+    return result;
+}
+#pragma endregion
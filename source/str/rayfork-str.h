@@ -5,6 +5,10 @@
 
 #define RF_INVALID_CODEPOINT '?' 
 
+#ifndef RF_STR_TWO_WAY_MIN_NEEDLE_SIZE
+    #define RF_STR_TWO_WAY_MIN_NEEDLE_SIZE (32) // Needles at least this long are searched with Two-Way instead of the SIMD filter, in both directions
+#endif
+
 typedef uint32_t rf_rune;
 typedef uint64_t rf_utf8_char;
 
@@ -37,18 +41,80 @@ typedef struct rf_str
     rf_int size;
 } rf_str;
 
+typedef struct rf_interned_str
+{
+    const char* data; // Null terminated
+    rf_int      size;
+    uint64_t    hash; // rf_str_hash of the string
+} rf_interned_str;
+
+typedef struct rf_str_pool_block
+{
+    struct rf_str_pool_block* next;
+    rf_arena                  arena;
+} rf_str_pool_block;
+
+/*
+ * Intern pool, every distinct string is copied once into arena blocks and returned as a stable rf_interned_str pointer,
+ * so interned strings can be compared by pointer and hashed for free. The strings live until the pool is freed.
+ * A thread-safe pool guards interning and lookups with a spin lock, the returned strings can be read from any thread without it.
+ */
+typedef struct rf_str_pool
+{
+    rf_hashmap         map; // rf_str keys pointing into the interned copies, the values are the rf_interned_str pointers
+    rf_str_pool_block* blocks;
+    rf_allocator       allocator;
+    rf_bool            thread_safe;
+    volatile rf_int    lock;
+} rf_str_pool;
+
 typedef struct rf_strbuf
 {
     char*        data;
     rf_int       size;
     rf_int       capacity;
     rf_allocator allocator;
+    rf_bool      owns_data; // False while the data is the buffer passed to rf_strbuf_make_on_buffer
     rf_bool      valid;
 } rf_strbuf;
 
+#ifndef RF_TEXTBUF_MIN_GAP
+    #define RF_TEXTBUF_MIN_GAP (256)
+#endif
+
+/*
+ * Gap buffer for editing text. The text after the cursor is kept at the end of the allocation so edits at the cursor only
+ * change the gap in between and are amortized O(1), moving the cursor moves the bytes it passes over.
+ * The starts of the lines are kept in an array with a gap at the cursor too, the ones after the cursor are stored as their
+ * distance to the end of the text so that edits don't have to update them.
+ * Offsets are in bytes, lines and columns start at 0 and columns count runes.
+ */
+typedef struct rf_textbuf
+{
+    char*        data;
+    rf_int       capacity;
+    rf_int       gap_begin; // The cursor
+    rf_int       gap_end;
+    rf_int*      line_starts; // Starts of every line but the first, the ones before the cursor from the front and the ones after it from the back
+    rf_int       line_starts_capacity;
+    rf_int       lines_before_cursor;
+    rf_int       lines_after_cursor;
+    rf_allocator allocator;
+    rf_bool      valid;
+} rf_textbuf;
+
+// A range of text in a textbuf, first followed by second. Second is only non empty if the range spans the cursor.
+typedef struct rf_textbuf_slice
+{
+    rf_str first;
+    rf_str second;
+} rf_textbuf_slice;
+
 #pragma region unicode
 rf_public rf_decoded_rune   rf_decode_utf8_char(const char* src, rf_int size);
 
+rf_public rf_bool           rf_validate_utf8(const char* src, rf_int size); // True if the whole input is valid UTF-8, validates whole blocks with SIMD when available
+
 rf_public rf_utf8_stats     rf_count_utf8_chars(const char* src, rf_int size);
 
 rf_public rf_utf8_stats     rf_count_utf8_chars_til(const char* src, rf_int size, rf_int n);
@@ -59,8 +125,8 @@ rf_public rf_decoded_string rf_decode_utf8(const char* src, rf_int size, rf_allo
 #pragma endregion
 
 #pragma region ascii
-rf_int rf_str_to_int(rf_str src);
-float rf_str_to_float(rf_str src);
+rf_public rf_int rf_str_to_int(rf_str src); // 0 if src doesn't start with a number, see rf_str_parse_int
+rf_public float rf_str_to_float(rf_str src);
 
 int rf_to_digit(char c);
 char rf_to_upper(char c);
@@ -75,9 +141,44 @@ rf_bool rf_is_alnum(char c);
 rf_bool rf_is_space(char c);
 #pragma endregion
 
+#pragma region format
+// printf compatible formatting without the libc locale path, returns the size the whole output needs like snprintf and null terminates dst if dst_size > 0
+rf_public rf_int rf_format_to_buffer(char* dst, rf_int dst_size, const char* format, ...);
+
+rf_public rf_int rf_format_to_buffer_v(char* dst, rf_int dst_size, const char* format, va_list args);
+#pragma endregion
+
+#pragma region numbers
+/*
+ * These skip leading spaces and return how many bytes of src make up the number, or 0 if it doesn't start with one.
+ * Floats are correctly rounded to nearest even, inf, infinity and nan are accepted in any case and values out of range become
+ * inf or 0 like with strtod. Integers saturate when they overflow.
+ */
+rf_public rf_int rf_str_parse_int(rf_str src, rf_int* dst);
+rf_public rf_int rf_str_parse_double(rf_str src, double* dst);
+rf_public rf_int rf_str_parse_float(rf_str src, float* dst);
+rf_public double rf_str_to_double(rf_str src);
+
+// Parse numbers separated by a delimiter into dst, a run of spaces counts as one delimiter if it is a space. Stops at the first field that isn't a number or when dst is full, returns how many were parsed.
+rf_public rf_int rf_str_parse_doubles(rf_str src, char delimiter, double* dst, rf_int dst_size);
+rf_public rf_int rf_str_parse_floats(rf_str src, char delimiter, float* dst, rf_int dst_size);
+
+// Write the shortest text that parses back to exactly the same value, in scientific notation for very big or small values. Return the size the whole output needs like snprintf.
+rf_public rf_int rf_format_double(char* dst, rf_int dst_size, double value);
+rf_public rf_int rf_format_float(char* dst, rf_int dst_size, float value);
+rf_public rf_int rf_format_int(char* dst, rf_int dst_size, int64_t value);
+#pragma endregion
+
 #pragma region strbuf
+// Declares a strbuf that starts out in a local array and only allocates once the contents outgrow it
+#define rf_strbuf_on_stack(name, stack_size, allocator) \
+    char rf_macro_var(name##_storage_)[stack_size]; \
+    rf_strbuf name = rf_strbuf_make_on_buffer(rf_macro_var(name##_storage_), (stack_size), (allocator))
+
 rf_public rf_strbuf rf_strbuf_make_ex(rf_int initial_amount, rf_allocator allocator);
 
+rf_public rf_strbuf rf_strbuf_make_on_buffer(char* buffer, rf_int buffer_size, rf_allocator allocator); // Uses the buffer until it is outgrown, then moves to memory from the allocator
+
 rf_public rf_strbuf rf_strbuf_clone_ex(rf_strbuf buf, rf_allocator allocator);
 
 rf_public rf_str rf_strbuf_to_str(rf_strbuf src);
@@ -90,9 +191,13 @@ rf_public void rf_strbuf_ensure_capacity_for(rf_strbuf* this_buf, rf_int size);
 
 rf_public void rf_strbuf_append(rf_strbuf* this_buf, rf_str it);
 
+rf_public void rf_strbuf_appendf(rf_strbuf* this_buf, const char* format, ...); // printf compatible, see rf_format_to_buffer
+
+rf_public void rf_strbuf_appendf_v(rf_strbuf* this_buf, const char* format, va_list args);
+
 rf_public void rf_strbuf_prepend(rf_strbuf* this_buf, rf_str it);
 
-rf_public void rf_strbuf_insert_utf8(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at);
+rf_public void rf_strbuf_insert_utf8(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at); // insert_at counts utf8 chars, 0 inserts at the front and past the last char appends
 
 rf_public void rf_strbuf_insert_b(rf_strbuf* this_buf, rf_str str_to_insert, rf_int insert_at);
 
@@ -103,6 +208,38 @@ rf_public void rf_strbuf_remove_range_b(rf_strbuf* this_buf, rf_int begin, rf_in
 rf_public void rf_strbuf_free(rf_strbuf* this_buf);
 #pragma endregion
 
+#pragma region textbuf
+rf_public rf_textbuf rf_textbuf_make(rf_int capacity, rf_allocator allocator);
+rf_public rf_textbuf rf_textbuf_make_from_str(rf_str text, rf_allocator allocator); // The cursor ends up at the end
+rf_public void rf_textbuf_free(rf_textbuf* this_buf);
+
+rf_public rf_int rf_textbuf_size(const rf_textbuf* this_buf);
+rf_public rf_int rf_textbuf_cursor(const rf_textbuf* this_buf);
+rf_public void rf_textbuf_set_cursor(rf_textbuf* this_buf, rf_int offset); // Clamped to the text, the caller keeps it on rune boundaries
+rf_public rf_int rf_textbuf_next_rune(const rf_textbuf* this_buf, rf_int offset);
+rf_public rf_int rf_textbuf_prev_rune(const rf_textbuf* this_buf, rf_int offset);
+
+// Edits return false and leave the text unchanged if an allocation fails
+rf_public rf_bool rf_textbuf_insert(rf_textbuf* this_buf, rf_str text); // At the cursor, the cursor ends up after the text
+rf_public rf_bool rf_textbuf_insert_at(rf_textbuf* this_buf, rf_str text, rf_int offset);
+rf_public rf_int rf_textbuf_delete_backward(rf_textbuf* this_buf, rf_int rune_count); // Like backspace, returns how many bytes were removed
+rf_public rf_int rf_textbuf_delete_forward(rf_textbuf* this_buf, rf_int rune_count); // Like delete, returns how many bytes were removed
+rf_public void rf_textbuf_remove_range(rf_textbuf* this_buf, rf_int begin, rf_int end); // The cursor ends up at begin unless the range is empty
+
+rf_public rf_int rf_textbuf_line_count(const rf_textbuf* this_buf);
+rf_public rf_int rf_textbuf_line_begin(const rf_textbuf* this_buf, rf_int line);
+rf_public rf_int rf_textbuf_line_end(const rf_textbuf* this_buf, rf_int line); // Offset of the line break or the end of the text
+rf_public rf_int rf_textbuf_line_at(const rf_textbuf* this_buf, rf_int offset); // O(log lines)
+rf_public rf_int rf_textbuf_column_at(const rf_textbuf* this_buf, rf_int offset);
+rf_public rf_int rf_textbuf_offset_at(const rf_textbuf* this_buf, rf_int line, rf_int column); // Clamped to the end of the line
+
+// Views into the buffer for rendering, they are invalidated by edits and cursor moves
+rf_public rf_textbuf_slice rf_textbuf_get_slice(const rf_textbuf* this_buf, rf_int begin, rf_int end);
+rf_public rf_textbuf_slice rf_textbuf_get_line(const rf_textbuf* this_buf, rf_int line); // Without the line break
+
+rf_public rf_strbuf rf_textbuf_to_strbuf(const rf_textbuf* this_buf, rf_allocator allocator);
+#pragma endregion
+
 #pragma region str
 rf_public rf_bool rf_str_valid(rf_str src);
 
@@ -130,9 +267,9 @@ rf_public rf_bool rf_str_match_suffix(rf_str, rf_str);
 
 rf_public rf_bool rf_str_match(rf_str, rf_str);
 
-rf_public rf_int rf_str_find_first(rf_str haystack, rf_str needle);
+rf_public rf_int rf_str_find_first(rf_str haystack, rf_str needle); // Returns the byte offset of the first match, SIMD filtered for short needles and Two-Way for long ones
 
-rf_public rf_int rf_str_find_last(rf_str haystack, rf_str needle);
+rf_public rf_int rf_str_find_last(rf_str haystack, rf_str needle); // Returns the byte offset at which the last match starts
 
 rf_public rf_bool rf_str_contains(rf_str, rf_str);
 
@@ -149,4 +286,30 @@ rf_public rf_str rf_str_pop_last_split(rf_str* src, rf_str split_by);
     for (;rf_str_valid(rf_macro_var(src_)); iter = rf_str_pop_first_split(&rf_macro_var(src_), rf_macro_var(split_by_)))
 #pragma endregion
 
+#pragma region str hash map
+// rf_str keyed wrappers over the rf_hashmap_key_bytes hash maps from core, the map doesn't copy the key so its data must outlive the entry
+#define rf_hashmap_get_str_as(T, map, key) ((T*) rf_hashmap_get_str((map), (key)))
+
+rf_public uint64_t rf_str_hash(rf_str src);
+
+rf_public void*   rf_hashmap_get_str(const rf_hashmap* map, rf_str key);
+rf_public void*   rf_hashmap_put_str(rf_hashmap* map, rf_str key, const void* value);
+rf_public rf_bool rf_hashmap_remove_str(rf_hashmap* map, rf_str key);
+#pragma endregion
+
+#pragma region str pool
+#ifndef RF_STR_POOL_BLOCK_SIZE
+    #define RF_STR_POOL_BLOCK_SIZE (16 * 1024)
+#endif
+
+#define rf_interned_str_to_str(interned) (rf_lit(rf_str) { (char*)(interned)->data, (interned)->size })
+
+rf_public rf_str_pool            rf_str_pool_make(rf_bool thread_safe, rf_allocator allocator);
+rf_public void                   rf_str_pool_free(rf_str_pool* pool);
+rf_public const rf_interned_str* rf_str_pool_intern(rf_str_pool* pool, rf_str src);       // Returns the same pointer for equal strings, null if the allocation failed
+rf_public const rf_interned_str* rf_str_pool_intern_cstr(rf_str_pool* pool, const char* src);
+rf_public const rf_interned_str* rf_str_pool_find(rf_str_pool* pool, rf_str src);         // Like rf_str_pool_intern but returns null instead of adding strings that aren't in the pool
+rf_public rf_int                 rf_str_pool_count(rf_str_pool* pool);
+#pragma endregion
+
 #endif // RAYFORK_STRBUF_H
\ No newline at end of file
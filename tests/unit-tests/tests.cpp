@@ -105,7 +105,7 @@ TEST_CASE("rf_str_find_last", "[str]")
     SECTION("The last \"\" should be on position 0 in \"\"")
     {
         rf_int pos = rf_str_find_last(rf_cstr(""), rf_cstr(""));
-        REQUIRE(pos == rf_invalid_index);
+        REQUIRE(pos == 0);
     }
     SECTION("The last \"bar\" should be on position 6 in \"Foobarbar\"")
     {
@@ -259,3 +259,1583 @@ TEST_CASE("rf_strbuf_insert_b", "[strbuf]")
         REQUIRE(rf_str_match(rf_strbuf_to_str(strbuf), rf_cstr("Fobaro")));
     }
 }
+
+TEST_CASE("rf_arena", "[allocator]")
+{
+    static char memory[1024];
+    rf_arena arena = rf_arena_make(memory, sizeof(memory));
+    rf_allocator allocator = rf_arena_allocator(&arena);
+
+    SECTION("Allocations should be aligned and bump the arena")
+    {
+        void* a = rf_alloc(allocator, 3);
+        void* b = rf_alloc(allocator, 8);
+        REQUIRE(a);
+        REQUIRE(b);
+        REQUIRE(((uintptr_t)b % RF_ARENA_ALIGNMENT) == 0);
+        REQUIRE((char*)b > (char*)a);
+    }
+    SECTION("Freeing the top allocation should give the memory back")
+    {
+        void* a = rf_alloc(allocator, 16);
+        rf_int used = arena.used;
+        void* b = rf_alloc(allocator, 64);
+        rf_free(allocator, b);
+        REQUIRE(arena.used == used);
+        rf_free(allocator, a); // Not the top allocation anymore, should be a no-op
+        REQUIRE(arena.used == used);
+    }
+    SECTION("Reallocating the top allocation should grow it in place")
+    {
+        char* a = (char*) rf_alloc(allocator, 16);
+        a[0] = 'x';
+        char* b = (char*) rf_realloc(allocator, a, 128, 16);
+        REQUIRE(a == b);
+        REQUIRE(b[0] == 'x');
+    }
+    SECTION("Allocations bigger than the arena should fail")
+    {
+        void* a = rf_alloc(allocator, 2048);
+        REQUIRE(a == 0);
+    }
+    SECTION("Restoring a mark should undo every allocation made after it")
+    {
+        rf_alloc(allocator, 16);
+        rf_arena_mark mark = rf_arena_get_mark(&arena);
+        rf_alloc(allocator, 100);
+        rf_alloc(allocator, 100);
+        rf_arena_restore(&arena, mark);
+        REQUIRE(arena.used == mark.used);
+
+        rf_arena_scope(&arena)
+        {
+            rf_alloc(allocator, 100);
+        }
+        REQUIRE(arena.used == mark.used);
+
+        rf_arena_reset(&arena);
+        REQUIRE(arena.used == 0);
+        REQUIRE(arena.high_water_mark > 200);
+    }
+}
+
+TEST_CASE("rf_pool_allocator", "[allocator]")
+{
+    static char memory[RF_POOL_SIZE_CLASS_COUNT * 256];
+    rf_size_class_pools pools = rf_size_class_pools_make(memory, sizeof(memory), rf_default_allocator);
+    rf_allocator allocator = rf_pool_allocator(&pools);
+
+    SECTION("Small allocations should come from the matching size class")
+    {
+        void* a = rf_alloc(allocator, 10);
+        void* b = rf_alloc(allocator, 100);
+        REQUIRE(rf_pool_owns(&pools.size_classes[0], a));
+        REQUIRE(rf_pool_owns(&pools.size_classes[3], b));
+    }
+    SECTION("Freed blocks should be reused")
+    {
+        void* a = rf_alloc(allocator, 16);
+        rf_free(allocator, a);
+        void* b = rf_alloc(allocator, 16);
+        REQUIRE(a == b);
+        REQUIRE(pools.size_classes[0].used_blocks == 1);
+    }
+    SECTION("Allocations bigger than every size class should use the fallback")
+    {
+        void* a = rf_alloc(allocator, 1 << 20);
+        REQUIRE(a);
+        REQUIRE(!rf_pool_owns(&pools.size_classes[RF_POOL_SIZE_CLASS_COUNT - 1], a));
+        rf_free(allocator, a);
+    }
+    SECTION("Reallocating should keep the contents when moving between size classes")
+    {
+        char* a = (char*) rf_alloc(allocator, 8);
+        a[0] = 'x';
+        char* b = (char*) rf_realloc(allocator, a, 12, 8);
+        REQUIRE(a == b);
+        char* c = (char*) rf_realloc(allocator, b, 60, 12);
+        REQUIRE(c != b);
+        REQUIRE(c[0] == 'x');
+        REQUIRE(pools.size_classes[0].used_blocks == 0);
+    }
+}
+
+TEST_CASE("rf_tracking_allocator", "[allocator]")
+{
+    static rf_allocation_tracker tracker;
+    rf_allocation_tracker_init(&tracker, rf_default_allocator);
+    rf_allocator allocator = rf_tracking_allocator(&tracker);
+
+    SECTION("Live and peak bytes should be tracked per call site")
+    {
+        void* a = rf_alloc(allocator, 100);
+        void* b = rf_alloc(allocator, 50);
+        REQUIRE(tracker.live_bytes == 150);
+        rf_free(allocator, a);
+        rf_free(allocator, b);
+        REQUIRE(tracker.live_bytes == 0);
+        REQUIRE(tracker.peak_live_bytes == 150);
+        REQUIRE(tracker.sites_count == 2);
+    }
+    SECTION("Reallocations should move the live bytes to the reallocating call site")
+    {
+        void* a = rf_alloc(allocator, 16);
+        a = rf_realloc(allocator, a, 64, 16);
+        REQUIRE(tracker.live_bytes == 64);
+
+        const rf_allocation_site_stats* sites[2];
+        rf_int count = rf_allocation_tracker_get_sorted_sites(&tracker, rf_allocation_sort_by_live_bytes, sites, 2);
+        REQUIRE(count == 2);
+        REQUIRE(sites[0]->live_bytes == 64);
+        REQUIRE(sites[0]->realloc_count == 1);
+        REQUIRE(sites[1]->live_bytes == 0);
+        rf_free(allocator, a);
+    }
+    SECTION("Known call sites should keep their stats once the table is full")
+    {
+        rf_source_location known = { "known.c", "known", 1 };
+        rf_allocator_args args = { 0, 32, 0 };
+
+        void* first = rf_tracking_allocator_proc(&allocator, known, rf_allocator_mode_alloc, args);
+
+        // Every filler site past the limit lands in the overflow site
+        static void* fillers[RF_TRACKING_ALLOCATOR_MAX_SITES * 2];
+        for (rf_int i = 0; i < RF_TRACKING_ALLOCATOR_MAX_SITES * 2; i++)
+        {
+            rf_source_location filler = { "filler.c", "filler", 100 + i };
+            fillers[i] = rf_tracking_allocator_proc(&allocator, filler, rf_allocator_mode_alloc, args);
+        }
+        REQUIRE(tracker.sites_count == RF_TRACKING_ALLOCATOR_MAX_SITES);
+
+        void* second = rf_tracking_allocator_proc(&allocator, known, rf_allocator_mode_alloc, args);
+
+        const rf_allocation_site_stats* sites[RF_TRACKING_ALLOCATOR_MAX_SITES];
+        rf_int count = rf_allocation_tracker_get_sorted_sites(&tracker, rf_allocation_sort_by_alloc_count, sites, RF_TRACKING_ALLOCATOR_MAX_SITES);
+        REQUIRE(count == RF_TRACKING_ALLOCATOR_MAX_SITES);
+        REQUIRE(strcmp(sites[0]->source_location.file_name, "<overflow>") == 0);
+        REQUIRE(sites[0]->alloc_count == RF_TRACKING_ALLOCATOR_MAX_SITES + 2);
+
+        const rf_allocation_site_stats* known_site = 0;
+        for (rf_int i = 0; i < count; i++) if (strcmp(sites[i]->source_location.file_name, "known.c") == 0) known_site = sites[i];
+        REQUIRE(known_site);
+        REQUIRE(known_site->alloc_count == 2);
+        REQUIRE(known_site->live_bytes == 64);
+
+        rf_allocator_args free_args = { first, 0, 0 };
+        rf_tracking_allocator_proc(&allocator, known, rf_allocator_mode_free, free_args);
+        free_args.pointer_to_free_or_realloc = second;
+        rf_tracking_allocator_proc(&allocator, known, rf_allocator_mode_free, free_args);
+        REQUIRE(known_site->live_bytes == 0);
+
+        for (rf_int i = 0; i < RF_TRACKING_ALLOCATOR_MAX_SITES * 2; i++) rf_free(allocator, fillers[i]);
+        REQUIRE(tracker.live_bytes == 0);
+        REQUIRE(sites[0]->live_bytes == 0);
+    }
+    SECTION("The csv report should contain one row per call site")
+    {
+        void* a = rf_alloc(allocator, 16);
+        static char report[4096];
+        rf_int size = rf_allocation_tracker_csv_to_buffer(&tracker, rf_allocation_sort_by_total_bytes, report, sizeof(report));
+        rf_int rows = 0;
+        for (rf_int i = 0; i < size; i++) rows += report[i] == '\n';
+        REQUIRE(rows == 2);
+        rf_free(allocator, a);
+    }
+}
+
+TEST_CASE("rf frame allocators", "[allocator]")
+{
+    // rf_end only calls into the gfx backend when the batch has vertices, so an empty batch lets it run without a gpu
+    static rf_gfx_context ctx;
+    static rf_vertex_buffer vertex_buffer;
+    static rf_render_batch batch;
+    batch.vertex_buffers_count = 1;
+    batch.vertex_buffers = &vertex_buffer;
+    rf_set_global_gfx_context_pointer(&ctx);
+    rf_set_active_render_batch(&batch);
+
+    alignas(RF_ARENA_ALIGNMENT) static char frame_memory[256];
+    alignas(RF_ARENA_ALIGNMENT) static char double_buffered_memory[512];
+    rf_set_frame_allocator_memory(frame_memory, sizeof(frame_memory), double_buffered_memory, sizeof(double_buffered_memory));
+
+    // Frame 0
+    rf_allocator frame = rf_get_frame_allocator();
+    rf_allocator double_buffered = rf_get_double_buffered_frame_allocator();
+    char* scratch_0 = (char*) rf_alloc(frame, 64);
+    char* kept_0 = (char*) rf_alloc(double_buffered, 48);
+    REQUIRE(scratch_0 == frame_memory);
+    REQUIRE(kept_0 == double_buffered_memory);
+    strcpy(kept_0, "frame 0");
+
+    rf_frame_allocator_stats stats = rf_get_frame_allocator_stats();
+    REQUIRE(stats.frame_used == 64);
+    REQUIRE(stats.frame_high_water_mark == 64);
+    REQUIRE(stats.double_buffered_used == 48);
+    REQUIRE(stats.double_buffered_high_water_mark == 48);
+
+    rf_end();
+
+    // Frame 1, the frame arena starts over while the double buffered memory of frame 0 is still there
+    stats = rf_get_frame_allocator_stats();
+    REQUIRE(stats.frame_used == 0);
+    REQUIRE(stats.frame_high_water_mark == 64);
+    REQUIRE(stats.double_buffered_used == 0);
+    REQUIRE(stats.double_buffered_high_water_mark == 48);
+
+    frame = rf_get_frame_allocator();
+    double_buffered = rf_get_double_buffered_frame_allocator();
+    char* scratch_1 = (char*) rf_alloc(frame, 100);
+    char* kept_1 = (char*) rf_alloc(double_buffered, 128);
+    REQUIRE(scratch_1 == frame_memory);
+    REQUIRE(kept_1 == double_buffered_memory + sizeof(double_buffered_memory) / 2);
+    strcpy(kept_1, "frame 1");
+    REQUIRE(strcmp(kept_0, "frame 0") == 0);
+    REQUIRE(rf_alloc(double_buffered, 256) == 0); // Each frame only gets half of the double buffered memory
+
+    stats = rf_get_frame_allocator_stats();
+    REQUIRE(stats.frame_used == 100);
+    REQUIRE(stats.frame_high_water_mark == 100);
+    REQUIRE(stats.double_buffered_used == 128);
+    REQUIRE(stats.double_buffered_high_water_mark == 128);
+
+    rf_end();
+
+    // Frame 2, the memory of frame 0 is handed out again and only frame 1 survives
+    double_buffered = rf_get_double_buffered_frame_allocator();
+    char* kept_2 = (char*) rf_alloc(double_buffered, 16);
+    REQUIRE(kept_2 == kept_0);
+    strcpy(kept_2, "frame 2");
+    REQUIRE(strcmp(kept_1, "frame 1") == 0);
+
+    stats = rf_get_frame_allocator_stats();
+    REQUIRE(stats.frame_used == 0);
+    REQUIRE(stats.frame_high_water_mark == 100);
+    REQUIRE(stats.double_buffered_used == 16);
+    REQUIRE(stats.double_buffered_high_water_mark == 128);
+
+    rf_end();
+
+    // Frame 3, frame 1's half is reset in turn
+    REQUIRE(rf_get_frame_allocator_stats().double_buffered_used == 0);
+    double_buffered = rf_get_double_buffered_frame_allocator();
+    REQUIRE(rf_alloc(double_buffered, 16) == kept_1);
+    REQUIRE(strcmp(kept_2, "frame 2") == 0);
+
+    rf_set_global_gfx_context_pointer(0);
+}
+
+TEST_CASE("rf_view_file", "[io]")
+{
+    const char* filename = ASSETS_PATH "bmfont.fnt";
+
+    SECTION("Mapped and read views of the same file should have the same contents")
+    {
+        rf_file_view mapped = rf_view_file(rf_mmap_io, filename, rf_default_allocator);
+        rf_file_view read   = rf_view_file(rf_default_io, filename, rf_default_allocator);
+
+        REQUIRE(mapped.valid);
+        REQUIRE(read.valid);
+        REQUIRE(!read.mapped);
+        REQUIRE(mapped.size == rf_mmap_get_file_size(0, filename));
+        REQUIRE(mapped.size == read.size);
+        REQUIRE(memcmp(mapped.data, read.data, read.size) == 0);
+
+        rf_release_file_view(rf_mmap_io, mapped, rf_default_allocator);
+        rf_release_file_view(rf_default_io, read, rf_default_allocator);
+    }
+}
+
+TEST_CASE("rf_libc_stream", "[io]")
+{
+    const char* filename = ASSETS_PATH "bmfont.fnt";
+    rf_io_callbacks io = rf_default_io;
+    rf_file_view file = rf_view_file(io, filename, rf_default_allocator);
+    REQUIRE(file.valid);
+    REQUIRE(rf_io_supports_streams(io));
+
+    void* stream = rf_open_stream(io, filename);
+    REQUIRE(stream);
+
+    SECTION("Reading after a seek should return the bytes at that offset")
+    {
+        char buffer[8];
+        REQUIRE(rf_seek_stream(io, stream, 4, rf_io_seek_set));
+        REQUIRE(rf_read_stream(io, stream, buffer, sizeof(buffer)) == sizeof(buffer));
+        REQUIRE(memcmp(buffer, (const char*) file.data + 4, sizeof(buffer)) == 0);
+    }
+    SECTION("Reading past the end should return less bytes than requested")
+    {
+        char buffer[8];
+        REQUIRE(rf_seek_stream(io, stream, -4, rf_io_seek_end));
+        REQUIRE(rf_read_stream(io, stream, buffer, sizeof(buffer)) == 4);
+    }
+
+    rf_close_stream(io, stream);
+    rf_release_file_view(io, file, rf_default_allocator);
+}
+
+TEST_CASE("rf_pack", "[pack]")
+{
+    static char repeated[4096];
+    for (int i = 0; i < sizeof(repeated); i++) repeated[i] = "rayfork"[i % 7];
+
+    rf_pack_source sources[] = {
+        { "textures/cat.txt", "meow", 4, 0 },
+        { "./shaders\\base.glsl", repeated, sizeof(repeated), 1 },
+        { "empty", "", 0, 0 },
+    };
+
+    rf_int bound = rf_pack_build_bound(sources, 3, 0);
+    char* archive = (char*) malloc(bound);
+    rf_int size = rf_pack_build_to_buffer(sources, 3, 0, archive, bound);
+    REQUIRE(size > 0);
+    REQUIRE(size <= bound);
+
+    rf_pack pack = rf_pack_open_from_memory(archive, size);
+    REQUIRE(pack.valid);
+    REQUIRE(pack.entry_count == 3);
+
+    SECTION("Entries should be found by path regardless of the separator used")
+    {
+        REQUIRE(rf_pack_find(&pack, "textures/cat.txt"));
+        REQUIRE(rf_pack_find(&pack, "textures\\cat.txt"));
+        REQUIRE(rf_pack_find(&pack, "shaders/base.glsl"));
+        REQUIRE(rf_pack_find(&pack, "empty"));
+        REQUIRE(!rf_pack_find(&pack, "textures/dog.txt"));
+    }
+    SECTION("Compressed entries should be smaller and read back to their original contents")
+    {
+        const rf_pack_entry* entry = rf_pack_find(&pack, "shaders/base.glsl");
+        REQUIRE(entry->compression == rf_pack_compression_lz4);
+        REQUIRE(entry->stored_size < entry->original_size);
+
+        static char dst[sizeof(repeated)];
+        REQUIRE(rf_pack_read_entry(&pack, entry, dst, sizeof(dst)));
+        REQUIRE(memcmp(dst, repeated, sizeof(repeated)) == 0);
+    }
+    SECTION("rf_pack_io should view uncompressed entries without copying them")
+    {
+        rf_file_view view = rf_view_file(rf_pack_io(&pack), "textures/cat.txt", rf_default_allocator);
+        REQUIRE(view.valid);
+        REQUIRE(view.mapped);
+        REQUIRE(view.size == 4);
+        REQUIRE(memcmp(view.data, "meow", 4) == 0);
+        rf_release_file_view(rf_pack_io(&pack), view, rf_default_allocator);
+    }
+    SECTION("The header and index should be stored little endian")
+    {
+        const unsigned char* bytes = (const unsigned char*) archive;
+        REQUIRE(memcmp(bytes, RF_PACK_MAGIC, 4) == 0);
+        REQUIRE((bytes[4] == RF_PACK_VERSION && bytes[5] == 0 && bytes[6] == 0 && bytes[7] == 0));
+        REQUIRE((bytes[8] == 3 && bytes[9] == 0 && bytes[10] == 0 && bytes[11] == 0));
+    }
+    SECTION("Archives opened through a stream should decode their index and read entries at their offsets")
+    {
+        const char* filename = "rf_pack_test.rfpk";
+        REQUIRE(rf_libc_write_file(0, filename, archive, size));
+
+        rf_pack streamed = rf_pack_open_file(filename, rf_default_io, rf_default_allocator);
+        REQUIRE(streamed.valid);
+        REQUIRE(streamed.stream);
+
+        static char dst[sizeof(repeated)];
+        REQUIRE(rf_pack_load_file_into_buffer(&streamed, "shaders/base.glsl", dst, sizeof(dst)));
+        REQUIRE(memcmp(dst, repeated, sizeof(repeated)) == 0);
+        REQUIRE(rf_pack_get_file_size(&streamed, "textures/cat.txt") == 4);
+
+        rf_pack_close(&streamed);
+        remove(filename);
+    }
+    SECTION("Archives with index entries pointing outside of the archive should be rejected")
+    {
+        rf_int entry_offset = (const char*) rf_pack_find(&pack, "textures/cat.txt") - archive;
+        char* corrupt = (char*) malloc(size);
+
+        auto open_corrupted = [&](void (*corrupt_entry)(rf_pack_entry*, rf_int)) -> rf_bool
+        {
+            memcpy(corrupt, archive, size);
+            corrupt_entry((rf_pack_entry*) (corrupt + entry_offset), size);
+            rf_pack corrupt_pack = rf_pack_open_from_memory(corrupt, size);
+            rf_pack_close(&corrupt_pack);
+            return corrupt_pack.valid;
+        };
+
+        REQUIRE(!open_corrupted([](rf_pack_entry* entry, rf_int size) { entry->data_offset = size - 2; }));
+        REQUIRE(!open_corrupted([](rf_pack_entry* entry, rf_int size) { entry->data_offset = UINT64_MAX - 1; }));
+        REQUIRE(!open_corrupted([](rf_pack_entry* entry, rf_int size) { entry->path_offset = (uint32_t) size; }));
+        REQUIRE(!open_corrupted([](rf_pack_entry* entry, rf_int size) { entry->original_size = entry->stored_size + 1; }));
+        REQUIRE(!open_corrupted([](rf_pack_entry* entry, rf_int size) { entry->path_size = 0; })); // One less entry than the header says
+
+        free(corrupt);
+    }
+    SECTION("Malformed lz4 data should be rejected")
+    {
+        const unsigned char bad[] = { 0x0f, 0x01, 0x00 };
+        char dst[64];
+        REQUIRE(rf_lz4_decompress_to_buffer(bad, sizeof(bad), dst, sizeof(dst)) == rf_invalid_index);
+    }
+
+    rf_pack_close(&pack);
+    free(archive);
+}
+
+static void rf_test_square_batch(void* data, rf_int begin, rf_int end)
+{
+    rf_int* values = (rf_int*) data;
+    for (rf_int i = begin; i < end; i++) values[i] = i * i;
+}
+
+static void rf_test_increment_job(void* data)
+{
+    rf_int* value = (rf_int*) data;
+    *value += 1;
+}
+
+static void rf_test_double_job(void* data)
+{
+    rf_int* value = (rf_int*) data;
+    *value *= 2;
+}
+
+static void rf_test_parallel_for(rf_job_scheduler scheduler)
+{
+    static rf_int values[10000];
+    memset(values, 0, sizeof(values));
+
+    rf_parallel_for(scheduler, 0, 10000, 16, rf_test_square_batch, values);
+
+    for (rf_int i = 0; i < 10000; i++) REQUIRE(values[i] == i * i);
+}
+
+static void rf_test_job_dependencies(rf_job_scheduler scheduler)
+{
+    rf_int values[64] = {0};
+    rf_job first[64];
+    rf_job second[64];
+    rf_job_counter first_counter = {0};
+    rf_job_counter second_counter = {0};
+
+    for (int i = 0; i < 64; i++)
+    {
+        first[i]  = { rf_test_increment_job, &values[i], &first_counter, 0 };
+        second[i] = { rf_test_double_job, &values[i], &second_counter, &first_counter };
+    }
+
+    rf_submit_jobs(scheduler, first, 64);
+    rf_submit_jobs(scheduler, second, 64);
+    rf_wait_for_counter(scheduler, &second_counter);
+
+    REQUIRE(rf_job_counter_done(&first_counter));
+    for (int i = 0; i < 64; i++) REQUIRE(values[i] == 2);
+}
+
+// Runs jobs right away like the immediate scheduler but claims more workers than rf_parallel_for has room for
+static rf_int rf_test_many_workers_count(void* user_data)
+{
+    (void) user_data;
+    return RF_JOBS_MAX_WORKERS * 4;
+}
+
+static void rf_test_many_workers_submit(void* user_data, const rf_job* jobs, rf_int jobs_count)
+{
+    rf_int* max_jobs_count = (rf_int*) user_data;
+    if (jobs_count > *max_jobs_count) *max_jobs_count = jobs_count;
+    rf_immediate_submit(0, jobs, jobs_count);
+}
+
+TEST_CASE("rf_jobs", "[jobs]")
+{
+    rf_job_system system;
+    REQUIRE(rf_job_system_init(&system, 3, rf_default_allocator));
+
+    SECTION("rf_parallel_for should visit every index exactly once")
+    {
+        rf_test_parallel_for(rf_job_system_scheduler(&system));
+        rf_test_parallel_for(rf_immediate_scheduler);
+    }
+    SECTION("rf_parallel_for should work with schedulers reporting more than RF_JOBS_MAX_WORKERS workers")
+    {
+        rf_int max_jobs_count = 0;
+        rf_job_scheduler scheduler = { &max_jobs_count, rf_test_many_workers_submit, rf_immediate_help, rf_test_many_workers_count };
+
+        rf_test_parallel_for(scheduler);
+        REQUIRE(max_jobs_count == RF_JOBS_MAX_WORKERS);
+    }
+    SECTION("Jobs should only start once their dependency is done")
+    {
+        rf_test_job_dependencies(rf_job_system_scheduler(&system));
+        rf_test_job_dependencies(rf_immediate_scheduler);
+    }
+
+    rf_job_system_shutdown(&system);
+}
+
+static void rf_test_count_log_message(void* user_data, const rf_log_message* message)
+{
+    rf_int* count = (rf_int*) user_data;
+    *count += 1 + message->suppressed_count;
+}
+
+TEST_CASE("rf_async_logger", "[logger]")
+{
+    rf_int written = 0;
+    rf_async_logger async_logger;
+    REQUIRE(rf_async_logger_init(&async_logger, 100, rf_test_count_log_message, &written, rf_default_allocator));
+    REQUIRE(async_logger.capacity == 128);
+
+    rf_logger previous_logger = rf_get_logger();
+    rf_log_type previous_filter = rf_get_log_filter();
+    rf_set_logger(rf_async_logger(&async_logger));
+    rf_set_logger_filter(rf_log_type_all);
+
+    SECTION("Every message should be written once the logger is flushed")
+    {
+        async_logger.rate_limit = 0;
+        for (int i = 0; i < 64; i++) rf_log(rf_log_type_info, "Message %d", i);
+        rf_async_logger_flush(&async_logger);
+        REQUIRE(written == 64);
+    }
+    SECTION("A call site should be rate limited")
+    {
+        async_logger.rate_limit = 4;
+        for (int i = 0; i < 64; i++) rf_log(rf_log_type_info, "Message %d", i);
+        rf_async_logger_flush(&async_logger);
+        REQUIRE(written == 4);
+    }
+
+    rf_set_logger(previous_logger);
+    rf_set_logger_filter(previous_filter);
+    rf_async_logger_shutdown(&async_logger);
+}
+
+TEST_CASE("rf_rand", "[rng]")
+{
+    SECTION("Generators with the same seed should give the same numbers")
+    {
+        rf_rand a = rf_rand_make(1234);
+        rf_rand b = rf_rand_make(1234);
+        for (int i = 0; i < 100; i++) REQUIRE(rf_rand_next(&a) == rf_rand_next(&b));
+
+        uint32_t bulk_a[37], bulk_b[37];
+        rf_rand_fill_u32(&a, bulk_a, 37);
+        rf_rand_fill_u32(&b, bulk_b, 37);
+        REQUIRE(memcmp(bulk_a, bulk_b, sizeof(bulk_a)) == 0);
+    }
+    SECTION("Ranges should be inclusive and stay in bounds")
+    {
+        rf_rand rng = rf_rand_make(99);
+        int seen[7] = {0};
+        int values[1000];
+        rf_rand_fill_range(&rng, values, 1000, -3, 3);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            REQUIRE(values[i] >= -3);
+            REQUIRE(values[i] <= 3);
+            seen[values[i] + 3] = 1;
+
+            rf_int value = rf_rand_range(&rng, 10, 12);
+            REQUIRE(value >= 10);
+            REQUIRE(value <= 12);
+        }
+
+        for (int i = 0; i < 7; i++) REQUIRE(seen[i]);
+    }
+    SECTION("Floats should be in [0, 1)")
+    {
+        rf_rand rng = rf_rand_make(7);
+        float values[1001];
+        rf_rand_fill_float(&rng, values, 1001);
+        for (int i = 0; i < 1001; i++)
+        {
+            REQUIRE(values[i] >= 0.0f);
+            REQUIRE(values[i] < 1.0f);
+        }
+
+        // Same stream as rf_rand_fill_u32, keeping the top 24 bits
+        rf_rand bits_rng = rf_rand_make(7);
+        static uint32_t bits[1001];
+        rf_rand_fill_u32(&bits_rng, bits, 1001);
+        for (int i = 0; i < 1001; i++) REQUIRE(values[i] == (float)(bits[i] >> 8) / 16777216.0f);
+    }
+}
+
+static void rf_test_append_trace(void* user_data, const char* data, rf_int size)
+{
+    std::string* trace = (std::string*) user_data;
+    trace->append(data, size);
+}
+
+TEST_CASE("rf_profiler", "[profiler]")
+{
+    rf_profiler_init(rf_default_allocator);
+
+    // Call the functions directly since the zone macros compile out unless rayfork_enable_profiler is defined
+    rf__profile_zone_begin("outer");
+    for (int i = 0; i < 3; i++)
+    {
+        rf__profile_zone_begin("inner");
+        rf__profile_zone_end();
+    }
+    rf__profile_zone_end();
+
+    std::string trace;
+    REQUIRE(rf_profiler_flush_chrome_trace(rf_test_append_trace, &trace) == 4);
+    REQUIRE(trace.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(trace.find("\"name\":\"outer\"") != std::string::npos);
+
+    SECTION("Flushing again should only write new zones")
+    {
+        std::string empty_trace;
+        REQUIRE(rf_profiler_flush_chrome_trace(rf_test_append_trace, &empty_trace) == 0);
+    }
+
+    rf_profiler_shutdown();
+}
+
+TEST_CASE("rf_arr", "[arr]")
+{
+    rf_arr(int) arr = rf_arr_make(int, 0, rf_default_allocator);
+    REQUIRE(arr);
+    REQUIRE(rf_arr_size(arr) == 0);
+
+    SECTION("Adding elements should grow the array and keep them in order")
+    {
+        for (int i = 0; i < 1000; i++) REQUIRE(rf_arr_add(arr, i));
+
+        REQUIRE(rf_arr_size(arr) == 1000);
+        REQUIRE(rf_arr_capacity(arr) >= 1000);
+        for (int i = 0; i < 1000; i++) REQUIRE(arr[i] == i);
+
+        REQUIRE(rf_arr_shrink_to_fit(arr));
+        REQUIRE(rf_arr_capacity(arr) == 1000);
+        REQUIRE(rf_arr_last(arr) == 999);
+    }
+    SECTION("Bulk insertion and removal should shift the tail")
+    {
+        const int values[] = { 0, 1, 2, 3, 4 };
+        const int middle[] = { 7, 8 };
+        REQUIRE(rf_arr_add_n(arr, values, 5));
+        REQUIRE(rf_arr_insert_n(arr, 2, middle, 2));
+        REQUIRE(rf_arr_insert(arr, 0, -1));
+
+        const int expected[] = { -1, 0, 1, 7, 8, 2, 3, 4 };
+        REQUIRE(rf_arr_size(arr) == 8);
+        REQUIRE(memcmp(arr, expected, sizeof(expected)) == 0);
+
+        rf_arr_remove_range(arr, 3, 2);
+        rf_arr_remove_ordered(arr, 0);
+        const int expected_after_remove[] = { 0, 1, 2, 3, 4 };
+        REQUIRE(rf_arr_size(arr) == 5);
+        REQUIRE(memcmp(arr, expected_after_remove, sizeof(expected_after_remove)) == 0);
+
+        rf_arr_remove_unordered(arr, 1);
+        REQUIRE(rf_arr_size(arr) == 4);
+        REQUIRE(arr[1] == 4);
+    }
+    SECTION("Inserting elements of the array into itself should copy the original values")
+    {
+        const int values[] = { 0, 1, 2, 3 };
+        REQUIRE(rf_arr_add_n(arr, values, 4));
+        REQUIRE(rf_arr_shrink_to_fit(arr));
+        REQUIRE(rf_arr_insert_n(arr, 1, arr, 4));
+
+        const int expected[] = { 0, 0, 1, 2, 3, 1, 2, 3 };
+        REQUIRE(memcmp(arr, expected, sizeof(expected)) == 0);
+    }
+    SECTION("Resizing should zero the new elements")
+    {
+        REQUIRE(rf_arr_resize(arr, 16));
+        for (int i = 0; i < 16; i++) REQUIRE(arr[i] == 0);
+    }
+
+    rf_arr_free(arr);
+    REQUIRE(arr == nullptr);
+}
+
+TEST_CASE("rf_hashmap", "[hashmap]")
+{
+    SECTION("Integer keys should survive growing and removal")
+    {
+        rf_hashmap map = rf_hashmap_make(rf_hashmap_key_u64, sizeof(int), 0, rf_default_allocator);
+
+        for (int i = 0; i < 5000; i++)
+        {
+            int value = i * 3;
+            REQUIRE(rf_hashmap_put_u64(&map, (uint64_t) i * 7919, &value));
+        }
+
+        REQUIRE(map.size == 5000);
+        for (int i = 0; i < 5000; i++)
+        {
+            int* value = rf_hashmap_get_as(int, &map, (uint64_t) i * 7919);
+            REQUIRE(value);
+            REQUIRE(*value == i * 3);
+        }
+        REQUIRE(!rf_hashmap_get_u64(&map, 1));
+
+        // Remove every other key, the rest must still be reachable after the backward shifts
+        for (int i = 0; i < 5000; i += 2) REQUIRE(rf_hashmap_remove_u64(&map, (uint64_t) i * 7919));
+        REQUIRE(!rf_hashmap_remove_u64(&map, 0));
+        REQUIRE(map.size == 2500);
+
+        for (int i = 0; i < 5000; i++)
+        {
+            int* value = rf_hashmap_get_as(int, &map, (uint64_t) i * 7919);
+            if (i % 2) REQUIRE((value && *value == i * 3));
+            else REQUIRE(!value);
+        }
+
+        rf_int used_slots = 0;
+        for (rf_int i = 0; i < map.capacity; i++) used_slots += rf_hashmap_slot_is_used(&map, i);
+        REQUIRE(used_slots == 2500);
+
+        rf_hashmap_free(&map);
+    }
+    SECTION("Putting an existing key should overwrite its value")
+    {
+        rf_hashmap map = rf_hashmap_make(rf_hashmap_key_u64, sizeof(int), 4, rf_default_allocator);
+
+        int a = 1, b = 2;
+        rf_hashmap_put_u64(&map, 42, &a);
+        rf_hashmap_put_u64(&map, 42, &b);
+        REQUIRE(map.size == 1);
+        REQUIRE(*rf_hashmap_get_as(int, &map, 42) == 2);
+
+        rf_hashmap_clear(&map);
+        REQUIRE(map.size == 0);
+        REQUIRE(!rf_hashmap_get_u64(&map, 42));
+
+        rf_hashmap_free(&map);
+    }
+    SECTION("String keys should compare by content")
+    {
+        rf_hashmap map = rf_hashmap_make(rf_hashmap_key_bytes, sizeof(int), 0, rf_default_allocator);
+
+        const char* names[] = { "position", "normal", "texcoord", "color", "tangent" };
+        for (int i = 0; i < 5; i++) rf_hashmap_put_str(&map, rf_cstr(names[i]), &i);
+
+        char key[] = "texcoord";
+        int* value = rf_hashmap_get_str_as(int, &map, rf_cstr(key));
+        REQUIRE(value);
+        REQUIRE(*value == 2);
+        REQUIRE(!rf_hashmap_get_str(&map, rf_cstr("texcoor")));
+        REQUIRE(rf_str_hash(rf_cstr("color")) == rf_hash_bytes("color", 5));
+
+        REQUIRE(rf_hashmap_remove_str(&map, rf_cstr("normal")));
+        REQUIRE(!rf_hashmap_get_str(&map, rf_cstr("normal")));
+        REQUIRE(*rf_hashmap_get_str_as(int, &map, rf_cstr("tangent")) == 4);
+
+        rf_hashmap_free(&map);
+    }
+}
+
+TEST_CASE("rf_str_pool", "[str]")
+{
+    rf_str_pool pool = rf_str_pool_make(1, rf_default_allocator);
+
+    char bone_name[32] = "spine_01";
+    const rf_interned_str* a = rf_str_pool_intern(&pool, rf_cstr(bone_name));
+    const rf_interned_str* b = rf_str_pool_intern_cstr(&pool, "spine_01");
+    const rf_interned_str* c = rf_str_pool_intern_cstr(&pool, "spine_02");
+
+    SECTION("Equal strings should intern to the same pointer")
+    {
+        REQUIRE(a);
+        REQUIRE(a == b);
+        REQUIRE(a != c);
+        REQUIRE(a->data != bone_name);
+        REQUIRE(strcmp(a->data, "spine_01") == 0);
+        REQUIRE(a->hash == rf_str_hash(rf_cstr("spine_01")));
+        REQUIRE(rf_str_match(rf_interned_str_to_str(c), rf_cstr("spine_02")));
+        REQUIRE(rf_str_pool_count(&pool) == 2);
+    }
+    SECTION("Interned strings should stay valid as the pool grows")
+    {
+        char name[64];
+        for (int i = 0; i < 4000; i++)
+        {
+            snprintf(name, sizeof(name), "material_%d", i);
+            REQUIRE(rf_str_pool_intern_cstr(&pool, name));
+        }
+
+        // Bigger than a block
+        static char big[RF_STR_POOL_BLOCK_SIZE * 2];
+        memset(big, 'x', sizeof(big) - 1);
+        const rf_interned_str* big_interned = rf_str_pool_intern_cstr(&pool, big);
+        REQUIRE(big_interned);
+        REQUIRE(big_interned->size == sizeof(big) - 1);
+
+        REQUIRE(rf_str_pool_count(&pool) == 4003);
+        REQUIRE(strcmp(a->data, "spine_01") == 0);
+        REQUIRE(rf_str_pool_find(&pool, rf_cstr("material_1234")) == rf_str_pool_intern_cstr(&pool, "material_1234"));
+        REQUIRE(!rf_str_pool_find(&pool, rf_cstr("material_4000")));
+    }
+
+    rf_str_pool_free(&pool);
+}
+
+TEST_CASE("rf_str_find matches a naive search", "[str]")
+{
+    rf_rand rng = rf_rand_make(15);
+
+    // Small alphabets make partial matches and periodic needles common, which exercises the verification and Two-Way paths
+    for (int iteration = 0; iteration < 2000; iteration++)
+    {
+        int alphabet = 2 + (int) rf_rand_range(&rng, 0, 2);
+        std::string haystack, needle;
+
+        rf_int haystack_size = rf_rand_range(&rng, 0, 300);
+        rf_int needle_size = iteration % 4 == 0 ? rf_rand_range(&rng, 32, 80) : rf_rand_range(&rng, 1, 12);
+        for (rf_int i = 0; i < haystack_size; i++) haystack += (char)('a' + rf_rand_range(&rng, 0, alphabet - 1));
+        for (rf_int i = 0; i < needle_size; i++) needle += (char)('a' + rf_rand_range(&rng, 0, alphabet - 1));
+
+        // Plant the needle sometimes so long needles get found too
+        if (iteration % 3 == 0 && needle.size() <= haystack.size())
+        {
+            haystack.replace(rf_rand_range(&rng, 0, haystack.size() - needle.size()), needle.size(), needle);
+        }
+
+        rf_str h = { (char*) haystack.data(), (rf_int) haystack.size() };
+        rf_str n = { (char*) needle.data(), (rf_int) needle.size() };
+
+        size_t first = haystack.find(needle);
+        size_t last = haystack.rfind(needle);
+        REQUIRE(rf_str_find_first(h, n) == (first == std::string::npos ? rf_invalid_index : (rf_int) first));
+        REQUIRE(rf_str_find_last(h, n) == (last == std::string::npos ? rf_invalid_index : (rf_int) last));
+    }
+}
+
+TEST_CASE("rf_str_pop_last_split", "[str]")
+{
+    rf_str src = rf_cstr("assets/models/robot.glb");
+    rf_str file = rf_str_pop_last_split(&src, rf_cstr("/"));
+
+    REQUIRE(rf_str_match(file, rf_cstr("robot.glb")));
+    REQUIRE(rf_str_match(src, rf_cstr("assets/models")));
+}
+
+TEST_CASE("rf_utf8 block decoding", "[str]")
+{
+    // Long enough to go through the block validation, with the multi byte sequences crossing block boundaries
+    std::string text;
+    for (int i = 0; i < 40; i++) text += "ascii run long enough for a block, h\xC3\xA9llo \xE2\x9C\x93 \xF0\x9F\x98\x80 \xE6\x97\xA5\xE6\x9C\xAC ";
+
+    SECTION("Valid text should decode to the same runes as rf_decode_utf8_char")
+    {
+        std::vector<rf_rune> expected;
+        for (rf_int i = 0; i < (rf_int) text.size();)
+        {
+            rf_decoded_rune rune = rf_decode_utf8_char(text.data() + i, text.size() - i);
+            REQUIRE(rune.valid);
+            expected.push_back(rune.codepoint);
+            i += rune.bytes_processed;
+        }
+
+        std::vector<rf_rune> runes(text.size());
+        rf_decoded_string decoded = rf_decode_utf8_to_buffer(text.data(), text.size(), runes.data(), runes.size());
+        REQUIRE(decoded.size == (rf_int) expected.size());
+        REQUIRE(decoded.invalid_bytes_count == 0);
+        REQUIRE(memcmp(runes.data(), expected.data(), expected.size() * sizeof(rf_rune)) == 0);
+
+        rf_utf8_stats stats = rf_count_utf8_chars(text.data(), text.size());
+        REQUIRE(stats.bytes_processed == (rf_int) text.size());
+        REQUIRE(stats.valid_rune_count == (rf_int) expected.size());
+        REQUIRE(stats.invalid_bytes == 0);
+        REQUIRE(rf_validate_utf8(text.data(), text.size()));
+    }
+    SECTION("Invalid sequences should be reported wherever they are")
+    {
+        const char* invalid[] = { "\xC0\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\x80", "\xE2\x9C" };
+
+        for (const char* sequence : invalid)
+        {
+            for (size_t at : { (size_t) 0, (size_t) 31, (size_t) 700, text.size() })
+            {
+                std::string broken = text;
+                broken.insert(at, sequence);
+
+                REQUIRE(!rf_validate_utf8(broken.data(), broken.size()));
+                rf_utf8_stats stats = rf_count_utf8_chars(broken.data(), broken.size());
+                REQUIRE(stats.invalid_bytes > 0);
+                REQUIRE(stats.bytes_processed == (rf_int) broken.size());
+            }
+        }
+    }
+}
+
+TEST_CASE("rf_strbuf_appendf", "[strbuf]")
+{
+    SECTION("Formatting should match snprintf")
+    {
+        char expected[256];
+        char result[256];
+
+        snprintf(expected, sizeof(expected), "%d|%-6s|%08.3f|%+.2e|%#x|%g|%5.1f%%|%.0f|%lld", -42, "hud", 3.14159, 12345.678, 255, 0.0001, 99.5, 2.5, -9000000000ll);
+        rf_int size = rf_format_to_buffer(result, sizeof(result), "%d|%-6s|%08.3f|%+.2e|%#x|%g|%5.1f%%|%.0f|%lld", -42, "hud", 3.14159, 12345.678, 255, 0.0001, 99.5, 2.5, -9000000000ll);
+
+        REQUIRE(size == (rf_int) strlen(expected));
+        REQUIRE(strcmp(result, expected) == 0);
+
+        // Truncated output still reports the full size
+        REQUIRE(rf_format_to_buffer(result, 4, "%d", 123456) == 6);
+        REQUIRE(strcmp(result, "123") == 0);
+
+        rf_format_to_buffer(result, sizeof(result), "%a|%.0a|%A|%010.2a|%a", 1.5, 1.5, -0.1, 3.0, 0.0);
+        REQUIRE(strcmp(result, "0x1.8p+0|0x2p+0|-0X1.999999999999AP-4|0x01.80p+1|0x0p+0") == 0);
+
+        // Unknown conversions are echoed with their flags and width
+        rf_format_to_buffer(result, sizeof(result), "[%-5y] [%y]", 1);
+        REQUIRE(strcmp(result, "[%-5y] [%y]") == 0);
+    }
+    SECTION("A strbuf on the stack should only allocate once it is outgrown")
+    {
+        rf_strbuf_on_stack(strbuf, 32, rf_default_allocator);
+        REQUIRE(strbuf.valid);
+        REQUIRE(!strbuf.owns_data);
+
+        rf_strbuf_appendf(&strbuf, "FPS: %d", 60);
+        REQUIRE(!strbuf.owns_data);
+        REQUIRE(rf_str_match(rf_strbuf_to_str(strbuf), rf_cstr("FPS: 60")));
+
+        for (int i = 0; i < 100; i++) rf_strbuf_appendf(&strbuf, " %d", i);
+        REQUIRE(strbuf.owns_data);
+        REQUIRE(strbuf.capacity > strbuf.size);
+        REQUIRE(rf_str_match_prefix(rf_strbuf_to_str(strbuf), rf_cstr("FPS: 60 0 1 2 3")));
+        REQUIRE(rf_str_match_suffix(rf_strbuf_to_str(strbuf), rf_cstr(" 98 99")));
+        REQUIRE(strbuf.data[strbuf.size] == 0);
+
+        rf_strbuf_free(&strbuf);
+    }
+    SECTION("Inserting utf8 should work at the front, in the middle and at the end")
+    {
+        rf_strbuf strbuf = rf_strbuf_make_ex(16, rf_default_allocator);
+        rf_strbuf_append(&strbuf, rf_cstr("\xc3\xa9t\xc3\xa9"));
+
+        rf_strbuf_insert_utf8(&strbuf, rf_cstr("<"), 0);
+        rf_strbuf_insert_utf8(&strbuf, rf_cstr("|"), 2);
+        rf_strbuf_insert_utf8(&strbuf, rf_cstr(">"), 5);
+        REQUIRE(rf_str_match(rf_strbuf_to_str(strbuf), rf_cstr("<\xc3\xa9|t\xc3\xa9>")));
+        REQUIRE(strbuf.data[strbuf.size] == 0);
+
+        rf_strbuf_free(&strbuf);
+    }
+}
+
+TEST_CASE("rf_str number parsing and formatting", "[str]")
+{
+    SECTION("Parsing should round like strtod")
+    {
+        const char* inputs[] = {
+            "0", "-0", "0.1", "1e23", "9007199254740993", "2.2250738585072011e-308", "4.9406564584124654e-324", "2.4703282292062328e-324",
+            "1.7976931348623157e308", "1e400", "1e-400", "123456789012345678901234567890.123", "3.4028235677973366e38", "7.0064923216240854e-46",
+        };
+
+        for (const char* input : inputs)
+        {
+            double parsed_double = 0;
+            float parsed_float = 0;
+            double expected_double = strtod(input, nullptr);
+            float expected_float = strtof(input, nullptr);
+
+            REQUIRE(rf_str_parse_double(rf_cstr(input), &parsed_double) == (rf_int) strlen(input));
+            REQUIRE(rf_str_parse_float(rf_cstr(input), &parsed_float) == (rf_int) strlen(input));
+            REQUIRE(memcmp(&parsed_double, &expected_double, sizeof(double)) == 0);
+            REQUIRE(memcmp(&parsed_float, &expected_float, sizeof(float)) == 0);
+        }
+
+        rf_int parsed_int = 0;
+        REQUIRE(rf_str_parse_int(rf_cstr("  -1234x"), &parsed_int) == 7);
+        REQUIRE(parsed_int == -1234);
+        REQUIRE(rf_str_parse_int(rf_cstr("x"), &parsed_int) == 0);
+        REQUIRE(rf_str_to_float(rf_cstr(" 2.5e1")) == 25.0f);
+    }
+    SECTION("Formatting should give the shortest text that round trips")
+    {
+        char buffer[64];
+
+        rf_format_double(buffer, sizeof(buffer), 0.1);
+        REQUIRE(strcmp(buffer, "0.1") == 0);
+        rf_format_double(buffer, sizeof(buffer), 1e22);
+        REQUIRE(strcmp(buffer, "1e+22") == 0);
+        rf_format_double(buffer, sizeof(buffer), 5e-324);
+        REQUIRE(strcmp(buffer, "5e-324") == 0);
+        rf_format_float(buffer, sizeof(buffer), 0.3f);
+        REQUIRE(strcmp(buffer, "0.3") == 0);
+        rf_format_int(buffer, sizeof(buffer), INT64_MIN);
+        REQUIRE(strcmp(buffer, "-9223372036854775808") == 0);
+
+        rf_rand rng = rf_rand_make(18);
+
+        for (int i = 0; i < 10000; i++)
+        {
+            uint64_t bits = rf_rand_next(&rng);
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            if (value != value) continue;
+
+            rf_int size = rf_format_double(buffer, sizeof(buffer), value);
+            REQUIRE(size == (rf_int) strlen(buffer));
+
+            double parsed = 0;
+            REQUIRE(rf_str_parse_double(rf_cstr(buffer), &parsed) == size);
+            REQUIRE(memcmp(&parsed, &value, sizeof(double)) == 0);
+        }
+    }
+    SECTION("Batch parsing should stop at the first field that isn't a number")
+    {
+        float values[8] = {0};
+
+        REQUIRE(rf_str_parse_floats(rf_cstr("v 1.5  -2\t3e2"), ' ', values, 8) == 0);
+        REQUIRE(rf_str_parse_floats(rf_cstr("1.5  -2\t3e2"), ' ', values, 8) == 3);
+        REQUIRE(values[2] == 300.0f);
+        REQUIRE(rf_str_parse_floats(rf_cstr("1, 2 ,3,,4"), ',', values, 8) == 3);
+        REQUIRE(rf_str_parse_floats(rf_cstr("1,2,3,4"), ',', values, 2) == 2);
+    }
+}
+
+TEST_CASE("rf_textbuf", "[strbuf]")
+{
+    SECTION("Random edits should match a std::string and keep the line index in sync")
+    {
+        rf_rand rng = rf_rand_make(19);
+        rf_textbuf textbuf = rf_textbuf_make(0, rf_default_allocator);
+        std::string expected;
+
+        const char* pieces[] = { "a", "bc", "\n", "x\ny", "\xc3\xa9", "\xe2\x82\xac\n", "line\n\n" };
+
+        for (int iteration = 0; iteration < 3000; iteration++)
+        {
+            rf_int operation = rf_rand_range(&rng, 0, 9);
+            rf_int cursor = rf_textbuf_cursor(&textbuf);
+
+            if (operation < 4)
+            {
+                const char* piece = pieces[rf_rand_range(&rng, 0, 6)];
+                REQUIRE(rf_textbuf_insert(&textbuf, rf_cstr(piece)));
+                expected.insert(cursor, piece);
+            }
+            else if (operation < 6)
+            {
+                // Move to a random rune boundary
+                rf_int offset = rf_rand_range(&rng, 0, (rf_int) expected.size());
+                while (offset > 0 && offset < (rf_int) expected.size() && (expected[offset] & 0xc0) == 0x80) offset--;
+                rf_textbuf_set_cursor(&textbuf, offset);
+                REQUIRE(rf_textbuf_cursor(&textbuf) == offset);
+            }
+            else if (operation == 6)
+            {
+                rf_int removed = rf_textbuf_delete_backward(&textbuf, rf_rand_range(&rng, 1, 3));
+                expected.erase(cursor - removed, removed);
+            }
+            else if (operation == 7)
+            {
+                rf_int removed = rf_textbuf_delete_forward(&textbuf, rf_rand_range(&rng, 1, 3));
+                expected.erase(cursor, removed);
+            }
+            else
+            {
+                rf_int begin = rf_rand_range(&rng, 0, (rf_int) expected.size());
+                rf_int end = rf_rand_range(&rng, begin, (rf_int) expected.size());
+                if (rf_textbuf_line_count(&textbuf) > 1 && operation == 9)
+                {
+                    // Remove a whole line like an editor would
+                    rf_int line = rf_rand_range(&rng, 0, rf_textbuf_line_count(&textbuf) - 2);
+                    begin = rf_textbuf_line_begin(&textbuf, line);
+                    end = rf_textbuf_line_begin(&textbuf, line + 1);
+                }
+                while (begin > 0 && (expected[begin] & 0xc0) == 0x80) begin--;
+                while (end < (rf_int) expected.size() && (expected[end] & 0xc0) == 0x80) end++;
+
+                rf_textbuf_remove_range(&textbuf, begin, end);
+                expected.erase(begin, end - begin);
+                if (begin < end) REQUIRE(rf_textbuf_cursor(&textbuf) == begin);
+            }
+
+            REQUIRE(rf_textbuf_size(&textbuf) == (rf_int) expected.size());
+
+            rf_textbuf_slice all = rf_textbuf_get_slice(&textbuf, 0, rf_textbuf_size(&textbuf));
+            REQUIRE(std::string(all.first.data, all.first.size) + std::string(all.second.data, all.second.size) == expected);
+
+            rf_int line = 0;
+            for (rf_int i = 0; i < (rf_int) expected.size(); i++)
+            {
+                if (expected[i] == '\n')
+                {
+                    line++;
+                    REQUIRE(rf_textbuf_line_begin(&textbuf, line) == i + 1);
+                }
+            }
+            REQUIRE(rf_textbuf_line_count(&textbuf) == line + 1);
+        }
+
+        rf_textbuf_free(&textbuf);
+    }
+    SECTION("Lines and columns")
+    {
+        rf_textbuf textbuf = rf_textbuf_make_from_str(rf_cstr("first\nd\xc3\xa9j\xc3\xa0 vu\n\nlast"), rf_default_allocator);
+        rf_textbuf_set_cursor(&textbuf, 8);
+
+        REQUIRE(rf_textbuf_line_count(&textbuf) == 4);
+        REQUIRE(rf_textbuf_line_at(&textbuf, 5) == 0);
+        REQUIRE(rf_textbuf_line_at(&textbuf, 6) == 1);
+        REQUIRE(rf_textbuf_line_at(&textbuf, 15) == 1);
+        REQUIRE(rf_textbuf_line_at(&textbuf, 16) == 2);
+        REQUIRE(rf_textbuf_line_at(&textbuf, 17) == 3);
+
+        // The line spans the cursor so it comes back in two parts
+        rf_textbuf_slice line = rf_textbuf_get_line(&textbuf, 1);
+        REQUIRE(rf_str_match(line.first, rf_cstr("d\xc3")));
+        REQUIRE(rf_str_match(line.second, rf_cstr("\xa9j\xc3\xa0 vu")));
+
+        REQUIRE(rf_textbuf_column_at(&textbuf, 12) == 4);
+        REQUIRE(rf_textbuf_offset_at(&textbuf, 1, 4) == 12);
+        REQUIRE(rf_textbuf_offset_at(&textbuf, 1, 100) == rf_textbuf_line_end(&textbuf, 1));
+        REQUIRE(rf_textbuf_next_rune(&textbuf, 7) == 9);
+        REQUIRE(rf_textbuf_prev_rune(&textbuf, 9) == 7);
+
+        rf_strbuf flat = rf_textbuf_to_strbuf(&textbuf, rf_default_allocator);
+        REQUIRE(rf_str_match(rf_strbuf_to_str(flat), rf_cstr("first\nd\xc3\xa9j\xc3\xa0 vu\n\nlast")));
+        rf_strbuf_free(&flat);
+
+        rf_textbuf_free(&textbuf);
+    }
+    SECTION("rf_strbuf_remove_range_utf8")
+    {
+        rf_strbuf strbuf = rf_strbuf_make_ex(32, rf_default_allocator);
+        rf_strbuf_append(&strbuf, rf_cstr("d\xc3\xa9j\xc3\xa0 vu"));
+
+        rf_strbuf_remove_range_utf8(&strbuf, 1, 4);
+        REQUIRE(rf_str_match(rf_strbuf_to_str(strbuf), rf_cstr("d vu")));
+
+        rf_strbuf_free(&strbuf);
+    }
+}
+
+TEST_CASE("rf_csv", "[csv]")
+{
+    SECTION("Quoted elements can contain separators, quotes and line breaks")
+    {
+        std::string long_quoted(100, 'x');
+        long_quoted[70] = ',';
+        long_quoted[80] = '\n';
+        std::string csv = "id,name,notes\r\n1,\"Doe, John\",\"said \"\"hi\"\"\"\r\n2,,\"" + long_quoted + "\"\n3,last,";
+
+        rf_csv_iter iter = rf_csv_make_iter(rf_str { (char*) csv.data(), (rf_int) csv.size() });
+        std::vector<std::vector<std::string>> rows;
+
+        while (rf_csv_advance_row(&iter))
+        {
+            rows.emplace_back();
+
+            rf_csv_element element;
+            while (rf_csv_next_col_element(&iter, &element))
+            {
+                char unescaped[256];
+                rf_int size = element.quoted ? rf_csv_unescape_to_buffer(element.str, unescaped, sizeof(unescaped)) : 0;
+                rows.back().push_back(element.quoted ? std::string(unescaped, size) : std::string(element.str.data, element.str.size));
+            }
+        }
+
+        REQUIRE(rows.size() == 4);
+        REQUIRE(rows[0] == std::vector<std::string> { "id", "name", "notes" });
+        REQUIRE(rows[1] == std::vector<std::string> { "1", "Doe, John", "said \"hi\"" });
+        REQUIRE(rows[2] == std::vector<std::string> { "2", "", long_quoted });
+        REQUIRE(rows[3] == std::vector<std::string> { "3", "last", "" });
+    }
+    SECTION("Rows that aren't read to the end are skipped")
+    {
+        rf_str csv = rf_cstr("a;b;c\nd;e;f\n\ng;h;i\n");
+        rf_csv_iter iter = rf_csv_make_iter_ex(csv, ';');
+
+        rf_int rows = 0;
+        rf_csv_element element = {0};
+        while (rf_csv_advance_row(&iter))
+        {
+            rf_csv_next_col_element(&iter, &element);
+            rows++;
+        }
+
+        REQUIRE(rows == 4);
+        REQUIRE(rf_str_match(element.str, rf_cstr("g")));
+        REQUIRE(rf_csv_col_count_ex(csv, ';') == 3);
+        REQUIRE(rf_csv_col_count(rf_cstr("")) == 0);
+    }
+    SECTION("Rows indexed in parallel start where the iterator finds them")
+    {
+        // Several chunks with quoted line breaks running across their boundaries
+        std::string csv;
+        rf_rand rng = rf_rand_make(21);
+        while (csv.size() < 3 * RF_CSV_CHUNK_SIZE + 1000)
+        {
+            csv += std::to_string(rf_rand_next(&rng) % 1000) + ",";
+            if (rf_rand_next(&rng) % 8 == 0) csv += "\"" + std::string(rf_rand_next(&rng) % 300000, '\n') + "\"\"\"";
+            csv += rf_rand_next(&rng) % 2 ? "\n" : "\r\n";
+        }
+        csv += "last";
+        rf_str src = rf_str { (char*) csv.data(), (rf_int) csv.size() };
+
+        std::vector<rf_int> expected;
+        rf_csv_iter iter = rf_csv_make_iter(src);
+        while (rf_csv_advance_row(&iter)) expected.push_back(iter.position);
+
+        rf_job_system system;
+        REQUIRE(rf_job_system_init(&system, 3, rf_default_allocator));
+
+        rf_csv_rows rows = rf_csv_index_rows_parallel(src, rf_job_system_scheduler(&system), rf_default_allocator);
+        REQUIRE(rows.valid);
+        REQUIRE(std::vector<rf_int>(rows.offsets, rows.offsets + rf_csv_rows_count(&rows)) == expected);
+        REQUIRE(rf_str_match(rf_csv_rows_get(&rows, rf_csv_rows_count(&rows) - 1), rf_cstr("last")));
+        REQUIRE(rf_csv_col_count(rf_csv_rows_get(&rows, 1)) == 2);
+        rf_csv_rows_free(&rows);
+
+        rf_job_system_shutdown(&system);
+
+        rows = rf_csv_index_rows(rf_cstr("a\r\nb\n\n"), rf_default_allocator);
+        REQUIRE(rf_csv_rows_count(&rows) == 3);
+        REQUIRE(rf_str_match(rf_csv_rows_get(&rows, 0), rf_cstr("a")));
+        REQUIRE(rf_str_match(rf_csv_rows_get(&rows, 2), rf_cstr("")));
+        REQUIRE(rf_str_match(rf_csv_rows_get_range(&rows, 0, 2), rf_cstr("a\r\nb")));
+        rf_csv_rows_free(&rows);
+    }
+    SECTION("Columns are extracted into typed arrays and bad cells are reported")
+    {
+        rf_str csv = rf_cstr("id,name,skipped,value,precise\n1,a,x,0.5,1e-300\n2,\"b, c\",x, 2.25 ,\"7\"\n3,d,x,oops,\n4,e\n5,f,x,1e10,3,extra\n");
+        rf_csv_iter iter = rf_csv_make_iter(csv);
+        REQUIRE(rf_csv_advance_row(&iter));
+
+        rf_int ids[3];
+        rf_str names[3];
+        float values[3];
+        double precise[3];
+        rf_csv_cell bad_cells[2];
+        rf_csv_column columns[] = {
+            { rf_csv_column_int, ids },
+            { rf_csv_column_str, names },
+            { rf_csv_column_skip, 0 },
+            { rf_csv_column_float, values },
+            { rf_csv_column_double, precise },
+        };
+
+        rf_csv_extract_result batch = rf_csv_extract_columns(&iter, columns, 5, 3, bad_cells, 2);
+        REQUIRE(batch.rows == 3);
+        REQUIRE(batch.bad_cells == 2);
+        REQUIRE(ids[2] == 3);
+        REQUIRE(rf_str_match(names[1], rf_cstr("b, c")));
+        REQUIRE(values[0] == 0.5f);
+        REQUIRE(values[1] == 2.25f);
+        REQUIRE(std::isnan(values[2]));
+        REQUIRE(precise[0] == 1e-300);
+        REQUIRE(precise[1] == 7);
+        REQUIRE(bad_cells[0].row == 3);
+        REQUIRE(bad_cells[0].col == 3);
+        REQUIRE(bad_cells[1].col == 4);
+
+        batch = rf_csv_extract_columns(&iter, columns, 5, 3, bad_cells, 2);
+        REQUIRE(batch.rows == 2);
+        REQUIRE(batch.bad_cells == 2);
+        REQUIRE(bad_cells[0].row == 4);
+        REQUIRE(bad_cells[0].col == 3);
+        REQUIRE(ids[1] == 5);
+        REQUIRE(values[1] == 1e10f);
+        REQUIRE(precise[1] == 3);
+
+        REQUIRE(rf_csv_extract_columns(&iter, columns, 5, 3, bad_cells, 2).rows == 0);
+    }
+    SECTION("Integers that overflow rf_int are bad cells instead of being saturated")
+    {
+        rf_str csv = rf_cstr("9223372036854775807\n99999999999999999999\n-9223372036854775808\n9223372036854775808\n00000000000000000000042\n");
+        rf_csv_iter iter = rf_csv_make_iter(csv);
+
+        rf_int ids[5];
+        rf_csv_cell bad_cells[4];
+        rf_csv_column columns[] = { { rf_csv_column_int, ids } };
+
+        rf_csv_extract_result batch = rf_csv_extract_columns(&iter, columns, 1, 5, bad_cells, 4);
+        REQUIRE(batch.rows == 5);
+        REQUIRE(batch.bad_cells == 2);
+        REQUIRE(bad_cells[0].row == 1);
+        REQUIRE(bad_cells[1].row == 3);
+        REQUIRE(ids[0] == PTRDIFF_MAX);
+        REQUIRE(ids[1] == 0);
+        REQUIRE(ids[2] == PTRDIFF_MIN);
+        REQUIRE(ids[3] == 0);
+        REQUIRE(ids[4] == 42);
+    }
+    SECTION("A saved row index jumps straight to any row")
+    {
+        std::string csv;
+        for (int i = 0; i < 100; i++) csv += std::to_string(i) + (i % 7 ? ",x\n" : ",\"multi\nline\"\r\n");
+        rf_str src = rf_str { (char*) csv.data(), (rf_int) csv.size() };
+
+        rf_csv_row_index index = rf_csv_build_row_index(src, 8, rf_immediate_scheduler, rf_default_allocator);
+        REQUIRE(index.valid);
+        REQUIRE(index.rows_count == 100);
+        REQUIRE(rf_arr_size(index.samples) == 13);
+
+        const char* filename = "rf_csv_row_index_test.csv";
+        REQUIRE(rf_csv_save_row_index(&index, rf_default_io, filename, rf_default_allocator));
+        rf_csv_row_index_free(&index);
+
+        // Same size but a line break moved into the row before the second sample
+        std::string edited = csv;
+        rf_int moved = 0;
+        {
+            rf_csv_row_index built = rf_csv_build_row_index(src, 8, rf_immediate_scheduler, rf_default_allocator);
+            moved = built.samples[1];
+            rf_csv_row_index_free(&built);
+        }
+        std::swap(edited[moved - 1], edited[moved - 2]);
+        rf_str edited_src = rf_str { (char*) edited.data(), (rf_int) edited.size() };
+
+        REQUIRE(!rf_csv_load_row_index(rf_default_io, filename, rf_str { src.data, src.size - 1 }, rf_default_allocator, rf_default_allocator).valid);
+        REQUIRE(!rf_csv_load_row_index(rf_default_io, filename, edited_src, rf_default_allocator, rf_default_allocator).valid);
+        index = rf_csv_load_row_index(rf_default_io, filename, src, rf_default_allocator, rf_default_allocator);
+        std::remove((std::string(filename) + RF_CSV_ROW_INDEX_EXTENSION).c_str());
+        REQUIRE(index.valid);
+        REQUIRE(rf_csv_row_index_matches(&index, src));
+        REQUIRE(!rf_csv_row_index_make_iter(&index, edited_src, ',', 8).valid);
+        REQUIRE(rf_csv_row_index_make_iter(&index, edited_src, ',', 0).valid);
+
+        for (int i = 0; i < 100; i++)
+        {
+            rf_csv_iter iter = rf_csv_row_index_make_iter(&index, src, ',', i);
+            rf_csv_element element;
+            REQUIRE(rf_csv_advance_row(&iter));
+            REQUIRE(iter.row == i);
+            REQUIRE(rf_csv_next_col_element(&iter, &element));
+            REQUIRE(rf_str_to_int(element.str) == i);
+        }
+
+        REQUIRE(!rf_csv_row_index_make_iter(&index, src, ',', 100).valid);
+        REQUIRE(!rf_csv_row_index_from_buffer(csv.data(), (rf_int) csv.size(), rf_default_allocator).valid);
+
+        // Counts near INT64_MAX in a crafted file are rejected without overflowing the checks
+        std::vector<char> buffer(rf_csv_row_index_to_buffer(&index, 0, 0));
+        REQUIRE(rf_csv_row_index_to_buffer(&index, buffer.data(), (rf_int) buffer.size()) == (rf_int) buffer.size());
+        rf_csv_row_index copy = rf_csv_row_index_from_buffer(buffer.data(), (rf_int) buffer.size(), rf_default_allocator);
+        REQUIRE(copy.valid);
+        rf_csv_row_index_free(&copy);
+        for (int field : { 16, 24 })
+        {
+            std::vector<char> crafted = buffer;
+            uint64_t huge = INT64_MAX;
+            memcpy(crafted.data() + field, &huge, 8);
+            REQUIRE(!rf_csv_row_index_from_buffer(crafted.data(), (rf_int) crafted.size(), rf_default_allocator).valid);
+        }
+        rf_csv_row_index_free(&index);
+    }
+}
+
+// The reference code below must not be fused into fma either, see the top of rayfork-math.c
+#if defined(rayfork_clang)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(rayfork_msvc)
+    #pragma fp_contract(off)
+#endif
+
+// The scalar versions of the math kernels, the simd ones have to match them to the bit
+static rf_mat reference_mat_mul(rf_mat left, rf_mat right)
+{
+    rf_mat result = {0};
+    result.m0 = left.m0 * right.m0 + left.m1 * right.m4 + left.m2 * right.m8 + left.m3 * right.m12;
+    result.m1 = left.m0 * right.m1 + left.m1 * right.m5 + left.m2 * right.m9 + left.m3 * right.m13;
+    result.m2 = left.m0 * right.m2 + left.m1 * right.m6 + left.m2 * right.m10 + left.m3 * right.m14;
+    result.m3 = left.m0 * right.m3 + left.m1 * right.m7 + left.m2 * right.m11 + left.m3 * right.m15;
+    result.m4 = left.m4 * right.m0 + left.m5 * right.m4 + left.m6 * right.m8 + left.m7 * right.m12;
+    result.m5 = left.m4 * right.m1 + left.m5 * right.m5 + left.m6 * right.m9 + left.m7 * right.m13;
+    result.m6 = left.m4 * right.m2 + left.m5 * right.m6 + left.m6 * right.m10 + left.m7 * right.m14;
+    result.m7 = left.m4 * right.m3 + left.m5 * right.m7 + left.m6 * right.m11 + left.m7 * right.m15;
+    result.m8 = left.m8 * right.m0 + left.m9 * right.m4 + left.m10 * right.m8 + left.m11 * right.m12;
+    result.m9 = left.m8 * right.m1 + left.m9 * right.m5 + left.m10 * right.m9 + left.m11 * right.m13;
+    result.m10 = left.m8 * right.m2 + left.m9 * right.m6 + left.m10 * right.m10 + left.m11 * right.m14;
+    result.m11 = left.m8 * right.m3 + left.m9 * right.m7 + left.m10 * right.m11 + left.m11 * right.m15;
+    result.m12 = left.m12 * right.m0 + left.m13 * right.m4 + left.m14 * right.m8 + left.m15 * right.m12;
+    result.m13 = left.m12 * right.m1 + left.m13 * right.m5 + left.m14 * right.m9 + left.m15 * right.m13;
+    result.m14 = left.m12 * right.m2 + left.m13 * right.m6 + left.m14 * right.m10 + left.m15 * right.m14;
+    result.m15 = left.m12 * right.m3 + left.m13 * right.m7 + left.m14 * right.m11 + left.m15 * right.m15;
+    return result;
+}
+
+static rf_mat reference_mat_invert(rf_mat mat)
+{
+    rf_mat result = {0};
+    float a00 = mat.m0, a01 = mat.m1, a02 = mat.m2, a03 = mat.m3;
+    float a10 = mat.m4, a11 = mat.m5, a12 = mat.m6, a13 = mat.m7;
+    float a20 = mat.m8, a21 = mat.m9, a22 = mat.m10, a23 = mat.m11;
+    float a30 = mat.m12, a31 = mat.m13, a32 = mat.m14, a33 = mat.m15;
+
+    float b00 = a00 * a11 - a01 * a10;
+    float b01 = a00 * a12 - a02 * a10;
+    float b02 = a00 * a13 - a03 * a10;
+    float b03 = a01 * a12 - a02 * a11;
+    float b04 = a01 * a13 - a03 * a11;
+    float b05 = a02 * a13 - a03 * a12;
+    float b06 = a20 * a31 - a21 * a30;
+    float b07 = a20 * a32 - a22 * a30;
+    float b08 = a20 * a33 - a23 * a30;
+    float b09 = a21 * a32 - a22 * a31;
+    float b10 = a21 * a33 - a23 * a31;
+    float b11 = a22 * a33 - a23 * a32;
+
+    float invDet = 1.0f / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06);
+
+    result.m0 = (a11 * b11 - a12 * b10 + a13 * b09) * invDet;
+    result.m1 = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet;
+    result.m2 = (a31 * b05 - a32 * b04 + a33 * b03) * invDet;
+    result.m3 = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet;
+    result.m4 = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet;
+    result.m5 = (a00 * b11 - a02 * b08 + a03 * b07) * invDet;
+    result.m6 = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet;
+    result.m7 = (a20 * b05 - a22 * b02 + a23 * b01) * invDet;
+    result.m8 = (a10 * b10 - a11 * b08 + a13 * b06) * invDet;
+    result.m9 = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet;
+    result.m10 = (a30 * b04 - a31 * b02 + a33 * b00) * invDet;
+    result.m11 = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet;
+    result.m12 = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet;
+    result.m13 = (a00 * b09 - a01 * b07 + a02 * b06) * invDet;
+    result.m14 = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet;
+    result.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet;
+    return result;
+}
+
+// Mostly ordinary values plus signed zeros, small integers and denormals to catch differently rounded or signed results
+static float random_math_float(rf_rand* rng)
+{
+    switch (rf_rand_next(rng) % 8)
+    {
+        case 0: return (rf_rand_next(rng) & 1) ? -0.0f : 0.0f;
+        case 1: return (float) (int) (rf_rand_next(rng) % 5) - 2;
+        case 2: return (rf_rand_next(rng) & 1 ? -1 : 1) * 1e-40f * (float) (rf_rand_next(rng) % 1000);
+        default: return ((float) (rf_rand_next(rng) % 2000001) / 1000000.0f - 1.0f) * (float) (1 << (rf_rand_next(rng) % 16));
+    }
+}
+
+TEST_CASE("rf_mat kernels match the scalar code bit for bit", "[math]")
+{
+    rf_rand rng = rf_rand_make(24);
+    auto random_float = [&rng]() -> float { return random_math_float(&rng); };
+
+    for (int i = 0; i < 100000; i++)
+    {
+        rf_mat a, b;
+        for (int j = 0; j < 16; j++) ((float*) &a)[j] = random_float();
+        for (int j = 0; j < 16; j++) ((float*) &b)[j] = random_float();
+
+        rf_mat expected_product = reference_mat_mul(a, b);
+        rf_mat product = rf_mat_mul(a, b);
+        REQUIRE(memcmp(&product, &expected_product, sizeof(rf_mat)) == 0);
+
+        rf_mat_mul_ptr(&a, &b, &product);
+        REQUIRE(memcmp(&product, &expected_product, sizeof(rf_mat)) == 0);
+
+        rf_mat expected_inverse = reference_mat_invert(a);
+        rf_mat inverse = rf_mat_invert(a);
+        REQUIRE(memcmp(&inverse, &expected_inverse, sizeof(rf_mat)) == 0);
+
+        // The outputs may alias the inputs
+        rf_mat_invert_ptr(&a, &a);
+        REQUIRE(memcmp(&a, &expected_inverse, sizeof(rf_mat)) == 0);
+
+        rf_vec3 v = { random_float(), random_float(), random_float() };
+        rf_vec3 expected_point = {
+            b.m0 * v.x + b.m4 * v.y + b.m8 * v.z + b.m12,
+            b.m1 * v.x + b.m5 * v.y + b.m9 * v.z + b.m13,
+            b.m2 * v.x + b.m6 * v.y + b.m10 * v.z + b.m14,
+        };
+        rf_vec3 point = rf_vec3_transform_ptr(v, &b);
+        REQUIRE(memcmp(&point, &expected_point, sizeof(rf_vec3)) == 0);
+
+        rf_quaternion q1 = { random_float(), random_float(), random_float(), random_float() };
+        rf_quaternion q2 = { random_float(), random_float(), random_float(), random_float() };
+        rf_quaternion expected_q = {
+            q1.x * q2.w + q1.w * q2.x + q1.y * q2.z - q1.z * q2.y,
+            q1.y * q2.w + q1.w * q2.y + q1.z * q2.x - q1.x * q2.z,
+            q1.z * q2.w + q1.w * q2.z + q1.x * q2.y - q1.y * q2.x,
+            q1.w * q2.w - q1.x * q2.x - q1.y * q2.y - q1.z * q2.z,
+        };
+        rf_quaternion q = rf_quaternion_mul(q1, q2);
+        REQUIRE(memcmp(&q, &expected_q, sizeof(rf_quaternion)) == 0);
+    }
+}
+
+TEST_CASE("rf_vec3_transform_array matches rf_vec3_transform", "[math]")
+{
+    rf_rand rng = rf_rand_make(25);
+
+    // Interleaved like mesh vertices with a position, a normal and a texcoord
+    struct vertex { rf_vec3 position; rf_vec3 normal; rf_vec2 texcoord; };
+
+    for (int count = 0; count < 40; count++)
+    {
+        rf_mat mat;
+        for (int j = 0; j < 16; j++) ((float*) &mat)[j] = random_math_float(&rng);
+
+        vertex vertices[40];
+        float xs[40], ys[40], zs[40];
+        for (int i = 0; i < count; i++)
+        {
+            vertices[i].position = { random_math_float(&rng), random_math_float(&rng), random_math_float(&rng) };
+            vertices[i].normal   = { random_math_float(&rng), random_math_float(&rng), random_math_float(&rng) };
+            vertices[i].texcoord = { random_math_float(&rng), random_math_float(&rng) };
+            xs[i] = vertices[i].position.x;
+            ys[i] = vertices[i].position.y;
+            zs[i] = vertices[i].position.z;
+        }
+
+        rf_vec3 positions[40], normals[40], points[40], expected_points[40], expected_normals[40];
+        rf_vec2 points_2d[40], expected_2d[40];
+        for (int i = 0; i < count; i++)
+        {
+            rf_vec3 p = vertices[i].position, n = vertices[i].normal;
+            rf_vec2 t = vertices[i].texcoord;
+
+            positions[i] = p;
+            normals[i] = n;
+            points_2d[i] = t;
+            expected_points[i] = rf_vec3_transform(p, mat);
+            expected_normals[i] = {
+                mat.m0 * n.x + mat.m4 * n.y + mat.m8 * n.z,
+                mat.m1 * n.x + mat.m5 * n.y + mat.m9 * n.z,
+                mat.m2 * n.x + mat.m6 * n.y + mat.m10 * n.z,
+            };
+            expected_2d[i] = { mat.m0 * t.x + mat.m4 * t.y + mat.m12, mat.m1 * t.x + mat.m5 * t.y + mat.m13 };
+        }
+
+        rf_vec3_transform_array(&mat, positions, points, count);
+        REQUIRE(memcmp(points, expected_points, count * sizeof(rf_vec3)) == 0);
+
+        // In place
+        rf_vec3_transform_array(&mat, positions, positions, count);
+        REQUIRE(memcmp(positions, expected_points, count * sizeof(rf_vec3)) == 0);
+
+        rf_vec3_transform_normals_array(&mat, normals, normals, count);
+        REQUIRE(memcmp(normals, expected_normals, count * sizeof(rf_vec3)) == 0);
+
+        rf_vec3_transform_array_soa(&mat, xs, ys, zs, xs, ys, zs, count);
+        for (int i = 0; i < count; i++)
+        {
+            rf_vec3 point = { xs[i], ys[i], zs[i] };
+            REQUIRE(memcmp(&point, &expected_points[i], sizeof(rf_vec3)) == 0);
+        }
+
+        rf_vec2_transform_array(&mat, points_2d, points_2d, count);
+        REQUIRE(memcmp(points_2d, expected_2d, count * sizeof(rf_vec2)) == 0);
+
+        // Strided in place, the fields around the transformed ones must stay untouched
+        vertex original[40];
+        memcpy(original, vertices, sizeof(vertices));
+        rf_vec3_transform_array_strided(&mat, &vertices[0].position, sizeof(vertex), &vertices[0].position, sizeof(vertex), count);
+        rf_vec3_transform_normals_array_strided(&mat, &vertices[0].normal, sizeof(vertex), &vertices[0].normal, sizeof(vertex), count);
+        for (int i = 0; i < count; i++)
+        {
+            REQUIRE(memcmp(&vertices[i].position, &expected_points[i], sizeof(rf_vec3)) == 0);
+            REQUIRE(memcmp(&vertices[i].normal, &expected_normals[i], sizeof(rf_vec3)) == 0);
+            REQUIRE(memcmp(&vertices[i].texcoord, &original[i].texcoord, sizeof(rf_vec2)) == 0);
+        }
+    }
+}
+
+#if defined(rayfork_clang)
+    #pragma STDC FP_CONTRACT DEFAULT
+#endif